@@ -25,6 +25,7 @@
 
 #include <vector>
 #include "ModelFitting/Parameters/EngineParameter.h"
+#include "ModelFitting/Parameters/ParameterUpdateBatch.h"
 
 namespace ModelFitting {
 
@@ -125,6 +126,8 @@ public:
    * of the managed parameters. Failure of this precondition can lead to
    * undefined behavior.
    * 
+   * The dependent parameters are updated once, after all the values are set.
+   * 
    * @tparam DoubleIter
    *    A forward input iterator to double
    * @param new_values_iter
@@ -9,6 +9,7 @@
 #define _MODELFITTING_MODELS_COMPACTSERSICMODEL_H_
 
 #include "ModelFitting/Models/CompactModelBase.h"
+#include "ModelFitting/Models/SersicProfileTable.h"
 
 namespace ModelFitting {
 
@@ -51,7 +52,30 @@ public:
     }
   };
 
+  /// Same as SersicModelEvaluator, from the tabulated profile
+  struct SersicTableEvaluator {
+    const SersicProfileTable* table;
+    Mat22 transform;
+    float i0, log_k, inv_n;
+    float max_r_sqr;
+
+    inline float evaluateModel(float x, float y) const {
+      float x2 = x * transform[0] + y * transform[1];
+      float y2 = x * transform[2] + y * transform[3];
+      float r_sqr = x2*x2 + y2*y2;
+      if (r_sqr < max_r_sqr) {
+        return i0 * table->evaluate(r_sqr, log_k, inv_n);
+      } else {
+        return 0.f;
+      }
+    }
+  };
+
 private:
+  /// Mean over the central pixel, from the integral over the disk inscribed in it, where the cusp is
+  float integrateCentralPixel(const SersicTableEvaluator& model_eval, double k, double n,
+                              unsigned int subsampling) const;
+
   using CompactModelBase<ImageType>::getMaxRadiusSqr;
   using CompactModelBase<ImageType>::getCombinedTransform;
   using CompactModelBase<ImageType>::samplePixel;
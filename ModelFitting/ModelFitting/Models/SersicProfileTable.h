@@ -0,0 +1,102 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * SersicProfileTable.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _MODELFITTING_MODELS_SERSICPROFILETABLE_H_
+#define _MODELFITTING_MODELS_SERSICPROFILETABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace ModelFitting {
+
+/**
+ * @class SersicProfileTable
+ * @brief Tabulated Sersic profile, shared by every index
+ *
+ * @details
+ *  The profile \f$ e^{-k R^{1/n}} \f$ is \f$ e^{-e^u} \f$ with \f$ u = \ln k + \ln(R) / n \f$, so a single
+ *  table in u covers every index and scale. It is interpolated linearly, and the logarithm is a polynomial,
+ *  so the evaluation of a row is arithmetic the compiler can vectorize, followed by the table lookups.
+ */
+class SersicProfileTable {
+public:
+
+  static const SersicProfileTable& getInstance();
+
+  /// Natural logarithm of a positive number, within a few ulp of std::log
+  static float fastLog(float x) {
+    std::int32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    // Split into a power of 2 and a mantissa in [sqrt(1/2), sqrt(2)), where the series below converges fast
+    std::int32_t exponent = (bits - 0x3f3504f3) >> 23;
+    bits -= exponent * (1 << 23);
+    float mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+    float z = (mantissa - 1.f) / (mantissa + 1.f), z2 = z * z;
+    float log_mantissa = 2.f * z * (1.f + z2 * (1.f / 3 + z2 * (1.f / 5 + z2 * (1.f / 7 + z2 * (1.f / 9)))));
+    return exponent * 0.69314718f + log_mantissa;
+  }
+
+  /// Profile with \f$ I_0 = 1 \f$ at the given \f$ R^2 \f$
+  float evaluate(float r_sqr, float log_k, float inv_n) const {
+    return lookup(toPosition(r_sqr, log_k, 0.5f * inv_n));
+  }
+
+  /**
+   * Profile with \f$ I_0 = 1 \f$ for count values of \f$ R^2 \f$, and 0 from max_r_sqr
+   */
+  void evaluate(const float* r_sqr, float* out, std::size_t count, float log_k, float inv_n, float max_r_sqr) const;
+
+  /// Integral of the profile with \f$ I_0 = 1 \f$ over the disk of the given radius
+  static double integrate(double k, double n, double radius);
+
+private:
+  // Below U_MIN the profile is 1 within 2e-8, above U_MAX it is below 1e-23
+  static constexpr float U_MIN = -18.f, U_MAX = 4.f;
+  static constexpr float STEPS_PER_UNIT = 256.f;
+  static constexpr float LAST_POSITION = (U_MAX - U_MIN) * STEPS_PER_UNIT;
+
+  SersicProfileTable();
+
+  static float toPosition(float r_sqr, float log_k, float half_inv_n) {
+    float u = log_k + fastLog(r_sqr) * half_inv_n;
+    float position = std::min(std::max((u - U_MIN) * STEPS_PER_UNIT, 0.f), LAST_POSITION);
+    // The logarithm of 0 is finite here, while the profile is 1 only at the center for large indices
+    return r_sqr > 0.f ? position : 0.f;
+  }
+
+  float lookup(float position) const {
+    auto i = static_cast<std::size_t>(position);
+    return m_values[i] + (position - i) * (m_values[i + 1] - m_values[i]);
+  }
+
+  std::vector<float> m_values;
+};
+
+} // end of namespace ModelFitting
+
+#endif /* _MODELFITTING_MODELS_SERSICPROFILETABLE_H_ */
@@ -27,6 +27,7 @@
 #include <vector>
 #include <memory>
 #include "ModelFitting/Parameters/BasicParameter.h"
+#include "ModelFitting/Parameters/ParameterUpdateBatch.h"
 
 namespace ModelFitting {
 
@@ -121,7 +122,15 @@ private:
     param->addObserver([this](double){
       // Do not bother updating live if there are no observers
       if (this->isObserved()) {
+        // Wait for all the inputs to be set when they are set together
+        if (auto batch = ParameterUpdateBatch::current()) {
+          batch->defer(this, [this]() {
+            this->update((*m_params)[0]->getValue());
+          });
+        }
+        else {
           this->update((*m_params)[0]->getValue());
+        }
       }
     });
   }
@@ -0,0 +1,78 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ParameterUpdateBatch.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef MODELFITTING_PARAMETERUPDATEBATCH_H
+#define MODELFITTING_PARAMETERUPDATEBATCH_H
+
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace ModelFitting {
+
+/**
+ * @class ParameterUpdateBatch
+ * @brief Delays the updates of the dependent parameters while several parameters are set
+ *
+ * @details
+ *    While a batch is active on a thread, the dependent parameters only register their update when one of
+ *    their inputs changes, and the updates run once all the inputs are set, when the batch is flushed. A
+ *    dependent parameter is then evaluated once instead of once per input changed. The evaluations of a
+ *    flush can also share a resource, such as a lock, kept until the flush ends.
+ *
+ *    Only the first batch created on a thread is active, the nested ones do nothing.
+ */
+class ParameterUpdateBatch {
+public:
+
+  ParameterUpdateBatch();
+
+  /// The updates not flushed are dropped
+  ~ParameterUpdateBatch();
+
+  ParameterUpdateBatch(const ParameterUpdateBatch&) = delete;
+  ParameterUpdateBatch& operator=(const ParameterUpdateBatch&) = delete;
+
+  /// Runs the delayed updates, including the ones they delay in turn, then releases the resources held
+  void flush();
+
+  /// @return the batch active on the calling thread, or nullptr if there is none
+  static ParameterUpdateBatch* current();
+
+  /// Registers the update of a parameter, if it is not already pending
+  void defer(const void* parameter, std::function<void()> update);
+
+  /// Keeps the resource created by the factory until the end of the flush, only once per key
+  void hold(const void* key, const std::function<std::shared_ptr<void>()>& factory);
+
+private:
+  bool m_active;
+  std::vector<std::pair<const void*, std::function<void()>>> m_updates;
+  std::unordered_set<const void*> m_pending;
+  std::vector<std::pair<const void*, std::shared_ptr<void>>> m_resources;
+};
+
+} // namespace ModelFitting
+
+#endif  /* MODELFITTING_PARAMETERUPDATEBATCH_H */
@@ -22,6 +22,7 @@
 
 #include "ModelFitting/Engine/GSLEngine.h"
 #include "ModelFitting/Engine/LeastSquareEngineManager.h"
+#include "SEUtils/MemoryAccounting.h"
 #include <ElementsKernel/Exception.h>
 #include <array>
 #include <chrono>
@@ -150,6 +151,11 @@ LeastSquareSummary GSLEngine::solveProblem(ModelFitting::EngineParameterManager&
   if (workspace == nullptr) {
     throw Elements::Exception() << "Insufficient memory for initializing the GSL solver";
   }
+  // Dominated by the jacobian, the residual vectors and the normal matrix of the Cholesky solver
+  size_t nresiduals = residual_estimator.numberOfResiduals(), nparams = parameter_manager.numberOfParameters();
+  SourceXtractor::MemoryAccounting::Allocation workspace_memory(
+    SourceXtractor::MemoryAccounting::FITTING,
+    (nresiduals * nparams + 4 * nresiduals + nparams * nparams) * sizeof(double));
 
   // Allocate space for the parameters and initialize with the guesses
   std::vector<double> param_values(parameter_manager.numberOfParameters());
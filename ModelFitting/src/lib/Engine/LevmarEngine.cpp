@@ -27,6 +27,7 @@
 #include <levmar.h>
 #include <ElementsKernel/Exception.h>
 #include <ElementsKernel/Logging.h>
+#include "SEUtils/MemoryAccounting.h"
 #include "ModelFitting/Engine/LeastSquareEngineManager.h"
 #include "ModelFitting/Engine/LevmarEngine.h"
 
@@ -174,6 +175,8 @@ LeastSquareSummary LevmarEngine::solveProblem(EngineParameterManager& parameter_
     summary.parameter_sigmas.resize(parameter_manager.numberOfParameters());
     return summary;
   }
+  SourceXtractor::MemoryAccounting::Allocation workarea_memory(SourceXtractor::MemoryAccounting::FITTING,
+                                                               workarea_size * sizeof(double));
 
   // Call the levmar library
   auto start = std::chrono::steady_clock::now();
@@ -0,0 +1,72 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * SersicProfileTable.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cmath>
+
+#include <boost/math/special_functions/gamma.hpp>
+
+#include "ModelFitting/Models/SersicProfileTable.h"
+
+namespace ModelFitting {
+
+constexpr float SersicProfileTable::U_MIN, SersicProfileTable::U_MAX;
+constexpr float SersicProfileTable::STEPS_PER_UNIT, SersicProfileTable::LAST_POSITION;
+
+const SersicProfileTable& SersicProfileTable::getInstance() {
+  static SersicProfileTable table;
+  return table;
+}
+
+SersicProfileTable::SersicProfileTable() {
+  auto size = static_cast<std::size_t>(LAST_POSITION) + 1;
+  m_values.resize(size + 1);
+  for (std::size_t i = 0; i < size; ++i) {
+    m_values[i] = static_cast<float>(std::exp(-std::exp(U_MIN + i / double(STEPS_PER_UNIT))));
+  }
+  // The last position reads the padding, both are 0 so the profile ends there
+  m_values[size - 1] = m_values[size] = 0.f;
+}
+
+void SersicProfileTable::evaluate(const float* r_sqr, float* out, std::size_t count,
+                                  float log_k, float inv_n, float max_r_sqr) const {
+  // The positions are computed first, in a loop without lookups that can be vectorized
+  float half_inv_n = 0.5f * inv_n;
+  for (std::size_t i = 0; i < count; ++i) {
+    float position = toPosition(r_sqr[i], log_k, half_inv_n);
+    out[i] = r_sqr[i] < max_r_sqr ? position : LAST_POSITION;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = lookup(out[i]);
+  }
+}
+
+double SersicProfileTable::integrate(double k, double n, double radius) {
+  // With v = k R^(1/n), the integral of 2 pi R e^(-k R^(1/n)) is 2 pi n k^(-2n) times the lower incomplete gamma
+  if (radius <= 0) {
+    return 0.;
+  }
+  return 2 * M_PI * n * std::exp(std::lgamma(2 * n) - 2 * n * std::log(k)) *
+         boost::math::gamma_p(2 * n, k * std::pow(radius, 1. / n));
+}
+
+} // end of namespace ModelFitting
@@ -0,0 +1,82 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ParameterUpdateBatch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+
+#include "ModelFitting/Parameters/ParameterUpdateBatch.h"
+
+namespace ModelFitting {
+
+static thread_local ParameterUpdateBatch* s_current_batch = nullptr;
+
+ParameterUpdateBatch::ParameterUpdateBatch() : m_active(s_current_batch == nullptr) {
+  if (m_active) {
+    s_current_batch = this;
+  }
+}
+
+ParameterUpdateBatch::~ParameterUpdateBatch() {
+  if (m_active) {
+    s_current_batch = nullptr;
+    // Released in the reverse order of their creation
+    while (!m_resources.empty()) {
+      m_resources.pop_back();
+    }
+  }
+}
+
+ParameterUpdateBatch* ParameterUpdateBatch::current() {
+  return s_current_batch;
+}
+
+void ParameterUpdateBatch::defer(const void* parameter, std::function<void()> update) {
+  if (m_pending.insert(parameter).second) {
+    m_updates.emplace_back(parameter, std::move(update));
+  }
+}
+
+void ParameterUpdateBatch::hold(const void* key, const std::function<std::shared_ptr<void>()>& factory) {
+  auto same_key = [key](const std::pair<const void*, std::shared_ptr<void>>& resource) {
+    return resource.first == key;
+  };
+  if (std::none_of(m_resources.begin(), m_resources.end(), same_key)) {
+    m_resources.emplace_back(key, factory());
+  }
+}
+
+void ParameterUpdateBatch::flush() {
+  if (!m_active) {
+    return;
+  }
+  // An update can change the inputs of a parameter already updated, which is then registered again
+  for (size_t i = 0; i < m_updates.size(); ++i) {
+    auto update = std::move(m_updates[i].second);
+    m_pending.erase(m_updates[i].first);
+    update();
+  }
+  m_updates.clear();
+  while (!m_resources.empty()) {
+    m_resources.pop_back();
+  }
+}
+
+} // namespace ModelFitting
@@ -0,0 +1,181 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CompactSersicModel_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "ModelFitting/Image/ImageTraits.h"
+
+/// Minimal image for the rasterization
+struct TestImage {
+  std::size_t width, height;
+  std::vector<float> data;
+};
+
+namespace ModelFitting {
+
+template <>
+struct ImageTraits<TestImage> {
+  using iterator = std::vector<float>::iterator;
+
+  static TestImage factory(std::size_t width, std::size_t height) {
+    return TestImage{width, height, std::vector<float>(width * height)};
+  }
+
+  static std::size_t width(TestImage& image) {
+    return image.width;
+  }
+
+  static std::size_t height(TestImage& image) {
+    return image.height;
+  }
+
+  static float& at(TestImage& image, std::size_t x, std::size_t y) {
+    return image.data[x + y * image.width];
+  }
+
+  static float at(const TestImage& image, std::size_t x, std::size_t y) {
+    return image.data[x + y * image.width];
+  }
+
+  static iterator begin(TestImage& image) {
+    return image.data.begin();
+  }
+
+  static iterator end(TestImage& image) {
+    return image.data.end();
+  }
+
+  static void addImageToImage(TestImage&, const TestImage&, double, double, double) {}
+
+  static TestImage scaledImage(const TestImage& image, double, double) {
+    return image;
+  }
+};
+
+}  // namespace ModelFitting
+
+#include "ModelFitting/Parameters/ManualParameter.h"
+#include "ModelFitting/Models/ExtendedModel.h"
+#include "ModelFitting/Models/CompactSersicModel.h"
+
+using namespace ModelFitting;
+
+// Size of the rendered stamp, and of the border added by getRasterizedImage
+const int SIZE = 25, BORDER = 4, FULL_SIZE = SIZE + 2 * BORDER;
+
+struct CompactSersicModelFixture {
+  std::shared_ptr<CompactSersicModel<TestImage>> makeModel(double sharp_radius, double n, double re, double q) {
+    auto param = [](double v) { return std::make_shared<ManualParameter>(v); };
+    double bn = 2 * n - 1. / 3.;
+    return std::make_shared<CompactSersicModel<TestImage>>(
+      sharp_radius, param(1.), param(bn / std::pow(re, 1. / n)), param(n), param(1.), param(q), param(0.5),
+      SIZE, SIZE, param(0.), param(0.), param(1.), std::make_tuple(1., 0., 0., 1.));
+  }
+
+  /// Mean of the exact profile over the pixel, on a regular grid of subsampling x subsampling points.
+  /// The subsampling must be even, so no sample falls on the cusp of the central pixel.
+  static double samplePixel(const CompactSersicModel<TestImage>& model, int x, int y, int subsampling) {
+    double sum = 0.;
+    for (int iy = 0; iy < subsampling; ++iy) {
+      for (int ix = 0; ix < subsampling; ++ix) {
+        sum += model.getValue(x + (ix + 0.5) / subsampling - 0.5, y + (iy + 0.5) / subsampling - 0.5);
+      }
+    }
+    return sum / (subsampling * subsampling);
+  }
+
+  /// Subsampled reference, truncated to the same pixels as the rasterized image and normalized to its flux
+  static std::vector<double> makeReference(const CompactSersicModel<TestImage>& model, const TestImage& image) {
+    std::vector<double> reference(FULL_SIZE * FULL_SIZE, 0.);
+    double total = 0.;
+    for (int y = 0; y < SIZE; ++y) {
+      for (int x = 0; x < SIZE; ++x) {
+        auto i = (x + BORDER) + (y + BORDER) * FULL_SIZE;
+        if (image.data[i] != 0.f) {
+          bool center = (x == SIZE / 2 && y == SIZE / 2);
+          reference[i] = samplePixel(model, x - SIZE / 2, y - SIZE / 2, center ? 1000 : 50);
+          total += reference[i];
+        }
+      }
+    }
+    for (auto& v : reference) {
+      v /= total;
+    }
+    return reference;
+  }
+
+  static double centralPixel(const std::vector<float>& data) {
+    return data[(FULL_SIZE / 2) + (FULL_SIZE / 2) * FULL_SIZE];
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (CompactSersicModel_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (Rasterize_test, CompactSersicModelFixture) {
+  for (double n : {0.5, 1., 4., 8.}) {
+    for (double re : {1., 3.}) {
+      BOOST_TEST_CONTEXT("n=" << n << " re=" << re) {
+        auto model = makeModel(3., n, re, 0.5);
+        auto image = model->getRasterizedImage(1., SIZE, SIZE);
+        auto reference = makeReference(*model, image);
+
+        double max_error = 0.;
+        for (std::size_t i = 0; i < reference.size(); ++i) {
+          max_error = std::max(max_error, std::fabs(image.data[i] - reference[i]));
+        }
+        // Relative to the total flux
+        BOOST_CHECK_LT(max_error, 5e-3);
+
+        // The cusp of the profile is in the central pixel
+        double central = centralPixel(std::vector<float>(reference.begin(), reference.end()));
+        BOOST_CHECK_CLOSE(centralPixel(image.data), central, 2.);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (RasterizeNoSharpRegion_test, CompactSersicModelFixture) {
+  // The central pixel is integrated even without a sharp region, instead of sampled at the cusp
+  for (double n : {0.5, 1., 4., 8.}) {
+    auto model = makeModel(0., n, 1., 0.5);
+    auto image = model->getRasterizedImage(1., SIZE, SIZE);
+    auto reference = makeReference(*model, image);
+    double central = centralPixel(std::vector<float>(reference.begin(), reference.end()));
+    BOOST_TEST_CONTEXT("n=" << n) {
+      BOOST_CHECK_CLOSE(centralPixel(image.data), central, 10.);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
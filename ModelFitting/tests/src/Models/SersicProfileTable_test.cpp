@@ -0,0 +1,102 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * SersicProfileTable_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "ModelFitting/Models/SersicProfileTable.h"
+
+using namespace ModelFitting;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (SersicProfileTable_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (FastLog_test) {
+  for (float x : {1e-30f, 1e-6f, 0.5f, 0.7071f, 1.f, 1.4142f, 2.f, 3.f, 10.f, 12345.f, 1e20f}) {
+    BOOST_CHECK_SMALL(SersicProfileTable::fastLog(x) - std::log(x), 1e-5f * std::max(1.f, std::fabs(std::log(x))));
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (Profile_test) {
+  auto& table = SersicProfileTable::getInstance();
+
+  // Close to the center the profile is steep for large indices
+  std::vector<float> r_sqr {1e-12f, 1e-6f, 2.5e-3f};
+  for (float r = 0; r < 50; r += 0.37) {
+    r_sqr.emplace_back(r * r);
+  }
+  std::vector<float> values(r_sqr.size());
+
+  for (double n : {0.5, 1., 2., 4., 8.}) {
+    for (double k : {0.3, 1., 7.669}) {
+      table.evaluate(r_sqr.data(), values.data(), r_sqr.size(), std::log(k), 1. / n, 1e30);
+      for (std::size_t i = 0; i < r_sqr.size(); ++i) {
+        double expected = std::exp(-k * std::pow(std::sqrt(r_sqr[i]), 1. / n));
+        BOOST_CHECK_SMALL(values[i] - expected, 1e-5);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (MaxRadius_test) {
+  auto& table = SersicProfileTable::getInstance();
+  std::vector<float> r_sqr {0., 1., 4., 9.}, values(4);
+
+  table.evaluate(r_sqr.data(), values.data(), r_sqr.size(), 0., 1., 4.);
+  BOOST_CHECK_CLOSE(values[0], 1., 1e-4);
+  BOOST_CHECK_CLOSE(values[1], std::exp(-1.), 1e-3);
+  BOOST_CHECK_EQUAL(values[2], 0.);
+  BOOST_CHECK_EQUAL(values[3], 0.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (Integrate_test) {
+  // Exponential profile, 2 pi (1 - e^-R (1 + R))
+  BOOST_CHECK_CLOSE(SersicProfileTable::integrate(1., 1., 2.), 2 * M_PI * (1 - std::exp(-2.) * 3), 1e-8);
+
+  // de Vaucouleurs profile, against a sum over thin rings
+  double k = 7.669, n = 4., radius = 0.5, sum = 0.;
+  int steps = 1000000;
+  for (int i = 0; i < steps; ++i) {
+    double r = (i + 0.5) * radius / steps;
+    sum += 2 * M_PI * r * std::exp(-k * std::pow(r, 1. / n)) * radius / steps;
+  }
+  BOOST_CHECK_CLOSE(SersicProfileTable::integrate(k, n, radius), sum, 1e-3);
+  BOOST_CHECK_EQUAL(SersicProfileTable::integrate(k, n, 0.), 0.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+//-----------------------------------------------------------------------------
@@ -24,6 +24,7 @@
 #include <boost/test/unit_test.hpp>
 #include "ModelFitting/Parameters/ManualParameter.h"
 #include "ModelFitting/Parameters/DependentParameter.h"
+#include "ModelFitting/Parameters/ParameterUpdateBatch.h"
 
 using namespace ModelFitting;
 using namespace std;
@@ -128,4 +129,50 @@ BOOST_AUTO_TEST_CASE(observeDependOnDependent_test) {
   BOOST_CHECK_EQUAL(34.0, test_observer);
 }
 
+BOOST_AUTO_TEST_CASE(batchUpdate_test) {
+  auto param1 = std::make_shared<ManualParameter>(4.0);
+  auto param2 = std::make_shared<ManualParameter>(2.0);
+
+  int calls = 0;
+  auto calculator = [&calls](double mp1, double mp2) {++calls; return mp1+mp2;};
+
+  auto dp = ModelFitting::createDependentParameter(calculator, param1, param2);
+  auto ddp = ModelFitting::createDependentParameter(calculator, dp, param1);
+
+  std::vector<double> observed;
+  ddp->addObserver([&](double v){observed.push_back(v);});
+  calls = 0;
+
+  int held = 0;
+  {
+    ParameterUpdateBatch batch;
+    param1->setValue(10.0);
+    param2->setValue(7.);
+    BOOST_CHECK_EQUAL(0, calls);
+
+    // Kept once, until the end of the flush
+    auto counting = [&held]() {
+      ++held;
+      return std::shared_ptr<void>(nullptr, [&held](void*) { --held; });
+    };
+    batch.hold(&held, counting);
+    batch.hold(&held, counting);
+    BOOST_CHECK_EQUAL(1, held);
+
+    batch.flush();
+    BOOST_CHECK_EQUAL(0, held);
+  }
+
+  // Each dependent parameter evaluated once, with all its inputs set
+  BOOST_CHECK_EQUAL(2, calls);
+  BOOST_CHECK_EQUAL(17.0, dp->getValue());
+  BOOST_CHECK_EQUAL(1u, observed.size());
+  BOOST_CHECK_EQUAL(27.0, observed.back());
+
+  // Without a batch, updated on each change of an input, twice for ddp
+  param1->setValue(1.0);
+  BOOST_CHECK_EQUAL(5, calls);
+  BOOST_CHECK_EQUAL(9.0, observed.back());
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,185 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * BenchApertures.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include "SEFramework/Aperture/CircularAperture.h"
+#include "SEFramework/Aperture/EllipticalAperture.h"
+#include "SEFramework/Aperture/FluxMeasurement.h"
+#include "SEFramework/Aperture/TransformedAperture.h"
+#include "SEFramework/Image/VectorImage.h"
+
+namespace po = boost::program_options;
+namespace timer = boost::timer;
+using namespace SourceXtractor;
+
+static Elements::Logging logger = Elements::Logging::getLogger("BenchApertures");
+
+/**
+ * @class BenchApertures
+ * Time measureFlux with the different aperture shapes and overlap modes
+ */
+class BenchApertures : public Elements::Program {
+private:
+  std::default_random_engine random_generator;
+
+public:
+
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{};
+    options.add_options()
+      ("apertures", po::value<std::string>()->default_value("circular,elliptical,kron"),
+       "Comma separated list of apertures")
+      ("overlaps", po::value<std::string>()->default_value("sampled,exact"),
+       "Comma separated list of overlap modes")
+      ("image-size", po::value<int>()->default_value(1024), "Image size")
+      ("positions", po::value<int>()->default_value(1000), "Number of measurements per repetition")
+      ("radius-start", po::value<double>()->default_value(2.), "Radius (semi-major axis) start")
+      ("radius-step-size", po::value<double>()->default_value(4.), "Radius step size")
+      ("radius-nsteps", po::value<int>()->default_value(5), "Number of steps for the radius")
+      ("axis-ratio", po::value<double>()->default_value(.6), "Axis ratio of the elliptical apertures")
+      ("kron-factor", po::value<double>()->default_value(2.5), "Kron factor")
+      ("repeat", po::value<int>()->default_value(5), "Repeat")
+      ("measures", po::value<int>()->default_value(10), "Number of measures");
+    return options;
+  }
+
+  std::shared_ptr<VectorImage<SeFloat>> generateImage(int size, double mean, double sigma) {
+    std::normal_distribution<SeFloat> random_value(mean, sigma);
+    auto img = VectorImage<SeFloat>::create(size, size);
+    for (auto& v : img->getData()) {
+      v = random_value(random_generator);
+    }
+    return img;
+  }
+
+  /**
+   * Ellipse with the given axis ratio and a 30 degrees angle, normalized so rad_max is the semi-major axis
+   */
+  static std::shared_ptr<Aperture> createAperture(const std::string& type, ApertureOverlap overlap, double radius,
+                                                  double axis_ratio, double kron_factor) {
+    if (type == "circular") {
+      return std::make_shared<CircularAperture>(radius, overlap);
+    }
+
+    double theta = M_PI / 6, a2 = 1., b2 = axis_ratio * axis_ratio;
+    double cos_t = std::cos(theta), sin_t = std::sin(theta);
+    SeFloat cxx = cos_t * cos_t / a2 + sin_t * sin_t / b2;
+    SeFloat cyy = sin_t * sin_t / a2 + cos_t * cos_t / b2;
+    SeFloat cxy = 2 * cos_t * sin_t * (1. / a2 - 1. / b2);
+
+    if (type == "elliptical") {
+      return std::make_shared<EllipticalAperture>(cxx, cyy, cxy, radius, overlap);
+    }
+    else if (type == "kron") {
+      // As AutoPhotometryTask builds it, with the identity jacobian of a single frame
+      return std::make_shared<TransformedAperture>(
+        std::make_shared<EllipticalAperture>(cxx, cyy, cxy, kron_factor * radius, overlap),
+        std::make_tuple(1., 0., 0., 1.));
+    }
+    throw Elements::Exception() << "Unknown aperture " << type;
+  }
+
+  static ApertureOverlap parseOverlap(const std::string& name) {
+    if (name == "sampled") {
+      return ApertureOverlap::SAMPLED;
+    }
+    else if (name == "exact") {
+      return ApertureOverlap::EXACT;
+    }
+    throw Elements::Exception() << "Unknown overlap mode " << name;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    std::vector<std::string> aperture_list, overlap_list;
+    boost::split(aperture_list, args["apertures"].as<std::string>(), boost::is_any_of(","));
+    boost::split(overlap_list, args["overlaps"].as<std::string>(), boost::is_any_of(","));
+    auto img_size = args["image-size"].as<int>();
+    auto npositions = args["positions"].as<int>();
+    auto radius_start = args["radius-start"].as<double>();
+    auto radius_step_size = args["radius-step-size"].as<double>();
+    auto radius_nsteps = args["radius-nsteps"].as<int>();
+    auto axis_ratio = args["axis-ratio"].as<double>();
+    auto kron_factor = args["kron-factor"].as<double>();
+    auto repeat = args["repeat"].as<int>();
+    auto measures = args["measures"].as<int>();
+
+    logger.info() << "Using an image of " << img_size << "x" << img_size;
+    std::shared_ptr<Image<SeFloat>> image = generateImage(img_size, 10, 5);
+    std::shared_ptr<Image<SeFloat>> variance = generateImage(img_size, 25, 1);
+
+    // Sub-pixel positions, so the exact overlap has to clip the pixels at the border of the aperture
+    std::uniform_real_distribution<double> random_pos(0, img_size);
+    std::vector<std::pair<SeFloat, SeFloat>> positions(npositions);
+    for (auto& p : positions) {
+      p.first = random_pos(random_generator);
+      p.second = random_pos(random_generator);
+    }
+
+    std::cout << "Aperture,Overlap,Radius,Time" << std::endl;
+
+    for (auto& aperture_type : aperture_list) {
+      for (auto& overlap_name : overlap_list) {
+        auto overlap = parseOverlap(overlap_name);
+
+        for (int radius_step = 0; radius_step < radius_nsteps; ++radius_step) {
+          auto radius = radius_start + radius_step * radius_step_size;
+          auto aperture = createAperture(aperture_type, overlap, radius, axis_ratio, kron_factor);
+          logger.info() << "Measuring with a " << aperture_type << " aperture of radius " << radius << " ("
+                        << overlap_name << ")";
+
+          for (int m = 0; m < measures; ++m) {
+            timer::cpu_timer timer;
+            timer.stop();
+
+            for (int r = 0; r < repeat; ++r) {
+              timer.start();
+              for (auto& p : positions) {
+                measureFlux(aperture, p.first, p.second, image, variance, 1e6, true);
+              }
+              timer.stop();
+            }
+
+            std::cout << aperture_type << ',' << overlap_name << ',' << radius << ',' << timer.elapsed().wall
+                      << std::endl;
+          }
+        }
+      }
+    }
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(BenchApertures)
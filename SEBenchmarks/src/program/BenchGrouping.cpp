@@ -0,0 +1,245 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * BenchGrouping.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include "SEFramework/Pipeline/SourceGrouping.h"
+#include "SEFramework/Source/SimpleSource.h"
+#include "SEFramework/Source/SimpleSourceGroupFactory.h"
+
+#include "SEImplementation/Grouping/AssocGrouping.h"
+#include "SEImplementation/Grouping/LineSelectionCriteria.h"
+#include "SEImplementation/Grouping/MoffatCriteria.h"
+#include "SEImplementation/Grouping/MoffatGrouping.h"
+#include "SEImplementation/Grouping/NoGroupingCriteria.h"
+#include "SEImplementation/Grouping/OverlappingBoundariesCriteria.h"
+#include "SEImplementation/Grouping/SplitSourcesGrouping.h"
+#include "SEImplementation/Plugin/AssocMode/AssocMode.h"
+#include "SEImplementation/Plugin/MoffatModelFitting/MoffatModelEvaluator.h"
+#include "SEImplementation/Plugin/MoffatModelFitting/MoffatModelFitting.h"
+#include "SEImplementation/Plugin/PeakValue/PeakValue.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
+#include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
+#include "SEImplementation/Property/SourceId.h"
+
+namespace po = boost::program_options;
+namespace timer = boost::timer;
+using namespace SourceXtractor;
+
+static Elements::Logging logger = Elements::Logging::getLogger("BenchGrouping");
+
+/**
+ * @class BenchGrouping
+ * Time the grouping of a catalog of sources with each one of the grouping criteria
+ */
+class BenchGrouping : public Elements::Program {
+private:
+  std::default_random_engine random_generator;
+
+  struct SourceDescription {
+    double x, y, radius, peak;
+    unsigned detection_id;
+  };
+
+  /// Only counts the groups, as the next stage of the pipeline would receive them
+  class CountingObserver : public Observer<SourceGroupInterface> {
+  public:
+    void handleMessage(const SourceGroupInterface&) override {
+      ++m_count;
+    }
+
+    size_t m_count = 0;
+  };
+
+public:
+
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{};
+    options.add_options()
+      ("criteria", po::value<std::string>()->default_value("none,overlapping,split,moffat,assoc"),
+       "Comma separated list of grouping criteria")
+      ("image-size", po::value<int>()->default_value(4096), "Size of the area covered by the sources")
+      ("sources-start", po::value<int>()->default_value(10000), "Number of sources start")
+      ("sources-step-size", po::value<int>()->default_value(10000), "Number of sources step size")
+      ("sources-nsteps", po::value<int>()->default_value(4), "Number of steps for the number of sources")
+      ("split-fraction", po::value<double>()->default_value(.2),
+       "Fraction of the sources sharing the detection (or assoc) of the previous one")
+      ("window-size", po::value<int>()->default_value(100),
+       "Lines between processing requests, as the segmentation would emit them")
+      ("hard-limit", po::value<unsigned>()->default_value(0), "Maximum group size, 0 for no limit")
+      ("repeat", po::value<int>()->default_value(5), "Repeat")
+      ("measures", po::value<int>()->default_value(10), "Number of measures");
+    return options;
+  }
+
+  /**
+   * Sources sorted by their last line, so they arrive in the order the segmentation would emit them.
+   * Split sources are placed next to their parent, with the same detection id.
+   */
+  std::vector<SourceDescription> generateSources(int size, int nsources, double split_fraction) {
+    std::uniform_real_distribution<double> random_pos(0, size);
+    std::uniform_real_distribution<double> random_radius(1, 10);
+    std::uniform_real_distribution<double> random_peak(10, 1000);
+    std::uniform_real_distribution<double> random_unit(0, 1);
+
+    std::vector<SourceDescription> sources;
+    sources.reserve(nsources);
+    unsigned detection_id = 0;
+    for (int i = 0; i < nsources; ++i) {
+      SourceDescription desc;
+      if (!sources.empty() && random_unit(random_generator) < split_fraction) {
+        auto& parent = sources.back();
+        desc.x = parent.x + parent.radius;
+        desc.y = parent.y;
+        desc.detection_id = parent.detection_id;
+      }
+      else {
+        desc.x = random_pos(random_generator);
+        desc.y = random_pos(random_generator);
+        desc.detection_id = ++detection_id;
+      }
+      desc.radius = random_radius(random_generator);
+      desc.peak = random_peak(random_generator);
+      sources.emplace_back(desc);
+    }
+
+    std::sort(sources.begin(), sources.end(), [](const SourceDescription& a, const SourceDescription& b) {
+      return a.y + a.radius < b.y + b.radius;
+    });
+    return sources;
+  }
+
+  /// Only the properties used by the grouping criteria are set
+  static std::unique_ptr<SourceInterface> createSource(const SourceDescription& desc) {
+    std::unique_ptr<SourceInterface> source{new SimpleSource};
+    source->setProperty<SourceId>(desc.detection_id);
+    source->setProperty<PixelCentroid>(desc.x, desc.y);
+    source->setProperty<PixelBoundaries>(int(desc.x - desc.radius), int(desc.y - desc.radius),
+                                         int(desc.x + desc.radius), int(desc.y + desc.radius));
+    source->setProperty<PeakValue>(0., desc.peak, int(desc.x), int(desc.y));
+    source->setProperty<AssocMode>(true, std::vector<double>{desc.x, desc.y}, 0., desc.detection_id);
+    MoffatModelFitting moffat(desc.x, desc.y, desc.peak, 1, 2, 1, desc.radius, 1, 1, 0, 1);
+    source->setProperty<MoffatModelFitting>(moffat);
+    source->setProperty<MoffatModelEvaluator>(moffat);
+    return source;
+  }
+
+  /// Same choice as GroupingFactory: the optimized implementation when there is one
+  static std::shared_ptr<SourceGroupingInterface> createGrouping(const std::string& criteria, unsigned hard_limit) {
+    auto group_factory = std::make_shared<SimpleSourceGroupFactory>();
+    if (criteria == "none") {
+      return std::make_shared<SourceGrouping>(std::make_shared<NoGroupingCriteria>(), group_factory, hard_limit);
+    }
+    else if (criteria == "overlapping") {
+      return std::make_shared<SourceGrouping>(std::make_shared<OverlappingBoundariesCriteria>(), group_factory,
+                                              hard_limit);
+    }
+    else if (criteria == "split") {
+      return std::make_shared<SplitSourcesGrouping>(group_factory, hard_limit);
+    }
+    else if (criteria == "moffat") {
+      return std::make_shared<MoffatGrouping>(std::make_shared<MoffatCriteria>(0.02, 300), group_factory,
+                                              hard_limit, 300);
+    }
+    else if (criteria == "assoc") {
+      return std::make_shared<AssocGrouping>(group_factory, hard_limit);
+    }
+    throw Elements::Exception() << "Unknown grouping criteria " << criteria;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    std::vector<std::string> criteria_list;
+    boost::split(criteria_list, args["criteria"].as<std::string>(), boost::is_any_of(","));
+    auto img_size = args["image-size"].as<int>();
+    auto sources_start = args["sources-start"].as<int>();
+    auto sources_step_size = args["sources-step-size"].as<int>();
+    auto sources_nsteps = args["sources-nsteps"].as<int>();
+    auto split_fraction = args["split-fraction"].as<double>();
+    auto window_size = args["window-size"].as<int>();
+    auto hard_limit = args["hard-limit"].as<unsigned>();
+    auto repeat = args["repeat"].as<int>();
+    auto measures = args["measures"].as<int>();
+
+    std::cout << "Criteria,Sources,Groups,Time" << std::endl;
+
+    for (int sources_step = 0; sources_step < sources_nsteps; ++sources_step) {
+      auto nsources = sources_start + sources_step * sources_step_size;
+      auto descriptions = generateSources(img_size, nsources, split_fraction);
+
+      for (auto& criteria : criteria_list) {
+        logger.info() << "Grouping " << nsources << " sources with " << criteria;
+
+        for (int m = 0; m < measures; ++m) {
+          timer::cpu_timer timer;
+          timer.stop();
+
+          size_t ngroups = 0;
+          for (int r = 0; r < repeat; ++r) {
+            auto grouping = createGrouping(criteria, hard_limit);
+            auto observer = std::make_shared<CountingObserver>();
+            grouping->addObserver(observer);
+
+            // The creation of the sources is not part of the measure
+            std::vector<std::unique_ptr<SourceInterface>> sources;
+            sources.reserve(descriptions.size());
+            for (auto& desc : descriptions) {
+              sources.emplace_back(createSource(desc));
+            }
+
+            timer.start();
+            int next_line = window_size;
+            for (size_t i = 0; i < sources.size(); ++i) {
+              auto last_line = descriptions[i].y + descriptions[i].radius;
+              while (window_size > 0 && last_line > next_line) {
+                grouping->receiveProcessSignal(
+                  ProcessSourcesEvent(std::make_shared<LineSelectionCriteria>(next_line - window_size)));
+                next_line += window_size;
+              }
+              grouping->receiveSource(std::move(sources[i]));
+            }
+            grouping->receiveProcessSignal(ProcessSourcesEvent(std::make_shared<SelectAllCriteria>()));
+            timer.stop();
+
+            ngroups = observer->m_count;
+          }
+
+          std::cout << criteria << ',' << nsources << ',' << ngroups << ',' << timer.elapsed().wall << std::endl;
+        }
+      }
+    }
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(BenchGrouping)
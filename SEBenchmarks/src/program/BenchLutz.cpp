@@ -0,0 +1,140 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * BenchLutz.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+
+#include "ElementsKernel/ProgramHeaders.h"
+#include "SEFramework/Image/VectorImage.h"
+#include "SEImplementation/Segmentation/Lutz.h"
+
+namespace po = boost::program_options;
+namespace timer = boost::timer;
+using namespace SourceXtractor;
+
+static Elements::Logging logger = Elements::Logging::getLogger("BenchLutz");
+
+/**
+ * @class BenchLutz
+ * Time the Lutz labelling of a thresholded image with a varying number of sources
+ */
+class BenchLutz : public Elements::Program {
+private:
+  std::default_random_engine random_generator;
+
+  /// Only counts the groups, so the time is dominated by the labelling itself
+  class CountingListener : public Lutz::LutzListener {
+  public:
+    void publishGroup(Lutz::PixelGroup&) override {
+      ++m_count;
+    }
+
+    size_t m_count = 0;
+  };
+
+public:
+
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{};
+    options.add_options()
+      ("image-size", po::value<int>()->default_value(2048), "Image size")
+      ("density-start", po::value<int>()->default_value(100), "Density start, in sources per megapixel")
+      ("density-step-size", po::value<int>()->default_value(400), "Density step size")
+      ("density-nsteps", po::value<int>()->default_value(4), "Number of steps for the density")
+      ("source-radius", po::value<double>()->default_value(4.), "Maximum radius of the sources")
+      ("repeat", po::value<int>()->default_value(5), "Repeat")
+      ("measures", po::value<int>()->default_value(10), "Number of measures");
+    return options;
+  }
+
+  /**
+   * Thresholded image: zero everywhere except on randomly placed disks, which may touch each other
+   */
+  std::shared_ptr<VectorImage<SeFloat>> generateImage(int size, int nsources, double max_radius) {
+    std::uniform_real_distribution<double> random_pos(0, size);
+    std::uniform_real_distribution<double> random_radius(1, max_radius);
+
+    auto img = VectorImage<SeFloat>::create(size, size);
+    for (int i = 0; i < nsources; ++i) {
+      double cx = random_pos(random_generator), cy = random_pos(random_generator);
+      double radius = random_radius(random_generator);
+      int min_x = std::max(0, int(cx - radius)), max_x = std::min(size - 1, int(cx + radius));
+      int min_y = std::max(0, int(cy - radius)), max_y = std::min(size - 1, int(cy + radius));
+      for (int y = min_y; y <= max_y; ++y) {
+        for (int x = min_x; x <= max_x; ++x) {
+          if ((x - cx) * (x - cx) + (y - cy) * (y - cy) <= radius * radius) {
+            img->at(x, y) = 1;
+          }
+        }
+      }
+    }
+    return img;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto img_size = args["image-size"].as<int>();
+    auto density_start = args["density-start"].as<int>();
+    auto density_step_size = args["density-step-size"].as<int>();
+    auto density_nsteps = args["density-nsteps"].as<int>();
+    auto source_radius = args["source-radius"].as<double>();
+    auto repeat = args["repeat"].as<int>();
+    auto measures = args["measures"].as<int>();
+
+    std::cout << "Image,Density,Groups,Time" << std::endl;
+
+    for (int density_step = 0; density_step < density_nsteps; ++density_step) {
+      auto density = density_start + density_step * density_step_size;
+      auto nsources = static_cast<int>(double(density) * img_size * img_size / 1e6);
+
+      logger.info() << "Using an image of " << img_size << "x" << img_size << " with " << nsources << " sources";
+      auto image = generateImage(img_size, nsources, source_radius);
+
+      for (int m = 0; m < measures; ++m) {
+        logger.info() << "Lutz " << m + 1 << "/" << measures;
+        timer::cpu_timer timer;
+        timer.stop();
+
+        size_t ngroups = 0;
+        for (int r = 0; r < repeat; ++r) {
+          CountingListener listener;
+          Lutz lutz;
+          timer.start();
+          lutz.labelImage(listener, *image);
+          timer.stop();
+          ngroups = listener.m_count;
+        }
+
+        std::cout << img_size << ',' << density << ',' << ngroups << ',' << timer.elapsed().wall << std::endl;
+      }
+    }
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(BenchLutz)
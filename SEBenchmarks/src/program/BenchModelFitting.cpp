@@ -0,0 +1,311 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * BenchModelFitting.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include "ModelFitting/Engine/LeastSquareEngineManager.h"
+
+#include "SEFramework/CoordinateSystem/CoordinateSystem.h"
+#include "SEFramework/Frame/Frame.h"
+#include "SEFramework/Image/VectorImage.h"
+#include "SEFramework/Source/SimpleSource.h"
+#include "SEFramework/Source/SimpleSourceGroup.h"
+
+#include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFitting.h"
+#include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingConverterFactory.h"
+#include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingParameter.h"
+#include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingFrame.h"
+#include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingIterativeTask.h"
+#include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingModel.h"
+#include "SEImplementation/Plugin/IsophotalFlux/IsophotalFlux.h"
+#include "SEImplementation/Plugin/Jacobian/Jacobian.h"
+#include "SEImplementation/Plugin/MeasurementFrameCoordinates/MeasurementFrameCoordinates.h"
+#include "SEImplementation/Plugin/MeasurementFrameImages/MeasurementFrameImages.h"
+#include "SEImplementation/Plugin/MeasurementFrameInfo/MeasurementFrameInfo.h"
+#include "SEImplementation/Plugin/MeasurementFrameRectangle/MeasurementFrameRectangle.h"
+#include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
+#include "SEImplementation/Plugin/ReferenceCoordinates/ReferenceCoordinates.h"
+#include "SEImplementation/Plugin/SourcePsf/SourcePsfProperty.h"
+#include "SEImplementation/Property/SourceId.h"
+
+namespace po = boost::program_options;
+namespace timer = boost::timer;
+using namespace SourceXtractor;
+
+static Elements::Logging logger = Elements::Logging::getLogger("BenchModelFitting");
+
+/**
+ * @class BenchModelFitting
+ * Time the iterative model fitting of a group of blended exponential profiles
+ */
+class BenchModelFitting : public Elements::Program {
+private:
+  std::default_random_engine random_generator;
+
+  /// Image and world coordinates are the same, so the models are placed directly in pixels
+  class IdentityCoordinateSystem : public CoordinateSystem {
+  public:
+    WorldCoordinate imageToWorld(ImageCoordinate c) const override {
+      return {c.m_x, c.m_y};
+    }
+
+    ImageCoordinate worldToImage(WorldCoordinate w) const override {
+      return {w.m_alpha, w.m_delta};
+    }
+  };
+
+  struct SourceDescription {
+    double x, y, flux, radius, ratio, angle;
+  };
+
+  enum ParameterId {
+    X, Y, FLUX, RADIUS, RATIO, ANGLE
+  };
+
+public:
+
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{};
+    options.add_options()
+      ("engines", po::value<std::string>()->default_value(ModelFitting::LeastSquareEngineManager::getDefault()),
+       "Comma separated list of minimization engines")
+      ("sources-start", po::value<int>()->default_value(1), "Number of sources in the group start")
+      ("sources-step-size", po::value<int>()->default_value(1), "Number of sources in the group step size")
+      ("sources-nsteps", po::value<int>()->default_value(4), "Number of steps for the group size")
+      ("stamp-size", po::value<int>()->default_value(64), "Size of the image containing the group")
+      ("psf-sigma", po::value<double>()->default_value(1.5), "Sigma of the gaussian PSF")
+      ("noise", po::value<double>()->default_value(1.), "Standard deviation of the background noise")
+      ("max-iterations", po::value<unsigned>()->default_value(200), "Maximum number of iterations of the engine")
+      ("meta-iterations", po::value<int>()->default_value(3), "Number of meta iterations")
+      ("repeat", po::value<int>()->default_value(1), "Repeat")
+      ("measures", po::value<int>()->default_value(5), "Number of measures");
+    return options;
+  }
+
+  /// Blended sources: all of them fall within the central third of the stamp
+  std::vector<SourceDescription> generateSources(int nsources, int stamp_size) {
+    std::uniform_real_distribution<double> random_pos(stamp_size / 3., 2 * stamp_size / 3.);
+    std::uniform_real_distribution<double> random_flux(1000, 5000);
+    std::uniform_real_distribution<double> random_radius(2, 4);
+    std::uniform_real_distribution<double> random_ratio(.5, 1);
+    std::uniform_real_distribution<double> random_angle(0, M_PI);
+
+    std::vector<SourceDescription> sources(nsources);
+    for (auto& s : sources) {
+      s.x = random_pos(random_generator);
+      s.y = random_pos(random_generator);
+      s.flux = random_flux(random_generator);
+      s.radius = random_radius(random_generator);
+      s.ratio = random_ratio(random_generator);
+      s.angle = random_angle(random_generator);
+    }
+    return sources;
+  }
+
+  /**
+   * Same profile as the CompactExponentialModel, without the PSF convolution, plus gaussian noise
+   */
+  std::shared_ptr<VectorImage<SeFloat>> generateImage(const std::vector<SourceDescription>& sources, int stamp_size,
+                                                      double noise) {
+    std::normal_distribution<SeFloat> random_noise(0, noise);
+    auto img = VectorImage<SeFloat>::create(stamp_size, stamp_size);
+    for (int y = 0; y < stamp_size; ++y) {
+      for (int x = 0; x < stamp_size; ++x) {
+        SeFloat value = random_noise(random_generator);
+        for (auto& s : sources) {
+          double i0 = s.flux / (2 * M_PI * 0.35513 * s.radius * s.radius * s.ratio);
+          double k = 1.678 / s.radius;
+          double dx = x - s.x, dy = y - s.y;
+          double xr = dx * std::cos(s.angle) + dy * std::sin(s.angle);
+          double yr = -dx * std::sin(s.angle) + dy * std::cos(s.angle);
+          value += i0 * std::exp(-k * std::sqrt(xr * xr + (yr / s.ratio) * (yr / s.ratio)));
+        }
+        img->at(x, y) = value;
+      }
+    }
+    return img;
+  }
+
+  static std::shared_ptr<VectorImage<SeFloat>> generatePsf(double sigma) {
+    int size = 2 * static_cast<int>(std::ceil(3 * sigma)) + 1;
+    auto psf = VectorImage<SeFloat>::create(size, size);
+    double total = 0;
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        double dx = x - size / 2, dy = y - size / 2;
+        psf->at(x, y) = std::exp(-(dx * dx + dy * dy) / (2 * sigma * sigma));
+        total += psf->at(x, y);
+      }
+    }
+    for (auto& v : psf->getData()) {
+      v /= total;
+    }
+    return psf;
+  }
+
+  /**
+   * Set the properties the measurement stage would have computed, with the initial guesses slightly off
+   */
+  std::unique_ptr<SourceGroupInterface> createGroup(const std::vector<SourceDescription>& descriptions,
+                                                    const std::shared_ptr<MeasurementImageFrame>& frame,
+                                                    const std::shared_ptr<CoordinateSystem>& coordinates,
+                                                    const std::shared_ptr<VectorImage<SeFloat>>& psf,
+                                                    int stamp_size, double noise) {
+    std::normal_distribution<double> random_offset(0, .5);
+
+    std::unique_ptr<SourceGroupInterface> group{new SimpleSourceGroup};
+    for (auto& desc : descriptions) {
+      std::unique_ptr<SourceInterface> source{new SimpleSource};
+      source->setProperty<SourceId>();
+      source->setProperty<PixelCentroid>(desc.x + random_offset(random_generator),
+                                         desc.y + random_offset(random_generator));
+      source->setProperty<IsophotalFlux>(desc.flux * .8, 0, 0, 0);
+      source->setProperty<ReferenceCoordinates>(coordinates);
+
+      int extent = static_cast<int>(std::ceil(3 * desc.radius));
+      source->setIndexedProperty<MeasurementFrameRectangle>(0,
+        PixelCoordinate(std::max(0, int(desc.x) - extent), std::max(0, int(desc.y) - extent)),
+        PixelCoordinate(std::min(stamp_size - 1, int(desc.x) + extent), std::min(stamp_size - 1, int(desc.y) + extent)));
+      source->setIndexedProperty<MeasurementFrameInfo>(0, stamp_size, stamp_size, 0., 0., 1e6, noise);
+      source->setIndexedProperty<MeasurementFrameImages>(0, frame, stamp_size, stamp_size);
+      source->setIndexedProperty<MeasurementFrameCoordinates>(0, coordinates);
+      source->setIndexedProperty<SourcePsfProperty>(0, 1., psf);
+      source->setIndexedProperty<JacobianSource>(0);
+
+      group->addSource(std::move(source));
+    }
+    return group;
+  }
+
+  /// Same parameters and ranges as a typical python configuration for an exponential profile
+  static std::vector<std::shared_ptr<FlexibleModelFittingParameter>> createParameters() {
+    auto position_range = std::make_shared<FlexibleModelFittingLinearRangeConverterFactory>(
+      [](double init, const SourceInterface&) { return std::make_pair(init - 5., init + 5.); });
+    auto flux_range = std::make_shared<FlexibleModelFittingExponentialRangeConverterFactory>(
+      [](double init, const SourceInterface&) { return std::make_pair(init * 1e-2, init * 1e2); });
+    auto radius_range = std::make_shared<FlexibleModelFittingExponentialRangeConverterFactory>(
+      [](double init, const SourceInterface&) { return std::make_pair(init * 1e-2, init * 1e2); });
+    auto ratio_range = std::make_shared<FlexibleModelFittingExponentialRangeConverterFactory>(
+      [](double, const SourceInterface&) { return std::make_pair(1e-1, 1e1); });
+    auto angle_range = std::make_shared<FlexibleModelFittingLinearRangeConverterFactory>(
+      [](double, const SourceInterface&) { return std::make_pair(-2 * M_PI, 2 * M_PI); });
+
+    // The model coordinates start at 1, as FITS pixels do
+    return {
+      std::make_shared<FlexibleModelFittingFreeParameter>(X, [](const SourceInterface& source) {
+        return source.getProperty<PixelCentroid>().getCentroidX() + 1;
+      }, position_range),
+      std::make_shared<FlexibleModelFittingFreeParameter>(Y, [](const SourceInterface& source) {
+        return source.getProperty<PixelCentroid>().getCentroidY() + 1;
+      }, position_range),
+      std::make_shared<FlexibleModelFittingFreeParameter>(FLUX, [](const SourceInterface& source) {
+        return source.getProperty<IsophotalFlux>().getFlux();
+      }, flux_range),
+      std::make_shared<FlexibleModelFittingFreeParameter>(RADIUS, [](const SourceInterface&) {
+        return 3.;
+      }, radius_range),
+      std::make_shared<FlexibleModelFittingFreeParameter>(RATIO, [](const SourceInterface&) {
+        return 1.;
+      }, ratio_range),
+      std::make_shared<FlexibleModelFittingFreeParameter>(ANGLE, [](const SourceInterface&) {
+        return 0.;
+      }, angle_range),
+    };
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    std::vector<std::string> engine_list;
+    boost::split(engine_list, args["engines"].as<std::string>(), boost::is_any_of(","));
+    auto sources_start = args["sources-start"].as<int>();
+    auto sources_step_size = args["sources-step-size"].as<int>();
+    auto sources_nsteps = args["sources-nsteps"].as<int>();
+    auto stamp_size = args["stamp-size"].as<int>();
+    auto psf_sigma = args["psf-sigma"].as<double>();
+    auto noise = args["noise"].as<double>();
+    auto max_iterations = args["max-iterations"].as<unsigned>();
+    auto meta_iterations = args["meta-iterations"].as<int>();
+    auto repeat = args["repeat"].as<int>();
+    auto measures = args["measures"].as<int>();
+
+    std::shared_ptr<CoordinateSystem> coordinates = std::make_shared<IdentityCoordinateSystem>();
+    auto psf = generatePsf(psf_sigma);
+
+    auto parameters = createParameters();
+    std::vector<std::shared_ptr<FlexibleModelFittingModel>> models{
+      std::make_shared<FlexibleModelFittingExponentialModel>(
+        parameters[X], parameters[Y], parameters[FLUX], parameters[RADIUS], parameters[RATIO], parameters[ANGLE])
+    };
+    std::vector<std::shared_ptr<FlexibleModelFittingFrame>> frames{
+      std::make_shared<FlexibleModelFittingFrame>(0, models)
+    };
+
+    std::cout << "Sources,Stamp,Engine,Time" << std::endl;
+
+    for (int sources_step = 0; sources_step < sources_nsteps; ++sources_step) {
+      auto nsources = sources_start + sources_step * sources_step_size;
+      logger.info() << "Using a group of " << nsources << " sources on a " << stamp_size << "x" << stamp_size
+                    << " stamp";
+
+      auto descriptions = generateSources(nsources, stamp_size);
+      auto image = generateImage(descriptions, stamp_size, noise);
+      auto variance = VectorImage<SeFloat>::create(stamp_size, stamp_size);
+      std::fill(variance->getData().begin(), variance->getData().end(), noise * noise);
+      auto frame = std::make_shared<MeasurementImageFrame>(image, coordinates, variance);
+
+      for (auto& engine : engine_list) {
+        FlexibleModelFittingIterativeTask task(engine, max_iterations, 10., parameters, frames, {}, 1.,
+                                               meta_iterations);
+
+        for (int m = 0; m < measures; ++m) {
+          logger.info() << "Fitting with " << engine << " " << m + 1 << "/" << measures;
+          timer::cpu_timer timer;
+          timer.stop();
+
+          for (int r = 0; r < repeat; ++r) {
+            auto group = createGroup(descriptions, frame, coordinates, psf, stamp_size, noise);
+            timer.start();
+            task.computeProperties(*group);
+            timer.stop();
+          }
+
+          std::cout << nsources << ',' << stamp_size << ',' << engine << ',' << timer.elapsed().wall << std::endl;
+        }
+      }
+    }
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(BenchModelFitting)
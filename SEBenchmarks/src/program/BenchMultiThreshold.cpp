@@ -0,0 +1,208 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * BenchMultiThreshold.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include "SEFramework/Image/VectorImage.h"
+#include "SEFramework/Property/DetectionFrame.h"
+#include "SEFramework/Source/SourceWithOnDemandProperties.h"
+#include "SEFramework/Source/SourceWithOnDemandPropertiesFactory.h"
+#include "SEFramework/Task/TaskFactoryRegistry.h"
+#include "SEFramework/Task/TaskProvider.h"
+
+#include "SEImplementation/Partition/MultiThresholdPartitionStep.h"
+#include "SEImplementation/Plugin/DetectionFrameImages/DetectionFrameImages.h"
+#include "SEImplementation/Plugin/DetectionFrameImages/DetectionFrameImagesTaskFactory.h"
+#include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValues.h"
+#include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValuesTaskFactory.h"
+#include "SEImplementation/Plugin/DetectionFrameSourceStamp/DetectionFrameSourceStamp.h"
+#include "SEImplementation/Plugin/DetectionFrameSourceStamp/DetectionFrameSourceStampTaskFactory.h"
+#include "SEImplementation/Plugin/PeakValue/PeakValue.h"
+#include "SEImplementation/Plugin/PeakValue/PeakValueTaskFactory.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundariesTaskFactory.h"
+#include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
+#include "SEImplementation/Plugin/PixelCentroid/PixelCentroidTaskFactory.h"
+#include "SEImplementation/Plugin/ShapeParameters/ShapeParameters.h"
+#include "SEImplementation/Plugin/ShapeParameters/ShapeParametersTaskFactory.h"
+#include "SEImplementation/Property/PixelCoordinateList.h"
+#include "SEImplementation/Property/SourceId.h"
+
+namespace po = boost::program_options;
+namespace timer = boost::timer;
+using namespace SourceXtractor;
+
+static Elements::Logging logger = Elements::Logging::getLogger("BenchMultiThreshold");
+
+/**
+ * @class BenchMultiThreshold
+ * Time the multi-threshold deblending of a single detection made of several blended components
+ */
+class BenchMultiThreshold : public Elements::Program {
+private:
+  std::default_random_engine random_generator;
+
+  std::shared_ptr<TaskFactoryRegistry> m_task_factory_registry{new TaskFactoryRegistry};
+  std::shared_ptr<TaskProvider> m_task_provider{new TaskProvider(m_task_factory_registry)};
+
+public:
+
+  BenchMultiThreshold() {
+    m_task_factory_registry->registerTaskFactory<ShapeParametersTaskFactory, ShapeParameters>();
+    m_task_factory_registry->registerTaskFactory<PixelCentroidTaskFactory, PixelCentroid>();
+    m_task_factory_registry->registerTaskFactory<DetectionFramePixelValuesTaskFactory, DetectionFramePixelValues>();
+    m_task_factory_registry->registerTaskFactory<PeakValueTaskFactory, PeakValue>();
+    m_task_factory_registry->registerTaskFactory<PixelBoundariesTaskFactory, PixelBoundaries>();
+    m_task_factory_registry->registerTaskFactory<DetectionFrameImagesTaskFactory, DetectionFrameImages>();
+    m_task_factory_registry->registerTaskFactory<DetectionFrameSourceStampTaskFactory, DetectionFrameSourceStamp>();
+  }
+
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{};
+    options.add_options()
+      ("size-start", po::value<int>()->default_value(32), "Source size start")
+      ("size-step-size", po::value<int>()->default_value(32), "Source size step size")
+      ("size-nsteps", po::value<int>()->default_value(4), "Number of steps for the source size")
+      ("components", po::value<int>()->default_value(3), "Number of blended components")
+      ("thresholds", po::value<int>()->default_value(32), "Number of thresholds")
+      ("contrast", po::value<double>()->default_value(0.005), "Minimum contrast")
+      ("min-area", po::value<int>()->default_value(3), "Minimum area of a deblended source")
+      ("repeat", po::value<int>()->default_value(5), "Repeat")
+      ("measures", po::value<int>()->default_value(10), "Number of measures");
+    return options;
+  }
+
+  /**
+   * Image with the given number of gaussian components, placed randomly so they overlap
+   */
+  std::shared_ptr<VectorImage<SeFloat>> generateImage(int size, int ncomponents) {
+    std::uniform_real_distribution<double> random_pos(size * .25, size * .75);
+    std::uniform_real_distribution<double> random_flux(100, 1000);
+    double sigma = size / 10.;
+
+    auto img = VectorImage<SeFloat>::create(size, size);
+    for (int c = 0; c < ncomponents; ++c) {
+      double cx = random_pos(random_generator), cy = random_pos(random_generator);
+      double flux = random_flux(random_generator);
+      for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+          double r2 = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+          img->at(x, y) += flux * std::exp(-r2 / (2 * sigma * sigma));
+        }
+      }
+    }
+    return img;
+  }
+
+  /**
+   * Build the source as segmentation would, with the pixels above 1% of the peak
+   */
+  std::unique_ptr<SourceInterface> createSource(const std::shared_ptr<VectorImage<SeFloat>>& image) {
+    std::vector<PixelCoordinate> pixels;
+    SeFloat max_value = *std::max_element(image->getData().begin(), image->getData().end());
+    SeFloat min_value = max_value;
+    int min_x = image->getWidth(), min_y = image->getHeight(), max_x = 0, max_y = 0, peak_x = 0, peak_y = 0;
+
+    for (int y = 0; y < image->getHeight(); ++y) {
+      for (int x = 0; x < image->getWidth(); ++x) {
+        auto value = image->getValue(x, y);
+        if (value < max_value * .01) {
+          continue;
+        }
+        pixels.emplace_back(x, y);
+        min_value = std::min(min_value, value);
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+        if (value == max_value) {
+          peak_x = x;
+          peak_y = y;
+        }
+      }
+    }
+
+    std::unique_ptr<SourceInterface> source{new SourceWithOnDemandProperties(m_task_provider)};
+    source->setProperty<SourceId>();
+    source->setProperty<DetectionFrame>(std::make_shared<DetectionImageFrame>(image));
+    source->setProperty<PeakValue>(min_value, max_value, peak_x, peak_y);
+    source->setProperty<PixelCoordinateList>(pixels);
+    source->setProperty<PixelBoundaries>(min_x, min_y, max_x, max_y);
+    return source;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto size_start = args["size-start"].as<int>();
+    auto size_step_size = args["size-step-size"].as<int>();
+    auto size_nsteps = args["size-nsteps"].as<int>();
+    auto ncomponents = args["components"].as<int>();
+    auto thresholds = args["thresholds"].as<int>();
+    auto contrast = args["contrast"].as<double>();
+    auto min_area = args["min-area"].as<int>();
+    auto repeat = args["repeat"].as<int>();
+    auto measures = args["measures"].as<int>();
+
+    auto source_factory = std::make_shared<SourceWithOnDemandPropertiesFactory>(m_task_provider);
+
+    std::cout << "Size,Components,Thresholds,Sources,Time" << std::endl;
+
+    for (int size_step = 0; size_step < size_nsteps; ++size_step) {
+      auto size = size_start + size_step * size_step_size;
+      logger.info() << "Using a source of " << size << "x" << size << " with " << ncomponents << " components";
+
+      auto image = generateImage(size, ncomponents);
+
+      for (int m = 0; m < measures; ++m) {
+        logger.info() << "MultiThreshold " << m + 1 << "/" << measures;
+        timer::cpu_timer timer;
+        timer.stop();
+
+        size_t nsources = 0;
+        for (int r = 0; r < repeat; ++r) {
+          MultiThresholdPartitionStep step(source_factory, contrast, thresholds, min_area, 42);
+          auto source = createSource(image);
+          timer.start();
+          auto result = step.partition(std::move(source));
+          timer.stop();
+          nsources = result.size();
+        }
+
+        std::cout << size << ',' << ncomponents << ',' << thresholds << ',' << nsources << ','
+                  << timer.elapsed().wall << std::endl;
+      }
+    }
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(BenchMultiThreshold)
@@ -0,0 +1,538 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * BenchPipeline.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <fitsio.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_01.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/regex.hpp>
+
+#include <ElementsKernel/Exception.h>
+#include <ElementsKernel/Logging.h>
+#include <ElementsKernel/Program.h>
+#include <ElementsKernel/Main.h>
+#include <AlexandriaKernel/StringUtils.h>
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+using namespace Euclid;
+
+static Elements::Logging logger = Elements::Logging::getLogger("BenchPipeline");
+
+typedef std::chrono::steady_clock Clock;
+
+static double secondsBetween(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * Preset configurations of the pipeline, from the cheapest to the most expensive
+ */
+struct PipelinePreset {
+  std::string m_properties;
+  // Python configuration, {image} is replaced by the path of the detection image
+  std::string m_python;
+};
+
+static const std::map<std::string, PipelinePreset> s_presets{
+  {"detection", {
+    "PixelCentroid,PixelBoundaries,IsophotalFlux,PeakValue",
+    ""
+  }},
+  {"photometry", {
+    "PixelCentroid,ShapeParameters,IsophotalFlux,KronRadius,AutoPhotometry,AperturePhotometry,FluxRadius",
+    "from sourcextractor.config import *\n"
+    "\n"
+    "top = load_fits_image('{image}')\n"
+    "add_output_column('aperture', add_aperture_photometry(top, [5, 10, 20]))\n"
+  }},
+  {"model-fitting", {
+    "PixelCentroid,IsophotalFlux,FlexibleModelFitting",
+    "import math\n"
+    "from sourcextractor.config import *\n"
+    "\n"
+    "top = load_fits_image('{image}')\n"
+    "mesgroup = MeasurementGroup(top)\n"
+    "\n"
+    "x, y = get_pos_parameters()\n"
+    "flux = get_flux_parameter()\n"
+    "radius = FreeParameter(lambda o: o.radius, Range(lambda v, o: (.01 * v, 100 * v), RangeType.EXPONENTIAL))\n"
+    "angle = FreeParameter(lambda o: o.angle, Range((-math.pi, math.pi), RangeType.LINEAR))\n"
+    "ratio = FreeParameter(1, Range((0.1, 10), RangeType.EXPONENTIAL))\n"
+    "add_model(mesgroup, ExponentialModel(x, y, flux, radius, ratio, angle))\n"
+    "\n"
+    "add_output_column('mf_x', x)\n"
+    "add_output_column('mf_y', y)\n"
+    "add_output_column('mf_flux', flux)\n"
+    "add_output_column('mf_radius', radius)\n"
+  }},
+};
+
+/// Categories of the trace events of each pipeline stage, in the order they are reported
+static const std::vector<std::string> s_stages{"segmentation", "grouping", "deblending", "measurement", "output"};
+
+/**
+ * Timings of a sourcextractor++ run. The setup, processing and finish times are derived from the time at which
+ * its log milestones are received, the time of each stage is summed over the threads from its trace.
+ */
+struct RunMeasure {
+  double m_setup = 0, m_processing = 0, m_finish = 0, m_total = 0;
+  long m_sources = 0;
+  double m_peak_rss_mb = 0;
+  std::map<std::string, double> m_stages;
+};
+
+/**
+ * Time spent on each stage, summed over the threads, from a trace written by sourcextractor++.
+ * Stages call each other on the same thread (i.e. the segmentation sends the sources to the grouping),
+ * so the time of an event is not counted for the stage of the event enclosing it.
+ */
+static std::map<std::string, double> readStageTimes(const std::string& trace_path) {
+  struct TraceEvent {
+    std::string m_category;
+    double m_start, m_duration;
+  };
+
+  // The trace is written with an event per line
+  boost::regex event_regex{
+    "\"cat\":\"([^\"]*)\",\"ph\":\"X\",\"pid\":[0-9]+,\"tid\":([0-9]+),\"ts\":([-0-9.]+),\"dur\":([-0-9.]+)"
+  };
+  std::map<int, std::vector<TraceEvent>> thread_events;
+  std::ifstream trace(trace_path);
+  std::string line;
+  while (std::getline(trace, line)) {
+    boost::smatch match;
+    if (boost::regex_search(line, match, event_regex)) {
+      thread_events[std::stoi(match[2])].push_back({match[1], std::stod(match[3]), std::stod(match[4])});
+    }
+  }
+
+  std::map<std::string, double> stage_times;
+  for (auto& stage : s_stages) {
+    stage_times[stage] = 0;
+  }
+
+  for (auto& entry : thread_events) {
+    auto& events = entry.second;
+    std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+      return a.m_start < b.m_start || (a.m_start == b.m_start && a.m_duration > b.m_duration);
+    });
+
+    // Events enclosing the current one that belong to a stage
+    std::vector<const TraceEvent*> enclosing;
+    for (auto& event : events) {
+      if (stage_times.count(event.m_category) == 0) {
+        continue;
+      }
+      // The trace has a resolution of a nanosecond
+      while (!enclosing.empty() &&
+             enclosing.back()->m_start + enclosing.back()->m_duration <= event.m_start + 1e-3) {
+        enclosing.pop_back();
+      }
+      if (enclosing.empty() || enclosing.back()->m_category != event.m_category) {
+        stage_times[event.m_category] += event.m_duration;
+        if (!enclosing.empty()) {
+          stage_times[enclosing.back()->m_category] -= event.m_duration;
+        }
+      }
+      enclosing.push_back(&event);
+    }
+  }
+
+  // Microseconds to seconds
+  for (auto& entry : stage_times) {
+    entry.second /= 1e6;
+  }
+  return stage_times;
+}
+
+/**
+ * @class BenchPipeline
+ * Generate reproducible fields with TestImage and run the whole pipeline on them,
+ * reporting the throughput, the time spent on each stage and the peak memory as CSV.
+ * Times are in seconds, the throughput in sources per second, and the peak memory in megabytes.
+ */
+class BenchPipeline : public Elements::Program {
+public:
+
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description options{"BenchPipeline options"};
+    options.add_options()
+      ("sourcextractor", po::value<std::string>()->default_value("sourcextractor++"),
+        "sourcextractor++ executable")
+      ("test-image", po::value<std::string>()->default_value("TestImage"), "TestImage executable")
+      ("work-dir", po::value<std::string>()->default_value(""),
+        "Directory for the generated images and catalogs (default: a temporary directory, removed at the end)")
+      ("config", po::value<std::string>()->default_value("detection,photometry,model-fitting"),
+        "Pipeline configurations to run: detection, photometry, model-fitting")
+      ("size", po::value<std::string>()->default_value("1024"), "Image sizes in pixels")
+      ("density", po::value<std::string>()->default_value("500"), "Number of sources per megapixel")
+      ("blend-fraction", po::value<std::string>()->default_value("0.2"),
+        "Fraction of the sources placed next to another source")
+      ("frames", po::value<int>()->default_value(1), "Number of detection frames (copies of the same field)")
+      ("repeat", po::value<int>()->default_value(1), "Number of runs for each combination")
+      ("seed", po::value<unsigned int>()->default_value(42), "Seed used to generate the fields")
+      ("thread-count", po::value<int>()->default_value(4), "Number of worker threads of sourcextractor++")
+      ("extra-args", po::value<std::string>()->default_value(""),
+        "Additional arguments for sourcextractor++, separated by spaces");
+    return options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    m_sourcextractor = args.at("sourcextractor").as<std::string>();
+    m_test_image = args.at("test-image").as<std::string>();
+    m_thread_count = args.at("thread-count").as<int>();
+
+    auto extra_args = boost::trim_copy(args.at("extra-args").as<std::string>());
+    if (!extra_args.empty()) {
+      boost::split(m_extra_args, extra_args, boost::is_any_of(" "), boost::token_compress_on);
+    }
+
+    std::vector<std::string> configs;
+    boost::split(configs, args.at("config").as<std::string>(), boost::is_any_of(","));
+    for (auto& config : configs) {
+      boost::trim(config);
+      if (s_presets.count(config) == 0) {
+        throw Elements::Exception() << "Unknown configuration " << config;
+      }
+    }
+
+    auto sizes = stringToVector<int>(args.at("size").as<std::string>());
+    auto densities = stringToVector<double>(args.at("density").as<std::string>());
+    auto blend_fractions = stringToVector<double>(args.at("blend-fraction").as<std::string>());
+    int frames = args.at("frames").as<int>();
+    int repeat = args.at("repeat").as<int>();
+    auto seed = args.at("seed").as<unsigned int>();
+
+    if (frames < 1 || repeat < 1) {
+      throw Elements::Exception() << "frames and repeat must be at least 1";
+    }
+
+    bool remove_work_dir = args.at("work-dir").as<std::string>().empty();
+    fs::path work_dir = remove_work_dir ?
+      fs::temp_directory_path() / fs::unique_path("BenchPipeline-%%%%-%%%%") : fs::path(args.at("work-dir").as<std::string>());
+    fs::create_directories(work_dir);
+    logger.info() << "Working on " << work_dir.native();
+
+    std::cout << "Config,Size,Density,BlendFraction,Frames,Sources,Generate,Setup,Processing,Finish,Total,"
+                 "Throughput,PeakRSS,Segmentation,Grouping,Deblending,Measurement,Output" << std::endl;
+
+    for (auto size : sizes) {
+      for (auto density : densities) {
+        for (auto blend_fraction : blend_fractions) {
+          std::ostringstream field_name_str;
+          field_name_str << "field_" << size << "_" << density << "_" << blend_fraction;
+          auto field_name = field_name_str.str();
+          auto image_path = (work_dir / (field_name + ".fits")).native();
+
+          logger.info() << "Generating " << image_path;
+          auto generate_start = Clock::now();
+          generateField(work_dir / field_name, size, density, blend_fraction, frames, seed);
+          double generate_time = secondsBetween(generate_start, Clock::now());
+
+          for (auto& config : configs) {
+            for (int r = 0; r < repeat; ++r) {
+              logger.info() << "Running " << config << " on " << image_path << " " << r + 1 << "/" << repeat;
+              auto measure = runPipeline(work_dir / (field_name + "_" + config), image_path, s_presets.at(config));
+              std::cout << config << ',' << size << ',' << density << ',' << blend_fraction << ',' << frames << ','
+                        << measure.m_sources << ',' << generate_time << ','
+                        << measure.m_setup << ',' << measure.m_processing << ',' << measure.m_finish << ','
+                        << measure.m_total << ',' << (measure.m_total > 0 ? measure.m_sources / measure.m_total : 0.)
+                        << ',' << measure.m_peak_rss_mb;
+              for (auto& stage : s_stages) {
+                std::cout << ',' << measure.m_stages.at(stage);
+              }
+              std::cout << std::endl;
+            }
+          }
+        }
+      }
+    }
+
+    if (remove_work_dir) {
+      fs::remove_all(work_dir);
+    }
+
+    return Elements::ExitCode::OK;
+  }
+
+private:
+  std::string m_sourcextractor, m_test_image;
+  int m_thread_count = 4;
+  std::vector<std::string> m_extra_args;
+
+  /**
+   * Write a TestImage source list. Blended sources are placed at 1.5 to 4 effective radii
+   * from a source placed before them.
+   */
+  void generateSourceList(const std::string& path, int size, double density, double blend_fraction,
+                          unsigned int seed) {
+    boost::random::mt19937 rng{seed};
+    boost::random::uniform_01<double> uniform;
+    boost::random::uniform_real_distribution<> random_pos(10, size - 10);
+    boost::random::uniform_real_distribution<> random_log_flux(3.5, 5.5);
+    boost::random::uniform_real_distribution<> random_radius(.5, 6);
+    boost::random::uniform_real_distribution<> random_aspect(.2, .8);
+    boost::random::uniform_real_distribution<> random_angle(-90, 90);
+
+    struct Position {
+      double x, y, radius;
+    };
+    std::vector<Position> positions;
+
+    long nb_sources = std::lround(density * size * size / 1e6);
+    std::ofstream list(path);
+    for (long i = 0; i < nb_sources; ++i) {
+      bool point_source = uniform(rng) < 0.2;
+      double flux = std::pow(10., random_log_flux(rng));
+      double radius = point_source ? 1. : random_radius(rng);
+
+      double x, y;
+      if (!positions.empty() && uniform(rng) < blend_fraction) {
+        auto& neighbour = positions[boost::random::uniform_int_distribution<size_t>(0, positions.size() - 1)(rng)];
+        double distance = (1.5 + 2.5 * uniform(rng)) * std::max(radius, neighbour.radius);
+        double direction = 2 * M_PI * uniform(rng);
+        x = std::min<double>(std::max(neighbour.x + distance * std::cos(direction), 0.), size - 1);
+        y = std::min<double>(std::max(neighbour.y + distance * std::sin(direction), 0.), size - 1);
+      }
+      else {
+        x = random_pos(rng);
+        y = random_pos(rng);
+      }
+      positions.push_back({x, y, radius});
+
+      if (point_source) {
+        list << x << " " << y << " 0 1 1 0 0 1 1 0 " << flux << "\n";
+      }
+      else {
+        list << x << " " << y << " " << flux << " " << radius << " " << random_aspect(rng) << " " << random_angle(rng)
+             << " 0 1 1 0 0\n";
+      }
+    }
+
+    if (!list) {
+      throw Elements::Exception() << "Failed to write the source list " << path;
+    }
+  }
+
+  /**
+   * Generate the field with TestImage, and replicate it in as many HDUs as frames requested.
+   * All frames are identical, so a measurement image loaded from the first HDU is valid for all of them.
+   */
+  void generateField(const fs::path& base, int size, double density, double blend_fraction, int frames,
+                     unsigned int seed) {
+    auto list_path = base.native() + ".list";
+    auto single_path = base.native() + "_single.fits";
+    auto image_path = base.native() + ".fits";
+
+    generateSourceList(list_path, size, density, blend_fraction, seed);
+
+    fs::remove(single_path);
+    auto result = runProcess({
+      m_test_image, "--output", single_path, "--size", std::to_string(size),
+      "--source-list", list_path, "--seed", std::to_string(seed), "--bg-level", "100", "--gain", "1"
+    }, nullptr);
+    if (result.first != 0) {
+      throw Elements::Exception() << m_test_image << " failed with status " << result.first;
+    }
+
+    int status = 0;
+    fitsfile *input = nullptr, *output = nullptr;
+    fs::remove(image_path);
+    fits_open_file(&input, single_path.c_str(), READONLY, &status);
+    fits_create_file(&output, image_path.c_str(), &status);
+    for (int frame = 0; frame < frames && status == 0; ++frame) {
+      fits_copy_hdu(input, output, 0, &status);
+    }
+    int close_status = 0;
+    if (output) {
+      fits_close_file(output, &close_status);
+    }
+    if (input) {
+      fits_close_file(input, &close_status);
+    }
+    if (status != 0 || close_status != 0) {
+      char err_txt[31];
+      fits_get_errstatus(status ? status : close_status, err_txt);
+      throw Elements::Exception() << "Failed to write " << image_path << " status: "
+                                  << (status ? status : close_status) << " = " << err_txt;
+    }
+    fs::remove(single_path);
+  }
+
+  RunMeasure runPipeline(const fs::path& base, const std::string& image_path, const PipelinePreset& preset) {
+    auto catalog_path = base.native() + ".fits";
+    auto trace_path = base.native() + ".trace.json";
+    fs::remove(catalog_path);
+
+    std::vector<std::string> cmd{
+      m_sourcextractor, "--detection-image", image_path,
+      "--output-catalog-filename", catalog_path, "--output-catalog-format", "FITS",
+      "--output-properties", preset.m_properties, "--thread-count", std::to_string(m_thread_count),
+      "--psf-fwhm", "5", "--psf-pixel-sampling", "0.2", "--trace-file", trace_path
+    };
+
+    if (!preset.m_python.empty()) {
+      auto python_path = base.native() + ".py";
+      std::ofstream python(python_path);
+      python << boost::replace_all_copy(preset.m_python, "{image}", image_path);
+      cmd.insert(cmd.end(), {"--python-config-file", python_path});
+    }
+    cmd.insert(cmd.end(), m_extra_args.begin(), m_extra_args.end());
+
+    // Stage boundaries from the log of sourcextractor++
+    boost::regex frame_start_regex{".*Processing frame [0-9]+ / [0-9]+.*"};
+    boost::regex frame_end_regex{".*sources detected in frame.*"};
+    boost::regex total_regex{".*total ([0-9]+) sources detected.*"};
+
+    Clock::time_point first_frame_start, last_frame_end;
+    bool frame_started = false, frame_ended = false;
+    RunMeasure measure;
+
+    auto start = Clock::now();
+    auto result = runProcess(cmd, [&](const std::string& line) {
+      auto now = Clock::now();
+      boost::smatch match;
+      if (!frame_started && boost::regex_match(line, frame_start_regex)) {
+        first_frame_start = now;
+        frame_started = true;
+      }
+      else if (boost::regex_match(line, frame_end_regex)) {
+        last_frame_end = now;
+        frame_ended = true;
+      }
+      else if (boost::regex_match(line, match, total_regex)) {
+        measure.m_sources = std::stol(match[1]);
+      }
+    });
+    auto end = Clock::now();
+
+    if (result.first != 0) {
+      throw Elements::Exception() << m_sourcextractor << " failed with status " << result.first;
+    }
+    if (!frame_started || !frame_ended) {
+      logger.warn() << "Could not find the frame boundaries in the log, only the total time is reported";
+      first_frame_start = last_frame_end = start;
+    }
+
+    measure.m_setup = secondsBetween(start, first_frame_start);
+    measure.m_processing = secondsBetween(first_frame_start, last_frame_end);
+    measure.m_finish = secondsBetween(last_frame_end, end);
+    measure.m_total = secondsBetween(start, end);
+    measure.m_peak_rss_mb = result.second / 1024.;
+    measure.m_stages = readStageTimes(trace_path);
+    return measure;
+  }
+
+  /**
+   * Run a child process, passing each line of its merged standard output and error to the callback
+   * @return The exit status and the peak resident set size of the child, in kilobytes
+   */
+  std::pair<int, long> runProcess(const std::vector<std::string>& cmd,
+                                  const std::function<void(const std::string&)>& on_line) {
+    int pipe_fds[2];
+    if (::pipe(pipe_fds) != 0) {
+      throw Elements::Exception() << "Failed to create a pipe: " << std::strerror(errno);
+    }
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+      throw Elements::Exception() << "Failed to fork: " << std::strerror(errno);
+    }
+    if (pid == 0) {
+      ::dup2(pipe_fds[1], STDOUT_FILENO);
+      ::dup2(pipe_fds[1], STDERR_FILENO);
+      ::close(pipe_fds[0]);
+      ::close(pipe_fds[1]);
+
+      std::vector<char*> argv;
+      for (auto& arg : cmd) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+      }
+      argv.push_back(nullptr);
+      ::execvp(argv[0], argv.data());
+      std::cerr << "Failed to run " << cmd[0] << ": " << std::strerror(errno) << std::endl;
+      ::_exit(127);
+    }
+
+    ::close(pipe_fds[1]);
+    std::string pending;
+    char buffer[4096];
+    ssize_t nread;
+    while ((nread = ::read(pipe_fds[0], buffer, sizeof(buffer))) != 0) {
+      if (nread < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      pending.append(buffer, nread);
+      size_t eol;
+      while ((eol = pending.find('\n')) != std::string::npos) {
+        auto line = pending.substr(0, eol);
+        pending.erase(0, eol + 1);
+        logger.debug() << line;
+        if (on_line) {
+          on_line(line);
+        }
+      }
+    }
+    if (!pending.empty() && on_line) {
+      on_line(pending);
+    }
+    ::close(pipe_fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+    while (::wait4(pid, &status, 0, &usage) < 0) {
+      if (errno != EINTR) {
+        throw Elements::Exception() << "Failed to wait for " << cmd[0] << ": " << std::strerror(errno);
+      }
+    }
+
+    int exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    // ru_maxrss is in kilobytes on Linux
+    return {exit_code, usage.ru_maxrss};
+  }
+};
+
+MAIN_FOR(BenchPipeline)
@@ -29,6 +29,14 @@
 
 namespace SourceXtractor {
 
+/**
+ * How the fraction of a pixel covered by an aperture is computed
+ */
+enum class ApertureOverlap {
+  SAMPLED, ///< Each aperture own approximation (supersampling for circles, pixel center for ellipses)
+  EXACT    ///< Exact geometric overlap between the aperture and the pixel square
+};
+
 class Aperture {
 public:
   virtual ~Aperture() = default;
@@ -42,6 +50,26 @@ public:
   virtual PixelCoordinate getMaxPixel(SeFloat centroid_x, SeFloat centroid_y) const = 0;
 
   virtual SeFloat getRadiusSquared(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const = 0;
+
+  /**
+   * Compute the area for the pixels [min_x, max_x] of the row pixel_y, storing them into areas,
+   * which must have room for max_x - min_x + 1 values
+   */
+  virtual void getAreaRow(SeFloat center_x, SeFloat center_y, int pixel_y, int min_x, int max_x, SeFloat *areas) const {
+    for (int x = min_x; x <= max_x; ++x) {
+      areas[x - min_x] = getArea(center_x, center_y, x, pixel_y);
+    }
+  }
+
+  /**
+   * Apertures configured for the exact overlap whose shape is an ellipse
+   * cxx * dx^2 + cyy * dy^2 + cxy * dx * dy <= rad^2 expose it, so decorators can keep the exact computation
+   * @return
+   *    false if the aperture does not use the exact overlap
+   */
+  virtual bool getExactEllipse(SeFloat& /*cxx*/, SeFloat& /*cyy*/, SeFloat& /*cxy*/, SeFloat& /*rad*/) const {
+    return false;
+  }
 };
 
 } // end SourceXtractor
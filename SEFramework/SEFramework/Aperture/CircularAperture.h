@@ -32,7 +32,8 @@ class CircularAperture : public Aperture {
 public:
   virtual ~CircularAperture() = default;
 
-  explicit CircularAperture(SeFloat radius) : m_radius(radius) {}
+  explicit CircularAperture(SeFloat radius, ApertureOverlap overlap = ApertureOverlap::SAMPLED)
+    : m_radius(radius), m_overlap(overlap) {}
 
   SeFloat getArea(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const override;
 
@@ -44,8 +45,13 @@ public:
 
   SeFloat getRadiusSquared(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const override;
 
+  void getAreaRow(SeFloat center_x, SeFloat center_y, int pixel_y, int min_x, int max_x, SeFloat *areas) const override;
+
+  bool getExactEllipse(SeFloat& cxx, SeFloat& cyy, SeFloat& cxy, SeFloat& rad) const override;
+
 private:
   SeFloat m_radius;
+  ApertureOverlap m_overlap;
 };
 
 } // end SourceXtractor
@@ -32,7 +32,8 @@ class EllipticalAperture : public Aperture {
 public:
   virtual ~EllipticalAperture() = default;
 
-  EllipticalAperture(SeFloat cxx, SeFloat cyy, SeFloat cxy, SeFloat rad_max);
+  EllipticalAperture(SeFloat cxx, SeFloat cyy, SeFloat cxy, SeFloat rad_max,
+                     ApertureOverlap overlap = ApertureOverlap::SAMPLED);
 
   SeFloat getArea(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const override;
 
@@ -44,11 +45,16 @@ public:
 
   SeFloat getRadiusSquared(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const override;
 
+  void getAreaRow(SeFloat center_x, SeFloat center_y, int pixel_y, int min_x, int max_x, SeFloat *areas) const override;
+
+  bool getExactEllipse(SeFloat& cxx, SeFloat& cyy, SeFloat& cxy, SeFloat& rad) const override;
+
 private:
   SeFloat m_cxx;
   SeFloat m_cyy;
   SeFloat m_cxy;
   SeFloat m_rad_max;
+  ApertureOverlap m_overlap;
 };
 
 } // end SourceXtractor
@@ -0,0 +1,58 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ExactOverlap.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEFRAMEWORK_SEFRAMEWORK_APERTURE_EXACTOVERLAP_H
+#define _SEFRAMEWORK_SEFRAMEWORK_APERTURE_EXACTOVERLAP_H
+
+#include "SEUtils/Types.h"
+
+namespace SourceXtractor {
+
+/**
+ * Exact area of the intersection between a circle of radius r centered on the origin and
+ * the axis-aligned rectangle [xmin, xmax] x [ymin, ymax]
+ */
+double circularOverlap(double xmin, double ymin, double xmax, double ymax, double r);
+
+/**
+ * Exact overlap of a circle of radius r centered on the origin with each of the unit pixels
+ * of a row. The pixel i covers [x0 + i - 0.5, x0 + i + 0.5] x [y - 0.5, y + 0.5], and the result is
+ * written into areas[i], for i in [0, n). Adjacent pixels share the computation of their common edge.
+ */
+void circularOverlapRow(double x0, double y, int n, double r, SeFloat *areas);
+
+/**
+ * Exact area of the intersection between the ellipse cxx*x^2 + cyy*y^2 + cxy*x*y <= r^2, centered on
+ * the origin, and the axis-aligned rectangle [xmin, xmax] x [ymin, ymax].
+ * The quadratic form must be positive definite, otherwise the result is 0.
+ */
+double ellipticalOverlap(double xmin, double ymin, double xmax, double ymax,
+                         double cxx, double cyy, double cxy, double r);
+
+/**
+ * Same as circularOverlapRow, for an ellipse cxx*x^2 + cyy*y^2 + cxy*x*y <= r^2
+ */
+void ellipticalOverlapRow(double x0, double y, int n, double cxx, double cyy, double cxy, double r, SeFloat *areas);
+
+} // end SourceXtractor
+
+#endif // _SEFRAMEWORK_SEFRAMEWORK_APERTURE_EXACTOVERLAP_H
@@ -26,6 +26,8 @@
 
 #include "Aperture.h"
 #include <array>
+#include <memory>
+#include <tuple>
 
 namespace SourceXtractor {
 
@@ -45,9 +47,17 @@ public:
 
   SeFloat getRadiusSquared(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const override;
 
+  void getAreaRow(SeFloat center_x, SeFloat center_y, int pixel_y, int min_x, int max_x, SeFloat *areas) const override;
+
+  bool getExactEllipse(SeFloat& cxx, SeFloat& cyy, SeFloat& cxy, SeFloat& rad) const override;
+
 private:
   std::shared_ptr<Aperture> m_decorated;
   std::array<double, 4> m_transform, m_inv_transform;
+
+  // If the decorated aperture is an exact ellipse, so is the transformed one
+  bool m_exact;
+  SeFloat m_cxx, m_cyy, m_cxy, m_rad;
 };
 
 } // end SourceXtractor
@@ -30,6 +30,7 @@
 #include "SEFramework/Image/PaddedImage.h"
 #include "SEFramework/Image/RecenterImage.h"
 #include "SEFramework/Image/WriteableImage.h"
+#include "SEUtils/MemoryAccounting.h"
 
 #include <fftw3.h>
 
@@ -61,6 +62,7 @@ public:
     int m_padded_width, m_padded_height, m_transform_padding;
     std::vector<real_t> m_kernel_transform, m_work_area;
     typename FFT<T>::plan_ptr_t m_fwd_plan, m_inv_plan;
+    MemoryAccounting::Allocation m_memory;
 
     friend class DFTConvolution<T, TPadding>;
   };
@@ -122,6 +124,7 @@ public:
     // Pre-allocate buffers for the transformations
     context->m_kernel_transform.resize(work_area_size);
     context->m_work_area.resize(work_area_size);
+    context->m_memory = MemoryAccounting::Allocation(MemoryAccounting::FFT, 2L * work_area_size * sizeof(T));
 
     // Since we already have the buffers, get the plans too
     context->m_fwd_plan = FFT<T>::createForwardPlan(context->m_padded_width, context->m_padded_height,
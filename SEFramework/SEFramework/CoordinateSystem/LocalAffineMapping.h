@@ -0,0 +1,83 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * LocalAffineMapping.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEFRAMEWORK_COORDINATESYSTEM_LOCALAFFINEMAPPING_H_
+#define _SEFRAMEWORK_COORDINATESYSTEM_LOCALAFFINEMAPPING_H_
+
+#include "SEFramework/CoordinateSystem/CoordinateSystem.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class LocalAffineMapping
+ * @brief
+ *  Approximates the mapping from the image coordinates of one coordinate system to the image
+ *  coordinates of another (image -> world -> image) with an affine transformation, valid within
+ *  a rectangular region.
+ *
+ * @details
+ *  The transformation is fitted from a 3x3 grid of exact evaluations spanning the region, and validated
+ *  on the fitted points plus four additional points inside the region. If any of the residuals is
+ *  above the tolerance, or any exact evaluation fails, the mapping is flagged as invalid and the caller
+ *  should fall back to the exact transformation.
+ */
+class LocalAffineMapping {
+public:
+  /**
+   * @param from
+   *    Coordinate system of the input image coordinates
+   * @param to
+   *    Coordinate system of the output image coordinates
+   * @param min_x, min_y, max_x, max_y
+   *    Region (in the `from` image coordinates) where the approximation is to be used
+   * @param tolerance
+   *    Maximum allowed deviation, in pixels of the `to` image
+   */
+  LocalAffineMapping(const CoordinateSystem& from, const CoordinateSystem& to,
+                     double min_x, double min_y, double max_x, double max_y, double tolerance);
+
+  /// True if the affine approximation is within the tolerance on the region
+  bool isValid() const {
+    return m_valid;
+  }
+
+  /// Maximum deviation found while validating the approximation
+  double getMaxResidual() const {
+    return m_max_residual;
+  }
+
+  ImageCoordinate operator()(double x, double y) const {
+    double dx = x - m_center_x, dy = y - m_center_y;
+    return {m_x0 + m_xx * dx + m_xy * dy, m_y0 + m_yx * dx + m_yy * dy};
+  }
+
+private:
+  double m_center_x, m_center_y;
+  double m_x0, m_xx, m_xy;
+  double m_y0, m_yx, m_yy;
+  double m_max_residual;
+  bool m_valid;
+};
+
+} // namespace SourceXtractor
+
+#endif /* _SEFRAMEWORK_COORDINATESYSTEM_LOCALAFFINEMAPPING_H_ */
@@ -0,0 +1,59 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * OffsetCoordinateSystem.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEFRAMEWORK_COORDINATESYSTEM_OFFSETCOORDINATESYSTEM_H_
+#define _SEFRAMEWORK_COORDINATESYSTEM_OFFSETCOORDINATESYSTEM_H_
+
+#include <memory>
+
+#include "SEFramework/CoordinateSystem/CoordinateSystem.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class OffsetCoordinateSystem
+ * @brief Coordinate system of a region of an image, whose first pixel is at the given offset
+ *
+ * The FITS headers have the reference pixel shifted, and the offset recorded with the IRAF
+ * LTV1 and LTV2 keywords, so the region can be placed back into the full image.
+ * The wrapped coordinate system may be null, then only the offset is written.
+ */
+class OffsetCoordinateSystem : public CoordinateSystem {
+public:
+  OffsetCoordinateSystem(std::shared_ptr<CoordinateSystem> coordinate_system, const PixelCoordinate& offset);
+
+  virtual ~OffsetCoordinateSystem() = default;
+
+  WorldCoordinate imageToWorld(ImageCoordinate image_coordinate) const override;
+
+  ImageCoordinate worldToImage(WorldCoordinate world_coordinate) const override;
+
+  std::map<std::string, std::string> getFitsHeaders() const override;
+
+private:
+  std::shared_ptr<CoordinateSystem> m_coordinate_system;
+  PixelCoordinate m_offset;
+};
+
+}  // namespace SourceXtractor
+
+#endif /* _SEFRAMEWORK_COORDINATESYSTEM_OFFSETCOORDINATESYSTEM_H_ */
@@ -25,7 +25,9 @@
 #ifndef _SEFRAMEWORK_IMAGE_FITSIMAGESOURCE_H_
 #define _SEFRAMEWORK_IMAGE_FITSIMAGESOURCE_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <map>
 
@@ -35,6 +37,7 @@
 #include "SEFramework/CoordinateSystem/CoordinateSystem.h"
 #include "SEFramework/Image/ImageSourceWithMetadata.h"
 #include "SEFramework/FITS/FitsFile.h"
+#include "SEFramework/FITS/FitsMemoryMap.h"
 #include "SEUtils/VariantCast.h"
 
 
@@ -89,10 +92,18 @@ public:
 
   void setLayer(int layer);
 
+  /**
+   * Source for another layer of the same data cube. The header is not read again, and the memory
+   * mapping, if any, covers the whole cube and is shared by all of its layers.
+   */
+  std::shared_ptr<FitsImageSource> createLayer(int layer) const;
+
   std::shared_ptr<ImageTile> getImageTile(int x, int y, int width, int height) const override;
 
   void saveTile(ImageTile& tile) override;
 
+  void flush() override;
+
   template<typename TT>
   bool readFitsKeyword(const std::string& header_keyword, TT& out_value) const {
     auto& headers = getMetadata();
@@ -118,9 +129,36 @@ public:
 
   void setMetadata(const std::string& key, const MetadataEntry& value) override;
 
+  /**
+   * Enable or disable memory mapped reads. When enabled, tiles from uncompressed and non-scaled image HDUs
+   * are decoded directly from a read-only mapping of the file, without going through cfitsio nor
+   * locking the file handler. Sources that are written to always use cfitsio.
+   */
+  static void setMemoryMapping(bool enabled) {
+    s_memory_mapping = enabled;
+  }
+
+  static bool getMemoryMapping() {
+    return s_memory_mapping;
+  }
+
+  /// True if this source is serving tiles from a memory mapping
+  bool isMemoryMapped() const;
+
 private:
+  struct MappedData {
+    std::once_flag m_flag;
+    std::unique_ptr<FitsMemoryMap> m_map;
+  };
+
+  FitsImageSource(const FitsImageSource& cube, int layer);
+
   void switchHdu(fitsfile *fptr, int hdu_number) const;
 
+  void checkMappable(fitsfile *fptr);
+
+  void readMappedTile(ImageTile& tile) const;
+
   int getDataType() const;
 
   int getImageType() const;
@@ -137,6 +175,14 @@ private:
   ImageTile::ImageType m_image_type;
 
   int m_current_layer;
+
+  // Memory mapped access
+  static std::atomic<bool> s_memory_mapping;
+  std::atomic<bool> m_mappable;
+  int m_bitpix;
+  long long m_data_offset;
+  std::string m_root_path;
+  std::shared_ptr<MappedData> m_mapped;
 };
 
 }
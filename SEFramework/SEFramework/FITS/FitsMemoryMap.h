@@ -0,0 +1,76 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * FitsMemoryMap.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEFRAMEWORK_FITS_FITSMEMORYMAP_H_
+#define _SEFRAMEWORK_FITS_FITSMEMORYMAP_H_
+
+#include <cstddef>
+#include <string>
+
+namespace SourceXtractor {
+
+/**
+ * @class FitsMemoryMap
+ * @brief Read-only memory map of the data unit of an uncompressed FITS image HDU
+ *
+ * The pixels are kept in the FITS (big endian) representation, so the caller is responsible for
+ * byte-swapping and converting them. Residency is left to the OS page cache.
+ */
+class FitsMemoryMap {
+public:
+  /**
+   * @param path
+   *    Path to the FITS file in the filesystem (not a cfitsio extended file name)
+   * @param offset
+   *    Offset, in bytes, of the data unit
+   * @param size
+   *    Size, in bytes, of the data unit
+   * @throws Elements::Exception
+   *    If the file can not be mapped, or it is not a plain FITS file (i.e. gzip compressed)
+   */
+  FitsMemoryMap(const std::string& path, long long offset, long long size);
+
+  virtual ~FitsMemoryMap();
+
+  FitsMemoryMap(const FitsMemoryMap&) = delete;
+  FitsMemoryMap& operator=(const FitsMemoryMap&) = delete;
+
+  /// Pointer to the first byte of the data unit
+  const unsigned char* getData() const {
+    return m_data;
+  }
+
+  std::size_t getSize() const {
+    return m_size;
+  }
+
+private:
+  void* m_mapping;
+  std::size_t m_mapping_size;
+  const unsigned char* m_data;
+  std::size_t m_size;
+};
+
+}  // namespace SourceXtractor
+
+#endif /* _SEFRAMEWORK_FITS_FITSMEMORYMAP_H_ */
@@ -62,6 +62,10 @@ public:
     return m_image_source->saveTile(tile);
   }
 
+  void flush() override {
+    m_image_source->flush();
+  }
+
   int getWidth() const override {
     return m_image_source->getWidth();
   }
@@ -172,6 +172,10 @@ public:
 
   void setFilter(std::shared_ptr<ImageFilter> filter);
 
+  std::shared_ptr<ImageFilter> getFilter() const {
+    return m_filter;
+  }
+
   void setLabel(const std::string &label);
 
 private:
@@ -65,6 +65,9 @@ public:
   virtual void saveTile(ImageTile& tile) = 0;
   virtual std::shared_ptr<ImageTile> getImageTile(int x, int y, int width, int height) const = 0;
 
+  /// Commit the tiles saved so far to the underlying storage
+  virtual void flush() {}
+
 
   /// Returns the width of the image in pixels
   virtual int getWidth() const = 0;
@@ -84,6 +84,11 @@ protected:
     m_tpad = hdiff / 2;
   }
 
+  // The image is placed at the given offset instead of centered
+  PaddedImage(std::shared_ptr<const Image<T>> img, int width, int height, const PixelCoordinate& offset)
+    : m_img{img}, m_width{width}, m_height{height}, m_lpad{offset.m_x}, m_tpad{offset.m_y} {
+  }
+
 public:
   template<typename... Args>
   static std::shared_ptr<PaddedImage<T, CoordinateInterpolation>> create(Args &&... args) {
@@ -24,10 +24,16 @@
 #ifndef _SEFRAMEWORK_IMAGE_TILEMANAGER_H_
 #define _SEFRAMEWORK_IMAGE_TILEMANAGER_H_
 
+#include <condition_variable>
+#include <exception>
 #include <iostream>
+#include <mutex>
 #include <thread>
 #include <list>
+#include <set>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
 
@@ -75,6 +81,29 @@ namespace SourceXtractor {
 class TileManager {
 public:
 
+  /**
+   * Records the image sources whose tiles are requested from the calling thread while it exists,
+   * i.e. the images read by a sweep over the detection frame.
+   */
+  class SourceRecorder {
+  public:
+    SourceRecorder();
+    ~SourceRecorder();
+
+    const std::unordered_set<std::shared_ptr<const ImageSource>>& getSources() const {
+      return m_sources;
+    }
+
+  private:
+    friend class TileManager;
+
+    void record(const std::shared_ptr<const ImageSource>& source);
+
+    SourceRecorder* m_previous;
+    const ImageSource* m_last;
+    std::unordered_set<std::shared_ptr<const ImageSource>> m_sources;
+  };
+
   TileManager();
 
   virtual ~TileManager();
@@ -82,8 +111,30 @@ public:
   // Actually not thread safe, call before starting the multi-threading
   void setOptions(int tile_width, int tile_height, int max_memory);
 
+  /**
+   * Enable or disable the asynchronous write-back of modified tiles. When enabled, evicted tiles
+   * are queued and written by a dedicated I/O thread, which coalesces adjacent tiles into larger blocks.
+   * Queued tiles are still served from memory if they are requested again. Disabled by default.
+   * Actually not thread safe, call before starting the multi-threading
+   */
+  void setWriteBack(bool write_back);
+
+  /// Write all modified tiles, and commit them to the underlying storage (checkpoint)
   void flush();
 
+  /**
+   * Save and release the cached tiles of the given sources that end before the given row, and one tile row
+   * above the lowest row held, see holdRowsFrom. They are loaded again if they are needed later, so this only
+   * bounds the memory of a sweep from the top of the images. The rows must be in the frame of the sources.
+   */
+  void releaseTilesBefore(int y, const std::unordered_set<std::shared_ptr<const ImageSource>>& sources);
+
+  /// Keep the tiles from the given row on, while a group needing them is measured
+  void holdRowsFrom(int y);
+
+  /// Drop a hold added by holdRowsFrom
+  void unholdRowsFrom(int y);
+
   std::shared_ptr<ImageTile>
   getTileForPixel(int x, int y, std::shared_ptr<const ImageSource> source);
 
@@ -107,6 +158,22 @@ private:
 
   void addTile(TileKey key, std::shared_ptr<ImageTile> tile);
 
+  /// Save the tile, either synchronously or queueing it for the I/O thread
+  void saveTile(const TileKey& key, const std::shared_ptr<ImageTile>& tile);
+
+  /// Add the tile to the write queue, m_write_mutex must be held
+  void enqueueTile(const TileKey& key, const std::shared_ptr<ImageTile>& tile);
+
+  /// Retrieve a tile queued for writing, waiting if it is being written right now
+  std::shared_ptr<ImageTile> takeFromWriteBack(const TileKey& key);
+
+  /// Wait until all queued tiles are written, and flush the modified sources
+  void waitWriteBack();
+
+  void stopWriteBack();
+
+  void writeBackLoop();
+
   int m_tile_width, m_tile_height;
   long m_max_memory;
   long m_total_memory_used;
@@ -114,8 +181,28 @@ private:
   std::unordered_map<TileKey, std::shared_ptr<ImageTile>> m_tile_map;
   std::unordered_map<const ImageSource*, std::shared_ptr<boost::mutex>> m_mutex_map;
   std::list<TileKey> m_tile_list;
+  /// First rows held by the groups being measured
+  std::multiset<int> m_held_rows;
 
   boost::shared_mutex m_mutex;
+
+  bool m_write_back;
+  /// Tiles queued for writing
+  std::unordered_map<TileKey, std::shared_ptr<ImageTile>> m_write_queue;
+  /// Tiles being written by the I/O thread
+  std::unordered_set<TileKey> m_write_in_flight;
+  /// Sources written since the last flush
+  std::unordered_map<const ImageSource*, std::weak_ptr<const ImageSource>> m_dirty_sources;
+  long m_write_queue_memory;
+  std::unique_ptr<std::thread> m_write_thread;
+  std::mutex m_write_mutex;
+  /// Notifies the I/O thread that there are tiles to write
+  std::condition_variable m_write_pending;
+  /// Notifies the waiting threads that a batch has been written
+  std::condition_variable m_write_done;
+  bool m_write_stop;
+  /// First error found by the I/O thread, re-thrown on the next flush
+  std::exception_ptr m_write_error;
 };
 
 }
@@ -25,6 +25,7 @@
 #define _SEFRAMEWORK_PIPELINE_OUTPUT_H_
 
 #include "SEFramework/Pipeline/PipelineStage.h"
+#include "SEFramework/Pipeline/Tracer.h"
 #include "SEFramework/Source/SourceGroupInterface.h"
 #include "SEFramework/Source/SourceInterface.h"
 
@@ -36,6 +37,7 @@ public:
   virtual ~Output() = default;
 
   void receiveSource(std::unique_ptr<SourceGroupInterface> source_group) override {
+    Tracer::Scope trace_scope("output", "Output group");
     for (auto& source : *source_group) {
       outputSource(source);
     }
@@ -43,6 +43,8 @@ public:
 
   using SourceToRowConverter = std::function<Euclid::Table::Row(const SourceInterface&)>;
 
+  using SourcePropertyRequester = std::function<void(const SourceInterface&)>;
+
   template <typename PropertyType, typename OutType>
   void registerColumnConverter(std::string column_name, ColumnConverter<PropertyType, OutType> converter,
                                std::string column_unit="", std::string column_description="") {
@@ -155,8 +157,22 @@ public:
     return result;
   }
 
+  /**
+   * The columns, their converters and the column information are resolved when this method is called,
+   * so all the properties and instances must have been registered before.
+   * Each call of the converter still builds a row of variant cells, all sharing the same ColumnInfo.
+   */
   SourceToRowConverter getSourceToRowConverter(const std::vector<std::string>& enabled_optional);
 
+  /**
+   * Returns a function that computes all the properties the output columns depend on,
+   * without converting them. Useful to do the measurements in parallel, ahead of the output.
+   */
+  SourcePropertyRequester getSourcePropertyRequester(const std::vector<std::string>& enabled_properties);
+
+  /// Property types written to the catalog for the given output properties, in output order
+  std::vector<std::type_index> getOutputPropertyTypes(const std::vector<std::string>& enabled_properties) const;
+
   void printPropertyColumnMap(const std::vector<std::string>& properties={});
 
 private:
@@ -168,13 +184,20 @@ private:
       m_convert_func = [converter](const SourceInterface& source, std::size_t i){
         return converter(source.getProperty<PropertyType>(i));
       };
+      m_property_id_func = [](std::size_t i) {
+        return PropertyId::create<PropertyType>(i);
+      };
     }
-    Euclid::Table::Row::cell_type operator()(const SourceInterface& source) {
+    Euclid::Table::Row::cell_type operator()(const SourceInterface& source) const {
       return m_convert_func(source, index);
     }
+    PropertyId getPropertyId() const {
+      return m_property_id_func(index);
+    }
     std::size_t index = 0;
   private:
     std::function<Euclid::Table::Row::cell_type(const SourceInterface&, std::size_t index)> m_convert_func;
+    std::function<PropertyId(std::size_t index)> m_property_id_func;
   };
 
   struct ColInfo {
@@ -86,21 +86,29 @@ public:
     m_segmentation(segmentation),
     m_detection_frame(detection_frame) {}
 
-  void publishSource(std::unique_ptr<SourceInterface> source) const {
+  virtual ~LabellingListener() = default;
+
+  virtual void publishSource(std::unique_ptr<SourceInterface> source) const {
     if (m_detection_frame) {
       source->setProperty<DetectionFrame>(m_detection_frame);
     }
     m_segmentation.sendSource(std::move(source));
   }
 
-  void notifyProgress(int position, int total) {
+  virtual void notifyProgress(int position, int total) {
     m_segmentation.Observable<SegmentationProgress>::notifyObservers(SegmentationProgress{position, total});
   }
 
-  void requestProcessing(const ProcessSourcesEvent& event) {
+  virtual void requestProcessing(const ProcessSourcesEvent& event) {
     m_segmentation.sendProcessSignal(event);
   }
 
+protected:
+  /// For listeners that stand for another frame of the same segmentation
+  LabellingListener(const LabellingListener& listener, std::shared_ptr<DetectionImageFrame> detection_frame) :
+    m_segmentation(listener.m_segmentation),
+    m_detection_frame(detection_frame) {}
+
 private:
   const Segmentation& m_segmentation;
   std::shared_ptr<DetectionImageFrame> m_detection_frame;
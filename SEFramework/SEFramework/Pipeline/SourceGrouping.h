@@ -49,6 +49,22 @@ public:
 
   /// Determines if the given Source must be processed or not
   virtual bool mustBeProcessed(const SourceInterface& source) const = 0;
+
+  /// If true, a group is processed only once all its sources must be, otherwise as soon as one of them must be
+  virtual bool requiresWholeGroup() const {
+    return false;
+  }
+
+  /// Determines if a group must be processed, from the selection of its sources
+  bool groupMustBeProcessed(const SourceGroupInterface& group) const {
+    bool whole_group = requiresWholeGroup();
+    for (auto& source : group) {
+      if (mustBeProcessed(source) != whole_group) {
+        return !whole_group;
+      }
+    }
+    return whole_group;
+  }
 };
 
 /**
@@ -0,0 +1,137 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Tracer.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEFRAMEWORK_PIPELINE_TRACER_H_
+#define _SEFRAMEWORK_PIPELINE_TRACER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace SourceXtractor {
+
+/**
+ * @class Tracer
+ * @brief Records when each thread enters and leaves the stages of the pipeline, in the Chrome trace-event format
+ *
+ * @details
+ *  Each thread appends its events to its own buffer, so recording does not contend with other threads.
+ *  When a buffer is full it is written to the trace file, and whatever is left is written by stop().
+ *  The file can be opened with chrome://tracing or https://ui.perfetto.dev
+ *
+ *  Names and categories are not copied, so they must be string literals or the name of a std::type_info.
+ *  With tracing disabled, the cost of a Scope is one relaxed atomic load.
+ */
+class Tracer {
+public:
+
+  /// Record the time spent between the construction and the destruction of the scope on the calling thread
+  class Scope {
+  public:
+    Scope(const char* category, const char* name)
+      : m_category(category), m_name(name), m_demangle(false), m_start(isEnabled() ? now() : -1) {}
+
+    /// The name of the type is used, i.e. for the measurement tasks
+    Scope(const char* category, const std::type_info& type)
+      : m_category(category), m_name(type.name()), m_demangle(true), m_start(isEnabled() ? now() : -1) {}
+
+    ~Scope() {
+      if (m_start >= 0) {
+        getInstance().recordComplete(m_category, m_name, m_demangle, m_start, now() - m_start);
+      }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    const char *m_category, *m_name;
+    bool m_demangle;
+    int64_t m_start;
+  };
+
+  static Tracer& getInstance();
+
+  virtual ~Tracer();
+
+  static bool isEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  /// Nanoseconds on a monotonic clock
+  static int64_t now();
+
+  /// Start recording into the given file, discarding the events of any previous trace
+  void start(const std::string& path);
+
+  /// Stop recording, and complete the trace file
+  void stop();
+
+  /// Name shown for the calling thread. Can be set before the tracing starts.
+  void setThreadName(const std::string& name);
+
+  void recordComplete(const char* category, const char* name, bool demangle, int64_t start, int64_t duration);
+
+private:
+  struct Event {
+    const char *m_category, *m_name;
+    bool m_demangle;
+    int64_t m_start, m_duration;
+  };
+
+  struct ThreadBuffer {
+    std::mutex m_mutex;
+    std::vector<Event> m_events;
+    int m_tid;
+    std::string m_name;
+  };
+
+  Tracer() : m_origin(0), m_pid(0), m_first_event(true), m_next_tid(1) {}
+
+  ThreadBuffer& getThreadBuffer();
+
+  /// These must be called with m_mutex held
+  void beginEvent();
+  void writeEvents(int tid, const std::vector<Event>& events);
+
+  static std::atomic<bool> s_enabled;
+
+  std::mutex m_mutex;
+  std::ofstream m_stream;
+  int64_t m_origin;
+  int m_pid;
+  bool m_first_event;
+  int m_next_tid;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+  std::map<const char*, std::string> m_demangled;
+};
+
+} // namespace SourceXtractor
+
+#endif /* _SEFRAMEWORK_PIPELINE_TRACER_H_ */
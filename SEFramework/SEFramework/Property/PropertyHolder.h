@@ -23,8 +23,10 @@
 #ifndef _SEFRAMEWORK_PROPERTY_PROPERTYHOLDER_H
 #define _SEFRAMEWORK_PROPERTY_PROPERTYHOLDER_H
 
+#include <algorithm>
 #include <memory>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "SEFramework/Property/PropertyId.h"
 #include "SEFramework/Property/Property.h"
@@ -36,7 +38,9 @@ namespace SourceXtractor {
  * @class PropertyHolder
  * @brief A class providing a simple implementation of a container of properties.
  *
- * @details This class is used to provide a common implementation for objects that have properties
+ * @details This class is used to provide a common implementation for objects that have properties.
+ * Properties are stored in a vector sorted by the type slot and the index of their PropertyId, so a
+ * holder only takes as much memory as the properties it has, whatever the slots and indexes are.
  *
  */
 
@@ -59,6 +63,13 @@ public:
   /// Returns a reference to a Property if it is set, if not throws a PropertyNotFoundException
   const Property& getProperty(const PropertyId& property_id) const;
 
+  /// Returns a pointer to a Property if it is set, nullptr otherwise
+  const Property* findProperty(const PropertyId& property_id) const {
+    auto key = getKey(property_id);
+    auto i = lowerBound(key);
+    return i != m_properties.end() && i->first == key ? i->second.get() : nullptr;
+  }
+
   /// Sets a property, overwriting it if necessary
   void setProperty(std::unique_ptr<Property> property, const PropertyId& property_id);
 
@@ -67,9 +78,26 @@ public:
   
   void clear();
 
+  /// Number of properties set
+  std::size_t size() const {
+    return m_properties.size();
+  }
+
 private:
 
-  std::unordered_map<PropertyId, std::unique_ptr<Property>> m_properties;
+  using Key = std::pair<unsigned int, unsigned int>;
+  using Entry = std::pair<Key, std::unique_ptr<Property>>;
+
+  static Key getKey(const PropertyId& property_id) {
+    return {property_id.getTypeSlot(), property_id.getIndex()};
+  }
+
+  std::vector<Entry>::const_iterator lowerBound(const Key& key) const {
+    return std::lower_bound(m_properties.begin(), m_properties.end(), key,
+                            [](const Entry& entry, const Key& k) { return entry.first < k; });
+  }
+
+  std::vector<Entry> m_properties;
 
 }; /* End of ObjectWithProperties class */
 
@@ -35,6 +35,8 @@ namespace SourceXtractor {
  * @class PropertyId
  * @brief Identifier used to set and retrieve properties.
  *
+ * @details Every property type is given a dense slot number the first time one of its PropertyIds is
+ * created, so containers can key the properties on the slot and the index instead of the type_index.
  */
 
 class PropertyId {
@@ -43,13 +45,15 @@ public:
   /// An optional index parameter is used to make the distinction between several properties of the same type.
   template<typename T>
   static PropertyId create(unsigned int index = 0) {
-    return PropertyId(typeid(T), index);
+    // The slot only depends on the type, so it is looked up once
+    static const unsigned int s_type_slot = getTypeSlot(typeid(T));
+    return PropertyId(typeid(T), index, s_type_slot);
   }
 
   /// Equality operator is needed to be use PropertyId as key in unordered_map
   bool operator==(PropertyId other) const {
-    // A PropertyId is equal to another if both their type_id and index are the same
-    return m_type_id == other.m_type_id && m_index == other.m_index;
+    // There is one slot per type_id
+    return m_type_slot == other.m_type_slot && m_index == other.m_index;
   }
 
   /// Less than operator needed to use PropertyId as key in a std::map
@@ -71,13 +75,23 @@ public:
     return m_index;
   }
 
+  /// Dense number identifying the type_id
+  unsigned int getTypeSlot() const {
+    return m_type_slot;
+  }
+
   std::string getString() const;
 
 private:
-  PropertyId(std::type_index type_id, unsigned int index) : m_type_id(type_id), m_index(index) {}
+  PropertyId(std::type_index type_id, unsigned int index, unsigned int type_slot)
+    : m_type_id(type_id), m_index(index), m_type_slot(type_slot) {}
+
+  /// Returns the slot assigned to the type_id, assigning a new one if needed
+  static unsigned int getTypeSlot(std::type_index type_id);
 
   std::type_index m_type_id;
   unsigned int m_index;
+  unsigned int m_type_slot;
 
 
   friend struct std::hash<SourceXtractor::PropertyId>;
@@ -93,10 +107,11 @@ template <>
 struct hash<SourceXtractor::PropertyId>
 {
   std::size_t operator()(const SourceXtractor::PropertyId& id) const {
-    std::size_t h = 0;
-    boost::hash_combine(h, id.m_type_id);
-    boost::hash_combine(h, id.m_index);
-    return h;
+    // Slots are unique per type, and cheaper to hash than the type_index
+    std::size_t hash = 0;
+    boost::hash_combine(hash, id.m_type_slot);
+    boost::hash_combine(hash, id.m_index);
+    return hash;
   }
 };
 
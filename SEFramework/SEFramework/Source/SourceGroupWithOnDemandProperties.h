@@ -35,6 +35,8 @@
 
 namespace SourceXtractor {
 
+class SourceWithOnDemandProperties;
+
 /**
  * @class SourceGroupWithOnDemandProperties
  * @brief A SourceGroupInterface implementation which used a TaskProvider to compute missing properties
@@ -111,6 +113,7 @@ private:
 
   PropertyHolder m_property_holder;
   std::shared_ptr<SourceInterface> m_source;
+  const SourceWithOnDemandProperties* m_on_demand_source;
   SourceGroupWithOnDemandProperties& m_group;
 
   friend void SourceGroupWithOnDemandProperties::clearGroupProperties();
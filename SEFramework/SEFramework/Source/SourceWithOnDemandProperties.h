@@ -65,6 +65,9 @@ public:
   // done by the using statements below.
   using SourceInterface::getProperty;
   using SourceInterface::setProperty;
+
+  /// Same as getProperty(), but returns nullptr instead of throwing if the property can not be provided
+  const Property* findProperty(const PropertyId& property_id) const;
   
 protected:
   
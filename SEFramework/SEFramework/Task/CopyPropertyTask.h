@@ -0,0 +1,75 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * CopyPropertyTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEFRAMEWORK_TASK_COPYPROPERTYTASK_H_
+#define _SEFRAMEWORK_TASK_COPYPROPERTYTASK_H_
+
+#include "SEFramework/Task/GroupTask.h"
+#include "SEFramework/Task/SourceTask.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class CopySourcePropertyTask
+ * @brief Sets an indexed property to a copy of the same property of another index
+ *
+ * @details
+ *  Used when two instances are known to give the same value, i.e. the planes of a data cube share
+ *  their coordinate system, so the geometry computed for the first plane holds for all of them.
+ */
+template <typename PropertyType>
+class CopySourcePropertyTask : public SourceTask {
+public:
+  CopySourcePropertyTask(unsigned int instance, unsigned int reference)
+    : m_instance(instance), m_reference(reference) {}
+
+  virtual ~CopySourcePropertyTask() = default;
+
+  void computeProperties(SourceInterface& source) const override {
+    source.setIndexedProperty<PropertyType>(m_instance, source.getProperty<PropertyType>(m_reference));
+  }
+
+private:
+  unsigned int m_instance, m_reference;
+};
+
+/// Same as CopySourcePropertyTask, for group properties
+template <typename PropertyType>
+class CopyGroupPropertyTask : public GroupTask {
+public:
+  CopyGroupPropertyTask(unsigned int instance, unsigned int reference)
+    : m_instance(instance), m_reference(reference) {}
+
+  virtual ~CopyGroupPropertyTask() = default;
+
+  void computeProperties(SourceGroupInterface& group) const override {
+    group.setIndexedProperty<PropertyType>(m_instance, group.getProperty<PropertyType>(m_reference));
+  }
+
+private:
+  unsigned int m_instance, m_reference;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEFRAMEWORK_TASK_COPYPROPERTYTASK_H_ */
@@ -0,0 +1,182 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * PropertyPlanner.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEFRAMEWORK_TASK_PROPERTYPLANNER_H_
+#define _SEFRAMEWORK_TASK_PROPERTYPLANNER_H_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <typeindex>
+#include <vector>
+
+#include "SEFramework/Property/PropertyId.h"
+#include "SEFramework/Source/SourceGroupInterface.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class PropertyPlanner
+ * @brief Builds the dependency graph between properties, and plans their computation
+ *
+ * @details
+ *  When recording is enabled, the on-demand sources report every request and every computation,
+ *  so the planner learns the dependency graph, and which properties the framework itself requests
+ *  (i.e. for the grouping, the deblending or the output). With the statistics enabled too, it also learns
+ *  how much time is spent on each property, excluding the time spent on its dependencies.
+ *  Each thread records into its own buffer, the shared graph is only locked when a thread finds
+ *  a dependency it did not know about.
+ *
+ *  The learnt graph includes the properties a task requests only under some conditions, so it is not
+ *  used for the plan. The plan starts from the catalog properties computed so far, and follows the
+ *  dependencies declared by the task factories (see TaskFactory::getRequiredProperties), which are requested
+ *  every time. execute() computes them for a whole group one property at a time, dependencies first,
+ *  so the image access of all the sources of a group is done together, before the expensive
+ *  measurements that depend on it. The properties requested only under some conditions are still
+ *  computed lazily by their tasks.
+ */
+class PropertyPlanner {
+public:
+
+  /// Properties the task computing a property requests every time
+  using RequiredProperties = std::function<std::set<PropertyId>(const PropertyId&)>;
+
+  struct PropertyStats {
+    /// Number of times the property has been computed
+    std::size_t m_computations;
+    /// Time spent computing the property, excluding its dependencies, in seconds
+    double m_self_time;
+    /// Time spent computing the property, including its dependencies, in seconds
+    double m_total_time;
+  };
+
+  /**
+   * Record the computation of a property on the calling thread.
+   * Nothing is done if the recording is disabled when the scope is created, and the time is not measured
+   * if the statistics are disabled.
+   */
+  class ComputeScope {
+  public:
+    explicit ComputeScope(const PropertyId& property_id);
+    ~ComputeScope();
+
+    ComputeScope(const ComputeScope&) = delete;
+    ComputeScope& operator=(const ComputeScope&) = delete;
+
+  private:
+    bool m_active, m_statistics;
+  };
+
+  static PropertyPlanner& getInstance();
+
+  virtual ~PropertyPlanner() = default;
+
+  static bool isRecording() {
+    return s_recording.load(std::memory_order_relaxed);
+  }
+
+  void setRecording(bool recording) {
+    s_recording = recording;
+  }
+
+  static bool isCollectingStatistics() {
+    return s_statistics.load(std::memory_order_relaxed);
+  }
+
+  /// Also count the computations of each property and the time spent on them, for the report
+  void setStatistics(bool statistics) {
+    s_statistics = statistics;
+  }
+
+  /// Register a request of the given property, from the property being computed on the calling thread,
+  /// or from the framework when no property is being computed
+  void recordRequest(const PropertyId& property_id);
+
+  /// Properties whose type is one of these are written to the catalog
+  void setOutputTypes(const std::set<std::type_index>& output_types);
+
+  /// Set where the declared dependencies come from, usually TaskFactoryRegistry::getRequiredProperties
+  void setRequiredProperties(RequiredProperties required_properties);
+
+  /// Catalog properties computed so far and their declared dependencies, with the dependencies first
+  std::shared_ptr<const std::vector<PropertyId>> getPlan() const;
+
+  /// Compute the planned properties for all the sources of the group
+  void execute(SourceGroupInterface& group) const;
+
+  std::map<PropertyId, PropertyStats> getStats() const;
+
+  std::set<PropertyId> getDependencies(const PropertyId& property_id) const;
+
+  /// Properties that have been computed, but are needed neither by the catalog nor by the framework
+  std::vector<PropertyId> getUnusedProperties() const;
+
+  /// Log the time spent on each property, and the properties that are not needed for the catalog
+  void logReport() const;
+
+  /// Forget the dependency graph and the statistics
+  void reset();
+
+private:
+  /// What a single thread has recorded
+  struct ThreadRecord {
+    std::mutex m_mutex;
+    std::map<PropertyId, std::set<PropertyId>> m_dependencies;
+    std::set<PropertyId> m_framework_requests;
+    std::map<PropertyId, PropertyStats> m_stats;
+  };
+
+  PropertyPlanner() : m_version(0), m_plan_version(0) {}
+
+  ThreadRecord& getThreadRecord();
+
+  void recordComputation(const PropertyId& property_id, const std::set<PropertyId>& dependencies,
+                         bool statistics, double self_time, double total_time);
+
+  void recordFrameworkRequest(const PropertyId& property_id);
+
+  static std::atomic<bool> s_recording;
+  static std::atomic<bool> s_statistics;
+
+  mutable std::mutex m_mutex;
+  /// Dependencies found by all the threads
+  std::map<PropertyId, std::set<PropertyId>> m_dependencies;
+  /// Properties requested from outside a task, other than by execute()
+  std::set<PropertyId> m_framework_requests;
+  std::vector<std::shared_ptr<ThreadRecord>> m_thread_records;
+  std::set<std::type_index> m_output_types;
+  RequiredProperties m_required_properties;
+
+  /// Incremented when the graph changes, so the plan is rebuilt
+  std::size_t m_version;
+  mutable std::size_t m_plan_version;
+  mutable std::shared_ptr<const std::vector<PropertyId>> m_plan;
+};
+
+} // namespace SourceXtractor
+
+#endif /* _SEFRAMEWORK_TASK_PROPERTYPLANNER_H_ */
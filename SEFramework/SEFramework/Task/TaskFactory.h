@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <memory>
+#include <set>
 
 #include "SEFramework/Property/PropertyId.h"
 #include "SEFramework/Task/Task.h"
@@ -48,6 +49,14 @@ public:
 
   /// Returns a Task producing a Property corresponding to the given PropertyId
   virtual std::shared_ptr<Task> createTask(const PropertyId& property_id) const = 0;
+
+  /**
+   * Properties the task computing the given property requests every time it runs, so they can be
+   * computed ahead of it. The ones requested only under some conditions must not be listed.
+   */
+  virtual std::set<PropertyId> getRequiredProperties(const PropertyId&) const {
+    return {};
+  }
   
   // Provides a default implementation of the Configurable interface that does nothing
   void reportConfigDependencies(Euclid::Configuration::ConfigManager&) const override {}
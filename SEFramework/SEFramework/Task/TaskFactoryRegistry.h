@@ -25,11 +25,13 @@
 #define _SEFRAMEWORK_TASK_TASKFACTORYREGISTRY_H_
 
 #include <memory>
+#include <set>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "SEFramework/Configuration/Configurable.h"
+#include "SEFramework/Property/PropertyId.h"
 
 namespace SourceXtractor {
 
@@ -60,6 +62,9 @@ public:
     return *m_type_task_factories_map.at(type_id);
   }
 
+  /// Properties declared as always required by the factory of the given property, if any
+  std::set<PropertyId> getRequiredProperties(const PropertyId& property_id) const;
+
   // Configurable interface
   void reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const override;
   void configure(Euclid::Configuration::ConfigManager& manager) override;
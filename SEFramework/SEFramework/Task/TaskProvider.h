@@ -23,8 +23,11 @@
 #ifndef _SEFRAMEWORK_TASK_TASKPROVIDER_H
 #define _SEFRAMEWORK_TASK_TASKPROVIDER_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "ElementsKernel/Exception.h"
 
@@ -38,16 +41,19 @@ namespace SourceXtractor {
  * @class TaskProvider
  * @brief
  *
+ * @details
+ *  Tasks are created on demand and cached. Lookups are done on an immutable table without locking.
+ *  A new task is created with the lock held, and remembered by the calling thread; the table is re-published
+ *  including the new tasks every time their number doubles, so after a few sources all lookups are lock-free.
  */
 class TaskProvider {
 
 public:
 
-  /// Destructor
-  virtual ~TaskProvider() = default;
+  /// Destructor. The threads drop the tasks they remember of this provider on their next lookup
+  virtual ~TaskProvider();
 
-  explicit TaskProvider(std::shared_ptr<TaskFactoryRegistry> task_factory_registry)
-    : m_task_factory_registry(task_factory_registry) {}
+  explicit TaskProvider(std::shared_ptr<TaskFactoryRegistry> task_factory_registry);
 
   /// Template version of getTask() that includes casting the returned pointer to the appropriate type
   template<class T>
@@ -59,8 +65,23 @@ protected:
   virtual std::shared_ptr<const Task> getTask(const PropertyId& property_id) const;
 
 private:
+  using TaskMap = std::unordered_map<PropertyId, std::shared_ptr<Task>>;
+
+  std::shared_ptr<const Task> getTaskLocked(const PropertyId& property_id) const;
+
   std::shared_ptr<TaskFactoryRegistry> m_task_factory_registry;
-  std::unordered_map<PropertyId, std::shared_ptr<Task>> m_tasks;
+
+  /// Identifies this provider on the per-thread caches
+  std::size_t m_serial;
+
+  /// All the tasks created so far, protected by m_tasks_mutex
+  mutable TaskMap m_tasks;
+  mutable std::mutex m_tasks_mutex;
+
+  /// Last published table. It is never modified, so it can be read without the lock
+  mutable std::atomic<const TaskMap*> m_published;
+  /// Published tables are kept alive, as a reader may still be using an older one
+  mutable std::vector<std::unique_ptr<const TaskMap>> m_published_tables;
 
 }; /* End of TaskProvider class */
 
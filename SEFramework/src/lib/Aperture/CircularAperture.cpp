@@ -22,6 +22,7 @@
  */
 #include <iostream>
 #include "SEFramework/Aperture/CircularAperture.h"
+#include "SEFramework/Aperture/ExactOverlap.h"
 
 namespace SourceXtractor {
 
@@ -31,6 +32,11 @@ const int SUPERSAMPLE_NB = 10;
 SeFloat CircularAperture::getArea(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const {
   auto dx = pixel_x - center_x;
   auto dy = pixel_y - center_y;
+
+  if (m_overlap == ApertureOverlap::EXACT) {
+    return circularOverlap(dx - .5, dy - .5, dx + .5, dy + .5, m_radius);
+  }
+
   SeFloat min_supersampled_radius_squared = m_radius > .75 ? (m_radius - .75) * (m_radius - .75) : 0;
   SeFloat max_supersampled_radius_squared = (m_radius + .75) * (m_radius + .75);
 
@@ -54,6 +60,25 @@ SeFloat CircularAperture::getArea(SeFloat center_x, SeFloat center_y, SeFloat pi
   return area;
 }
 
+void CircularAperture::getAreaRow(SeFloat center_x, SeFloat center_y, int pixel_y, int min_x, int max_x,
+                                  SeFloat *areas) const {
+  if (m_overlap != ApertureOverlap::EXACT) {
+    Aperture::getAreaRow(center_x, center_y, pixel_y, min_x, max_x, areas);
+    return;
+  }
+  circularOverlapRow(min_x - center_x, pixel_y - center_y, max_x - min_x + 1, m_radius, areas);
+}
+
+bool CircularAperture::getExactEllipse(SeFloat& cxx, SeFloat& cyy, SeFloat& cxy, SeFloat& rad) const {
+  if (m_overlap != ApertureOverlap::EXACT) {
+    return false;
+  }
+  cxx = cyy = 1.;
+  cxy = 0.;
+  rad = m_radius;
+  return true;
+}
+
 SeFloat CircularAperture::drawArea(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const {
 	SeFloat thickness = 0.5;
 
@@ -22,16 +22,22 @@
  */
 
 #include "SEFramework/Aperture/EllipticalAperture.h"
+#include "SEFramework/Aperture/ExactOverlap.h"
 #include <iostream>
 namespace SourceXtractor {
 
 
 EllipticalAperture::EllipticalAperture(SeFloat cxx, SeFloat cyy, SeFloat cxy,
-                                       SeFloat rad_max)
-  : m_cxx{cxx}, m_cyy{cyy}, m_cxy{cxy}, m_rad_max{rad_max} {
+                                       SeFloat rad_max, ApertureOverlap overlap)
+  : m_cxx{cxx}, m_cyy{cyy}, m_cxy{cxy}, m_rad_max{rad_max}, m_overlap{overlap} {
 }
 
   SeFloat EllipticalAperture::getArea(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const {
+    if (m_overlap == ApertureOverlap::EXACT) {
+      auto dx = pixel_x - center_x;
+      auto dy = pixel_y - center_y;
+      return ellipticalOverlap(dx - .5, dy - .5, dx + .5, dy + .5, m_cxx, m_cyy, m_cxy, m_rad_max);
+    }
   	if (getRadiusSquared(center_x, center_y, pixel_x, pixel_y) < m_rad_max * m_rad_max) {
 
   		return 1.0;
@@ -62,6 +68,27 @@ EllipticalAperture::EllipticalAperture(SeFloat cxx, SeFloat cyy, SeFloat cxy,
 	  return 0.;
   }
 
+void EllipticalAperture::getAreaRow(SeFloat center_x, SeFloat center_y, int pixel_y, int min_x, int max_x,
+                                    SeFloat *areas) const {
+  if (m_overlap != ApertureOverlap::EXACT) {
+    Aperture::getAreaRow(center_x, center_y, pixel_y, min_x, max_x, areas);
+    return;
+  }
+  ellipticalOverlapRow(min_x - center_x, pixel_y - center_y, max_x - min_x + 1,
+                       m_cxx, m_cyy, m_cxy, m_rad_max, areas);
+}
+
+bool EllipticalAperture::getExactEllipse(SeFloat& cxx, SeFloat& cyy, SeFloat& cxy, SeFloat& rad) const {
+  if (m_overlap != ApertureOverlap::EXACT) {
+    return false;
+  }
+  cxx = m_cxx;
+  cyy = m_cyy;
+  cxy = m_cxy;
+  rad = m_rad_max;
+  return true;
+}
+
 SeFloat EllipticalAperture::getRadiusSquared(SeFloat center_x, SeFloat center_y, SeFloat pixel_x,
                                              SeFloat pixel_y) const {
   auto dist_x = SeFloat(pixel_x) - center_x;
@@ -0,0 +1,243 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ExactOverlap.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "SEFramework/Aperture/ExactOverlap.h"
+
+namespace SourceXtractor {
+
+namespace {
+
+/**
+ * Area of the circle of radius r inside [0, x] x [0, y], for x, y >= 0
+ */
+double circularQuadrantArea(double x, double y, double r) {
+  double r2 = r * r;
+  x = std::min(x, r);
+  y = std::min(y, r);
+  if (x * x + y * y <= r2) {
+    return x * y;
+  }
+  // Abscissa where the arc crosses the horizontal y; from there the area is bounded by the arc
+  double x0 = std::sqrt(std::max(r2 - y * y, 0.));
+  auto primitive = [r, r2](double u) {
+    return 0.5 * (u * std::sqrt(std::max(r2 - u * u, 0.)) + r2 * std::asin(std::min(u / r, 1.)));
+  };
+  return y * x0 + primitive(x) - primitive(x0);
+}
+
+/**
+ * Signed area of the circle of radius r inside the rectangle spanned by the origin and (x, y).
+ * The area of any rectangle follows from inclusion-exclusion of its four corners.
+ */
+double circularCumulative(double x, double y, double r) {
+  double area = circularQuadrantArea(std::abs(x), std::abs(y), r);
+  return ((x < 0) != (y < 0)) ? -area : area;
+}
+
+/**
+ * Signed area of the intersection between the unit circle and the triangle (origin, a, b)
+ */
+double sectorArea(double ax, double ay, double bx, double by) {
+  return 0.5 * std::atan2(ax * by - ay * bx, ax * bx + ay * by);
+}
+
+double segmentArea(double ax, double ay, double bx, double by) {
+  double dx = bx - ax, dy = by - ay;
+  double a = dx * dx + dy * dy;
+  if (a == 0) {
+    return 0.;
+  }
+  double b = ax * dx + ay * dy;
+  double c = ax * ax + ay * ay - 1.;
+  double disc = b * b - a * c;
+  if (disc <= 0) {
+    return sectorArea(ax, ay, bx, by);
+  }
+  double s = std::sqrt(disc);
+  double t1 = (-b - s) / a, t2 = (-b + s) / a;
+  if (t2 <= 0 || t1 >= 1) {
+    return sectorArea(ax, ay, bx, by);
+  }
+  t1 = std::max(t1, 0.);
+  t2 = std::min(t2, 1.);
+  double p1x = ax + t1 * dx, p1y = ay + t1 * dy;
+  double p2x = ax + t2 * dx, p2y = ay + t2 * dy;
+  return sectorArea(ax, ay, p1x, p1y) + 0.5 * (p1x * p2y - p1y * p2x) + sectorArea(p2x, p2y, bx, by);
+}
+
+/**
+ * Upper triangular factor L of the quadratic form (cxx, cxy/2; cxy/2, cyy) = L^T L, so the ellipse
+ * becomes the unit circle under u = L * x / r
+ */
+bool ellipseFactor(double cxx, double cyy, double cxy, double& l00, double& l01, double& l11) {
+  if (cxx <= 0) {
+    return false;
+  }
+  l00 = std::sqrt(cxx);
+  l01 = cxy / (2 * l00);
+  double d = cyy - l01 * l01;
+  if (d <= 0) {
+    return false;
+  }
+  l11 = std::sqrt(d);
+  return true;
+}
+
+double ellipticalOverlapFactored(double xmin, double ymin, double xmax, double ymax,
+                                 double cxx, double cyy, double cxy, double r,
+                                 double l00, double l01, double l11) {
+  double r2 = r * r;
+  auto q = [cxx, cyy, cxy](double x, double y) {
+    return cxx * x * x + cyy * y * y + cxy * x * y;
+  };
+
+  // Convex: if all corners are inside, so is the rectangle
+  if (q(xmin, ymin) <= r2 && q(xmax, ymin) <= r2 && q(xmin, ymax) <= r2 && q(xmax, ymax) <= r2) {
+    return (xmax - xmin) * (ymax - ymin);
+  }
+
+  // Quick rejection using the bounding box of the ellipse
+  double ext_x = r * std::sqrt(l01 * l01 + l11 * l11) / (l00 * l11);
+  double ext_y = r / l11;
+  if (xmin >= ext_x || xmax <= -ext_x || ymin >= ext_y || ymax <= -ext_y) {
+    return 0.;
+  }
+
+  // Map the corners into the space where the ellipse is the unit circle, and integrate
+  // the (counter-clockwise) polygon edge by edge
+  double inv_r = 1. / r;
+  double cx[4] = {xmin, xmax, xmax, xmin};
+  double cy[4] = {ymin, ymin, ymax, ymax};
+  double ux[4], uy[4];
+  for (int i = 0; i < 4; ++i) {
+    ux[i] = (l00 * cx[i] + l01 * cy[i]) * inv_r;
+    uy[i] = l11 * cy[i] * inv_r;
+  }
+  double area = 0;
+  for (int i = 0; i < 4; ++i) {
+    int j = (i + 1) % 4;
+    area += segmentArea(ux[i], uy[i], ux[j], uy[j]);
+  }
+
+  // Undo the scaling introduced by the transformation
+  return std::max(area, 0.) * r2 / (l00 * l11);
+}
+
+} // end anonymous namespace
+
+double circularOverlap(double xmin, double ymin, double xmax, double ymax, double r) {
+  if (r <= 0) {
+    return 0.;
+  }
+  double r2 = r * r;
+
+  // Farthest corner inside: full coverage
+  double fx = std::max(std::abs(xmin), std::abs(xmax));
+  double fy = std::max(std::abs(ymin), std::abs(ymax));
+  if (fx * fx + fy * fy <= r2) {
+    return (xmax - xmin) * (ymax - ymin);
+  }
+
+  // Nearest point outside: no coverage
+  double nx = (xmin > 0) ? xmin : ((xmax < 0) ? -xmax : 0.);
+  double ny = (ymin > 0) ? ymin : ((ymax < 0) ? -ymax : 0.);
+  if (nx * nx + ny * ny >= r2) {
+    return 0.;
+  }
+
+  return circularCumulative(xmax, ymax, r) - circularCumulative(xmin, ymax, r)
+         - circularCumulative(xmax, ymin, r) + circularCumulative(xmin, ymin, r);
+}
+
+void circularOverlapRow(double x0, double y, int n, double r, SeFloat *areas) {
+  double ymin = y - 0.5, ymax = y + 0.5;
+  double r2 = r * r;
+
+  if (r <= 0) {
+    std::fill(areas, areas + n, 0.);
+    return;
+  }
+
+  double fy = std::max(std::abs(ymin), std::abs(ymax));
+  double ny = (ymin > 0) ? ymin : ((ymax < 0) ? -ymax : 0.);
+
+  // The cumulative values on the left edge of the pixel are those of the right edge of the previous one,
+  // so they are kept while consecutive pixels need the exact computation
+  bool have_left = false;
+  double left_top = 0, left_bottom = 0;
+
+  for (int i = 0; i < n; ++i) {
+    double xmin = x0 + i - 0.5, xmax = xmin + 1.;
+
+    double fx = std::max(std::abs(xmin), std::abs(xmax));
+    if (fx * fx + fy * fy <= r2) {
+      areas[i] = 1.;
+      have_left = false;
+      continue;
+    }
+    double nx = (xmin > 0) ? xmin : ((xmax < 0) ? -xmax : 0.);
+    if (nx * nx + ny * ny >= r2) {
+      areas[i] = 0.;
+      have_left = false;
+      continue;
+    }
+
+    if (!have_left) {
+      left_top = circularCumulative(xmin, ymax, r);
+      left_bottom = circularCumulative(xmin, ymin, r);
+    }
+    double right_top = circularCumulative(xmax, ymax, r);
+    double right_bottom = circularCumulative(xmax, ymin, r);
+
+    areas[i] = std::min(std::max(right_top - left_top - right_bottom + left_bottom, 0.), 1.);
+
+    left_top = right_top;
+    left_bottom = right_bottom;
+    have_left = true;
+  }
+}
+
+double ellipticalOverlap(double xmin, double ymin, double xmax, double ymax,
+                         double cxx, double cyy, double cxy, double r) {
+  double l00, l01, l11;
+  if (r <= 0 || !ellipseFactor(cxx, cyy, cxy, l00, l01, l11)) {
+    return 0.;
+  }
+  return ellipticalOverlapFactored(xmin, ymin, xmax, ymax, cxx, cyy, cxy, r, l00, l01, l11);
+}
+
+void ellipticalOverlapRow(double x0, double y, int n, double cxx, double cyy, double cxy, double r, SeFloat *areas) {
+  double l00, l01, l11;
+  if (r <= 0 || !ellipseFactor(cxx, cyy, cxy, l00, l01, l11)) {
+    std::fill(areas, areas + n, 0.);
+    return;
+  }
+  for (int i = 0; i < n; ++i) {
+    double xmin = x0 + i - 0.5;
+    areas[i] = std::min(
+      ellipticalOverlapFactored(xmin, y - 0.5, xmin + 1., y + 0.5, cxx, cyy, cxy, r, l00, l01, l11), 1.);
+  }
+}
+
+} // end SourceXtractor
@@ -23,6 +23,7 @@
 
 #include "SEFramework/Aperture/FluxMeasurement.h"
 #include "SEFramework/Image/ImageChunk.h"
+#include <vector>
 
 namespace SourceXtractor {
 
@@ -74,15 +75,18 @@ FluxMeasurement measureFlux(const std::shared_ptr<Aperture> &aperture, SeFloat c
   auto img_cutout = img->getChunk(min_pixel, max_pixel);
   auto var_cutout = variance_map->getChunk(min_pixel, max_pixel);
 
-  // iterate over the aperture pixels
+  // iterate over the aperture pixels, computing the area coverage a full row at a time
+  std::vector<SeFloat> areas(img_cutout->getWidth());
   for (int pixel_y = 0; pixel_y < img_cutout->getHeight(); pixel_y++) {
+    aperture->getAreaRow(centroid_x, centroid_y, min_pixel.m_y + pixel_y,
+                         min_pixel.m_x, min_pixel.m_x + img_cutout->getWidth() - 1, areas.data());
+
     for (int pixel_x = 0; pixel_x < img_cutout->getWidth(); pixel_x++) {
       SeFloat pixel_value = 0;
       SeFloat pixel_variance = 0;
 
-      // get the area coverage and continue if there is overlap
-      auto area = aperture->getArea(centroid_x, centroid_y, min_pixel.m_x + pixel_x,
-                                    min_pixel.m_y + pixel_y);
+      // continue if there is no overlap
+      auto area = areas[pixel_x];
       if (area == 0) {
         continue;
       }
@@ -22,13 +22,14 @@
  */
 
 #include "SEFramework/Aperture/TransformedAperture.h"
+#include "SEFramework/Aperture/ExactOverlap.h"
 #include <algorithm>
 
 namespace SourceXtractor {
 
 TransformedAperture::TransformedAperture(std::shared_ptr<Aperture> decorated,
                                          const std::tuple<double, double, double, double> &jacobian)
-  : m_decorated{decorated} {
+  : m_decorated{decorated}, m_exact{false}, m_cxx{0}, m_cyy{0}, m_cxy{0}, m_rad{0} {
 
   m_transform[0] = std::get<0>(jacobian);
   m_transform[1] = std::get<1>(jacobian);
@@ -41,6 +42,17 @@ TransformedAperture::TransformedAperture(std::shared_ptr<Aperture> decorated,
   m_inv_transform[1] = -m_transform[1] * inv_det;
   m_inv_transform[2] = -m_transform[2] * inv_det;
   m_inv_transform[3] = m_transform[0] * inv_det;
+
+  // The decorated ellipse is evaluated on T^-1 * d, so the quadratic form becomes T^-T * Q * T^-1
+  SeFloat cxx, cyy, cxy;
+  m_exact = m_decorated->getExactEllipse(cxx, cyy, cxy, m_rad);
+  if (m_exact) {
+    double a = m_inv_transform[0], b = m_inv_transform[2], c = m_inv_transform[1], d = m_inv_transform[3];
+    double q01 = cxy / 2.;
+    m_cxx = cxx * a * a + 2 * q01 * a * c + cyy * c * c;
+    m_cyy = cxx * b * b + 2 * q01 * b * d + cyy * d * d;
+    m_cxy = 2 * (cxx * a * b + q01 * (a * d + b * c) + cyy * c * d);
+  }
 }
 
 inline std::pair<double, double> transform(int x, int y, const std::array<double, 4> &t) {
@@ -84,12 +96,36 @@ SeFloat TransformedAperture::getArea(SeFloat center_x, SeFloat center_y, SeFloat
   auto diff_x = pixel_x - center_x;
   auto diff_y = pixel_y - center_y;
 
+  if (m_exact) {
+    return ellipticalOverlap(diff_x - .5, diff_y - .5, diff_x + .5, diff_y + .5, m_cxx, m_cyy, m_cxy, m_rad);
+  }
+
   SeFloat new_diff_x = diff_x * m_inv_transform[0] + diff_y * m_inv_transform[2];
   SeFloat new_diff_y = diff_x * m_inv_transform[1] + diff_y * m_inv_transform[3];
 
   return m_decorated->getArea(0, 0, new_diff_x, new_diff_y);
 }
 
+void TransformedAperture::getAreaRow(SeFloat center_x, SeFloat center_y, int pixel_y, int min_x, int max_x,
+                                     SeFloat *areas) const {
+  if (!m_exact) {
+    Aperture::getAreaRow(center_x, center_y, pixel_y, min_x, max_x, areas);
+    return;
+  }
+  ellipticalOverlapRow(min_x - center_x, pixel_y - center_y, max_x - min_x + 1, m_cxx, m_cyy, m_cxy, m_rad, areas);
+}
+
+bool TransformedAperture::getExactEllipse(SeFloat& cxx, SeFloat& cyy, SeFloat& cxy, SeFloat& rad) const {
+  if (!m_exact) {
+    return false;
+  }
+  cxx = m_cxx;
+  cyy = m_cyy;
+  cxy = m_cxy;
+  rad = m_rad;
+  return true;
+}
+
 SeFloat TransformedAperture::drawArea(SeFloat center_x, SeFloat center_y, SeFloat pixel_x, SeFloat pixel_y) const {
   auto diff_x = pixel_x - center_x;
   auto diff_y = pixel_y - center_y;
@@ -0,0 +1,99 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * LocalAffineMapping.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "SEFramework/CoordinateSystem/LocalAffineMapping.h"
+
+namespace SourceXtractor {
+
+LocalAffineMapping::LocalAffineMapping(const CoordinateSystem& from, const CoordinateSystem& to,
+                                       double min_x, double min_y, double max_x, double max_y, double tolerance)
+  : m_center_x{(min_x + max_x) / 2.}, m_center_y{(min_y + max_y) / 2.},
+    m_x0{0}, m_xx{1}, m_xy{0}, m_y0{0}, m_yx{0}, m_yy{1},
+    m_max_residual{0}, m_valid{false} {
+
+  double half_w = (max_x - min_x) / 2., half_h = (max_y - min_y) / 2.;
+
+  auto exact = [&from, &to](double x, double y) {
+    return to.worldToImage(from.imageToWorld(ImageCoordinate(x, y)));
+  };
+
+  try {
+    // Evaluate on a symmetric 3x3 grid: the least squares fit decouples into means and
+    // first moments along each axis
+    ImageCoordinate grid[3][3];
+    double sum_x = 0, sum_y = 0;
+    double mom_xx = 0, mom_xy = 0, mom_yx = 0, mom_yy = 0;
+    for (int j = -1; j <= 1; ++j) {
+      for (int i = -1; i <= 1; ++i) {
+        auto c = exact(m_center_x + i * half_w, m_center_y + j * half_h);
+        grid[j + 1][i + 1] = c;
+        sum_x += c.m_x;
+        sum_y += c.m_y;
+        mom_xx += i * half_w * c.m_x;
+        mom_xy += j * half_h * c.m_x;
+        mom_yx += i * half_w * c.m_y;
+        mom_yy += j * half_h * c.m_y;
+      }
+    }
+
+    m_x0 = sum_x / 9.;
+    m_y0 = sum_y / 9.;
+    // Each axis has six points at +-half, so the second moment is 6 * half^2
+    if (half_w > 0) {
+      m_xx = mom_xx / (6. * half_w * half_w);
+      m_yx = mom_yx / (6. * half_w * half_w);
+    }
+    if (half_h > 0) {
+      m_xy = mom_xy / (6. * half_h * half_h);
+      m_yy = mom_yy / (6. * half_h * half_h);
+    }
+
+    auto residual = [this](double x, double y, const ImageCoordinate& c) {
+      auto approx = (*this)(x, y);
+      return std::max(std::abs(approx.m_x - c.m_x), std::abs(approx.m_y - c.m_y));
+    };
+
+    for (int j = -1; j <= 1; ++j) {
+      for (int i = -1; i <= 1; ++i) {
+        m_max_residual = std::max(m_max_residual,
+                                  residual(m_center_x + i * half_w, m_center_y + j * half_h, grid[j + 1][i + 1]));
+      }
+    }
+
+    // Independent validation points, not used for the fit
+    for (int j = -1; j <= 1; j += 2) {
+      for (int i = -1; i <= 1; i += 2) {
+        double x = m_center_x + i * half_w / 2., y = m_center_y + j * half_h / 2.;
+        m_max_residual = std::max(m_max_residual, residual(x, y, exact(x, y)));
+      }
+    }
+
+    m_valid = std::isfinite(m_max_residual) && m_max_residual <= tolerance;
+  }
+  catch (const InvalidCoordinatesException&) {
+    m_valid = false;
+  }
+}
+
+} // namespace SourceXtractor
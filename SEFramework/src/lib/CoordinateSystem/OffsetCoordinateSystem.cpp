@@ -0,0 +1,83 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * OffsetCoordinateSystem.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iomanip>
+#include <sstream>
+
+#include "SEFramework/CoordinateSystem/OffsetCoordinateSystem.h"
+
+namespace SourceXtractor {
+
+namespace {
+
+// Shift the value of a header card, keeping its comment
+void shiftHeaderValue(std::map<std::string, std::string>& headers, const std::string& key, double shift) {
+  auto i = headers.find(key);
+  if (i == headers.end()) {
+    return;
+  }
+  auto comment = i->second.find('/');
+  std::ostringstream value;
+  value << std::setprecision(17) << std::stod(i->second) + shift;
+  if (comment != std::string::npos) {
+    value << " " << i->second.substr(comment);
+  }
+  i->second = value.str();
+}
+
+}
+
+OffsetCoordinateSystem::OffsetCoordinateSystem(std::shared_ptr<CoordinateSystem> coordinate_system,
+                                               const PixelCoordinate& offset)
+  : m_coordinate_system(std::move(coordinate_system)), m_offset(offset) {}
+
+WorldCoordinate OffsetCoordinateSystem::imageToWorld(ImageCoordinate image_coordinate) const {
+  if (!m_coordinate_system) {
+    throw InvalidCoordinatesException();
+  }
+  return m_coordinate_system->imageToWorld(
+      ImageCoordinate(image_coordinate.m_x + m_offset.m_x, image_coordinate.m_y + m_offset.m_y));
+}
+
+ImageCoordinate OffsetCoordinateSystem::worldToImage(WorldCoordinate world_coordinate) const {
+  if (!m_coordinate_system) {
+    throw InvalidCoordinatesException();
+  }
+  auto image_coordinate = m_coordinate_system->worldToImage(world_coordinate);
+  return ImageCoordinate(image_coordinate.m_x - m_offset.m_x, image_coordinate.m_y - m_offset.m_y);
+}
+
+std::map<std::string, std::string> OffsetCoordinateSystem::getFitsHeaders() const {
+  std::map<std::string, std::string> headers;
+  if (m_coordinate_system) {
+    headers = m_coordinate_system->getFitsHeaders();
+  }
+  shiftHeaderValue(headers, "CRPIX1", -m_offset.m_x);
+  shiftHeaderValue(headers, "CRPIX2", -m_offset.m_y);
+
+  // Physical = image - LTV
+  headers["LTV1"] = std::to_string(-m_offset.m_x);
+  headers["LTV2"] = std::to_string(-m_offset.m_y);
+  return headers;
+}
+
+}  // namespace SourceXtractor
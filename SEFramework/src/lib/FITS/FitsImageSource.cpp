@@ -27,11 +27,17 @@
 #include "SEUtils/VariantCast.h"
 #include <AlexandriaKernel/memory_tools.h>
 #include <ElementsKernel/Exception.h>
+#include <ElementsKernel/Logging.h>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/endian/conversion.hpp>
 #include <boost/regex.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <numeric>
@@ -41,6 +47,10 @@ namespace SourceXtractor {
 
 using Euclid::make_unique;
 
+static Elements::Logging logger = Elements::Logging::getLogger("FitsImageSource");
+
+std::atomic<bool> FitsImageSource::s_memory_mapping{false};
+
 namespace {
 
 ImageTile::ImageType convertImageType(int bitpix) {
@@ -69,6 +79,95 @@ ImageTile::ImageType convertImageType(int bitpix) {
   return image_type;
 }
 
+template <std::size_t N>
+struct RawType;
+
+template <>
+struct RawType<1> { using type = std::uint8_t; };
+
+template <>
+struct RawType<2> { using type = std::uint16_t; };
+
+template <>
+struct RawType<4> { using type = std::uint32_t; };
+
+template <>
+struct RawType<8> { using type = std::uint64_t; };
+
+template <typename S>
+S readBigEndian(const unsigned char* ptr) {
+  typename RawType<sizeof(S)>::type raw;
+  std::memcpy(&raw, ptr, sizeof(S));
+  raw = boost::endian::big_to_native(raw);
+  S value;
+  std::memcpy(&value, &raw, sizeof(S));
+  return value;
+}
+
+template <typename S, typename T>
+void decodeRow(const unsigned char* src, T* dst, int n) {
+  for (int i = 0; i < n; ++i) {
+    dst[i] = static_cast<T>(readBigEndian<S>(src + i * sizeof(S)));
+  }
+}
+
+template <typename T>
+void decodeRow(int bitpix, const unsigned char* src, T* dst, int n) {
+  switch (bitpix) {
+  case BYTE_IMG:
+    decodeRow<std::uint8_t>(src, dst, n);
+    break;
+  case SHORT_IMG:
+    decodeRow<std::int16_t>(src, dst, n);
+    break;
+  case LONG_IMG:
+    decodeRow<std::int32_t>(src, dst, n);
+    break;
+  case LONGLONG_IMG:
+    decodeRow<std::int64_t>(src, dst, n);
+    break;
+  case FLOAT_IMG:
+    decodeRow<float>(src, dst, n);
+    break;
+  case DOUBLE_IMG:
+    decodeRow<double>(src, dst, n);
+    break;
+  default:
+    throw Elements::Exception() << "Unsupported FITS image type: " << bitpix;
+  }
+}
+
+template <typename T>
+void decodeTile(const unsigned char* data, int bitpix, long long first_pixel, int row_stride, ImageTile& tile) {
+  auto dst = static_cast<T*>(tile.getDataPtr());
+  int width = tile.getWidth();
+  int height = tile.getHeight();
+  long long pixel_size = std::abs(bitpix) / 8;
+  for (int j = 0; j < height; ++j) {
+    decodeRow(bitpix, data + (first_pixel + static_cast<long long>(j) * row_stride) * pixel_size,
+              dst + static_cast<long long>(j) * width, width);
+  }
+}
+
+/**
+ * Conversions that may overflow the destination type are left to cfitsio, which clamps the values
+ */
+bool isSafeConversion(int bitpix, ImageTile::ImageType image_type) {
+  switch (image_type) {
+  case ImageTile::FloatImage:
+  case ImageTile::DoubleImage:
+    return true;
+  case ImageTile::IntImage:
+    return bitpix == BYTE_IMG || bitpix == SHORT_IMG || bitpix == LONG_IMG;
+  case ImageTile::UIntImage:
+    return bitpix == BYTE_IMG;
+  case ImageTile::LongLongImage:
+    return bitpix > 0;
+  default:
+    return false;
+  }
+}
+
 }
 
 FitsImageSource::FitsImageSource(const std::string& filename, int hdu_number,
@@ -77,7 +176,12 @@ FitsImageSource::FitsImageSource(const std::string& filename, int hdu_number,
     : m_filename(filename)
     , m_file_manager(std::move(manager))
     , m_handler(m_file_manager->getFileHandler(filename))
-    , m_hdu_number(hdu_number) {
+    , m_hdu_number(hdu_number)
+    , m_current_layer(0)
+    , m_mappable(false)
+    , m_bitpix(0)
+    , m_data_offset(0)
+    , m_mapped(std::make_shared<MappedData>()) {
   int status = 0;
   int bitpix, naxis;
   long naxes[3] = {1, 1, 1};
@@ -113,6 +217,9 @@ FitsImageSource::FitsImageSource(const std::string& filename, int hdu_number,
   else {
     m_image_type = image_type;
   }
+
+  m_bitpix = bitpix;
+  checkMappable(fptr);
 }
 
 FitsImageSource::FitsImageSource(const std::string& filename, int width, int height, ImageTile::ImageType image_type,
@@ -123,7 +230,13 @@ FitsImageSource::FitsImageSource(const std::string& filename, int width, int hei
     , m_handler(m_file_manager->getFileHandler(filename))
     , m_width(width)
     , m_height(height)
-    , m_image_type(image_type) {
+    , m_depth(1)
+    , m_image_type(image_type)
+    , m_current_layer(0)
+    , m_mappable(false)
+    , m_bitpix(0)
+    , m_data_offset(0)
+    , m_mapped(std::make_shared<MappedData>()) {
 
   int status = 0;
   fitsfile* fptr = nullptr;
@@ -181,11 +294,11 @@ FitsImageSource::FitsImageSource(const std::string& filename, int width, int hei
       }
     }
 
-    std::vector<char> buffer(width * ImageTile::getTypeSize(image_type));
-    for (int i = 0; i < height; i++) {
-      long first_pixel[2] = {1, i + 1};
-      fits_write_pix(fptr, getDataType(), first_pixel, width, &buffer[0], &status);
-    }
+    // cfitsio fills with zeros the gap between the end of file and the first written record,
+    // so writing the last pixel is enough to allocate the whole data unit
+    std::vector<char> buffer(ImageTile::getTypeSize(image_type));
+    long last_pixel[2] = {width, height};
+    fits_write_pix(fptr, getDataType(), last_pixel, 1, &buffer[0], &status);
 
     if (status != 0) {
       char error_message[32];
@@ -207,6 +320,13 @@ FitsImageSource::FitsImageSource(const std::string& filename, int width, int hei
 }
 
 std::shared_ptr<ImageTile> FitsImageSource::getImageTile(int x, int y, int width, int height) const {
+  if (isMemoryMapped()) {
+    auto tile = ImageTile::create(m_image_type, x, y, width, height,
+                                  std::const_pointer_cast<ImageSource>(shared_from_this()));
+    readMappedTile(*tile);
+    return tile;
+  }
+
   auto acc  = m_handler->getAccessor<FitsFile>();
   auto fptr = acc->m_fd.getFitsFilePtr();
   switchHdu(fptr, m_hdu_number);
@@ -232,6 +352,8 @@ std::shared_ptr<ImageTile> FitsImageSource::getImageTile(int x, int y, int width
 }
 
 void FitsImageSource::saveTile(ImageTile& tile) {
+  m_mappable = false;
+
   auto acc  = m_handler->getAccessor<FitsFile>(FileHandler::kWrite);
   auto fptr = acc->m_fd.getFitsFilePtr();
   switchHdu(fptr, m_hdu_number);
@@ -252,7 +374,107 @@ void FitsImageSource::saveTile(ImageTile& tile) {
     throw Elements::Exception() << "Error saving image tile to FITS file."
         << " status: " << status << " = " << error_message;
   }
+}
+
+void FitsImageSource::flush() {
+  auto acc  = m_handler->getAccessor<FitsFile>(FileHandler::kWrite);
+  auto fptr = acc->m_fd.getFitsFilePtr();
+
+  int status = 0;
   fits_flush_buffer(fptr, 0, &status);
+  if (status != 0) {
+    char error_message[32];
+    fits_get_errstatus(status, error_message);
+    throw Elements::Exception() << "Error flushing FITS file " << m_filename
+        << " status: " << status << " = " << error_message;
+  }
+}
+
+bool FitsImageSource::isMemoryMapped() const {
+  if (!s_memory_mapping || !m_mappable) {
+    return false;
+  }
+  std::call_once(m_mapped->m_flag, [this]() {
+    long long size = static_cast<long long>(m_width) * m_height * m_depth * (std::abs(m_bitpix) / 8);
+    try {
+      m_mapped->m_map = make_unique<FitsMemoryMap>(m_root_path, m_data_offset, size);
+    }
+    catch (const Elements::Exception& e) {
+      logger.debug() << "Falling back to cfitsio for " << m_filename << ": " << e.what();
+    }
+  });
+  return m_mapped->m_map != nullptr && m_mappable;
+}
+
+void FitsImageSource::checkMappable(fitsfile *fptr) {
+  int status = 0;
+
+  // Only plain files on disk, cfitsio keeps filtered or compressed files in memory
+  char url_type[FLEN_FILENAME];
+  fits_url_type(fptr, url_type, &status);
+  if (status != 0 || std::string(url_type) != "file://") {
+    return;
+  }
+
+  int is_compressed = fits_is_compressed_image(fptr, &status);
+  if (status != 0 || is_compressed || !isSafeConversion(m_bitpix, m_image_type)) {
+    return;
+  }
+
+  double bscale = 1., bzero = 0.;
+  fits_read_key(fptr, TDOUBLE, "BSCALE", &bscale, nullptr, &status);
+  if (status == KEY_NO_EXIST) {
+    status = 0;
+  }
+  fits_read_key(fptr, TDOUBLE, "BZERO", &bzero, nullptr, &status);
+  if (status == KEY_NO_EXIST) {
+    status = 0;
+  }
+  if (status != 0 || bscale != 1. || bzero != 0.) {
+    return;
+  }
+
+  LONGLONG header_start, data_start, data_end;
+  fits_get_hduaddrll(fptr, &header_start, &data_start, &data_end, &status);
+
+  char root_name[FLEN_FILENAME];
+  fits_parse_rootname(const_cast<char*>(m_filename.c_str()), root_name, &status);
+  if (status != 0) {
+    return;
+  }
+
+  m_root_path = root_name;
+  if (boost::starts_with(m_root_path, "file://")) {
+    m_root_path = m_root_path.substr(7);
+  }
+  m_data_offset = data_start;
+  m_mappable = true;
+}
+
+void FitsImageSource::readMappedTile(ImageTile& tile) const {
+  long long first_pixel =
+      (static_cast<long long>(m_current_layer) * m_height + tile.getPosY()) * m_width + tile.getPosX();
+  auto data = m_mapped->m_map->getData();
+
+  switch (m_image_type) {
+  case ImageTile::FloatImage:
+    decodeTile<float>(data, m_bitpix, first_pixel, m_width, tile);
+    break;
+  case ImageTile::DoubleImage:
+    decodeTile<double>(data, m_bitpix, first_pixel, m_width, tile);
+    break;
+  case ImageTile::IntImage:
+    decodeTile<int>(data, m_bitpix, first_pixel, m_width, tile);
+    break;
+  case ImageTile::UIntImage:
+    decodeTile<unsigned int>(data, m_bitpix, first_pixel, m_width, tile);
+    break;
+  case ImageTile::LongLongImage:
+    decodeTile<std::int64_t>(data, m_bitpix, first_pixel, m_width, tile);
+    break;
+  default:
+    throw Elements::Exception() << "Unsupported image tile type: " << m_image_type;
+  }
 }
 
 void FitsImageSource::switchHdu(fitsfile *fptr, int hdu_number) const {
@@ -273,12 +495,34 @@ void FitsImageSource::switchHdu(fitsfile *fptr, int hdu_number) const {
 }
 
 void FitsImageSource::setLayer(int layer) {
-  if (layer < 0 && layer >= m_depth) {
+  if (layer < 0 || layer >= m_depth) {
     throw Elements::Exception() << "Trying to access an inexistent data cube layer (" << layer << ") in " << m_filename;
   }
   m_current_layer = layer;
 }
 
+FitsImageSource::FitsImageSource(const FitsImageSource& cube, int layer)
+    : m_filename(cube.m_filename)
+    , m_file_manager(cube.m_file_manager)
+    , m_handler(cube.m_handler)
+    , m_hdu_number(cube.m_hdu_number)
+    , m_width(cube.m_width)
+    , m_height(cube.m_height)
+    , m_depth(cube.m_depth)
+    , m_image_type(cube.m_image_type)
+    , m_current_layer(0)
+    , m_mappable(cube.m_mappable.load())
+    , m_bitpix(cube.m_bitpix)
+    , m_data_offset(cube.m_data_offset)
+    , m_root_path(cube.m_root_path)
+    , m_mapped(cube.m_mapped) {
+  setLayer(layer);
+}
+
+std::shared_ptr<FitsImageSource> FitsImageSource::createLayer(int layer) const {
+  return std::shared_ptr<FitsImageSource>(new FitsImageSource(*this, layer));
+}
+
 std::unique_ptr<std::vector<char>> FitsImageSource::getFitsHeaders(int& number_of_records) const {
   number_of_records = 0;
   std::string records;
@@ -330,6 +574,9 @@ const std::map<std::string, MetadataEntry>& FitsImageSource::getMetadata() const
 }
 
 void FitsImageSource::setMetadata(const std::string& key, const MetadataEntry& value) {
+  // Adding cards may displace the data unit
+  m_mappable = false;
+
   auto acc  = m_handler->getAccessor<FitsFile>(FileHandler::kWrite);
   auto fptr = acc->m_fd.getFitsFilePtr();
   switchHdu(fptr, m_hdu_number);
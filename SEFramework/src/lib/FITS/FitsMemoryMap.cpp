@@ -0,0 +1,74 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * FitsMemoryMap.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ElementsKernel/Exception.h"
+
+#include "SEFramework/FITS/FitsMemoryMap.h"
+
+namespace SourceXtractor {
+
+FitsMemoryMap::FitsMemoryMap(const std::string& path, long long offset, long long size)
+  : m_mapping(MAP_FAILED), m_mapping_size(0), m_data(nullptr), m_size(size) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw Elements::Exception() << "Can not open " << path << " for mapping: " << std::strerror(errno);
+  }
+
+  // A plain FITS file starts with the SIMPLE keyword; anything else (i.e. gzip) is decoded by cfitsio
+  char magic[6];
+  struct stat file_stat;
+  if (::pread(fd, magic, sizeof(magic), 0) != sizeof(magic) || std::memcmp(magic, "SIMPLE", sizeof(magic)) != 0 ||
+      ::fstat(fd, &file_stat) != 0 || file_stat.st_size < offset + size) {
+    ::close(fd);
+    throw Elements::Exception() << "Not a plain FITS file: " << path;
+  }
+
+  // The offset of the mapping must be aligned to the page size
+  long long page_size = ::sysconf(_SC_PAGESIZE);
+  long long aligned_offset = (offset / page_size) * page_size;
+  m_mapping_size = static_cast<std::size_t>(size + offset - aligned_offset);
+
+  m_mapping = ::mmap(nullptr, m_mapping_size, PROT_READ, MAP_SHARED, fd, aligned_offset);
+  int map_errno = errno;
+  ::close(fd);
+
+  if (m_mapping == MAP_FAILED) {
+    throw Elements::Exception() << "Can not map " << path << ": " << std::strerror(map_errno);
+  }
+  m_data = static_cast<const unsigned char*>(m_mapping) + (offset - aligned_offset);
+}
+
+FitsMemoryMap::~FitsMemoryMap() {
+  if (m_mapping != MAP_FAILED) {
+    ::munmap(m_mapping, m_mapping_size);
+  }
+}
+
+}  // namespace SourceXtractor
@@ -21,13 +21,136 @@
  *      Author: mschefer
  */
 
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+#include <AlexandriaKernel/memory_tools.h>
+
+#include "SEUtils/MemoryAccounting.h"
+
 #include "SEFramework/Image/TileManager.h"
+#include "SEFramework/Pipeline/Tracer.h"
 
 namespace SourceXtractor {
 
 static std::shared_ptr<TileManager> s_instance;
 static Elements::Logging s_tile_logger = Elements::Logging::getLogger("TileManager");
 
+static thread_local TileManager::SourceRecorder* s_source_recorder = nullptr;
+
+TileManager::SourceRecorder::SourceRecorder() : m_previous(s_source_recorder), m_last(nullptr) {
+  s_source_recorder = this;
+}
+
+TileManager::SourceRecorder::~SourceRecorder() {
+  s_source_recorder = m_previous;
+}
+
+void TileManager::SourceRecorder::record(const std::shared_ptr<const ImageSource>& source) {
+  // Sweeps read the same few images over and over
+  if (source.get() != m_last) {
+    m_last = source.get();
+    m_sources.emplace(source);
+  }
+}
+
+namespace {
+
+/**
+ * Set of tiles that cover a rectangular region of the image
+ */
+struct WriteBlock {
+  ImageTile::ImageType m_type;
+  int m_x, m_y, m_width, m_height;
+  std::vector<std::shared_ptr<ImageTile>> m_tiles;
+
+  explicit WriteBlock(const std::shared_ptr<ImageTile>& tile)
+    : m_type(tile->getType()), m_x(tile->getPosX()), m_y(tile->getPosY()),
+      m_width(tile->getWidth()), m_height(tile->getHeight()), m_tiles{tile} {}
+};
+
+/**
+ * Coalesce tiles into blocks: first adjacent tiles along the same row, then rows of tiles with the same extent
+ * along x. For full width images this means a single block per set of contiguous rows.
+ */
+std::vector<WriteBlock> coalesceTiles(std::vector<std::shared_ptr<ImageTile>> tiles) {
+  std::sort(tiles.begin(), tiles.end(), [](const std::shared_ptr<ImageTile>& a, const std::shared_ptr<ImageTile>& b) {
+    return std::make_tuple(a->getType(), a->getPosY(), a->getPosX()) <
+           std::make_tuple(b->getType(), b->getPosY(), b->getPosX());
+  });
+
+  std::vector<WriteBlock> rows;
+  for (auto& tile : tiles) {
+    if (!rows.empty()) {
+      auto& last = rows.back();
+      if (last.m_type == tile->getType() && last.m_y == tile->getPosY() && last.m_height == tile->getHeight() &&
+          last.m_x + last.m_width == tile->getPosX()) {
+        last.m_width += tile->getWidth();
+        last.m_tiles.emplace_back(tile);
+        continue;
+      }
+    }
+    rows.emplace_back(tile);
+  }
+
+  std::sort(rows.begin(), rows.end(), [](const WriteBlock& a, const WriteBlock& b) {
+    return std::make_tuple(a.m_type, a.m_x, a.m_width, a.m_y) < std::make_tuple(b.m_type, b.m_x, b.m_width, b.m_y);
+  });
+
+  std::vector<WriteBlock> blocks;
+  for (auto& row : rows) {
+    if (!blocks.empty()) {
+      auto& last = blocks.back();
+      if (last.m_type == row.m_type && last.m_x == row.m_x && last.m_width == row.m_width &&
+          last.m_y + last.m_height == row.m_y) {
+        last.m_height += row.m_height;
+        last.m_tiles.insert(last.m_tiles.end(), row.m_tiles.begin(), row.m_tiles.end());
+        continue;
+      }
+    }
+    blocks.emplace_back(std::move(row));
+  }
+
+  return blocks;
+}
+
+void writeBlock(ImageSource& source, const WriteBlock& block) {
+  if (block.m_tiles.size() == 1) {
+    source.saveTile(*block.m_tiles.front());
+    return;
+  }
+
+  auto merged = ImageTile::create(block.m_type, block.m_x, block.m_y, block.m_width, block.m_height);
+  auto pixel_size = ImageTile::getTypeSize(block.m_type);
+  auto dst = static_cast<char*>(merged->getDataPtr());
+
+  for (auto& tile : block.m_tiles) {
+    auto src = static_cast<const char*>(tile->getDataPtr());
+    auto row_size = tile->getWidth() * pixel_size;
+    for (int iy = 0; iy < tile->getHeight(); ++iy) {
+      auto offset = static_cast<std::size_t>(tile->getPosY() - block.m_y + iy) * block.m_width +
+                    (tile->getPosX() - block.m_x);
+      std::memcpy(dst + offset * pixel_size, src + iy * row_size, row_size);
+    }
+  }
+
+  source.saveTile(*merged);
+}
+
+/**
+ * Copy of a tile, so it can be written while the original is still being modified
+ */
+std::shared_ptr<ImageTile> copyTile(const std::shared_ptr<const ImageSource>& source, ImageTile& tile) {
+  auto copy = ImageTile::create(tile.getType(), tile.getPosX(), tile.getPosY(), tile.getWidth(), tile.getHeight(),
+                                std::const_pointer_cast<ImageSource>(source));
+  std::memcpy(copy->getDataPtr(), tile.getDataPtr(), tile.getTileMemorySize());
+  copy->setModified(true);
+  return copy;
+}
+
+}
+
 bool TileKey::operator==(const TileKey& other) const {
   return m_source == other.m_source && m_tile_x == other.m_tile_x && m_tile_y == other.m_tile_y;
 }
@@ -40,7 +163,8 @@ std::string TileKey::getRepr() const {
 
 
 TileManager::TileManager() : m_tile_width(256), m_tile_height(256),
-                             m_max_memory(100 * 1024L * 1024L), m_total_memory_used(0) {
+                             m_max_memory(100 * 1024L * 1024L), m_total_memory_used(0),
+                             m_write_back(false), m_write_queue_memory(0), m_write_stop(false) {
 }
 
 TileManager::~TileManager() {
@@ -49,6 +173,7 @@ TileManager::~TileManager() {
   } catch (const std::exception& e) {
     s_tile_logger.error() << "Error while saving tiles at destruction: " << e.what();
   }
+  stopWriteBack();
 }
 
 void TileManager::setOptions(int tile_width, int tile_height, int max_memory) {
@@ -60,6 +185,11 @@ void TileManager::setOptions(int tile_width, int tile_height, int max_memory) {
   m_max_memory = max_memory * 1024L * 1024L;
 }
 
+void TileManager::setWriteBack(bool write_back) {
+  flush();
+  m_write_back = write_back;
+}
+
 void TileManager::flush() {
   // empty anything still stored in cache
   saveAllTiles();
@@ -67,9 +197,43 @@ void TileManager::flush() {
   boost::lock_guard<boost::shared_mutex> wr_lock(m_mutex);
   m_tile_list.clear();
   m_tile_map.clear();
+  MemoryAccounting::getInstance().release(MemoryAccounting::TILES, m_total_memory_used);
   m_total_memory_used = 0;
 }
 
+void TileManager::releaseTilesBefore(int y, const std::unordered_set<std::shared_ptr<const ImageSource>>& sources) {
+  Tracer::Scope trace_scope("tiles", "Release tiles");
+  boost::lock_guard<boost::shared_mutex> wr_lock(m_mutex);
+
+  // Keep a tile row above the held rows too, as the window does
+  if (!m_held_rows.empty()) {
+    y = std::min(y, *m_held_rows.begin() - m_tile_height);
+  }
+  for (auto i = m_tile_list.begin(); i != m_tile_list.end();) {
+    auto& tile = m_tile_map.at(*i);
+    if (tile->getPosY() + tile->getHeight() <= y && sources.count(i->m_source)) {
+      removeTile(*i);
+      i = m_tile_list.erase(i);
+    }
+    else {
+      ++i;
+    }
+  }
+}
+
+void TileManager::holdRowsFrom(int y) {
+  boost::lock_guard<boost::shared_mutex> wr_lock(m_mutex);
+  m_held_rows.emplace(y);
+}
+
+void TileManager::unholdRowsFrom(int y) {
+  boost::lock_guard<boost::shared_mutex> wr_lock(m_mutex);
+  auto i = m_held_rows.find(y);
+  if (i != m_held_rows.end()) {
+    m_held_rows.erase(i);
+  }
+}
+
 /*
  * boost::upgrade_lock can only be acquired by a single thread, even if none of them
  * ends needing an exclusive lock. Cache lookup must be done with a shared_lock instead
@@ -103,6 +267,10 @@ std::shared_ptr<boost::mutex>& TileManager::getMutexForImageSource(const ImageSo
 
 std::shared_ptr<ImageTile> TileManager::getTileForPixel(int x, int y,
                                                         std::shared_ptr<const ImageSource> source) {
+  if (s_source_recorder) {
+    s_source_recorder->record(source);
+  }
+
   x = x / m_tile_width * m_tile_width;
   y = y / m_tile_height * m_tile_height;
   TileKey key{std::static_pointer_cast<const ImageSource>(source), x, y};
@@ -126,9 +294,14 @@ std::shared_ptr<ImageTile> TileManager::getTileForPixel(int x, int y,
     return tile;
   }
 
-  tile = source->getImageTile(x, y,
-                              std::min(m_tile_width, source->getWidth() - x),
-                              std::min(m_tile_height, source->getHeight() - y));
+  // It may be waiting to be written
+  tile = takeFromWriteBack(key);
+  if (!tile) {
+    Tracer::Scope trace_scope("tiles", "Load tile");
+    tile = source->getImageTile(x, y,
+                                std::min(m_tile_width, source->getWidth() - x),
+                                std::min(m_tile_height, source->getHeight() - y));
+  }
 
   // Here we need to acquire the mutex in write mode!
   boost::lock_guard<boost::shared_mutex> wr_lock(m_mutex);
@@ -145,11 +318,28 @@ std::shared_ptr<TileManager> TileManager::getInstance() {
 }
 
 void TileManager::saveAllTiles() {
+  Tracer::Scope trace_scope("tiles", "Save all tiles");
   boost::lock_guard<boost::shared_mutex> wr_lock(m_mutex);
 
-  for (auto tile_key : m_tile_list) {
-    m_tile_map.at(tile_key)->saveIfModified();
+  if (m_write_back) {
+    // Queue all at once so they are coalesced. They are in memory already, so no need to wait for room.
+    // The tiles stay in the cache, where they can still be modified, so the I/O thread gets a copy.
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    for (auto tile_key : m_tile_list) {
+      auto& tile = m_tile_map.at(tile_key);
+      if (tile->isModified()) {
+        tile->setModified(false);
+        enqueueTile(tile_key, copyTile(tile_key.m_source, *tile));
+      }
+    }
+    m_write_pending.notify_one();
+  }
+  else {
+    for (auto tile_key : m_tile_list) {
+      saveTile(tile_key, m_tile_map.at(tile_key));
+    }
   }
+  waitWriteBack();
 }
 
 int TileManager::getTileWidth() const {
@@ -164,11 +354,14 @@ void TileManager::removeTile(TileKey tile_key) {
 #ifndef NDEBUG
   s_tile_logger.debug() << "Cache eviction " << tile_key;
 #endif
+  Tracer::Scope trace_scope("tiles", "Evict tile");
 
   auto& tile = m_tile_map.at(tile_key);
 
-  tile->saveIfModified();
+  // Released before queueing, so the tile is never counted both as cached and queued
   m_total_memory_used -= tile->getTileMemorySize();
+  MemoryAccounting::getInstance().release(MemoryAccounting::TILES, tile->getTileMemorySize());
+  saveTile(tile_key, tile);
 
   m_tile_map.erase(tile_key);
 }
@@ -190,6 +383,166 @@ void TileManager::addTile(TileKey key, std::shared_ptr<ImageTile> tile) {
   m_tile_map[key] = tile;
   m_tile_list.push_front(key);
   m_total_memory_used += tile->getTileMemorySize();
+  MemoryAccounting::getInstance().allocate(MemoryAccounting::TILES, tile->getTileMemorySize());
+}
+
+void TileManager::saveTile(const TileKey& key, const std::shared_ptr<ImageTile>& tile) {
+  if (!tile->isModified()) {
+    return;
+  }
+
+  if (!m_write_back) {
+    std::const_pointer_cast<ImageSource>(key.m_source)->saveTile(*tile);
+    tile->setModified(false);
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    m_dirty_sources[key.m_source.get()] = key.m_source;
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(m_write_mutex);
+
+  // Keep the memory used by the queued tiles bounded
+  long tile_memory = tile->getTileMemorySize();
+  m_write_done.wait(lock, [this, tile_memory]() {
+    return m_write_queue_memory == 0 || m_write_queue_memory + tile_memory <= m_max_memory / 4;
+  });
+
+  enqueueTile(key, tile);
+  m_write_pending.notify_one();
+}
+
+void TileManager::enqueueTile(const TileKey& key, const std::shared_ptr<ImageTile>& tile) {
+  if (!m_write_thread) {
+    m_write_thread = Euclid::make_unique<std::thread>(&TileManager::writeBackLoop, this);
+  }
+
+  auto i = m_write_queue.find(key);
+  if (i == m_write_queue.end()) {
+    m_write_queue.emplace(key, tile);
+    m_write_queue_memory += tile->getTileMemorySize();
+    MemoryAccounting::getInstance().allocate(MemoryAccounting::TILES, tile->getTileMemorySize());
+  }
+  else if (i->second != tile) {
+    // A copy queued by saveAllTiles is superseded by the tile itself
+    i->second->setModified(false);
+    i->second = tile;
+  }
+  m_dirty_sources[key.m_source.get()] = key.m_source;
+}
+
+std::shared_ptr<ImageTile> TileManager::takeFromWriteBack(const TileKey& key) {
+  std::unique_lock<std::mutex> lock(m_write_mutex);
+
+  // The content on the source is stale until the write finishes
+  m_write_done.wait(lock, [this, &key]() {
+    return m_write_in_flight.count(key) == 0;
+  });
+
+  auto i = m_write_queue.find(key);
+  if (i == m_write_queue.end()) {
+    return nullptr;
+  }
+
+  auto tile = i->second;
+  m_write_queue.erase(i);
+  m_write_queue_memory -= tile->getTileMemorySize();
+  MemoryAccounting::getInstance().release(MemoryAccounting::TILES, tile->getTileMemorySize());
+  m_write_done.notify_all();
+  return tile;
+}
+
+void TileManager::waitWriteBack() {
+  std::unique_lock<std::mutex> lock(m_write_mutex);
+  m_write_done.wait(lock, [this]() {
+    return m_write_queue.empty() && m_write_in_flight.empty();
+  });
+
+  auto dirty_sources = std::move(m_dirty_sources);
+  m_dirty_sources.clear();
+  auto error = m_write_error;
+  m_write_error = nullptr;
+  lock.unlock();
+
+  for (auto& dirty : dirty_sources) {
+    auto source = dirty.second.lock();
+    if (source) {
+      std::const_pointer_cast<ImageSource>(source)->flush();
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void TileManager::stopWriteBack() {
+  {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    m_write_stop = true;
+  }
+  m_write_pending.notify_all();
+  if (m_write_thread && m_write_thread->joinable()) {
+    m_write_thread->join();
+  }
+}
+
+void TileManager::writeBackLoop() {
+  Tracer::getInstance().setThreadName("Tile writer");
+  std::unique_lock<std::mutex> lock(m_write_mutex);
+
+  while (true) {
+    m_write_pending.wait(lock, [this]() {
+      return m_write_stop || !m_write_queue.empty();
+    });
+    if (m_write_queue.empty()) {
+      break;
+    }
+
+    // Take everything queued so far, grouped by source
+    std::unordered_map<const ImageSource*, std::vector<std::shared_ptr<ImageTile>>> batch;
+    std::vector<TileKey> keys;
+    long batch_memory = 0;
+    for (auto& entry : m_write_queue) {
+      m_write_in_flight.insert(entry.first);
+      keys.emplace_back(entry.first);
+      batch[entry.first.m_source.get()].emplace_back(entry.second);
+      batch_memory += entry.second->getTileMemorySize();
+      // Modifications done from now on will need to be saved again
+      entry.second->setModified(false);
+    }
+    m_write_queue.clear();
+
+    lock.unlock();
+    try {
+      for (auto& key : keys) {
+        auto i = batch.find(key.m_source.get());
+        if (i == batch.end()) {
+          continue;
+        }
+        auto source = std::const_pointer_cast<ImageSource>(key.m_source);
+        for (auto& block : coalesceTiles(std::move(i->second))) {
+          Tracer::Scope trace_scope("tiles", "Write tiles");
+          writeBlock(*source, block);
+        }
+        batch.erase(i);
+      }
+    } catch (const std::exception& e) {
+      s_tile_logger.error() << "Error while writing tiles: " << e.what();
+      std::lock_guard<std::mutex> error_lock(m_write_mutex);
+      if (!m_write_error) {
+        m_write_error = std::current_exception();
+      }
+    }
+    batch.clear();
+    lock.lock();
+
+    for (auto& key : keys) {
+      m_write_in_flight.erase(key);
+    }
+    m_write_queue_memory -= batch_memory;
+    MemoryAccounting::getInstance().release(MemoryAccounting::TILES, batch_memory);
+    m_write_done.notify_all();
+  }
 }
 
 }
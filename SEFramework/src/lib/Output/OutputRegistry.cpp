@@ -33,7 +33,8 @@ using namespace Euclid::Table;
 
 namespace SourceXtractor {
 
-auto OutputRegistry::getSourceToRowConverter(const std::vector<std::string>& enabled_properties) -> SourceToRowConverter {
+auto OutputRegistry::getOutputPropertyTypes(const std::vector<std::string>& enabled_properties) const
+-> std::vector<std::type_index> {
   std::vector<std::type_index> out_prop_list {};
   for (auto& prop : enabled_properties) {
     if (m_output_properties.count(prop) == 0) {
@@ -46,24 +47,62 @@ auto OutputRegistry::getSourceToRowConverter(const std::vector<std::string>& ena
       }
     }
   }
-  return [this, out_prop_list](const SourceInterface& source) {
-    std::vector<ColumnInfo::info_type> info_list {};
+  return out_prop_list;
+}
+
+auto OutputRegistry::getSourceToRowConverter(const std::vector<std::string>& enabled_properties) -> SourceToRowConverter {
+  auto out_prop_list = getOutputPropertyTypes(enabled_properties);
+
+  // Resolve the columns once, so converting a source does not need any lookup,
+  // and all rows share the same column information
+  std::vector<ColumnInfo::info_type> info_list {};
+  std::vector<ColumnFromSource> converters {};
+  for (const auto& property : out_prop_list) {
+    if (m_property_to_names_map.count(property) == 0) {
+      throw Elements::Exception() << "Missing column generator for " << property.name();
+    }
+    for (const auto& name : m_property_to_names_map.at(property)) {
+      auto& col_info = m_name_to_col_info_map.at(name);
+      auto& converter = m_name_to_converter_map.at(name);
+      info_list.emplace_back(name, converter.first, col_info.unit, col_info.description);
+      converters.emplace_back(converter.second);
+    }
+  }
+  if (info_list.empty()) {
+    throw Elements::Exception() << "The given configuration would not generate any output";
+  }
+  auto column_info = std::make_shared<ColumnInfo>(std::move(info_list));
+
+  return [column_info, converters](const SourceInterface& source) {
     std::vector<Row::cell_type> cell_values {};
-    for (const auto& property : out_prop_list) {
-      if (m_property_to_names_map.count(property) == 0) {
-        throw Elements::Exception() << "Missing column generator for " << property.name();
-      }
-      for (const auto& name : m_property_to_names_map.at(property)) {
-        auto& col_info = m_name_to_col_info_map.at(name);
-        info_list.emplace_back(name, m_name_to_converter_map.at(name).first,
-                               col_info.unit, col_info.description);
-        cell_values.emplace_back(m_name_to_converter_map.at(name).second(source));
+    cell_values.reserve(converters.size());
+    for (const auto& converter : converters) {
+      cell_values.emplace_back(converter(source));
+    }
+    return Row {std::move(cell_values), column_info};
+  };
+}
+
+auto OutputRegistry::getSourcePropertyRequester(const std::vector<std::string>& enabled_properties)
+-> SourcePropertyRequester {
+  std::vector<PropertyId> property_ids {};
+  for (const auto& property : getOutputPropertyTypes(enabled_properties)) {
+    if (m_property_to_names_map.count(property) == 0) {
+      throw Elements::Exception() << "Missing column generator for " << property.name();
+    }
+    // Several columns usually come from the same property
+    for (const auto& name : m_property_to_names_map.at(property)) {
+      auto property_id = m_name_to_converter_map.at(name).second.getPropertyId();
+      if (std::find(property_ids.begin(), property_ids.end(), property_id) == property_ids.end()) {
+        property_ids.emplace_back(property_id);
       }
     }
-    if (info_list.empty()) {
-      throw Elements::Exception() << "The given configuration would not generate any output";
+  }
+
+  return [property_ids](const SourceInterface& source) {
+    for (const auto& property_id : property_ids) {
+      source.getProperty(property_id);
     }
-    return Row {std::move(cell_values), std::make_shared<ColumnInfo>(move(info_list))};
   };
 }
 
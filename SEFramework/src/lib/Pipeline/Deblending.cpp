@@ -21,6 +21,7 @@
  */
 
 #include "SEFramework/Pipeline/Deblending.h"
+#include "SEFramework/Pipeline/Tracer.h"
 
 namespace SourceXtractor {
 
@@ -31,8 +32,11 @@ Deblending::Deblending(std::vector<std::shared_ptr<DeblendStep>> deblend_steps)
 void Deblending::receiveSource(std::unique_ptr<SourceGroupInterface> group) {
 
   // Applies every DeblendStep to the SourceGroup
-  for (auto& step : m_deblend_steps) {
-    step->deblend(*group);
+  {
+    Tracer::Scope trace_scope("deblending", "Deblend group");
+    for (auto& step : m_deblend_steps) {
+      step->deblend(*group);
+    }
   }
 
   // If the SourceGroup still contains sources, we notify the observers
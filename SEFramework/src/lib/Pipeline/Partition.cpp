@@ -21,6 +21,7 @@
  */
 
 #include "SEFramework/Pipeline/Partition.h"
+#include "SEFramework/Pipeline/Tracer.h"
 
 namespace SourceXtractor {
 
@@ -35,6 +36,7 @@ void Partition::receiveSource(std::unique_ptr<SourceInterface> input_source) {
 
   // Applies all the steps
   for (const auto& step : m_steps) {
+    Tracer::Scope trace_scope("partition", typeid(*step));
     std::vector<std::unique_ptr<SourceInterface>> step_output_sources;
     // For each Source in pour input list
     for (auto& source : step_input_sources) {
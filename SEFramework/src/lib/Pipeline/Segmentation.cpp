@@ -21,6 +21,7 @@
  */
 
 #include "SEFramework/Pipeline/Segmentation.h"
+#include "SEFramework/Pipeline/Tracer.h"
 
 namespace SourceXtractor {
 
@@ -29,7 +30,10 @@ Segmentation::Segmentation(std::shared_ptr<DetectionImageFrame::ImageFilter> ima
 }
 
 void Segmentation::processFrame(std::shared_ptr<DetectionImageFrame> frame) const {
-  if (m_filter_image_processing != nullptr && frame != nullptr) {
+  Tracer::Scope trace_scope("segmentation", "Segmentation");
+
+  // The frame may have been labelled ahead, with the filter already set
+  if (m_filter_image_processing != nullptr && frame != nullptr && frame->getFilter() != m_filter_image_processing) {
     frame->setFilter(m_filter_image_processing);
   }
 
@@ -21,6 +21,7 @@
  */
 
 #include "SEFramework/Pipeline/SourceGrouping.h"
+#include "SEFramework/Pipeline/Tracer.h"
 #include <vector>
 
 
@@ -33,6 +34,8 @@ SourceGrouping::SourceGrouping(std::shared_ptr<GroupingCriteria> grouping_criter
 }
 
 void SourceGrouping::receiveSource(std::unique_ptr<SourceInterface> source) {
+  Tracer::Scope trace_scope("grouping", "Group source");
+
   // Pointer which points to the group of the source
   SourceGroupInterface* matched_group = nullptr;
 
@@ -85,16 +88,15 @@ void SourceGrouping::receiveSource(std::unique_ptr<SourceInterface> source) {
 }
 
 void SourceGrouping::receiveProcessSignal(const ProcessSourcesEvent& process_event) {
+  Tracer::Scope trace_scope("grouping", "Flush groups");
+
   std::vector<std::list<std::unique_ptr<SourceGroupInterface>>::iterator> groups_to_process;
 
   // We iterate through all the SourceGroups we have
   for (auto group_it = m_source_groups.begin(); group_it != m_source_groups.end(); ++group_it) {
-    // We look at its Sources and if we find at least one that needs to be processed we put it in groups_to_process
-    for (auto& source : **group_it) {
-      if (process_event.m_selection_criteria->mustBeProcessed(source)) {
-        groups_to_process.push_back(group_it);
-        break;
-      }
+    // We look at its Sources to know if it needs to be processed, and if so we put it in groups_to_process
+    if (process_event.m_selection_criteria->groupMustBeProcessed(**group_it)) {
+      groups_to_process.push_back(group_it);
     }
   }
 
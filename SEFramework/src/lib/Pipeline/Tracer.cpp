@@ -0,0 +1,198 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Tracer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <unistd.h>
+
+#include <boost/core/demangle.hpp>
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+
+#include "SEFramework/Pipeline/Tracer.h"
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("Tracer");
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+namespace {
+
+/// Events kept by each thread before they are written
+const std::size_t BUFFER_SIZE = 16384;
+
+void writeString(std::ostream& out, const std::string& str) {
+  out << '"';
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+}
+
+Tracer& Tracer::getInstance() {
+  static Tracer tracer;
+  return tracer;
+}
+
+Tracer::~Tracer() {
+  stop();
+}
+
+int64_t Tracer::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Tracer::ThreadBuffer& Tracer::getThreadBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if (!buffer) {
+    buffer = std::make_shared<ThreadBuffer>();
+    buffer->m_events.reserve(BUFFER_SIZE);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer->m_tid = m_next_tid++;
+    m_buffers.emplace_back(buffer);
+  }
+  return *buffer;
+}
+
+void Tracer::start(const std::string& path) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_stream.is_open()) {
+    throw Elements::Exception() << "A trace is already being recorded";
+  }
+
+  m_stream.open(path, std::ios::out | std::ios::trunc);
+  if (!m_stream) {
+    throw Elements::Exception() << "Can not open the trace file " << path;
+  }
+  m_stream << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+  m_first_event = true;
+  m_pid = ::getpid();
+
+  for (auto& buffer : m_buffers) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->m_mutex);
+    buffer->m_events.clear();
+  }
+
+  m_origin = now();
+  s_enabled = true;
+  logger.info() << "Recording a trace into " << path;
+}
+
+void Tracer::stop() {
+  s_enabled = false;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_stream.is_open()) {
+    return;
+  }
+
+  for (auto& buffer : m_buffers) {
+    std::vector<Event> events;
+    std::string name;
+    {
+      std::lock_guard<std::mutex> buffer_lock(buffer->m_mutex);
+      events.swap(buffer->m_events);
+      name = buffer->m_name.empty() ? "Thread " + std::to_string(buffer->m_tid) : buffer->m_name;
+    }
+    writeEvents(buffer->m_tid, events);
+
+    beginEvent();
+    m_stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << m_pid << ",\"tid\":" << buffer->m_tid
+             << ",\"args\":{\"name\":";
+    writeString(m_stream, name);
+    m_stream << "}}";
+  }
+
+  m_stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  m_stream.close();
+}
+
+void Tracer::setThreadName(const std::string& name) {
+  auto& buffer = getThreadBuffer();
+  std::lock_guard<std::mutex> buffer_lock(buffer.m_mutex);
+  buffer.m_name = name;
+}
+
+void Tracer::recordComplete(const char* category, const char* name, bool demangle, int64_t start,
+                            int64_t duration) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  auto& buffer = getThreadBuffer();
+  std::vector<Event> full;
+  {
+    std::lock_guard<std::mutex> buffer_lock(buffer.m_mutex);
+    buffer.m_events.push_back({category, name, demangle, start, duration});
+    if (buffer.m_events.size() < BUFFER_SIZE) {
+      return;
+    }
+    full.swap(buffer.m_events);
+    buffer.m_events.reserve(BUFFER_SIZE);
+  }
+
+  // The time spent writing shows in the trace of this thread
+  Scope scope("tracer", "Write trace");
+  std::lock_guard<std::mutex> lock(m_mutex);
+  writeEvents(buffer.m_tid, full);
+}
+
+void Tracer::beginEvent() {
+  m_stream << (m_first_event ? "\n" : ",\n");
+  m_first_event = false;
+}
+
+void Tracer::writeEvents(int tid, const std::vector<Event>& events) {
+  if (!m_stream.is_open()) {
+    return;
+  }
+
+  for (auto& event : events) {
+    beginEvent();
+    m_stream << "{\"name\":";
+    if (event.m_demangle) {
+      auto i = m_demangled.find(event.m_name);
+      if (i == m_demangled.end()) {
+        i = m_demangled.emplace(event.m_name, boost::core::demangle(event.m_name)).first;
+      }
+      writeString(m_stream, i->second);
+    }
+    else {
+      writeString(m_stream, event.m_name);
+    }
+    m_stream << ",\"cat\":";
+    writeString(m_stream, event.m_category);
+    m_stream << ",\"ph\":\"X\",\"pid\":" << m_pid << ",\"tid\":" << tid
+             << ",\"ts\":" << (event.m_start - m_origin) / 1000. << ",\"dur\":" << event.m_duration / 1000. << '}';
+  }
+}
+
+} // namespace SourceXtractor
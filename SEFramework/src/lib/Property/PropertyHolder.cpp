@@ -27,10 +27,10 @@
 namespace SourceXtractor {
 
 const Property& PropertyHolder::getProperty(const PropertyId& property_id) const {
-  auto iter = m_properties.find(property_id);
-  if (iter != m_properties.end()) {
+  auto property = findProperty(property_id);
+  if (property != nullptr) {
     // Returns the property if it is found
-    return *iter->second;
+    return *property;
   } else {
     // If we don't have that property throws an exception
     throw PropertyNotFoundException(property_id);
@@ -38,11 +38,18 @@ const Property& PropertyHolder::getProperty(const PropertyId& property_id) const
 }
 
 void PropertyHolder::setProperty(std::unique_ptr<Property> property, const PropertyId& property_id) {
-  m_properties[property_id] = std::move(property);
+  auto key = getKey(property_id);
+  auto i = m_properties.begin() + (lowerBound(key) - m_properties.cbegin());
+  if (i != m_properties.end() && i->first == key) {
+    i->second = std::move(property);
+  }
+  else {
+    m_properties.emplace(i, key, std::move(property));
+  }
 }
 
 bool PropertyHolder::isPropertySet(const PropertyId& property_id) const {
-  return m_properties.find(property_id) != m_properties.end();
+  return findProperty(property_id) != nullptr;
 }
 
 void PropertyHolder::clear() {
@@ -21,6 +21,8 @@
  */
 
 
+#include <map>
+#include <mutex>
 #include "SEFramework/Property/PropertyId.h"
 
 #if BOOST_VERSION < 105600
@@ -33,6 +35,15 @@ using boost::core::demangle;
 
 namespace SourceXtractor {
 
+unsigned int PropertyId::getTypeSlot(std::type_index type_id) {
+  // Function local, as PropertyIds may be created during static initialization
+  static std::mutex slots_mutex;
+  static std::map<std::type_index, unsigned int> slots;
+
+  std::lock_guard<std::mutex> lock(slots_mutex);
+  return slots.emplace(type_id, static_cast<unsigned int>(slots.size())).first->second;
+}
+
 std::string PropertyId::getString() const {
   std::stringstream property_name;
   property_name << demangle(m_type_id.name()) << " [ " << m_index << " ] ";
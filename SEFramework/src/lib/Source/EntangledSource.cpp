@@ -20,12 +20,15 @@
  */
 
 #include "SEFramework/Source/SourceGroupWithOnDemandProperties.h"
+#include "SEFramework/Source/SourceWithOnDemandProperties.h"
 #include "SEFramework/Task/GroupTask.h"
+#include "SEFramework/Task/PropertyPlanner.h"
+#include "SEFramework/Pipeline/Tracer.h"
 
 namespace SourceXtractor {
 
 SourceGroupWithOnDemandProperties::EntangledSource::EntangledSource(std::shared_ptr<SourceInterface> source, SourceGroupWithOnDemandProperties& group)
-        : m_source(source), m_group(group) {
+        : m_source(source), m_on_demand_source(nullptr), m_group(group) {
   // Normally, it should not be possible that the given source is of type
   // EntangledSource, because the entangled sources of a group can only be
   // accessed via the iterator as references. Nevertheless, to be sure that
@@ -35,43 +38,64 @@ SourceGroupWithOnDemandProperties::EntangledSource::EntangledSource(std::shared_
   if (entangled_ptr != nullptr) {
     m_source = entangled_ptr->m_source;
   }
+  // Sources with on demand properties can report a missing property without throwing
+  m_on_demand_source = dynamic_cast<const SourceWithOnDemandProperties*>(m_source.get());
 }
 
 const Property& SourceGroupWithOnDemandProperties::EntangledSource::getProperty(const PropertyId& property_id) const {
+  if (PropertyPlanner::isRecording()) {
+    PropertyPlanner::getInstance().recordRequest(property_id);
+  }
 
   // If we already have the property stored in this object, returns it
-  if (m_property_holder.isPropertySet(property_id)) {
-    return m_property_holder.getProperty(property_id);
+  auto property = m_property_holder.findProperty(property_id);
+  if (property != nullptr) {
+    return *property;
   }
 
   // If the property is already stored in the group, we return it
-  if (m_group.m_property_holder.isPropertySet(property_id)) {
-    return m_group.getProperty(property_id);
+  property = m_group.m_property_holder.findProperty(property_id);
+  if (property != nullptr) {
+    return *property;
   }
 
-  try {
-    // Try to get the the property from the encapsulated Source
+  // Try to get the the property from the encapsulated Source
+  if (m_on_demand_source != nullptr) {
+    property = m_on_demand_source->findProperty(property_id);
+    if (property != nullptr) {
+      return *property;
+    }
+  }
+  else {
     // if it cannot provide it, this will throw a PropertyNotFoundException
-    return m_source->getProperty(property_id);
-  } catch (PropertyNotFoundException& e) {
-    // Getting this exception means the property must be computed at the group level
-
-    // Get the group task
-    auto group_task = m_group.m_task_provider->getTask<GroupTask>(property_id);
-    if (!group_task) {
-      // No task is available to make that property
-      throw PropertyNotFoundException(property_id);
+    try {
+      return m_source->getProperty(property_id);
+    } catch (PropertyNotFoundException&) {
     }
+  }
+
+  // The property must be computed at the group level
+
+  // Get the group task
+  auto group_task = m_group.m_task_provider->getTask<GroupTask>(property_id);
+  if (!group_task) {
+    // No task is available to make that property
+    throw PropertyNotFoundException(property_id);
+  }
 
   // Use the task to make the property
+  {
+    PropertyPlanner::ComputeScope compute_scope(property_id);
+    Tracer::Scope trace_scope("task", typeid(*group_task));
     group_task->computeProperties(m_group);
+  }
 
-    // The property should now be available either in this object or in the group object
-    if (m_property_holder.isPropertySet(property_id)) {
-      return m_property_holder.getProperty(property_id);
-    } else {
-      return m_group.m_property_holder.getProperty(property_id);
-    }
+  // The property should now be available either in this object or in the group object
+  property = m_property_holder.findProperty(property_id);
+  if (property != nullptr) {
+    return *property;
+  } else {
+    return m_group.m_property_holder.getProperty(property_id);
   }
 
 } // end of getProperty()
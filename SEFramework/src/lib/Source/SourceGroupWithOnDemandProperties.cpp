@@ -24,6 +24,8 @@
 
 #include "SEFramework/Source/SourceGroupWithOnDemandProperties.h"
 #include "SEFramework/Task/GroupTask.h"
+#include "SEFramework/Task/PropertyPlanner.h"
+#include "SEFramework/Pipeline/Tracer.h"
 
 namespace SourceXtractor {
 
@@ -82,15 +84,22 @@ void SourceGroupWithOnDemandProperties::merge(SourceGroupInterface&& other) {
 }
 
 const Property& SourceGroupWithOnDemandProperties::getProperty(const PropertyId& property_id) const {
+  if (PropertyPlanner::isRecording()) {
+    PropertyPlanner::getInstance().recordRequest(property_id);
+  }
+
   // If we already have the property, return it
-  if (m_property_holder.isPropertySet(property_id)) {
-    return m_property_holder.getProperty(property_id);
+  auto property = m_property_holder.findProperty(property_id);
+  if (property != nullptr) {
+    return *property;
   }
 
   try {
     // If not, get the task for that property, use it to compute the property then return it
     auto task = m_task_provider->getTask<GroupTask>(property_id);
     if (task) {
+      PropertyPlanner::ComputeScope compute_scope(property_id);
+      Tracer::Scope trace_scope("task", typeid(*task));
       task->computeProperties(const_cast<SourceGroupWithOnDemandProperties&>(*this));
       return m_property_holder.getProperty(property_id);
     }
@@ -24,6 +24,8 @@
 
 #include "SEFramework/Task/TaskProvider.h"
 #include "SEFramework/Task/SourceTask.h"
+#include "SEFramework/Task/PropertyPlanner.h"
+#include "SEFramework/Pipeline/Tracer.h"
 #include "SEFramework/Property/PropertyNotFoundException.h"
 
 #include "SEFramework/Source/SourceWithOnDemandProperties.h"
@@ -37,25 +39,40 @@ SourceWithOnDemandProperties::SourceWithOnDemandProperties(std::shared_ptr<const
 }
 
 const Property& SourceWithOnDemandProperties::getProperty(const PropertyId& property_id) const {
+  auto property = findProperty(property_id);
+  if (property == nullptr) {
+    // no task available to make the property, just throw an exception
+    throw PropertyNotFoundException(property_id);
+  }
+  return *property;
+}
+
+const Property* SourceWithOnDemandProperties::findProperty(const PropertyId& property_id) const {
+  if (PropertyPlanner::isRecording()) {
+    PropertyPlanner::getInstance().recordRequest(property_id);
+  }
+
   // if we have the property already, just return it
-  if (m_property_holder.isPropertySet(property_id)) {
-    return m_property_holder.getProperty(property_id);
+  auto property = m_property_holder.findProperty(property_id);
+  if (property != nullptr) {
+    return property;
   }
 
   try {
     // if not, get the task that makes it and execute, we should have it then
     auto task = m_task_provider->getTask<SourceTask>(property_id);
     if (task) {
+      PropertyPlanner::ComputeScope compute_scope(property_id);
+      Tracer::Scope trace_scope("task", typeid(*task));
       task->computeProperties(const_cast<SourceWithOnDemandProperties&>(*this));
-      return m_property_holder.getProperty(property_id);
+      return m_property_holder.findProperty(property_id);
     }
   }
   catch (Elements::Exception& e) {
     logger.debug() << e.what();
   }
 
-  // no task available to make the property, just throw an exception
-  throw PropertyNotFoundException(property_id);
+  return nullptr;
 }
 
 void SourceWithOnDemandProperties::setProperty(std::unique_ptr<Property> property, const PropertyId& property_id) {
@@ -0,0 +1,317 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * PropertyPlanner.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+#include <ElementsKernel/Logging.h>
+
+#include "SEFramework/Task/PropertyPlanner.h"
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("PropertyPlanner");
+
+std::atomic<bool> PropertyPlanner::s_recording{false};
+std::atomic<bool> PropertyPlanner::s_statistics{false};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// A property being computed on this thread
+struct ComputeFrame {
+  PropertyId m_property_id;
+  Clock::time_point m_start;
+  double m_dependencies_time;
+  std::set<PropertyId> m_dependencies;
+
+  ComputeFrame(const PropertyId& property_id, bool statistics)
+    : m_property_id(property_id), m_start(statistics ? Clock::now() : Clock::time_point()), m_dependencies_time(0) {}
+};
+
+thread_local std::vector<ComputeFrame> s_compute_stack;
+
+/// Set while execute() requests the plan, those requests are not done by the framework
+thread_local bool s_executing = false;
+
+struct ExecuteScope {
+  ExecuteScope() { s_executing = true; }
+  ~ExecuteScope() { s_executing = false; }
+};
+
+}
+
+PropertyPlanner::ComputeScope::ComputeScope(const PropertyId& property_id)
+  : m_active(isRecording()), m_statistics(m_active && isCollectingStatistics()) {
+  if (m_active) {
+    s_compute_stack.emplace_back(property_id, m_statistics);
+  }
+}
+
+PropertyPlanner::ComputeScope::~ComputeScope() {
+  if (!m_active) {
+    return;
+  }
+  auto frame = std::move(s_compute_stack.back());
+  s_compute_stack.pop_back();
+
+  double total_time = 0;
+  if (m_statistics) {
+    total_time = std::chrono::duration<double>(Clock::now() - frame.m_start).count();
+    if (!s_compute_stack.empty()) {
+      s_compute_stack.back().m_dependencies_time += total_time;
+    }
+  }
+  getInstance().recordComputation(frame.m_property_id, frame.m_dependencies, m_statistics,
+                                  total_time - frame.m_dependencies_time, total_time);
+}
+
+PropertyPlanner& PropertyPlanner::getInstance() {
+  static PropertyPlanner planner;
+  return planner;
+}
+
+void PropertyPlanner::recordRequest(const PropertyId& property_id) {
+  // Requests done from outside a task (i.e. grouping or the output) are not dependencies,
+  // but what they request is used
+  if (s_compute_stack.empty()) {
+    if (!s_executing) {
+      recordFrameworkRequest(property_id);
+    }
+  }
+  else if (!(s_compute_stack.back().m_property_id == property_id)) {
+    s_compute_stack.back().m_dependencies.emplace(property_id);
+  }
+}
+
+void PropertyPlanner::recordFrameworkRequest(const PropertyId& property_id) {
+  auto& record = getThreadRecord();
+  {
+    std::lock_guard<std::mutex> record_lock(record.m_mutex);
+    if (!record.m_framework_requests.emplace(property_id).second) {
+      return;
+    }
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_framework_requests.emplace(property_id);
+}
+
+auto PropertyPlanner::getThreadRecord() -> ThreadRecord& {
+  thread_local std::shared_ptr<ThreadRecord> record;
+  if (!record) {
+    record = std::make_shared<ThreadRecord>();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_thread_records.emplace_back(record);
+  }
+  return *record;
+}
+
+void PropertyPlanner::recordComputation(const PropertyId& property_id, const std::set<PropertyId>& dependencies,
+                                        bool statistics, double self_time, double total_time) {
+  auto& record = getThreadRecord();
+  bool new_dependencies;
+  {
+    std::lock_guard<std::mutex> record_lock(record.m_mutex);
+    if (statistics) {
+      auto& stats = record.m_stats.emplace(property_id, PropertyStats{0, 0., 0.}).first->second;
+      stats.m_computations += 1;
+      stats.m_self_time += self_time;
+      stats.m_total_time += total_time;
+    }
+
+    auto known = record.m_dependencies.emplace(property_id, std::set<PropertyId>{});
+    auto known_size = known.first->second.size();
+    known.first->second.insert(dependencies.begin(), dependencies.end());
+    new_dependencies = known.second || known.first->second.size() != known_size;
+  }
+
+  // Only what this thread did not know yet needs to be merged into the graph
+  if (new_dependencies) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto known = m_dependencies.emplace(property_id, std::set<PropertyId>{});
+    auto known_size = known.first->second.size();
+    known.first->second.insert(dependencies.begin(), dependencies.end());
+    if (known.second || known.first->second.size() != known_size) {
+      ++m_version;
+    }
+  }
+}
+
+void PropertyPlanner::setOutputTypes(const std::set<std::type_index>& output_types) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_output_types = output_types;
+  ++m_version;
+}
+
+void PropertyPlanner::setRequiredProperties(RequiredProperties required_properties) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_required_properties = std::move(required_properties);
+  ++m_version;
+}
+
+std::shared_ptr<const std::vector<PropertyId>> PropertyPlanner::getPlan() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_plan && m_plan_version == m_version) {
+    return m_plan;
+  }
+
+  // Depth-first post-order from the output properties: dependencies are visited first.
+  // Only the declared dependencies are followed, the learnt ones may be requested only sometimes
+  auto plan = std::make_shared<std::vector<PropertyId>>();
+  std::set<PropertyId> visited;
+  std::function<void(const PropertyId&)> visit = [&](const PropertyId& property_id) {
+    if (!visited.emplace(property_id).second) {
+      return;
+    }
+    if (m_required_properties) {
+      for (auto& dependency : m_required_properties(property_id)) {
+        visit(dependency);
+      }
+    }
+    plan->emplace_back(property_id);
+  };
+  for (auto& entry : m_dependencies) {
+    if (m_output_types.count(entry.first.getTypeId())) {
+      visit(entry.first);
+    }
+  }
+
+  m_plan = plan;
+  m_plan_version = m_version;
+  return m_plan;
+}
+
+void PropertyPlanner::execute(SourceGroupInterface& group) const {
+  auto plan = getPlan();
+  ExecuteScope execute_scope;
+  for (auto& property_id : *plan) {
+    for (auto& source : group) {
+      source.getProperty(property_id);
+    }
+  }
+}
+
+auto PropertyPlanner::getStats() const -> std::map<PropertyId, PropertyStats> {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::map<PropertyId, PropertyStats> merged;
+  for (auto& record : m_thread_records) {
+    std::lock_guard<std::mutex> record_lock(record->m_mutex);
+    for (auto& entry : record->m_stats) {
+      auto& stats = merged.emplace(entry.first, PropertyStats{0, 0., 0.}).first->second;
+      stats.m_computations += entry.second.m_computations;
+      stats.m_self_time += entry.second.m_self_time;
+      stats.m_total_time += entry.second.m_total_time;
+    }
+  }
+  return merged;
+}
+
+std::set<PropertyId> PropertyPlanner::getDependencies(const PropertyId& property_id) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto dependencies = m_dependencies.find(property_id);
+  if (dependencies == m_dependencies.end()) {
+    return {};
+  }
+  return dependencies->second;
+}
+
+std::vector<PropertyId> PropertyPlanner::getUnusedProperties() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // Everything the catalog and the framework requested, directly or not, is used
+  std::set<PropertyId> required;
+  std::function<void(const PropertyId&)> visit = [&](const PropertyId& property_id) {
+    if (!required.emplace(property_id).second) {
+      return;
+    }
+    auto dependencies = m_dependencies.find(property_id);
+    if (dependencies != m_dependencies.end()) {
+      for (auto& dependency : dependencies->second) {
+        visit(dependency);
+      }
+    }
+  };
+  for (auto& entry : m_dependencies) {
+    if (m_output_types.count(entry.first.getTypeId())) {
+      visit(entry.first);
+    }
+  }
+  for (auto& property_id : m_framework_requests) {
+    visit(property_id);
+  }
+
+  std::vector<PropertyId> unused;
+  for (auto& entry : m_dependencies) {
+    if (required.count(entry.first) == 0) {
+      unused.emplace_back(entry.first);
+    }
+  }
+  return unused;
+}
+
+void PropertyPlanner::logReport() const {
+  auto stats = getStats();
+  std::vector<std::pair<PropertyId, PropertyStats>> sorted(stats.begin(), stats.end());
+  std::sort(sorted.begin(), sorted.end(), [](const std::pair<PropertyId, PropertyStats>& a,
+                                             const std::pair<PropertyId, PropertyStats>& b) {
+    return a.second.m_self_time > b.second.m_self_time;
+  });
+
+  logger.info() << "Property computations (self time excludes the dependencies):";
+  for (auto& entry : sorted) {
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(3)
+         << std::setw(10) << entry.second.m_computations << " computed "
+         << std::setw(12) << entry.second.m_self_time << " s self "
+         << std::setw(12) << entry.second.m_total_time << " s total  "
+         << entry.first.getString();
+    logger.info() << line.str();
+  }
+
+  auto unused = getUnusedProperties();
+  if (!unused.empty()) {
+    logger.info() << "Properties computed but needed neither by the catalog nor by the framework:";
+    for (auto& property_id : unused) {
+      logger.info() << "  " << property_id.getString();
+    }
+  }
+}
+
+void PropertyPlanner::reset() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_dependencies.clear();
+  m_framework_requests.clear();
+  for (auto& record : m_thread_records) {
+    std::lock_guard<std::mutex> record_lock(record->m_mutex);
+    record->m_dependencies.clear();
+    record->m_framework_requests.clear();
+    record->m_stats.clear();
+  }
+  m_plan.reset();
+  ++m_version;
+}
+
+} // namespace SourceXtractor
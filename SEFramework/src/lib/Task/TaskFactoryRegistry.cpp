@@ -39,6 +39,14 @@ void TaskFactoryRegistry::configure(Euclid::Configuration::ConfigManager& manage
   }
 }
 
+std::set<PropertyId> TaskFactoryRegistry::getRequiredProperties(const PropertyId& property_id) const {
+  auto factory = m_type_task_factories_map.find(property_id.getTypeId());
+  if (factory == m_type_task_factories_map.end()) {
+    return {};
+  }
+  return factory->second->getRequiredProperties(property_id);
+}
+
 void TaskFactoryRegistry::registerPropertyInstances(OutputRegistry& output_registry) {
   for (auto& factory : m_task_factories) {
     factory->registerPropertyInstances(output_registry);
@@ -21,17 +21,68 @@
  */
 
 
-#include <mutex>
+#include <map>
+#include <utility>
 #include "SEFramework/Task/TaskProvider.h"
 
 namespace SourceXtractor {
 
 namespace {
-  std::mutex task_provider_mutex;
+  std::atomic<std::size_t> s_provider_serial{0};
+
+  /// Incremented every time a provider is destroyed, so the threads forget what they remember of it
+  std::atomic<std::size_t> s_destroyed_providers{0};
+
+  /**
+   * Tasks (or their absence) already requested by this thread, for tasks not yet in the published table.
+   * The tasks belong to their provider and are only referenced here, so they go with it.
+   */
+  struct ThreadTasks {
+    std::size_t m_destroyed_providers = 0;
+    std::map<std::pair<std::size_t, PropertyId>, std::weak_ptr<const Task>> m_tasks;
+  };
+
+  thread_local ThreadTasks s_thread_tasks;
+}
+
+TaskProvider::TaskProvider(std::shared_ptr<TaskFactoryRegistry> task_factory_registry)
+  : m_task_factory_registry(task_factory_registry), m_serial(s_provider_serial++), m_published(nullptr) {
+}
+
+TaskProvider::~TaskProvider() {
+  s_destroyed_providers++;
 }
 
 std::shared_ptr<const Task> TaskProvider::getTask(const PropertyId& property_id) const {
-  std::lock_guard<std::mutex> lock(task_provider_mutex);
+  auto published = m_published.load(std::memory_order_acquire);
+  if (published != nullptr) {
+    auto iterTask = published->find(property_id);
+    if (iterTask != published->end()) {
+      return iterTask->second;
+    }
+  }
+
+  auto destroyed_providers = s_destroyed_providers.load(std::memory_order_relaxed);
+  if (s_thread_tasks.m_destroyed_providers != destroyed_providers) {
+    s_thread_tasks.m_tasks.clear();
+    s_thread_tasks.m_destroyed_providers = destroyed_providers;
+  }
+
+  // The tasks are kept by m_tasks while the provider exists, so an expired entry is a missing task
+  auto key = std::make_pair(m_serial, property_id);
+  auto iterThread = s_thread_tasks.m_tasks.find(key);
+  if (iterThread != s_thread_tasks.m_tasks.end()) {
+    return iterThread->second.lock();
+  }
+
+  // Also remember when there is no task, so the lookup is not repeated under the lock
+  auto task = getTaskLocked(property_id);
+  s_thread_tasks.m_tasks.emplace(key, task);
+  return task;
+}
+
+std::shared_ptr<const Task> TaskProvider::getTaskLocked(const PropertyId& property_id) const {
+  std::lock_guard<std::mutex> lock(m_tasks_mutex);
 
   // tries to find the Task for the property
   auto iterTask = m_tasks.find(property_id);
@@ -45,7 +96,15 @@ std::shared_ptr<const Task> TaskProvider::getTask(const PropertyId& property_id)
       auto task = task_factory.createTask(property_id);
 
       // Put it in the cache
-      const_cast<TaskProvider&>(*this).m_tasks[property_id] = task;
+      m_tasks[property_id] = task;
+
+      // Publish a new table once the number of tasks doubles, so the tables kept alive
+      // are, together, at most twice as big as the last one
+      auto published = m_published.load(std::memory_order_relaxed);
+      if (published == nullptr || m_tasks.size() >= 2 * published->size()) {
+        m_published_tables.emplace_back(new TaskMap(m_tasks));
+        m_published.store(m_published_tables.back().get(), std::memory_order_release);
+      }
 
       return task;
     } catch (std::out_of_range&) {
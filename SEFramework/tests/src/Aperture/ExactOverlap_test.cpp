@@ -0,0 +1,109 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include "SEFramework/Aperture/CircularAperture.h"
+#include "SEFramework/Aperture/EllipticalAperture.h"
+#include "SEFramework/Aperture/ExactOverlap.h"
+#include "SEFramework/Aperture/TransformedAperture.h"
+
+using namespace SourceXtractor;
+
+/**
+ * Sum the area of all the pixels around the center
+ */
+static double totalArea(const Aperture& aperture, SeFloat cx, SeFloat cy, int size) {
+  std::vector<SeFloat> row(2 * size + 1);
+  double total = 0;
+  for (int y = -size; y <= size; ++y) {
+    aperture.getAreaRow(cx, cy, y, -size, size, row.data());
+    for (auto a : row) {
+      total += a;
+    }
+  }
+  return total;
+}
+
+BOOST_AUTO_TEST_SUITE (ExactOverlap_test)
+
+BOOST_AUTO_TEST_CASE(CircleInsideOutside_test) {
+  BOOST_CHECK_CLOSE(circularOverlap(-0.5, -0.5, 0.5, 0.5, 5.), 1., 1e-8);
+  BOOST_CHECK_EQUAL(circularOverlap(9.5, 9.5, 10.5, 10.5, 5.), 0.);
+  // A pixel bigger than the circle contains all of it
+  BOOST_CHECK_CLOSE(circularOverlap(-2, -2, 2, 2, 1.), M_PI, 1e-8);
+  // Half-plane
+  BOOST_CHECK_CLOSE(circularOverlap(0, -2, 2, 2, 1.), M_PI / 2, 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE(CircleTotal_test) {
+  for (double r : {0.3, 1., 2.7, 10.2}) {
+    CircularAperture aperture(r, ApertureOverlap::EXACT);
+    BOOST_CHECK_CLOSE(totalArea(aperture, 0.3, -0.2, 15), M_PI * r * r, 1e-4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CircleRow_test) {
+  CircularAperture aperture(3.4, ApertureOverlap::EXACT);
+  std::vector<SeFloat> row(11);
+  for (int y = -5; y <= 5; ++y) {
+    aperture.getAreaRow(0.2, 0.7, y, -5, 5, row.data());
+    for (int x = -5; x <= 5; ++x) {
+      BOOST_CHECK_CLOSE(row[x + 5] + 1., aperture.getArea(0.2, 0.7, x, y) + 1., 1e-4);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CircleVsSampled_test) {
+  CircularAperture exact(4., ApertureOverlap::EXACT), sampled(4.);
+  for (int y = -5; y <= 5; ++y) {
+    for (int x = -5; x <= 5; ++x) {
+      BOOST_CHECK_SMALL(exact.getArea(0, 0, x, y) - sampled.getArea(0, 0, x, y), SeFloat(0.1));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(EllipseAsCircle_test) {
+  for (int y = -4; y <= 4; ++y) {
+    for (int x = -4; x <= 4; ++x) {
+      BOOST_CHECK_CLOSE(ellipticalOverlap(x - .5, y - .5, x + .5, y + .5, 1., 1., 0., 2.5) + 1.,
+                        circularOverlap(x - .5, y - .5, x + .5, y + .5, 2.5) + 1., 1e-8);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(EllipseTotal_test) {
+  double cxx = 0.5, cyy = 1.2, cxy = 0.3, r = 3.5;
+  EllipticalAperture aperture(cxx, cyy, cxy, r, ApertureOverlap::EXACT);
+  double expected = M_PI * r * r / std::sqrt(cxx * cyy - cxy * cxy / 4);
+  BOOST_CHECK_CLOSE(totalArea(aperture, -0.4, 0.1, 15), expected, 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(TransformedExact_test) {
+  auto circle = std::make_shared<CircularAperture>(3., ApertureOverlap::EXACT);
+  TransformedAperture transformed(circle, std::make_tuple(2., 0.5, 0.2, 1.));
+  double det = 2. * 1. - 0.5 * 0.2;
+  BOOST_CHECK_CLOSE(totalArea(transformed, 0.1, 0.1, 20), M_PI * 9 * det, 1e-4);
+
+  SeFloat cxx, cyy, cxy, rad;
+  BOOST_CHECK(transformed.getExactEllipse(cxx, cyy, cxy, rad));
+  BOOST_CHECK(!TransformedAperture(std::make_shared<CircularAperture>(3.), std::make_tuple(1., 0., 0., 1.))
+    .getExactEllipse(cxx, cyy, cxy, rad));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,89 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include "SEFramework/CoordinateSystem/LocalAffineMapping.h"
+
+using namespace SourceXtractor;
+
+/**
+ * Linear coordinate system: world = origin + scale * R(angle) * image
+ */
+class LinearCoordinateSystem : public CoordinateSystem {
+public:
+  LinearCoordinateSystem(double origin_x, double origin_y, double scale, double angle)
+    : m_ox(origin_x), m_oy(origin_y), m_scale(scale), m_cos(std::cos(angle)), m_sin(std::sin(angle)) {}
+
+  WorldCoordinate imageToWorld(ImageCoordinate c) const override {
+    return {m_ox + m_scale * (m_cos * c.m_x - m_sin * c.m_y), m_oy + m_scale * (m_sin * c.m_x + m_cos * c.m_y)};
+  }
+
+  ImageCoordinate worldToImage(WorldCoordinate w) const override {
+    double dx = (w.m_alpha - m_ox) / m_scale, dy = (w.m_delta - m_oy) / m_scale;
+    return {m_cos * dx + m_sin * dy, -m_sin * dx + m_cos * dy};
+  }
+
+private:
+  double m_ox, m_oy, m_scale, m_cos, m_sin;
+};
+
+/**
+ * Strongly distorted coordinate system
+ */
+class QuadraticCoordinateSystem : public CoordinateSystem {
+public:
+  WorldCoordinate imageToWorld(ImageCoordinate c) const override {
+    return {c.m_x + 1e-2 * c.m_x * c.m_x, c.m_y + 1e-2 * c.m_y * c.m_y};
+  }
+
+  ImageCoordinate worldToImage(WorldCoordinate w) const override {
+    return {(std::sqrt(1 + 4e-2 * w.m_alpha) - 1) / 2e-2, (std::sqrt(1 + 4e-2 * w.m_delta) - 1) / 2e-2};
+  }
+};
+
+BOOST_AUTO_TEST_SUITE (LocalAffineMapping_test)
+
+BOOST_AUTO_TEST_CASE(Linear_test) {
+  LinearCoordinateSystem from(10, 20, 0.5, 0.3), to(-5, 3, 0.25, -0.1);
+  LocalAffineMapping mapping(from, to, 100, 200, 163, 263, 1e-6);
+
+  BOOST_CHECK(mapping.isValid());
+  for (double y = 200; y < 264; y += 7) {
+    for (double x = 100; x < 164; x += 7) {
+      auto exact = to.worldToImage(from.imageToWorld({x, y}));
+      auto approx = mapping(x, y);
+      BOOST_CHECK_SMALL(exact.m_x - approx.m_x, 1e-6);
+      BOOST_CHECK_SMALL(exact.m_y - approx.m_y, 1e-6);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Distorted_test) {
+  LinearCoordinateSystem to(0, 0, 1, 0);
+  QuadraticCoordinateSystem from;
+
+  LocalAffineMapping mapping(from, to, 100, 100, 163, 163, 0.01);
+  BOOST_CHECK(!mapping.isValid());
+  BOOST_CHECK_GT(mapping.getMaxResidual(), 0.01);
+
+  // Small enough region, the distortion is negligible
+  LocalAffineMapping small_mapping(from, to, 10, 10, 11, 11, 0.01);
+  BOOST_CHECK(small_mapping.isValid());
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
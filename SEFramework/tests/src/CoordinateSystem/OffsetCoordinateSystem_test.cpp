@@ -0,0 +1,89 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * OffsetCoordinateSystem_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/CoordinateSystem/OffsetCoordinateSystem.h"
+
+using namespace SourceXtractor;
+
+/// World coordinates are the image coordinates scaled by 2
+class ScaledCoordinateSystem : public CoordinateSystem {
+public:
+  WorldCoordinate imageToWorld(ImageCoordinate image_coordinate) const override {
+    return WorldCoordinate(image_coordinate.m_x * 2, image_coordinate.m_y * 2);
+  }
+
+  ImageCoordinate worldToImage(WorldCoordinate world_coordinate) const override {
+    return ImageCoordinate(world_coordinate.m_alpha / 2, world_coordinate.m_delta / 2);
+  }
+
+  std::map<std::string, std::string> getFitsHeaders() const override {
+    return {{"CRPIX1", "100.5 / Pixel coordinate of reference point"}, {"CRPIX2", "50"}, {"CDELT1", "2"}};
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (OffsetCoordinateSystem_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( coordinates_test ) {
+  OffsetCoordinateSystem offset(std::make_shared<ScaledCoordinateSystem>(), PixelCoordinate(10, 20));
+
+  auto world = offset.imageToWorld(ImageCoordinate(1, 2));
+  BOOST_CHECK_EQUAL(world.m_alpha, 22);
+  BOOST_CHECK_EQUAL(world.m_delta, 44);
+
+  auto image = offset.worldToImage(world);
+  BOOST_CHECK_EQUAL(image.m_x, 1);
+  BOOST_CHECK_EQUAL(image.m_y, 2);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( headers_test ) {
+  OffsetCoordinateSystem offset(std::make_shared<ScaledCoordinateSystem>(), PixelCoordinate(10, 20));
+
+  auto headers = offset.getFitsHeaders();
+  BOOST_CHECK_EQUAL(headers.at("CRPIX1"), "90.5 / Pixel coordinate of reference point");
+  BOOST_CHECK_EQUAL(headers.at("CRPIX2"), "30");
+  BOOST_CHECK_EQUAL(headers.at("CDELT1"), "2");
+  BOOST_CHECK_EQUAL(headers.at("LTV1"), "-10");
+  BOOST_CHECK_EQUAL(headers.at("LTV2"), "-20");
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( without_coordinate_system_test ) {
+  OffsetCoordinateSystem offset(nullptr, PixelCoordinate(10, 20));
+
+  auto headers = offset.getFitsHeaders();
+  BOOST_CHECK_EQUAL(headers.size(), 2);
+  BOOST_CHECK_EQUAL(headers.at("LTV1"), "-10");
+  BOOST_CHECK_THROW(offset.imageToWorld(ImageCoordinate(1, 2)), InvalidCoordinatesException);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
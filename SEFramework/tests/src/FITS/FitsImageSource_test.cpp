@@ -20,7 +20,10 @@
  * @author Alejandro Alvarez Ayllon
  */
 
+#include <vector>
+
 #include <boost/test/unit_test.hpp>
+#include <fitsio.h>
 
 #include "ElementsKernel/Temporary.h"
 #include <ElementsKernel/Auxiliary.h>
@@ -180,6 +183,91 @@ BOOST_FIXTURE_TEST_CASE(write_fits_headers, FitsImageSourceFixture) {
   }
 }
 
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(memory_mapped_read_test, FitsImageSourceFixture) {
+  {
+    auto image_source = std::make_shared<FitsImageSource>(temp_path.path().native(),
+        50, 40, ImageTile::FloatImage, nullptr, false, true);
+    auto image = WriteableBufferedImage<float>::create(image_source);
+    for (int y = 0; y < 40; ++y) {
+      for (int x = 0; x < 50; ++x) {
+        image->setValue(x, y, x * 0.5f - y * 3.25f);
+      }
+    }
+  }
+  TileManager::getInstance()->flush();
+
+  // Compressed images are served by cfitsio
+  FitsImageSource::setMemoryMapping(true);
+  auto compressed = std::make_shared<FitsImageSource>(mhdu_path + "[1]", 0, ImageTile::FloatImage);
+  BOOST_CHECK(!compressed->isMemoryMapped());
+  BOOST_CHECK_CLOSE(compressed->getImageTile(0, 0, 1, 1)->getValue<SeFloat>(0, 0), 256.2f, 1e-8);
+
+  auto float_source = std::make_shared<FitsImageSource>(temp_path.path().native(), 2);
+  auto double_source = std::make_shared<FitsImageSource>(temp_path.path().native(), 2, ImageTile::DoubleImage);
+  BOOST_CHECK(float_source->isMemoryMapped());
+  BOOST_CHECK(double_source->isMemoryMapped());
+  auto float_tile = float_source->getImageTile(7, 5, 30, 20);
+  auto double_tile = double_source->getImageTile(7, 5, 30, 20);
+
+  FitsImageSource::setMemoryMapping(false);
+  auto cfitsio_source = std::make_shared<FitsImageSource>(temp_path.path().native(), 2);
+  BOOST_CHECK(!cfitsio_source->isMemoryMapped());
+  auto cfitsio_tile = cfitsio_source->getImageTile(7, 5, 30, 20);
+
+  for (int y = 5; y < 25; ++y) {
+    for (int x = 7; x < 37; ++x) {
+      BOOST_CHECK_EQUAL(float_tile->getValue<float>(x, y), x * 0.5f - y * 3.25f);
+      BOOST_CHECK_EQUAL(double_tile->getValue<double>(x, y), x * 0.5f - y * 3.25f);
+      BOOST_CHECK_EQUAL(cfitsio_tile->getValue<float>(x, y), float_tile->getValue<float>(x, y));
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(cube_layers_test, FitsImageSourceFixture) {
+  {
+    int status = 0;
+    fitsfile *fptr = nullptr;
+    long naxes[3] = {6, 4, 3};
+    std::vector<float> pixels;
+    for (int z = 0; z < 3; ++z) {
+      for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 6; ++x) {
+          pixels.emplace_back(x + 10 * y + 100 * z);
+        }
+      }
+    }
+    fits_create_file(&fptr, ("!" + temp_path.path().native()).c_str(), &status);
+    fits_create_img(fptr, FLOAT_IMG, 3, naxes, &status);
+    fits_write_img(fptr, TFLOAT, 1, pixels.size(), pixels.data(), &status);
+    fits_close_file(fptr, &status);
+    BOOST_REQUIRE_EQUAL(status, 0);
+  }
+
+  for (bool mapping : {false, true}) {
+    FitsImageSource::setMemoryMapping(mapping);
+    auto cube = std::make_shared<FitsImageSource>(temp_path.path().native(), 1, ImageTile::FloatImage);
+    BOOST_CHECK_EQUAL(cube->getDepth(), 3);
+    BOOST_CHECK_THROW(cube->createLayer(3), Elements::Exception);
+
+    for (int z = 0; z < 3; ++z) {
+      auto layer = cube->createLayer(z);
+      BOOST_CHECK_EQUAL(layer->getWidth(), 6);
+      BOOST_CHECK_EQUAL(layer->getHeight(), 4);
+      BOOST_CHECK_EQUAL(layer->isMemoryMapped(), mapping);
+      auto tile = layer->getImageTile(1, 1, 4, 3);
+      for (int y = 1; y < 4; ++y) {
+        for (int x = 1; x < 5; ++x) {
+          BOOST_CHECK_EQUAL(tile->getValue<float>(x, y), x + 10 * y + 100 * z);
+        }
+      }
+    }
+  }
+  FitsImageSource::setMemoryMapping(false);
+}
 
 //-----------------------------------------------------------------------------
 
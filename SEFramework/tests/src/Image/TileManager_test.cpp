@@ -0,0 +1,231 @@
+/** Copyright © 2019 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * TileManager_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+#include "SEFramework/Image/WriteableBufferedImage.h"
+#include "SEFramework/Image/VectorImage.h"
+#include "SEFramework/Image/ImageAccessor.h"
+
+using namespace SourceXtractor;
+
+class WriteableImageSourceMock : public ImageSource {
+public:
+  WriteableImageSourceMock(int width, int height)
+    : m_img(VectorImage<float>::create(width, height)), m_save_count(0), m_flush_count(0) {}
+
+  virtual ~WriteableImageSourceMock() = default;
+
+  std::string getRepr() const override {
+    return "WriteableImageSourceMock";
+  }
+
+  void saveTile(ImageTile& tile) override {
+    for (int iy = tile.getPosY(); iy < tile.getPosY() + tile.getHeight(); ++iy) {
+      for (int ix = tile.getPosX(); ix < tile.getPosX() + tile.getWidth(); ++ix) {
+        m_img->setValue(ix, iy, tile.getValue<float>(ix, iy));
+      }
+    }
+    ++m_save_count;
+  }
+
+  void flush() override {
+    ++m_flush_count;
+  }
+
+  int getWidth() const override {
+    return m_img->getWidth();
+  }
+
+  int getHeight() const override {
+    return m_img->getHeight();
+  }
+
+  std::shared_ptr<ImageTile> getImageTile(int x, int y, int width, int height) const override {
+    auto tile = ImageTile::create(ImageTile::FloatImage, x, y, width, height);
+    for (int iy = y; iy < y + height; ++iy) {
+      for (int ix = x; ix < x + width; ++ix) {
+        tile->setValue(ix, iy, m_img->getValue(ix, iy));
+      }
+    }
+    return tile;
+  }
+
+  ImageTile::ImageType getType() const override {
+    return ImageTile::FloatImage;
+  }
+
+  std::shared_ptr<VectorImage<float>> m_img;
+  int m_save_count, m_flush_count;
+};
+
+struct TileManagerFixture {
+  std::shared_ptr<WriteableImageSourceMock> m_source;
+  std::shared_ptr<TileManager> m_tile_manager;
+
+  TileManagerFixture()
+    : m_source(std::make_shared<WriteableImageSourceMock>(1024, 1024)),
+      m_tile_manager(std::make_shared<TileManager>()) {
+  }
+
+  void fill() {
+    auto image = WriteableBufferedImage<float>::create(m_source, m_tile_manager);
+    for (int y = 0; y < 1024; ++y) {
+      for (int x = 0; x < 1024; ++x) {
+        image->setValue(x, y, x + y * 1024.f);
+      }
+    }
+  }
+
+  bool check(const std::shared_ptr<const Image<float>>& image) {
+    ImageAccessor<float> accessor(image);
+    for (int y = 0; y < 1024; ++y) {
+      for (int x = 0; x < 1024; ++x) {
+        if (accessor.getValue(x, y) != x + y * 1024.f) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (TileManager_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (Coalesce_test, TileManagerFixture) {
+  m_tile_manager->setOptions(256, 256, 64);
+  m_tile_manager->setWriteBack(true);
+  fill();
+  m_tile_manager->flush();
+
+  // A single block covering the 16 tiles, and a single flush
+  BOOST_CHECK_EQUAL(m_source->m_save_count, 1);
+  BOOST_CHECK_EQUAL(m_source->m_flush_count, 1);
+  BOOST_CHECK(check(m_source->m_img));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (Eviction_test, TileManagerFixture) {
+  // Room for only four tiles
+  m_tile_manager->setOptions(256, 256, 1);
+  m_tile_manager->setWriteBack(true);
+  fill();
+
+  // Read back while tiles are evicted, queued, or being written
+  auto image = BufferedImage<float>::create(m_source, m_tile_manager);
+  BOOST_CHECK(check(image));
+
+  m_tile_manager->flush();
+  BOOST_CHECK_LE(m_source->m_save_count, 16);
+  BOOST_CHECK_EQUAL(m_source->m_flush_count, 1);
+  BOOST_CHECK(check(m_source->m_img));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (SaveAll_test, TileManagerFixture) {
+  m_tile_manager->setOptions(256, 256, 64);
+  m_tile_manager->setWriteBack(true);
+  auto image = WriteableBufferedImage<float>::create(m_source, m_tile_manager);
+  image->setValue(0, 0, 1.f);
+  m_tile_manager->saveAllTiles();
+  BOOST_CHECK_EQUAL(m_source->m_img->getValue(0, 0), 1.f);
+
+  // The tile is still cached, later changes are saved again
+  image->setValue(0, 0, 2.f);
+  m_tile_manager->saveAllTiles();
+  BOOST_CHECK_EQUAL(m_source->m_img->getValue(0, 0), 2.f);
+  BOOST_CHECK_EQUAL(m_source->m_save_count, 2);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (ReleaseTilesBefore_test, TileManagerFixture) {
+  m_tile_manager->setOptions(256, 256, 64);
+  std::unordered_set<std::shared_ptr<const ImageSource>> sources;
+  {
+    TileManager::SourceRecorder recorder;
+    fill();
+    sources = recorder.getSources();
+  }
+  BOOST_CHECK_EQUAL(sources.size(), 1);
+
+  // The first two rows of tiles end before the line, and are saved
+  m_tile_manager->releaseTilesBefore(600, sources);
+  BOOST_CHECK_EQUAL(m_source->m_save_count, 8);
+  BOOST_CHECK_EQUAL(m_source->m_img->getValue(1023, 511), 1023 + 511 * 1024.f);
+  BOOST_CHECK_EQUAL(m_source->m_img->getValue(0, 512), 0.f);
+
+  // They are loaded again if needed
+  auto image = BufferedImage<float>::create(m_source, m_tile_manager);
+  BOOST_CHECK(check(image));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (ReleaseTilesBeforeOtherSource_test, TileManagerFixture) {
+  m_tile_manager->setOptions(256, 256, 64);
+  fill();
+
+  // Only the tiles of the given sources are released
+  auto other_source = std::make_shared<WriteableImageSourceMock>(1024, 1024);
+  m_tile_manager->releaseTilesBefore(600, {other_source});
+  BOOST_CHECK_EQUAL(m_source->m_save_count, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (ReleaseTilesBeforeHeld_test, TileManagerFixture) {
+  m_tile_manager->setOptions(256, 256, 64);
+  fill();
+
+  // A group from the row 600 is being measured, only the first row of tiles can go
+  m_tile_manager->holdRowsFrom(600);
+  m_tile_manager->releaseTilesBefore(800, {m_source});
+  BOOST_CHECK_EQUAL(m_source->m_save_count, 4);
+
+  // Once measured, the rest goes too
+  m_tile_manager->unholdRowsFrom(600);
+  m_tile_manager->releaseTilesBefore(800, {m_source});
+  BOOST_CHECK_EQUAL(m_source->m_save_count, 12);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE (Synchronous_test, TileManagerFixture) {
+  m_tile_manager->setOptions(256, 256, 1);
+  m_tile_manager->setWriteBack(false);
+  fill();
+  m_tile_manager->flush();
+
+  BOOST_CHECK_EQUAL(m_source->m_save_count, 16);
+  BOOST_CHECK_EQUAL(m_source->m_flush_count, 1);
+  BOOST_CHECK(check(m_source->m_img));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,170 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * OutputRegistry_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+
+#include "ElementsKernel/Exception.h"
+
+#include "SEFramework/Output/OutputRegistry.h"
+#include "SEFramework/Property/Property.h"
+#include "SEFramework/Source/SimpleSource.h"
+
+using namespace SourceXtractor;
+
+class FluxProperty : public Property {
+public:
+  FluxProperty(double flux, std::int64_t flags) : m_flux(flux), m_flags(flags) {}
+
+  double m_flux;
+  std::int64_t m_flags;
+};
+
+class PositionProperty : public Property {
+public:
+  explicit PositionProperty(double x) : m_x(x) {}
+
+  double m_x;
+};
+
+class UnregisteredProperty : public Property {
+};
+
+/// Keeps track of the properties requested from it
+class RecordingSource : public SimpleSource {
+public:
+  using SimpleSource::getProperty;
+
+  mutable std::vector<PropertyId> m_requested;
+
+protected:
+  const Property& getProperty(const PropertyId& property_id) const override {
+    m_requested.emplace_back(property_id);
+    return SimpleSource::getProperty(property_id);
+  }
+};
+
+struct OutputRegistryFixture {
+  OutputRegistry m_registry;
+  RecordingSource m_source;
+
+  OutputRegistryFixture() {
+    m_registry.registerColumnConverter<FluxProperty, double>(
+      "flux", [](const FluxProperty& p) { return p.m_flux; }, "count", "Total flux");
+    m_registry.registerColumnConverter<FluxProperty, std::int64_t>(
+      "flux_flags", [](const FluxProperty& p) { return p.m_flags; });
+    m_registry.registerColumnConverter<PositionProperty, double>(
+      "x", [](const PositionProperty& p) { return p.m_x; }, "pixel");
+    m_registry.enableOutput<FluxProperty>("Flux");
+    m_registry.enableOutput<PositionProperty>("Position");
+
+    m_source.setProperty<PositionProperty>(12.5);
+  }
+
+  std::size_t countRequests(const PropertyId& property_id) const {
+    return std::count(m_source.m_requested.begin(), m_source.m_requested.end(), property_id);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (OutputRegistry_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( row_converter_test, OutputRegistryFixture ) {
+  m_source.setProperty<FluxProperty>(100., 2);
+
+  auto converter = m_registry.getSourceToRowConverter({"Position", "Flux"});
+  auto row = converter(m_source);
+
+  // Columns follow the order of the output properties, then of the registration
+  auto column_info = row.getColumnInfo();
+  BOOST_REQUIRE_EQUAL(column_info->size(), 3);
+  BOOST_CHECK_EQUAL(column_info->getDescription(0).name, "x");
+  BOOST_CHECK_EQUAL(column_info->getDescription(0).unit, "pixel");
+  BOOST_CHECK_EQUAL(column_info->getDescription(1).name, "flux");
+  BOOST_CHECK_EQUAL(column_info->getDescription(1).description, "Total flux");
+  BOOST_CHECK_EQUAL(column_info->getDescription(2).name, "flux_flags");
+  BOOST_CHECK(column_info->getDescription(2).type == typeid(std::int64_t));
+
+  BOOST_CHECK_EQUAL(boost::get<double>(row[0]), 12.5);
+  BOOST_CHECK_EQUAL(boost::get<double>(row[1]), 100.);
+  BOOST_CHECK_EQUAL(boost::get<std::int64_t>(row[2]), 2);
+
+  // All the rows share the column information
+  BOOST_CHECK_EQUAL(converter(m_source).getColumnInfo(), column_info);
+}
+
+BOOST_FIXTURE_TEST_CASE( row_converter_instances_test, OutputRegistryFixture ) {
+  m_registry.registerPropertyInstances<FluxProperty>({{"a", 0}, {"b", 1}});
+  m_source.setIndexedProperty<FluxProperty>(0, 1., 0);
+  m_source.setIndexedProperty<FluxProperty>(1, 2., 1);
+
+  auto row = m_registry.getSourceToRowConverter({"Flux"})(m_source);
+
+  auto column_info = row.getColumnInfo();
+  BOOST_REQUIRE_EQUAL(column_info->size(), 4);
+  BOOST_CHECK_EQUAL(column_info->getDescription(0).name, "flux_a");
+  BOOST_CHECK_EQUAL(column_info->getDescription(1).name, "flux_b");
+  BOOST_CHECK_EQUAL(column_info->getDescription(2).name, "flux_flags_a");
+  BOOST_CHECK_EQUAL(column_info->getDescription(3).name, "flux_flags_b");
+  BOOST_CHECK_EQUAL(boost::get<double>(row[0]), 1.);
+  BOOST_CHECK_EQUAL(boost::get<double>(row[1]), 2.);
+  BOOST_CHECK_EQUAL(boost::get<std::int64_t>(row[3]), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE( row_converter_errors_test, OutputRegistryFixture ) {
+  m_registry.enableOutput<UnregisteredProperty>("Unregistered", true);
+
+  // Reported when the converter is created, not on the first row
+  BOOST_CHECK_THROW(m_registry.getSourceToRowConverter({"Unknown"}), Elements::Exception);
+  BOOST_CHECK_THROW(m_registry.getSourceToRowConverter({"Unregistered"}), Elements::Exception);
+  BOOST_CHECK_THROW(m_registry.getSourceToRowConverter({}), Elements::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE( property_requester_test, OutputRegistryFixture ) {
+  m_registry.registerPropertyInstances<FluxProperty>({{"a", 0}, {"b", 1}});
+  m_source.setIndexedProperty<FluxProperty>(0, 1., 0);
+  m_source.setIndexedProperty<FluxProperty>(1, 2., 1);
+
+  auto requester = m_registry.getSourcePropertyRequester({"Flux", "Position"});
+  requester(m_source);
+
+  // Each property instance is requested once, even if several columns come from it
+  BOOST_CHECK_EQUAL(m_source.m_requested.size(), 3);
+  BOOST_CHECK_EQUAL(countRequests(PropertyId::create<FluxProperty>(0)), 1);
+  BOOST_CHECK_EQUAL(countRequests(PropertyId::create<FluxProperty>(1)), 1);
+  BOOST_CHECK_EQUAL(countRequests(PropertyId::create<PositionProperty>()), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE( property_requester_missing_test, OutputRegistryFixture ) {
+  auto requester = m_registry.getSourcePropertyRequester({"Flux"});
+
+  // The properties are not converted, but a property that can not be provided is still an error
+  BOOST_CHECK_THROW(requester(m_source), PropertyNotFoundException);
+  BOOST_CHECK_THROW(m_registry.getSourcePropertyRequester({"Unknown"}), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
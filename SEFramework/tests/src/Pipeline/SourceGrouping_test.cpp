@@ -56,6 +56,24 @@ class TestGroupingCriteria : public GroupingCriteria {
   }
 };
 
+// Selects the sources by id, either any of them or the whole group
+class IdSelectionCriteria : public SelectionCriteria {
+public:
+  IdSelectionCriteria(std::string id, bool whole_group) : m_id(id), m_whole_group(whole_group) {}
+
+  bool mustBeProcessed(const SourceInterface& source) const override {
+    return source.getProperty<IdProperty>().id <= m_id;
+  }
+
+  bool requiresWholeGroup() const override {
+    return m_whole_group;
+  }
+
+private:
+  std::string m_id;
+  bool m_whole_group;
+};
+
 class SourceGroupObserver : public Observer<SourceGroupInterface> {
 public:
   virtual void handleMessage(const SourceGroupInterface& group) override {
@@ -166,6 +184,46 @@ BOOST_FIXTURE_TEST_CASE( process_sources_test, SourceGroupingFixture ) {
 
 }
 
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( whole_group_selection_test, SourceGroupingFixture ) {
+  source_a->setProperty<SimpleIntProperty>(1);
+  source_b->setProperty<SimpleIntProperty>(2);
+  source_c->setProperty<SimpleIntProperty>(1);
+
+  source_grouping->receiveSource(std::move(source_a));
+  source_grouping->receiveSource(std::move(source_b));
+  source_grouping->receiveSource(std::move(source_c));
+
+  // C is not selected, so its group with A is kept
+  source_grouping->receiveProcessSignal(ProcessSourcesEvent { std::make_shared<IdSelectionCriteria>("B", true) } );
+  BOOST_CHECK_EQUAL(source_group_observer->m_list.size(), 1);
+  BOOST_CHECK(source_group_observer->m_list[0] == std::vector<std::string>{"B"});
+
+  source_grouping->receiveProcessSignal(ProcessSourcesEvent { std::make_shared<IdSelectionCriteria>("C", true) } );
+  BOOST_CHECK_EQUAL(source_group_observer->m_list.size(), 2);
+  BOOST_CHECK((source_group_observer->m_list[1] == std::vector<std::string>{"A", "C"}));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( any_source_selection_test, SourceGroupingFixture ) {
+  source_a->setProperty<SimpleIntProperty>(1);
+  source_b->setProperty<SimpleIntProperty>(2);
+  source_c->setProperty<SimpleIntProperty>(1);
+
+  source_grouping->receiveSource(std::move(source_a));
+  source_grouping->receiveSource(std::move(source_b));
+  source_grouping->receiveSource(std::move(source_c));
+
+  // A is enough to process its group
+  source_grouping->receiveProcessSignal(ProcessSourcesEvent { std::make_shared<IdSelectionCriteria>("A", false) } );
+  BOOST_CHECK_EQUAL(source_group_observer->m_list.size(), 1);
+  BOOST_CHECK((source_group_observer->m_list[0] == std::vector<std::string>{"A", "C"}));
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_FIXTURE_TEST_CASE( grouping_limit, SourceGroupingFixture ) {
   source_a->setProperty<SimpleIntProperty>(1);
   source_b->setProperty<SimpleIntProperty>(1);
@@ -0,0 +1,143 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "ElementsKernel/Temporary.h"
+
+#include "SEFramework/Pipeline/Tracer.h"
+
+using namespace SourceXtractor;
+
+namespace SourceXtractor {
+struct TracedTask {};
+}
+
+struct TracerFixture {
+  Elements::TempFile trace_file;
+  Tracer& tracer = Tracer::getInstance();
+
+  ~TracerFixture() {
+    tracer.stop();
+  }
+
+  boost::property_tree::ptree readEvents() {
+    boost::property_tree::ptree trace;
+    boost::property_tree::read_json(trace_file.path().native(), trace);
+    return trace.get_child("traceEvents");
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (Tracer_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Threads_test, TracerFixture ) {
+  tracer.start(trace_file.path().native());
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([this, t]() {
+      tracer.setThreadName("worker " + std::to_string(t));
+      for (int i = 0; i < 10; ++i) {
+        Tracer::Scope outer("measurement", "Measure group");
+        Tracer::Scope inner("task", typeid(TracedTask));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  tracer.stop();
+
+  std::map<std::string, int> counts;
+  std::map<int, std::string> thread_names;
+  for (auto& entry : readEvents()) {
+    auto& event = entry.second;
+    auto phase = event.get<std::string>("ph");
+    if (phase == "M") {
+      thread_names[event.get<int>("tid")] = event.get<std::string>("args.name");
+    }
+    else {
+      BOOST_CHECK_EQUAL(phase, "X");
+      BOOST_CHECK_GE(event.get<double>("ts"), 0.);
+      BOOST_CHECK_GE(event.get<double>("dur"), 0.);
+      ++counts[event.get<std::string>("cat") + "/" + event.get<std::string>("name")];
+    }
+  }
+
+  BOOST_CHECK_EQUAL(counts.size(), 2);
+  BOOST_CHECK_EQUAL(counts["measurement/Measure group"], 40);
+  BOOST_CHECK_EQUAL(counts["task/SourceXtractor::TracedTask"], 40);
+
+  int named = 0;
+  for (auto& entry : thread_names) {
+    named += (entry.second.compare(0, 7, "worker ") == 0);
+  }
+  BOOST_CHECK_EQUAL(named, 4);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Disabled_test, TracerFixture ) {
+  {
+    Tracer::Scope scope("segmentation", "Label");
+  }
+
+  tracer.start(trace_file.path().native());
+  tracer.stop();
+
+  // Scopes outside of the recording are not written
+  {
+    Tracer::Scope scope("segmentation", "Label");
+  }
+
+  for (auto& entry : readEvents()) {
+    BOOST_CHECK_EQUAL(entry.second.get<std::string>("ph"), "M");
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( LargeTrace_test, TracerFixture ) {
+  tracer.start(trace_file.path().native());
+  for (int i = 0; i < 40000; ++i) {
+    Tracer::Scope scope("grouping", "Receive source");
+  }
+  tracer.stop();
+
+  int count = 0, writes = 0;
+  for (auto& entry : readEvents()) {
+    auto name = entry.second.get<std::string>("name");
+    count += (name == "Receive source");
+    writes += (name == "Write trace");
+  }
+  BOOST_CHECK_EQUAL(count, 40000);
+  BOOST_CHECK_GT(writes, 0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
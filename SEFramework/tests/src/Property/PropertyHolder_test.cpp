@@ -130,6 +130,37 @@ BOOST_FIXTURE_TEST_CASE( isPropertySet_test, ObjectWithPropertiesFixture ) {
   BOOST_CHECK(!object.isPropertySet(PropertyId::create<SimpleStringProperty>(1)));
 }
 
+BOOST_FIXTURE_TEST_CASE( sparse_test, ObjectWithPropertiesFixture ) {
+  // A high index, as a per-frame property of the last of many frames, only takes one entry
+  object.setProperty(std::unique_ptr<SimpleIntProperty>(new SimpleIntProperty(100000)),
+      PropertyId::create<SimpleIntProperty>(100000));
+  BOOST_CHECK_EQUAL(object.size(), 1);
+  BOOST_CHECK(!object.isPropertySet(PropertyId::create<SimpleIntProperty>(99999)));
+
+  // Instances set out of order are all found
+  for (int index : {7, 0, 42, 3}) {
+    object.setProperty(std::unique_ptr<SimpleIntProperty>(new SimpleIntProperty(index)),
+        PropertyId::create<SimpleIntProperty>(index));
+  }
+  object.setProperty(std::unique_ptr<SimpleStringProperty>(new SimpleStringProperty(test_string)),
+      PropertyId::create<SimpleStringProperty>(5));
+  BOOST_CHECK_EQUAL(object.size(), 6);
+  for (int index : {0, 3, 7, 42, 100000}) {
+    auto& int_property = dynamic_cast<const SimpleIntProperty&>(
+        object.getProperty(PropertyId::create<SimpleIntProperty>(index)));
+    BOOST_CHECK_EQUAL(int_property.m_value, index);
+  }
+  BOOST_CHECK(!object.isPropertySet(PropertyId::create<SimpleStringProperty>()));
+
+  // Setting it again replaces it
+  object.setProperty(std::unique_ptr<SimpleIntProperty>(new SimpleIntProperty(magic_number)),
+      PropertyId::create<SimpleIntProperty>(42));
+  BOOST_CHECK_EQUAL(object.size(), 6);
+  auto& int_property = dynamic_cast<const SimpleIntProperty&>(
+      object.getProperty(PropertyId::create<SimpleIntProperty>(42)));
+  BOOST_CHECK_EQUAL(int_property.m_value, magic_number);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END ()
@@ -56,6 +56,23 @@ BOOST_AUTO_TEST_CASE( example_test ) {
 
 //-----------------------------------------------------------------------------
 
+BOOST_AUTO_TEST_CASE( slot_test ) {
+  auto a0 = PropertyId::create<ExamplePropertyA>();
+  auto a1 = PropertyId::create<ExamplePropertyA>(1);
+  auto b0 = PropertyId::create<ExamplePropertyB>();
+
+  // Slots are stable, and unique per type
+  BOOST_CHECK_EQUAL(a0.getTypeSlot(), PropertyId::create<ExamplePropertyA>().getTypeSlot());
+  BOOST_CHECK_EQUAL(a0.getTypeSlot(), a1.getTypeSlot());
+  BOOST_CHECK_NE(a0.getTypeSlot(), b0.getTypeSlot());
+
+  // The index still tells the instances apart
+  BOOST_CHECK(!(a0 == a1));
+  BOOST_CHECK(a1 == PropertyId::create<ExamplePropertyA>(1));
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END ()
 
 
@@ -0,0 +1,245 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <algorithm>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Property/Property.h"
+#include "SEFramework/Source/SimpleSourceGroup.h"
+#include "SEFramework/Source/SourceWithOnDemandProperties.h"
+#include "SEFramework/Task/PropertyPlanner.h"
+#include "SEFramework/Task/SourceTask.h"
+#include "SEFramework/Task/TaskProvider.h"
+
+using namespace SourceXtractor;
+
+struct PropertyA : public Property {};
+struct PropertyB : public Property {};
+struct PropertyC : public Property {};
+struct PropertyD : public Property {};
+
+// A <- B <- C, and D <- C
+struct TaskA : public SourceTask {
+  void computeProperties(SourceInterface& source) const override {
+    source.getProperty<PropertyB>();
+    source.setProperty<PropertyA>();
+  }
+};
+
+struct TaskB : public SourceTask {
+  void computeProperties(SourceInterface& source) const override {
+    source.getProperty<PropertyC>();
+    source.setProperty<PropertyB>();
+  }
+};
+
+struct TaskC : public SourceTask {
+  void computeProperties(SourceInterface& source) const override {
+    source.setProperty<PropertyC>();
+  }
+};
+
+struct TaskD : public SourceTask {
+  void computeProperties(SourceInterface& source) const override {
+    source.getProperty<PropertyC>();
+    source.setProperty<PropertyD>();
+  }
+};
+
+class ExampleTaskProvider : public TaskProvider {
+public:
+  ExampleTaskProvider() : TaskProvider(nullptr) {}
+
+protected:
+  std::shared_ptr<const Task> getTask(const PropertyId& property_id) const override {
+    if (property_id == PropertyId::create<PropertyA>())
+      return std::make_shared<TaskA>();
+    if (property_id == PropertyId::create<PropertyB>())
+      return std::make_shared<TaskB>();
+    if (property_id == PropertyId::create<PropertyC>())
+      return std::make_shared<TaskC>();
+    if (property_id == PropertyId::create<PropertyD>())
+      return std::make_shared<TaskD>();
+    return nullptr;
+  }
+};
+
+struct PropertyPlannerFixture {
+  std::shared_ptr<ExampleTaskProvider> provider = std::make_shared<ExampleTaskProvider>();
+  PropertyPlanner& planner = PropertyPlanner::getInstance();
+
+  PropertyPlannerFixture() {
+    planner.reset();
+    planner.setOutputTypes({typeid(PropertyA)});
+    // TaskD requests C too, but as if it did only under some conditions
+    planner.setRequiredProperties([](const PropertyId& property_id) {
+      if (property_id == PropertyId::create<PropertyA>())
+        return std::set<PropertyId>{PropertyId::create<PropertyB>()};
+      if (property_id == PropertyId::create<PropertyB>())
+        return std::set<PropertyId>{PropertyId::create<PropertyC>()};
+      return std::set<PropertyId>{};
+    });
+    planner.setRecording(true);
+    planner.setStatistics(true);
+  }
+
+  ~PropertyPlannerFixture() {
+    planner.setRecording(false);
+    planner.setStatistics(false);
+    planner.setRequiredProperties(nullptr);
+    planner.reset();
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (PropertyPlanner_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Dependencies_test, PropertyPlannerFixture ) {
+  for (int i = 0; i < 3; ++i) {
+    SourceWithOnDemandProperties source(provider);
+    source.getProperty<PropertyD>();
+    source.getProperty<PropertyA>();
+  }
+
+  BOOST_CHECK(planner.getDependencies(PropertyId::create<PropertyA>()) ==
+              std::set<PropertyId>{PropertyId::create<PropertyB>()});
+  BOOST_CHECK(planner.getDependencies(PropertyId::create<PropertyB>()) ==
+              std::set<PropertyId>{PropertyId::create<PropertyC>()});
+  BOOST_CHECK(planner.getDependencies(PropertyId::create<PropertyD>()) ==
+              std::set<PropertyId>{PropertyId::create<PropertyC>()});
+
+  // C is computed once per source, even if requested twice
+  auto stats = planner.getStats();
+  BOOST_CHECK_EQUAL(stats.at(PropertyId::create<PropertyC>()).m_computations, 3);
+  BOOST_CHECK_GE(stats.at(PropertyId::create<PropertyA>()).m_total_time,
+                 stats.at(PropertyId::create<PropertyA>()).m_self_time);
+
+  std::vector<PropertyId> expected_plan{
+    PropertyId::create<PropertyC>(), PropertyId::create<PropertyB>(), PropertyId::create<PropertyA>()
+  };
+  BOOST_CHECK(*planner.getPlan() == expected_plan);
+
+  // D is requested from outside a task, as the grouping would do
+  BOOST_CHECK(planner.getUnusedProperties().empty());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Declared_test, PropertyPlannerFixture ) {
+  // The learnt dependencies of A are not declared, so they are not planned
+  planner.setOutputTypes({typeid(PropertyA), typeid(PropertyD)});
+  planner.setRequiredProperties([](const PropertyId& property_id) {
+    if (property_id == PropertyId::create<PropertyD>())
+      return std::set<PropertyId>{PropertyId::create<PropertyC>()};
+    return std::set<PropertyId>{};
+  });
+
+  SourceWithOnDemandProperties source(provider);
+  source.getProperty<PropertyA>();
+  source.getProperty<PropertyD>();
+
+  auto plan = planner.getPlan();
+  std::set<PropertyId> expected_plan{
+    PropertyId::create<PropertyA>(), PropertyId::create<PropertyC>(), PropertyId::create<PropertyD>()
+  };
+  BOOST_CHECK(std::set<PropertyId>(plan->begin(), plan->end()) == expected_plan);
+  BOOST_CHECK_EQUAL(plan->size(), 3);
+  BOOST_CHECK(std::find(plan->begin(), plan->end(), PropertyId::create<PropertyC>()) <
+              std::find(plan->begin(), plan->end(), PropertyId::create<PropertyD>()));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Execute_test, PropertyPlannerFixture ) {
+  // Learn that A is written to the catalog
+  {
+    SourceWithOnDemandProperties source(provider);
+    source.getProperty<PropertyA>();
+  }
+
+  // A declared dependency nobody requests is computed by the plan, but it is not used
+  planner.setRequiredProperties([](const PropertyId& property_id) {
+    if (property_id == PropertyId::create<PropertyA>())
+      return std::set<PropertyId>{PropertyId::create<PropertyB>(), PropertyId::create<PropertyD>()};
+    return std::set<PropertyId>{};
+  });
+
+  SimpleSourceGroup group;
+  group.addSource(std::unique_ptr<SourceInterface>(new SourceWithOnDemandProperties(provider)));
+  group.addSource(std::unique_ptr<SourceInterface>(new SourceWithOnDemandProperties(provider)));
+  planner.execute(group);
+
+  BOOST_CHECK_EQUAL(planner.getStats().at(PropertyId::create<PropertyD>()).m_computations, 2);
+  std::vector<PropertyId> expected_unused{PropertyId::create<PropertyD>()};
+  BOOST_CHECK(planner.getUnusedProperties() == expected_unused);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Disabled_test, PropertyPlannerFixture ) {
+  planner.setRecording(false);
+
+  SourceWithOnDemandProperties source(provider);
+  source.getProperty<PropertyA>();
+
+  BOOST_CHECK(planner.getStats().empty());
+  BOOST_CHECK(planner.getPlan()->empty());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( NoStatistics_test, PropertyPlannerFixture ) {
+  planner.setStatistics(false);
+
+  SourceWithOnDemandProperties source(provider);
+  source.getProperty<PropertyA>();
+
+  // The graph is still learnt
+  BOOST_CHECK(planner.getStats().empty());
+  BOOST_CHECK(planner.getDependencies(PropertyId::create<PropertyA>()) ==
+              std::set<PropertyId>{PropertyId::create<PropertyB>()});
+  BOOST_CHECK_EQUAL(planner.getPlan()->size(), 3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Threads_test, PropertyPlannerFixture ) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([this]() {
+      for (int j = 0; j < 10; ++j) {
+        SourceWithOnDemandProperties source(provider);
+        source.getProperty<PropertyA>();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The statistics of all the threads are merged
+  BOOST_CHECK_EQUAL(planner.getStats().at(PropertyId::create<PropertyC>()).m_computations, 40);
+  BOOST_CHECK_EQUAL(planner.getPlan()->size(), 3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
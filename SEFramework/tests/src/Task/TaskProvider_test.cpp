@@ -21,6 +21,8 @@
  */
 
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -56,6 +58,45 @@ class ExampleTaskFactory : public TaskFactory {
 
 };
 
+// Factory that does not provide any task, and counts how many times it is asked
+class NullTaskFactory : public TaskFactory {
+public:
+  static int s_calls;
+
+  virtual std::shared_ptr<Task> createTask(const PropertyId&) const override {
+    ++s_calls;
+    return nullptr;
+  }
+};
+
+int NullTaskFactory::s_calls = 0;
+
+// Task that counts its instances
+class CountedTask : public SourceTask {
+public:
+  static int s_instances;
+
+  CountedTask() {
+    ++s_instances;
+  }
+
+  ~CountedTask() {
+    --s_instances;
+  }
+
+  virtual void computeProperties(SourceInterface& ) const override {
+  }
+};
+
+int CountedTask::s_instances = 0;
+
+class CountedTaskFactory : public TaskFactory {
+public:
+  virtual std::shared_ptr<Task> createTask(const PropertyId&) const override {
+    return std::make_shared<CountedTask>();
+  }
+};
+
 struct TaskProviderFixture {
   std::unique_ptr<ExampleTaskFactory> factory;
   std::shared_ptr<TaskFactoryRegistry> registry;
@@ -93,6 +134,55 @@ BOOST_FIXTURE_TEST_CASE( TaskProvider_notfound_test, TaskProviderFixture ) {
   BOOST_CHECK_THROW(provider->getTask<SourceTask>(PropertyId::create<ExamplePropertyB>()), std::exception);
 }
 
+BOOST_FIXTURE_TEST_CASE( TaskProvider_concurrent_test, TaskProviderFixture ) {
+  registry->registerTaskFactory<ExampleTaskFactory, ExampleProperty>();
+
+  // All threads must get the same task, created only once
+  std::vector<std::shared_ptr<const SourceTask>> tasks(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    threads.emplace_back([this, &tasks, i]() {
+      for (int j = 0; j < 1000; ++j) {
+        tasks[i] = provider->getTask<SourceTask>(PropertyId::create<ExampleProperty>());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& task : tasks) {
+    BOOST_CHECK(task);
+    BOOST_CHECK_EQUAL(task, tasks.front());
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( TaskProvider_null_test, TaskProviderFixture ) {
+  registry->registerTaskFactory<NullTaskFactory, ExamplePropertyB>();
+  NullTaskFactory::s_calls = 0;
+
+  // A missing task is asked to the factory only once
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(!provider->getTask<SourceTask>(PropertyId::create<ExamplePropertyB>()));
+  }
+  BOOST_CHECK_EQUAL(NullTaskFactory::s_calls, 1);
+}
+
+BOOST_FIXTURE_TEST_CASE( TaskProvider_release_test, TaskProviderFixture ) {
+  registry->registerTaskFactory<CountedTaskFactory, ExamplePropertyB>();
+
+  // The third task is not published yet, only remembered by this thread
+  for (unsigned i = 0; i < 3; ++i) {
+    BOOST_CHECK(provider->getTask<SourceTask>(PropertyId::create<ExamplePropertyB>(i)));
+  }
+  BOOST_CHECK(provider->getTask<SourceTask>(PropertyId::create<ExamplePropertyB>(2)));
+  BOOST_CHECK_EQUAL(CountedTask::s_instances, 3);
+
+  // The tasks go with the provider
+  provider.reset();
+  BOOST_CHECK_EQUAL(CountedTask::s_instances, 0);
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END ()
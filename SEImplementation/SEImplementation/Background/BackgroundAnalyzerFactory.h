@@ -31,6 +31,8 @@
 
 #include "SEFramework/Background/BackgroundAnalyzer.h"
 
+#include "SEImplementation/Checkpoint/Checkpoint.h"
+
 namespace SourceXtractor {
 
 class BackgroundAnalyzerFactory  : public Euclid::Configuration::Configuration {
@@ -40,8 +42,14 @@ public:
   /// Destructor
   virtual ~BackgroundAnalyzerFactory() = default;
 
-  std::shared_ptr<BackgroundAnalyzer> createBackgroundAnalyzer() const;
-  std::shared_ptr<BackgroundAnalyzer> createBackgroundAnalyzer(WeightImageConfig::WeightType weight_type) const;
+  /**
+   * @param checkpoint_name
+   *    Name of the frame in the checkpoint. If given, and checkpointing is enabled, the background
+   *    model is stored in the checkpoint and reused when resuming.
+   */
+  std::shared_ptr<BackgroundAnalyzer> createBackgroundAnalyzer(const std::string& checkpoint_name = "") const;
+  std::shared_ptr<BackgroundAnalyzer> createBackgroundAnalyzer(WeightImageConfig::WeightType weight_type,
+                                                               const std::string& checkpoint_name = "") const;
 
   void initialize(const UserValues& args) override;
 
@@ -49,6 +57,7 @@ private:
   std::vector<int> m_cell_size;
   std::vector<int> m_smoothing_box;
   WeightImageConfig::WeightType m_weight_type;
+  std::shared_ptr<Checkpoint> m_checkpoint;
 };
 
 }
@@ -37,8 +37,11 @@
 #include "SEFramework/Image/ProcessedImage.h"
 #include "SEFramework/Image/WriteableImage.h"
 #include "SEFramework/Frame/Frame.h"
+#include "SEUtils/PixelRectangle.h"
 
 #include "SEImplementation/Image/LockedWriteableImage.h"
+#include "SEImplementation/Image/DeferredWriteableImage.h"
+#include "SEImplementation/Plugin/MeasurementFrame/LazyMeasurementFrame.h"
 
 
 namespace SourceXtractor {
@@ -51,6 +54,9 @@ public:
 
   void saveImages();
 
+  /// Apply the changes drawn by the sources so far, in the order of their identifiers
+  void mergeDeferredChanges();
+
   std::shared_ptr<WriteableImage<int>> getSegmentationImage(size_t index) const {
     if (index < m_segmentation_images.size()) {
       auto segmentation_image = m_segmentation_images.at(index);
@@ -81,22 +87,16 @@ public:
     return nullptr;
   }
 
-  std::shared_ptr<WriteableImage<int>> getDetectionAutoApertureImage(size_t index) const {
-    if (index < m_auto_aperture_images.size()) {
-      auto auto_aperture_image = m_auto_aperture_images.at(index);
-      if (auto_aperture_image != nullptr) {
-        return LockedWriteableImage<int>::create(auto_aperture_image);
-      }
+  std::shared_ptr<WriteableImage<int>> getDetectionAutoApertureImage(size_t index, unsigned int source_id) const {
+    if (index < m_auto_aperture_changes.size()) {
+      return DeferredWriteableImage<int>::create(m_auto_aperture_changes.at(index), source_id);
     }
     return nullptr;
   }
 
-  std::shared_ptr<WriteableImage<int>> getDetectionApertureImage(size_t index) const {
-    if (index < m_aperture_images.size()) {
-      auto aperture_image = m_aperture_images.at(index);
-      if (aperture_image != nullptr) {
-        return LockedWriteableImage<int>::create(aperture_image);
-      }
+  std::shared_ptr<WriteableImage<int>> getDetectionApertureImage(size_t index, unsigned int source_id) const {
+    if (index < m_aperture_changes.size()) {
+      return DeferredWriteableImage<int>::create(m_aperture_changes.at(index), source_id);
     }
     return nullptr;
   }
@@ -111,13 +111,17 @@ public:
     return nullptr;
   }
 
-  std::shared_ptr<WriteableImage<int>> getMeasurementAutoApertureImage(unsigned int frame_number);
+  /// The images drawn by the sources are merged by mergeDeferredChanges(), in the order of the source_id given
+  std::shared_ptr<WriteableImage<int>> getMeasurementAutoApertureImage(unsigned int frame_number,
+                                                                       unsigned int source_id);
 
-  std::shared_ptr<WriteableImage<int>> getMeasurementApertureImage(unsigned int frame_number);
+  std::shared_ptr<WriteableImage<int>> getMeasurementApertureImage(unsigned int frame_number, unsigned int source_id);
 
-  std::shared_ptr<WriteableImage<MeasurementImage::PixelType>> getModelFittingImage(unsigned int frame_number);
+  std::shared_ptr<WriteableImage<MeasurementImage::PixelType>> getModelFittingImage(unsigned int frame_number,
+                                                                                    unsigned int source_id);
 
-  std::shared_ptr<WriteableImage<MeasurementImage::PixelType>> getPsfImage(unsigned int frame_number);
+  std::shared_ptr<WriteableImage<MeasurementImage::PixelType>> getPsfImage(unsigned int frame_number,
+                                                                           unsigned int source_id);
 
   std::shared_ptr<WriteableImage<float>> getMLDetectionImage(unsigned int plane_number, size_t index);
 
@@ -168,11 +172,21 @@ private:
 
   static std::unique_ptr<CheckImages> m_instance;
 
+  /// Create the check image of a detection image, covering only its region
+  template <typename T>
+  std::shared_ptr<WriteableImage<T>> newDetectionCheckImage(const boost::filesystem::path& filename,
+                                                            size_t index, bool add_number) const;
+
+  /// Write the region of an image computed for a detection image
+  template <typename T>
+  void writeDetectionCheckImage(std::shared_ptr<Image<T>> image, const boost::filesystem::path& filename,
+                                size_t index) const;
+
   struct FrameInfo {
     std::string m_label;
     int m_width, m_height;
     std::shared_ptr<CoordinateSystem> m_coordinate_system;
-    std::shared_ptr<DetectionImage> m_subtracted_image;
+    std::shared_ptr<LazyMeasurementFrame> m_frame;
   };
 
   // check image
@@ -188,6 +202,14 @@ private:
   std::map<unsigned int, std::shared_ptr<WriteableImage<MeasurementImage::PixelType>>> m_check_image_model_fitting, m_check_image_psf;
   std::vector<std::map<unsigned int, std::shared_ptr<WriteableImage<float>>>> m_check_image_ml_detection;
 
+  // Changes drawn by the sources into the images above, until mergeDeferredChanges()
+  using IntChanges = DeferredWriteableImage<int>::PendingChanges;
+  using PixelChanges = DeferredWriteableImage<MeasurementImage::PixelType>::PendingChanges;
+  std::vector<std::shared_ptr<IntChanges>> m_auto_aperture_changes, m_aperture_changes;
+  std::map<unsigned int, std::shared_ptr<IntChanges>> m_measurement_aperture_changes;
+  std::map<unsigned int, std::shared_ptr<IntChanges>> m_measurement_auto_aperture_changes;
+  std::map<unsigned int, std::shared_ptr<PixelChanges>> m_model_fitting_changes, m_psf_changes;
+
   std::vector<std::shared_ptr<DetectionImage>> m_detection_images;
   std::vector<std::shared_ptr<Image<SeFloat>>> m_background_images;
   std::vector<std::shared_ptr<Image<SeFloat>>> m_filtered_images;
@@ -201,6 +223,9 @@ private:
 
   std::vector<std::shared_ptr<CoordinateSystem>> m_coordinate_systems;
 
+  // Part of each detection image covered by the check images, smaller than the image for a shard
+  std::vector<PixelRectangle> m_detection_regions;
+
   boost::filesystem::path m_model_fitting_image_filename;
   boost::filesystem::path m_residual_filename;
   boost::filesystem::path m_background_filename;
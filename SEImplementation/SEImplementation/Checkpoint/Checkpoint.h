@@ -0,0 +1,151 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * Checkpoint.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINT_H_
+#define _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINT_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Table/Row.h"
+
+#include "SEFramework/Source/SourceGroupInterface.h"
+
+namespace SourceXtractor {
+
+class FitsTableWriter;
+
+/**
+ * @class Checkpoint
+ * @brief State of a run kept on disk, so an interrupted run can be resumed
+ *
+ * @details
+ *  The directory contains:
+ *   - groups.dat: the keys of the groups whose rows have been stored, appended after the rows
+ *   - rows_NNNN.fits: the catalog rows of those groups, one file per run, with the group key as last two columns
+ *   - the background and variance maps of each frame (see CheckpointBackgroundAnalyzer)
+ *
+ *  The rows of a group are always stored in the same block, and its key is only appended to
+ *  groups.dat once the block is on disk, so rows without a key in groups.dat are ignored on resume.
+ *  Segmentation and grouping are deterministic, so a resumed run finds the same groups, and
+ *  the ones already stored are skipped before the measurement.
+ */
+class Checkpoint {
+public:
+
+  /**
+   * Key identifying a group across runs.
+   *
+   * The sources of a frame do not share pixels, so the first pixel (in row-major order) identifies the group,
+   * and the hash of all its pixels checks that the group is the same one, and separates groups that could
+   * overlap, i.e. the ones built from an assoc catalog.
+   */
+  struct GroupKey {
+    /// Detection frame in the upper 16 bits, then the row and column of the first pixel, 24 bits each
+    std::int64_t m_position;
+    /// Hash of the full pixel list, independent of the order of the pixels and sources
+    std::int64_t m_pixels;
+
+    bool operator==(const GroupKey& other) const {
+      return m_position == other.m_position && m_pixels == other.m_pixels;
+    }
+
+    bool operator!=(const GroupKey& other) const {
+      return !(*this == other);
+    }
+  };
+
+  struct GroupKeyHash {
+    std::size_t operator()(const GroupKey& key) const {
+      return std::hash<std::int64_t>()(key.m_pixels ^ key.m_position);
+    }
+  };
+
+  /// Open the checkpoint in the directory, creating it if needed, and load the state of the previous runs
+  explicit Checkpoint(const std::string& directory);
+
+  virtual ~Checkpoint();
+
+  Checkpoint(const Checkpoint&) = delete;
+  Checkpoint& operator=(const Checkpoint&) = delete;
+
+  const std::string& getDirectory() const {
+    return m_directory;
+  }
+
+  /// Path of a file in the checkpoint directory
+  std::string getPath(const std::string& filename) const;
+
+  /// Key of a group of the given detection frame
+  static GroupKey getGroupKey(unsigned int frame, const SourceGroupInterface& group);
+
+  static unsigned int getKeyFrame(const GroupKey& key) {
+    return static_cast<unsigned int>(static_cast<std::uint64_t>(key.m_position) >> 48);
+  }
+
+  bool isCompleted(const GroupKey& key) const {
+    return m_completed.count(key) > 0;
+  }
+
+  std::size_t getCompletedCount() const {
+    return m_completed.size();
+  }
+
+  /// Largest value of an integer column in the stored rows, 0 if there are none
+  std::int64_t getMaxStoredValue(const std::string& column) const;
+
+  /// Move out the rows stored by previous runs for the given frame
+  std::vector<Euclid::Table::Row> takeStoredRows(unsigned int frame);
+
+  /**
+   * Store the rows of completed groups
+   * @param rows
+   *    Catalog rows
+   * @param row_keys
+   *    Key of the group of each row
+   * @param group_keys
+   *    Keys of the completed groups, including the ones without rows
+   */
+  void commit(const std::vector<Euclid::Table::Row>& rows, const std::vector<GroupKey>& row_keys,
+              const std::vector<GroupKey>& group_keys);
+
+private:
+  void loadJournal();
+  void loadRows();
+
+  std::string m_directory;
+  std::unordered_set<GroupKey, GroupKeyHash> m_completed;
+  std::map<unsigned int, std::vector<Euclid::Table::Row>> m_stored_rows;
+  unsigned int m_run;
+
+  std::unique_ptr<FitsTableWriter> m_rows_writer;
+  std::shared_ptr<Euclid::Table::ColumnInfo> m_source_column_info, m_stored_column_info;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINT_H_ */
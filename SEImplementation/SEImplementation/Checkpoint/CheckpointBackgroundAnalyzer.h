@@ -0,0 +1,59 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointBackgroundAnalyzer.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTBACKGROUNDANALYZER_H_
+#define _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTBACKGROUNDANALYZER_H_
+
+#include "SEFramework/Background/BackgroundAnalyzer.h"
+
+#include "SEImplementation/Checkpoint/Checkpoint.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class CheckpointBackgroundAnalyzer
+ * @brief Stores the background model computed by the wrapped analyzer in the checkpoint, and reuses it on resume
+ *
+ * The level and variance maps are written as FITS images named after the frame, and a small text file
+ * with the scaling factor and median RMS is written last, so its presence marks a complete model.
+ */
+class CheckpointBackgroundAnalyzer : public BackgroundAnalyzer {
+public:
+
+  CheckpointBackgroundAnalyzer(std::shared_ptr<BackgroundAnalyzer> analyzer, std::shared_ptr<Checkpoint> checkpoint,
+                               const std::string& name);
+
+  virtual ~CheckpointBackgroundAnalyzer() = default;
+
+  BackgroundModel analyzeBackground(
+      std::shared_ptr<DetectionImage> image, std::shared_ptr<WeightImage> variance_map,
+      std::shared_ptr<Image<unsigned char>> mask, WeightImage::PixelType variance_threshold) const override;
+
+private:
+  std::shared_ptr<BackgroundAnalyzer> m_analyzer;
+  std::shared_ptr<Checkpoint> m_checkpoint;
+  std::string m_name;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTBACKGROUNDANALYZER_H_ */
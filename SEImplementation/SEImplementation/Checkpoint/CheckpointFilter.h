@@ -0,0 +1,74 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointFilter.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTFILTER_H_
+#define _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTFILTER_H_
+
+#include <mutex>
+#include <vector>
+
+#include "SEFramework/Pipeline/PipelineStage.h"
+#include "SEFramework/Source/SourceGroupInterface.h"
+
+#include "SEImplementation/Checkpoint/Checkpoint.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class CheckpointFilter
+ * @brief
+ *  Drops the groups already measured by a previous run, and tags the others with their
+ *  CheckpointGroupKey so the CheckpointOutput can store them.
+ *
+ * @details
+ *  Placed between the deblending and the measurement. The frame of a group is found from the
+ *  detection identifiers, as they are assigned in segmentation order: the main loop calls endFrame
+ *  after segmenting each frame.
+ */
+class CheckpointFilter : public PipelineReceiver<SourceGroupInterface>, public PipelineEmitter<SourceGroupInterface> {
+public:
+
+  explicit CheckpointFilter(std::shared_ptr<Checkpoint> checkpoint);
+
+  virtual ~CheckpointFilter() = default;
+
+  void receiveSource(std::unique_ptr<SourceGroupInterface> group) override;
+  void receiveProcessSignal(const ProcessSourcesEvent& event) override;
+
+  /// Register the end of the frame whose segmentation has just finished
+  void endFrame();
+
+  /// Number of groups skipped so far
+  std::size_t getSkippedCount() const {
+    return m_skipped;
+  }
+
+private:
+  std::shared_ptr<Checkpoint> m_checkpoint;
+  std::mutex m_boundaries_mutex;
+  std::vector<unsigned int> m_boundaries;
+  std::size_t m_skipped;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTFILTER_H_ */
@@ -0,0 +1,53 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointGroupKey.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTGROUPKEY_H_
+#define _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTGROUPKEY_H_
+
+#include "SEFramework/Property/Property.h"
+
+#include "SEImplementation/Checkpoint/Checkpoint.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class CheckpointGroupKey
+ * @brief Key of the group the source was measured with, set by the CheckpointFilter
+ */
+class CheckpointGroupKey : public Property {
+public:
+
+  explicit CheckpointGroupKey(const Checkpoint::GroupKey& key) : m_key(key) {}
+
+  virtual ~CheckpointGroupKey() = default;
+
+  const Checkpoint::GroupKey& getKey() const {
+    return m_key;
+  }
+
+private:
+  Checkpoint::GroupKey m_key;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CHECKPOINT_CHECKPOINTGROUPKEY_H_ */
@@ -24,6 +24,8 @@
 #ifndef _SEIMPLEMENTATION_CONFIGURATION_CHECKIMAGESCONFIG_H_
 #define _SEIMPLEMENTATION_CONFIGURATION_CHECKIMAGESCONFIG_H_
 
+#include <boost/filesystem/path.hpp>
+
 #include "Configuration/Configuration.h"
 #include "SEFramework/Image/Image.h"
 
@@ -41,6 +43,9 @@ public:
 
   void initialize(const UserValues& args) override;
 
+  /// Name of the check image of one of several frames: the number is appended to the stem if add_number is set
+  static std::string addNumberToFilename(boost::filesystem::path original_filename, size_t number, bool add_number);
+
   const std::string& getModelFittingImageFilename() const {
     return m_model_fitting_filename;
   }
@@ -0,0 +1,76 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointConfig.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CONFIGURATION_CHECKPOINTCONFIG_H_
+#define _SEIMPLEMENTATION_CONFIGURATION_CHECKPOINTCONFIG_H_
+
+#include <memory>
+
+#include "Configuration/Configuration.h"
+
+namespace SourceXtractor {
+
+class Checkpoint;
+
+/**
+ * @class CheckpointConfig
+ * @brief Directory where the state of the run is kept, so it can be resumed if interrupted
+ *
+ * The options used to create the checkpoint are recorded in it, and resuming with different
+ * options is refused, since the stored groups and background would not match.
+ */
+class CheckpointConfig : public Euclid::Configuration::Configuration {
+
+public:
+
+  explicit CheckpointConfig(long manager_id);
+
+  virtual ~CheckpointConfig() = default;
+
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
+  void initialize(const UserValues& args) override;
+
+  bool isEnabled() const {
+    return m_checkpoint != nullptr;
+  }
+
+  /// nullptr if checkpointing is disabled
+  std::shared_ptr<Checkpoint> getCheckpoint() const {
+    return m_checkpoint;
+  }
+
+  /// Minimum time, in seconds, between two writes of the measured groups
+  int getInterval() const {
+    return m_interval;
+  }
+
+private:
+  void checkOptions(const UserValues& args) const;
+
+  std::shared_ptr<Checkpoint> m_checkpoint;
+  int m_interval;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CONFIGURATION_CHECKPOINTCONFIG_H_ */
@@ -25,6 +25,8 @@
 
 #include <SEFramework/Frame/Frame.h>
 
+#include "SEImplementation/Plugin/MeasurementFrame/LazyMeasurementFrame.h"
+
 namespace SourceXtractor {
 
 class MeasurementFrameConfig : public Euclid::Configuration::Configuration {
@@ -33,14 +35,17 @@ public:
 
   explicit MeasurementFrameConfig(long manager_id);
 
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
   void initialize(const UserValues& args) override;
 
-  const std::map<int, std::shared_ptr<MeasurementImageFrame>>& getFrames() const {
+  // The frames are built when first needed, unless lazy loading is disabled
+  const std::map<int, std::shared_ptr<LazyMeasurementFrame>>& getFrames() const {
     return m_measurement_frames;
   }
 
 private:
-  std::map<int, std::shared_ptr<MeasurementImageFrame>> m_measurement_frames;
+  std::map<int, std::shared_ptr<LazyMeasurementFrame>> m_measurement_frames;
 };
 
 }
@@ -22,6 +22,7 @@
 #ifndef _SEIMPLEMENTATION_CONFIGURATION_MEASUREMENTIMAGECONFIG_H
 #define _SEIMPLEMENTATION_CONFIGURATION_MEASUREMENTIMAGECONFIG_H
 
+#include <map>
 #include <vector>
 #include <memory>
 
@@ -65,6 +66,9 @@ public:
     bool m_is_data_cube;
     int m_image_layer;
     int m_weight_layer;
+
+    // id of the first image with the same coordinate system and size, i.e. the first layer of a cube
+    int m_geometry_id;
   };
 
   explicit MeasurementImageConfig(long manager_id);
@@ -75,6 +79,17 @@ public:
     return m_image_infos;
   }
 
+  /// Images sharing the geometry of an earlier one, mapped to the id of that one
+  std::map<int, int> getGeometryReferences() const {
+    std::map<int, int> references;
+    for (auto& info : m_image_infos) {
+      if (info.m_geometry_id != info.m_id) {
+        references[info.m_id] = info.m_geometry_id;
+      }
+    }
+    return references;
+  }
+
 private:
 
   std::vector<MeasurementImageInfo> m_image_infos;
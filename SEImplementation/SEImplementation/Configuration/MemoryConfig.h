@@ -47,9 +47,33 @@ public:
     return m_tile_size;
   }
 
+  // read uncompressed FITS images through a memory mapping
+  bool getMemoryMapping() const {
+    return m_memory_mapping;
+  }
+
+  // write modified tiles from a dedicated I/O thread
+  bool getWriteBack() const {
+    return m_write_back;
+  }
+
+  // memory in megabytes, not counting the tiles, above which the measurement input waits (0 = no limit)
+  int getSoftLimit() const {
+    return m_soft_limit;
+  }
+
+  // log the high-water marks of the memory accounting
+  bool getMemoryReport() const {
+    return m_report;
+  }
+
 private:
   int m_max_memory;
   int m_tile_size;
+  bool m_memory_mapping;
+  bool m_write_back;
+  int m_soft_limit;
+  bool m_report;
 };
 
 
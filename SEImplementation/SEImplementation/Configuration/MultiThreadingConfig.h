@@ -51,8 +51,14 @@ public:
     return m_max_queue_size;
   }
 
+  // If true, the segmentation of a detection frame overlaps with the measurement of the previous one
+  bool getFramePipelining() const {
+    return m_frame_pipelining;
+  }
+
 private:
   int m_threads_nb, m_max_queue_size;
+  bool m_frame_pipelining;
   std::shared_ptr<Euclid::ThreadPool> m_thread_pool;
 };
 
@@ -0,0 +1,59 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * PropertyPlannerConfig.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CONFIGURATION_PROPERTYPLANNERCONFIG_H_
+#define _SEIMPLEMENTATION_CONFIGURATION_PROPERTYPLANNERCONFIG_H_
+
+#include "Configuration/Configuration.h"
+
+namespace SourceXtractor {
+
+class PropertyPlannerConfig : public Euclid::Configuration::Configuration {
+
+public:
+
+  explicit PropertyPlannerConfig(long manager_id);
+
+  virtual ~PropertyPlannerConfig() = default;
+
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
+  void initialize(const UserValues& args) override;
+
+  // If true, the properties needed by the catalog are computed group by group following their dependencies
+  bool getPropertyPlanning() const {
+    return m_property_planning;
+  }
+
+  // If true, the time spent on each property and the properties not written are reported at the end
+  bool getPropertyReport() const {
+    return m_property_report;
+  }
+
+private:
+  bool m_property_planning;
+  bool m_property_report;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CONFIGURATION_PROPERTYPLANNERCONFIG_H_ */
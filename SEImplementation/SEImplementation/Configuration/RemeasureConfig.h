@@ -0,0 +1,84 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * RemeasureConfig.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CONFIGURATION_REMEASURECONFIG_H_
+#define _SEIMPLEMENTATION_CONFIGURATION_REMEASURECONFIG_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Configuration/Configuration.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class RemeasureConfig
+ * @brief Sources and groups of a previous run, measured again instead of segmenting the detection image
+ *
+ * The pixels of each source are read from the partition check image of the previous run, and the
+ * identifiers of the sources and their groups from its catalog, so the new catalog can be joined with it.
+ * With several detection images, there is one partition image per detection image, named like the check images.
+ */
+class RemeasureConfig : public Euclid::Configuration::Configuration {
+
+public:
+
+  /// Identifiers given to a source by the previous run
+  struct SourceInfo {
+    unsigned int m_detection_id;
+    unsigned int m_group_id;
+  };
+
+  using SourceMap = std::unordered_map<unsigned int, SourceInfo>;
+
+  explicit RemeasureConfig(long manager_id);
+
+  virtual ~RemeasureConfig() = default;
+
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
+  void initialize(const UserValues& args) override;
+
+  bool isEnabled() const {
+    return m_sources != nullptr;
+  }
+
+  /// Partition image of each detection image
+  const std::vector<std::string>& getPartitionImagePaths() const {
+    return m_partition_image_paths;
+  }
+
+  /// Sources of the previous catalog by source_id, nullptr if the re-measurement is disabled
+  std::shared_ptr<const SourceMap> getSources() const {
+    return m_sources;
+  }
+
+private:
+  std::vector<std::string> m_partition_image_paths;
+  std::shared_ptr<const SourceMap> m_sources;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CONFIGURATION_REMEASURECONFIG_H_ */
@@ -65,6 +65,10 @@ public:
     return m_lutz_window_size;
   }
 
+  bool isStreaming() const {
+    return m_streaming;
+  }
+
   int getBfsMaxDelta() const {
     return m_bfs_max_delta;
   }
@@ -85,6 +89,10 @@ public:
     return m_ml_threshold;
   }
 
+  int getFramesAhead() const {
+    return m_frames_ahead;
+  }
+
 
 private:
   std::shared_ptr<DetectionImageFrame::ImageFilter> getDefaultFilter() const;
@@ -96,9 +104,11 @@ private:
   std::shared_ptr<DetectionImageFrame::ImageFilter> m_filter;
 
   int m_lutz_window_size;
+  bool m_streaming;
   int m_bfs_max_delta;
   std::string m_onnx_model_path;
   double m_ml_threshold;
+  int m_frames_ahead;
 }; /* End of SegmentationConfig class */
 
 } /* namespace SourceXtractor */
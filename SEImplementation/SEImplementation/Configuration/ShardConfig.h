@@ -0,0 +1,81 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ShardConfig.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CONFIGURATION_SHARDCONFIG_H_
+#define _SEIMPLEMENTATION_CONFIGURATION_SHARDCONFIG_H_
+
+#include "Configuration/Configuration.h"
+#include "SEUtils/PixelRectangle.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class ShardConfig
+ * @brief Restricts the processing to a region of the detection image
+ *
+ * Only the region grown by the margin is segmented, and only the sources with the centroid inside
+ * the region are written to the catalog. Shards with abutting regions own each source exactly once.
+ */
+class ShardConfig : public Euclid::Configuration::Configuration {
+
+public:
+
+  explicit ShardConfig(long manager_id);
+
+  virtual ~ShardConfig() = default;
+
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
+  void initialize(const UserValues& args) override;
+
+  bool isEnabled() const {
+    return m_enabled;
+  }
+
+  // Region owned by this shard, in zero-based pixel coordinates
+  const PixelRectangle& getCoreRegion() const {
+    return m_core_region;
+  }
+
+  // Margin around the region that is segmented and measured, but not written
+  int getMargin() const {
+    return m_margin;
+  }
+
+  // Region grown by the margin, the upper bounds must still be clipped to the image size
+  PixelRectangle getProcessedRegion() const;
+
+  // Region grown by the margin and clipped to an image, or the whole image when sharding is disabled
+  PixelRectangle getProcessedRegion(int width, int height) const;
+
+  // Parse a region given as xmin,ymin,xmax,ymax, with the first pixel being 1,1
+  static PixelRectangle parseRegion(const std::string& region);
+
+private:
+  bool m_enabled;
+  PixelRectangle m_core_region;
+  int m_margin;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CONFIGURATION_SHARDCONFIG_H_ */
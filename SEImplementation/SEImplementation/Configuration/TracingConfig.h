@@ -0,0 +1,57 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * TracingConfig.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_CONFIGURATION_TRACINGCONFIG_H_
+#define _SEIMPLEMENTATION_CONFIGURATION_TRACINGCONFIG_H_
+
+#include "Configuration/Configuration.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class TracingConfig
+ * @brief File where the timeline of the pipeline stages is recorded, see Tracer
+ */
+class TracingConfig : public Euclid::Configuration::Configuration {
+
+public:
+
+  explicit TracingConfig(long manager_id);
+
+  virtual ~TracingConfig() = default;
+
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
+  void initialize(const UserValues& args) override;
+
+  // Empty when tracing is disabled
+  const std::string& getTraceFile() const {
+    return m_trace_file;
+  }
+
+private:
+  std::string m_trace_file;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_CONFIGURATION_TRACINGCONFIG_H_ */
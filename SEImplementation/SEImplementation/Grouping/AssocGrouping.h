@@ -18,6 +18,7 @@
 #ifndef _SEIMPLEMENTATION_GROUPING_ASSOCGROUPING_H_
 #define _SEIMPLEMENTATION_GROUPING_ASSOCGROUPING_H_
 
+#include <list>
 #include <map>
 
 #include "SEFramework/Pipeline/SourceGrouping.h"
@@ -41,6 +42,8 @@ public:
 private:
   std::shared_ptr<SourceGroupFactory> m_group_factory;
   std::map<unsigned int, std::unique_ptr<SourceGroupInterface>> m_source_groups;
+  // Sources without a group id (0), each in its own group
+  std::list<std::unique_ptr<SourceGroupInterface>> m_single_groups;
   unsigned int m_hard_limit;
 
 };
@@ -0,0 +1,54 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * BoundingBoxSelectionCriteria.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_GROUPING_BOUNDINGBOXSELECTIONCRITERIA_H_
+#define _SEIMPLEMENTATION_GROUPING_BOUNDINGBOXSELECTIONCRITERIA_H_
+
+#include "SEFramework/Pipeline/SourceGrouping.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class BoundingBoxSelectionCriteria
+ * @brief Selects the groups whose sources all end before a line, i.e. that are fully behind a sliding window
+ */
+class BoundingBoxSelectionCriteria : public SelectionCriteria {
+public:
+
+  explicit BoundingBoxSelectionCriteria(int line_number) : m_line_number(line_number) {
+  }
+
+  bool mustBeProcessed(const SourceInterface& ) const override;
+
+  bool requiresWholeGroup() const override {
+    return true;
+  }
+
+private:
+  int m_line_number;
+};
+
+}
+
+
+#endif /* _SEIMPLEMENTATION_GROUPING_BOUNDINGBOXSELECTIONCRITERIA_H_ */
@@ -35,6 +35,7 @@
 #include "SEImplementation/Grouping/AssocCriteria.h"
 
 #include "SEImplementation/Configuration/GroupingConfig.h"
+#include "SEImplementation/Configuration/RemeasureConfig.h"
 
 namespace SourceXtractor {
 
@@ -60,6 +61,8 @@ private:
   std::shared_ptr<SourceGroupFactory> m_source_group_factory;
   unsigned int m_hard_limit;
   double m_moffat_max_distance;
+  /// Sources of the previous run when re-measuring, their groups are kept
+  std::shared_ptr<const RemeasureConfig::SourceMap> m_remeasured_sources;
 };
 
 } /* namespace SourceXtractor */
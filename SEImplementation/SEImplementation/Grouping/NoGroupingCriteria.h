@@ -25,6 +25,7 @@
 #define _SEIMPLEMENTATION_GROUPING_NOGROUPINGCRITERIA_H_
 
 #include "SEFramework/Pipeline/SourceGrouping.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
 
 namespace SourceXtractor {
 
@@ -34,6 +35,11 @@ public:
   bool shouldGroup(const SourceInterface&, const SourceInterface&) const override {
     return false;
   }
+
+  /// The boundaries select the groups to process when the segmentation is streaming
+  std::set<PropertyId> requiredProperties() const override {
+    return { PropertyId::create<PixelBoundaries>(), };
+  }
 };
 
 
@@ -36,6 +36,8 @@ namespace SourceXtractor {
 class OverlappingBoundariesCriteria : public GroupingCriteria {
 public:
   bool shouldGroup(const SourceInterface& first, const SourceInterface& second) const override;
+
+  std::set<PropertyId> requiredProperties() const override;
 };
 
 
@@ -0,0 +1,70 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * RemeasureGrouping.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_GROUPING_REMEASUREGROUPING_H_
+#define _SEIMPLEMENTATION_GROUPING_REMEASUREGROUPING_H_
+
+#include <map>
+#include <unordered_map>
+
+#include "SEFramework/Pipeline/SourceGrouping.h"
+#include "SEImplementation/Configuration/RemeasureConfig.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class RemeasureGrouping
+ * @brief Groups the sources of a previous run as they were grouped in its catalog
+ *
+ * @details
+ *  A group is sent as soon as all the sources the catalog gives it have been received,
+ *  and keeps its group id. The groups still incomplete are sent when a processing request selects them.
+ */
+class RemeasureGrouping : public SourceGroupingInterface {
+public:
+
+  RemeasureGrouping(std::shared_ptr<SourceGroupFactory> group_factory,
+                    std::shared_ptr<const RemeasureConfig::SourceMap> sources);
+
+  virtual ~RemeasureGrouping() = default;
+
+  std::set<PropertyId> requiredProperties() const override;
+
+  /// Handles a new Source
+  void receiveSource(std::unique_ptr<SourceInterface> source) override;
+
+  /// Handles a ProcessSourcesEvent to trigger the processing of some of the Sources stored in SourceGrouping
+  void receiveProcessSignal(const ProcessSourcesEvent& event) override;
+
+private:
+  void sendGroup(unsigned int group_id);
+
+  std::shared_ptr<SourceGroupFactory> m_group_factory;
+  std::shared_ptr<const RemeasureConfig::SourceMap> m_sources;
+  /// Number of sources of each group in the catalog
+  std::unordered_map<unsigned int, size_t> m_group_sizes;
+  std::map<unsigned int, std::unique_ptr<SourceGroupInterface>> m_source_groups;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_GROUPING_REMEASUREGROUPING_H_ */
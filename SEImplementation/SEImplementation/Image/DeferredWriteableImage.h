@@ -0,0 +1,263 @@
+/*
+ * DeferredWriteableImage.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_IMAGE_DEFERREDWRITEABLEIMAGE_H_
+#define _SEIMPLEMENTATION_IMAGE_DEFERREDWRITEABLEIMAGE_H_
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <ElementsKernel/Logging.h>
+
+#include "SEFramework/Image/ImageChunk.h"
+#include "SEFramework/Image/WriteableImage.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class DeferredWriteableImage
+ * @brief Writeable image that buffers the changes in tiles and commits them to the wrapped image on destruction
+ *
+ * @details
+ *  The lock of the wrapped image is held only while a tile is first read, and while the changes
+ *  are committed, so several threads can draw into the same image at once.
+ *  With MergeMode::ADD, the difference against the value first read is added to the wrapped image,
+ *  so concurrent accumulations are not lost. With MergeMode::REPLACE, the written value wins.
+ *
+ *  When created on a PendingChanges, the changes are handed to it on destruction instead, and applied
+ *  when it is merged, in the order of the keys given to the writers.
+ */
+template <typename T>
+class DeferredWriteableImage : public WriteableImage<T> {
+public:
+  enum class MergeMode {
+    REPLACE, ADD
+  };
+
+private:
+  struct Tile {
+    int m_x, m_y, m_width, m_height;
+    bool m_loaded, m_dirty;
+    std::vector<T> m_values, m_original;
+    std::vector<bool> m_modified;
+
+    int index(int x, int y) const {
+      return (x - m_x) + (y - m_y) * m_width;
+    }
+  };
+
+  // Ordered by (y, x) so changes are committed in a deterministic order
+  using TileMap = std::map<std::pair<int, int>, Tile>;
+
+public:
+  /**
+   * Changes of the writers of an image, kept until merge() applies them in the order of the writer keys,
+   * i.e. the source identifiers, so the result does not depend on which thread finished first
+   */
+  class PendingChanges {
+  public:
+    PendingChanges(std::shared_ptr<WriteableImage<T>> img, MergeMode merge_mode)
+      : m_img{std::move(img)}, m_merge_mode{merge_mode} {
+    }
+
+    void merge() {
+      std::multimap<unsigned int, TileMap> changes;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        changes.swap(m_changes);
+      }
+      if (changes.empty()) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(m_img->m_write_mutex);
+      for (auto& entry : changes) {
+        apply(*m_img, m_merge_mode, entry.second);
+      }
+    }
+
+  private:
+    void add(unsigned int key, TileMap&& tiles) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_changes.emplace(key, std::move(tiles));
+    }
+
+    std::shared_ptr<WriteableImage<T>> m_img;
+    MergeMode m_merge_mode;
+    std::mutex m_mutex;
+    std::multimap<unsigned int, TileMap> m_changes;
+
+    friend class DeferredWriteableImage<T>;
+  };
+
+protected:
+  DeferredWriteableImage(std::shared_ptr<WriteableImage<T>> img, MergeMode merge_mode, int tile_size = 64)
+    : m_img{std::move(img)}, m_merge_mode{merge_mode}, m_tile_size{tile_size},
+      m_last_tile{nullptr}, m_last_tile_x{-1}, m_last_tile_y{-1}, m_key{0} {
+  }
+
+  DeferredWriteableImage(std::shared_ptr<PendingChanges> pending, unsigned int key, int tile_size = 64)
+    : m_img{pending->m_img}, m_merge_mode{pending->m_merge_mode}, m_tile_size{tile_size},
+      m_last_tile{nullptr}, m_last_tile_x{-1}, m_last_tile_y{-1}, m_pending{std::move(pending)}, m_key{key} {
+  }
+
+public:
+  template<typename... Args>
+  static std::shared_ptr<DeferredWriteableImage<T>> create(Args &&... args) {
+    return std::shared_ptr<DeferredWriteableImage<T>>(new DeferredWriteableImage{std::forward<Args>(args)...});
+  }
+
+  virtual ~DeferredWriteableImage() {
+    if (m_pending) {
+      if (isDirty()) {
+        m_pending->add(m_key, std::move(m_tiles));
+      }
+      return;
+    }
+    try {
+      commit();
+    } catch (const std::exception& e) {
+      Elements::Logging::getLogger("DeferredWriteableImage").error()
+        << "Failed to commit changes to " << m_img->getRepr() << ": " << e.what();
+    }
+  }
+
+  std::string getRepr() const override {
+    return "DeferredWriteableImage(" + m_img->getRepr() + ")";
+  }
+
+  int getWidth() const override {
+    return m_img->getWidth();
+  }
+
+  int getHeight() const override {
+    return m_img->getHeight();
+  }
+
+  void setValue(int x, int y, T value) override {
+    auto& tile = getTile(x, y, m_merge_mode == MergeMode::ADD);
+    auto i = tile.index(x, y);
+    tile.m_values[i] = value;
+    tile.m_modified[i] = true;
+    tile.m_dirty = true;
+  }
+
+  std::shared_ptr<ImageChunk<T>> getChunk(int x, int y, int width, int height) const override {
+    std::vector<T> data(width * height);
+    for (int iy = 0; iy < height; ++iy) {
+      for (int ix = 0; ix < width; ++ix) {
+        auto& tile = getTile(x + ix, y + iy, true);
+        data[ix + iy * width] = tile.m_values[tile.index(x + ix, y + iy)];
+      }
+    }
+    return UniversalImageChunk<T>::create(std::move(data), width, height);
+  }
+
+  /// Apply the changes to the wrapped image, and reset the buffers
+  void commit() {
+    if (isDirty()) {
+      std::lock_guard<std::mutex> lock(m_img->m_write_mutex);
+      apply(*m_img, m_merge_mode, m_tiles);
+    }
+    m_tiles.clear();
+    m_last_tile = nullptr;
+  }
+
+private:
+  bool isDirty() const {
+    return std::any_of(m_tiles.begin(), m_tiles.end(), [](const typename TileMap::value_type& entry) {
+      return entry.second.m_dirty;
+    });
+  }
+
+  /// Must be called with the lock of the image held
+  static void apply(WriteableImage<T>& img, MergeMode merge_mode, const TileMap& tiles) {
+    for (auto& entry : tiles) {
+      auto& tile = entry.second;
+      if (!tile.m_dirty) {
+        continue;
+      }
+      std::shared_ptr<ImageChunk<T>> current;
+      if (merge_mode == MergeMode::ADD) {
+        current = img.getChunk(tile.m_x, tile.m_y, tile.m_width, tile.m_height);
+      }
+      for (int iy = 0; iy < tile.m_height; ++iy) {
+        for (int ix = 0; ix < tile.m_width; ++ix) {
+          auto i = ix + iy * tile.m_width;
+          if (!tile.m_modified[i]) {
+            continue;
+          }
+          if (merge_mode == MergeMode::ADD) {
+            img.setValue(tile.m_x + ix, tile.m_y + iy,
+                         current->getValue(ix, iy) + (tile.m_values[i] - tile.m_original[i]));
+          }
+          else {
+            img.setValue(tile.m_x + ix, tile.m_y + iy, tile.m_values[i]);
+          }
+        }
+      }
+    }
+  }
+
+  Tile& getTile(int x, int y, bool load) const {
+    int tile_x = x / m_tile_size, tile_y = y / m_tile_size;
+    if (m_last_tile == nullptr || tile_x != m_last_tile_x || tile_y != m_last_tile_y) {
+      auto i = m_tiles.find(std::make_pair(tile_y, tile_x));
+      if (i == m_tiles.end()) {
+        Tile tile;
+        tile.m_x = tile_x * m_tile_size;
+        tile.m_y = tile_y * m_tile_size;
+        tile.m_width = std::min(m_tile_size, getWidth() - tile.m_x);
+        tile.m_height = std::min(m_tile_size, getHeight() - tile.m_y);
+        tile.m_loaded = tile.m_dirty = false;
+        tile.m_values.resize(tile.m_width * tile.m_height);
+        tile.m_modified.resize(tile.m_values.size(), false);
+        i = m_tiles.emplace(std::make_pair(tile_y, tile_x), std::move(tile)).first;
+      }
+      m_last_tile = &i->second;
+      m_last_tile_x = tile_x;
+      m_last_tile_y = tile_y;
+    }
+    if (load && !m_last_tile->m_loaded) {
+      loadTile(*m_last_tile);
+    }
+    return *m_last_tile;
+  }
+
+  void loadTile(Tile& tile) const {
+    // The chunk may be a view over the wrapped image, so the copy must be done with the lock held
+    std::lock_guard<std::mutex> lock(m_img->m_write_mutex);
+    auto chunk = m_img->getChunk(tile.m_x, tile.m_y, tile.m_width, tile.m_height);
+    tile.m_original.resize(tile.m_values.size());
+    for (int iy = 0; iy < tile.m_height; ++iy) {
+      for (int ix = 0; ix < tile.m_width; ++ix) {
+        auto i = ix + iy * tile.m_width;
+        tile.m_original[i] = chunk->getValue(ix, iy);
+        if (!tile.m_modified[i]) {
+          tile.m_values[i] = tile.m_original[i];
+        }
+      }
+    }
+    tile.m_loaded = true;
+  }
+
+  std::shared_ptr<WriteableImage<T>> m_img;
+  MergeMode m_merge_mode;
+  int m_tile_size;
+
+  mutable TileMap m_tiles;
+  mutable Tile* m_last_tile;
+  mutable int m_last_tile_x, m_last_tile_y;
+
+  std::shared_ptr<PendingChanges> m_pending;
+  unsigned int m_key;
+};
+
+}
+
+#endif /* _SEIMPLEMENTATION_IMAGE_DEFERREDWRITEABLEIMAGE_H_ */
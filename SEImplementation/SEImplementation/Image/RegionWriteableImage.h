@@ -0,0 +1,95 @@
+/*
+ * RegionWriteableImage.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_IMAGE_REGIONWRITEABLEIMAGE_H_
+#define _SEIMPLEMENTATION_IMAGE_REGIONWRITEABLEIMAGE_H_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "SEUtils/PixelCoordinate.h"
+#include "SEFramework/Image/ImageChunk.h"
+#include "SEFramework/Image/WriteableImage.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class RegionWriteableImage
+ * @brief Writeable image that only stores a region of a larger image, addressed with the coordinates of the larger one
+ *
+ * @details
+ *  Writes outside the region are dropped, and reads outside the region return the default value.
+ *  The check images of a shard only cover the processed region, and are wrapped so the check image
+ *  tasks can keep drawing with the coordinates of the detection image.
+ */
+template <typename T>
+class RegionWriteableImage : public WriteableImage<T> {
+protected:
+  RegionWriteableImage(std::shared_ptr<WriteableImage<T>> img, const PixelCoordinate& offset,
+                       int width, int height, T default_value = {})
+    : m_img{std::move(img)}, m_offset{offset}, m_width{width}, m_height{height}, m_default{default_value} {
+  }
+
+public:
+  template<typename... Args>
+  static std::shared_ptr<RegionWriteableImage<T>> create(Args &&... args) {
+    return std::shared_ptr<RegionWriteableImage<T>>(new RegionWriteableImage{std::forward<Args>(args)...});
+  }
+
+  std::string getRepr() const override {
+    return "RegionWriteableImage(" + m_img->getRepr() + ", " + std::to_string(m_offset.m_x) + ", " +
+           std::to_string(m_offset.m_y) + ")";
+  }
+
+  int getWidth() const override {
+    return m_width;
+  }
+
+  int getHeight() const override {
+    return m_height;
+  }
+
+  void setValue(int x, int y, T value) override {
+    int region_x = x - m_offset.m_x, region_y = y - m_offset.m_y;
+    if (region_x >= 0 && region_y >= 0 && region_x < m_img->getWidth() && region_y < m_img->getHeight()) {
+      m_img->setValue(region_x, region_y, value);
+    }
+  }
+
+  std::shared_ptr<ImageChunk<T>> getChunk(int x, int y, int width, int height) const override {
+    // Overlap of the chunk with the region, in region coordinates
+    int min_x = std::max(x - m_offset.m_x, 0), min_y = std::max(y - m_offset.m_y, 0);
+    int max_x = std::min(x + width - m_offset.m_x, m_img->getWidth());
+    int max_y = std::min(y + height - m_offset.m_y, m_img->getHeight());
+
+    if (min_x == x - m_offset.m_x && min_y == y - m_offset.m_y &&
+        max_x - min_x == width && max_y - min_y == height) {
+      return m_img->getChunk(min_x, min_y, width, height);
+    }
+
+    std::vector<T> data(width * height, m_default);
+    if (min_x < max_x && min_y < max_y) {
+      auto chunk = m_img->getChunk(min_x, min_y, max_x - min_x, max_y - min_y);
+      for (int iy = min_y; iy < max_y; ++iy) {
+        for (int ix = min_x; ix < max_x; ++ix) {
+          data[(ix + m_offset.m_x - x) + (iy + m_offset.m_y - y) * width] = chunk->getValue(ix - min_x, iy - min_y);
+        }
+      }
+    }
+    return UniversalImageChunk<T>::create(std::move(data), width, height);
+  }
+
+private:
+  std::shared_ptr<WriteableImage<T>> m_img;
+  PixelCoordinate m_offset;
+  int m_width, m_height;
+  T m_default;
+};
+
+}
+
+#endif /* _SEIMPLEMENTATION_IMAGE_REGIONWRITEABLEIMAGE_H_ */
@@ -41,7 +41,8 @@ class MeasurementFactory : public Configurable {
 public:
 
   explicit MeasurementFactory(std::shared_ptr<OutputRegistry> output_registry)
-      : m_output_registry(output_registry), m_threads_nb(0), m_max_queue(0) {}
+      : m_output_registry(output_registry), m_threads_nb(0), m_max_queue(0), m_property_planning(false),
+        m_hold_tile_rows(false) {}
 
   std::unique_ptr<Measurement> getMeasurement() const;
 
@@ -56,6 +57,8 @@ private:
   std::shared_ptr<Euclid::ThreadPool> m_thread_pool;
 
   unsigned int m_threads_nb, m_max_queue;
+  bool m_property_planning;
+  bool m_hold_tile_rows;
 };
 
 }
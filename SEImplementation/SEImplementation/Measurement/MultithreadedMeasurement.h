@@ -38,12 +38,16 @@ namespace SourceXtractor {
 class MultithreadedMeasurement : public Measurement {
 public:
 
-  using SourceToRowConverter = std::function<Euclid::Table::Row(const SourceInterface&)>;
-  MultithreadedMeasurement(SourceToRowConverter source_to_row, const std::shared_ptr<Euclid::ThreadPool>& thread_pool,
-                           unsigned max_queue_size)
-      : m_source_to_row(source_to_row),
+  /// Computes the properties needed by the output, see OutputRegistry::getSourcePropertyRequester
+  using SourcePropertyRequester = std::function<void(const SourceInterface&)>;
+  MultithreadedMeasurement(SourcePropertyRequester request_properties,
+                           const std::shared_ptr<Euclid::ThreadPool>& thread_pool,
+                           unsigned max_queue_size, bool property_planning = false, bool hold_tile_rows = false)
+      : m_request_properties(request_properties),
         m_thread_pool(thread_pool),
-        m_group_counter(0),
+        m_property_planning(property_planning),
+        m_hold_tile_rows(hold_tile_rows),
+        m_group_counter(0), m_groups_in_flight(0),
         m_input_done(false), m_abort_raised(false), m_semaphore(max_queue_size) {}
 
   ~MultithreadedMeasurement() override;
@@ -59,11 +63,16 @@ private:
   static void outputThreadStatic(MultithreadedMeasurement* measurement);
   void outputThreadLoop();
 
-  SourceToRowConverter m_source_to_row;
+  SourcePropertyRequester m_request_properties;
   std::shared_ptr<Euclid::ThreadPool> m_thread_pool;
   std::unique_ptr<std::thread> m_output_thread;
+  bool m_property_planning;
+  /// Keep the tiles of the groups being measured, the streaming segmentation releases those behind it
+  bool m_hold_tile_rows;
 
   int m_group_counter;
+  // Received, but not sent downstream yet
+  std::atomic<int> m_groups_in_flight;
   std::atomic_bool m_input_done, m_abort_raised;
 
   std::condition_variable m_new_output;
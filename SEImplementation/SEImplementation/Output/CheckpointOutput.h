@@ -0,0 +1,88 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointOutput.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_OUTPUT_CHECKPOINTOUTPUT_H_
+#define _SEIMPLEMENTATION_OUTPUT_CHECKPOINTOUTPUT_H_
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "SEImplementation/Checkpoint/Checkpoint.h"
+#include "SEImplementation/Output/FlushableOutput.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class CheckpointOutput
+ * @brief Stores the rows of the measured groups in the checkpoint, and writes the rows stored by previous runs
+ *
+ * @details
+ *  Sources must carry the CheckpointGroupKey set by the CheckpointFilter. The sources of a group arrive
+ *  one after the other, so a group is complete when a source with another key (or a flush) is received.
+ *  Completed groups are stored at most every interval seconds, and on flush.
+ *
+ *  The rows of previous runs are written at the beginning of the catalog part of their frame. The group
+ *  identifiers of the new groups are shifted past the stored ones, as the counter restarts on each run.
+ *  The source identifiers can not be shifted here, as the Sorter orders on them, so the SourceIDTask
+ *  counter is started past the stored ones instead.
+ */
+class CheckpointOutput : public Output {
+
+public:
+  CheckpointOutput(std::shared_ptr<FlushableOutput> output, FlushableOutput::SourceToRowConverter source_to_row,
+                   std::shared_ptr<Checkpoint> checkpoint, int interval);
+
+  virtual ~CheckpointOutput();
+
+  void outputSource(const SourceInterface& source) override;
+
+  size_t flush() override;
+
+  void nextPart() override;
+
+private:
+  void replayPart();
+  void endGroup();
+  void commit();
+  Euclid::Table::Row shiftGroupId(const Euclid::Table::Row& row);
+
+  std::shared_ptr<FlushableOutput> m_output;
+  FlushableOutput::SourceToRowConverter m_source_to_row;
+  std::shared_ptr<Checkpoint> m_checkpoint;
+  std::chrono::seconds m_interval;
+  std::chrono::steady_clock::time_point m_last_commit;
+
+  unsigned int m_part;
+  std::int64_t m_group_id_offset;
+
+  bool m_in_group;
+  Checkpoint::GroupKey m_group_key;
+  std::vector<Euclid::Table::Row> m_group_rows;
+
+  std::vector<Euclid::Table::Row> m_pending_rows;
+  std::vector<Checkpoint::GroupKey> m_pending_row_keys, m_pending_group_keys;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_OUTPUT_CHECKPOINTOUTPUT_H_ */
@@ -0,0 +1,96 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * FitsTableWriter.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_OUTPUT_FITSTABLEWRITER_H_
+#define _SEIMPLEMENTATION_OUTPUT_FITSTABLEWRITER_H_
+
+#include <fitsio.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Table/Row.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class FitsTableWriter
+ * @brief Streams rows into a FITS binary table
+ *
+ * @details
+ *  The file is kept open between calls to addRows, and each block of rows is written
+ *  column by column with fits_write_col, in chunks of the size cfitsio considers optimal for its buffers.
+ *  NAXIS2 is updated when each block has been written, so the file is consistent on disk between blocks.
+ *
+ *  The layout of the table is fixed by the first block: vectors and NdArrays must keep the same size
+ *  (they are stored as fixed-size columns), and strings can not be longer than the longest
+ *  value of the first block. A later block that breaks the layout is reported as an error.
+ *
+ *  The rows still hold their cells as variants, as built by the OutputRegistry converters:
+ *  each column writer unboxes its cells into a typed buffer before handing it to cfitsio.
+ */
+class FitsTableWriter {
+public:
+  class ColumnWriter;
+
+  /**
+   * @param filename
+   *    Path of the FITS file
+   * @param override_file
+   *    If true, an existing file is replaced. Otherwise, the table is appended to it.
+   */
+  FitsTableWriter(const std::string& filename, bool override_file = false);
+
+  virtual ~FitsTableWriter();
+
+  FitsTableWriter(const FitsTableWriter&) = delete;
+  FitsTableWriter& operator=(const FitsTableWriter&) = delete;
+
+  /// Must be called before the first block is written
+  void setHduName(const std::string& hdu_name);
+
+  /// Append the rows to the table, creating the HDU if this is the first block
+  void addRows(const std::vector<Euclid::Table::Row>& rows);
+
+  /// Number of rows written so far
+  long long getRowCount() const {
+    return m_row_count;
+  }
+
+  /// Close the file. Called automatically on destruction.
+  void close();
+
+private:
+  void createTable(const std::vector<Euclid::Table::Row>& rows);
+
+  std::string m_filename;
+  bool m_override_file;
+  std::string m_hdu_name;
+
+  fitsfile* m_fptr;
+  long long m_row_count;
+  std::vector<std::unique_ptr<ColumnWriter>> m_columns;
+};
+
+}  // namespace SourceXtractor
+
+#endif /* _SEIMPLEMENTATION_OUTPUT_FITSTABLEWRITER_H_ */
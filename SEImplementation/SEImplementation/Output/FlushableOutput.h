@@ -11,9 +11,20 @@
 #include "Table/Row.h"
 
 #include "SEFramework/Output/Output.h"
+#include "SEFramework/Pipeline/Tracer.h"
+#include "SEUtils/MemoryAccounting.h"
 
 namespace SourceXtractor {
 
+/**
+ * @class FlushableOutput
+ * @brief Buffers the rows of the catalog, and writes them every flush_size rows
+ *
+ * @details
+ *  The rows are Euclid::Table::Row, built by the OutputRegistry converter with every cell boxed in a variant.
+ *  The writers of the subclasses consume these rows: there is no typed, column-oriented batch between the
+ *  sources and the writers.
+ */
 class FlushableOutput : public Output {
 
 public:
@@ -27,15 +38,24 @@ public:
 
   size_t flush() override {
     if (!m_rows.empty()) {
+      Tracer::Scope trace_scope("output", "Write rows");
       writeRows(m_rows);
     }
     m_total_rows_written += m_rows.size();
     m_rows.clear();
+    m_rows_memory.resize(0);
     return m_total_rows_written;
   }
 
   void outputSource(const SourceInterface& source) override {
-    m_rows.emplace_back(m_source_to_row(source));
+    outputRow(m_source_to_row(source));
+  }
+
+  /// Add a row already converted (i.e. by a decorator that needs the rows too)
+  void outputRow(Euclid::Table::Row row) {
+    // Only the cells are counted, not the content of the strings and arrays they point to
+    m_rows_memory.resize(m_rows_memory.getBytes() + row.size() * sizeof(Euclid::Table::Row::cell_type));
+    m_rows.emplace_back(std::move(row));
     if (m_flush_size > 0 && m_rows.size() % m_flush_size == 0) {
       flush();
     }
@@ -49,6 +69,7 @@ private:
   size_t m_flush_size;
 
   std::vector<Euclid::Table::Row> m_rows {};
+  MemoryAccounting::Allocation m_rows_memory {MemoryAccounting::OUTPUT, 0};
   size_t m_total_rows_written;
 };
 
@@ -0,0 +1,68 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * IdRenumbering.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_OUTPUT_IDRENUMBERING_H_
+#define _SEIMPLEMENTATION_OUTPUT_IDRENUMBERING_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Table/Row.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class IdRenumbering
+ * @brief Shifts the id columns of the catalogs of several shards, so the ids stay unique once merged
+ *
+ * @details
+ *  The ids of each shard are shifted past the largest id of the previous shards. Ids that are not
+ *  in the catalog, i.e. in a check image, can be accounted for with updateMaxId.
+ */
+class IdRenumbering {
+public:
+  explicit IdRenumbering(const std::vector<std::string>& columns);
+
+  /// Called before the first row of a new shard
+  void nextShard();
+
+  /// Raise the largest id of the current shard
+  void updateMaxId(const std::string& column, std::int64_t id);
+
+  /// Offset added to the ids of the current shard
+  std::int64_t getOffset(const std::string& column) const;
+
+  Euclid::Table::Row apply(const Euclid::Table::Row& row);
+
+  /// Value of an integer id cell
+  static std::int64_t getId(const Euclid::Table::Row::cell_type& cell, const std::string& column);
+
+private:
+  std::vector<std::string> m_columns;
+  std::map<std::string, std::int64_t> m_offsets, m_max_ids;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_OUTPUT_IDRENUMBERING_H_ */
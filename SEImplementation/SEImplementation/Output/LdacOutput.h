@@ -10,6 +10,7 @@
 
 #include "Table/FitsWriter.h"
 
+#include "SEImplementation/Output/FitsTableWriter.h"
 #include "SEImplementation/Output/FlushableOutput.h"
 
 namespace SourceXtractor {
@@ -27,8 +28,7 @@ public:
 
 protected:
   void writeRows(const std::vector<Euclid::Table::Row>& rows) override {
-    Euclid::Table::Table table {rows};
-    m_fits_writer->addData(table);
+    m_fits_writer->addRows(rows);
   }
 
 private:
@@ -37,7 +37,7 @@ private:
   std::string m_filename;
   int m_part_nb;
 
-  std::shared_ptr<Euclid::Table::FitsWriter> m_fits_writer;
+  std::shared_ptr<FitsTableWriter> m_fits_writer;
 
   std::map<std::string, MetadataEntry> m_image_metadata {};
   DetectionImage::PixelType m_rms;
@@ -23,9 +23,12 @@
 #ifndef _SEIMPLEMENTATION_OUTPUT_OUTPUTFACTORY_H
 #define _SEIMPLEMENTATION_OUTPUT_OUTPUTFACTORY_H
 
+#include "SEImplementation/Checkpoint/Checkpoint.h"
 #include "SEImplementation/Configuration/OutputConfig.h"
+#include "SEImplementation/Output/FlushableOutput.h"
 #include "SEFramework/Output/Output.h"
 #include "SEFramework/Configuration/Configurable.h"
+#include "SEUtils/PixelRectangle.h"
 
 namespace SourceXtractor {
 
@@ -39,7 +42,8 @@ class OutputFactory : public Configurable {
 public:
 
   explicit OutputFactory(std::shared_ptr<OutputRegistry> output_registry)
-    : m_output_registry(output_registry), m_flush_size(100), m_output_format(OutputConfig::OutputFileFormat::ASCII) {
+    : m_output_registry(output_registry), m_flush_size(100), m_output_format(OutputConfig::OutputFileFormat::ASCII),
+      m_shard_enabled(false), m_shard_margin(0), m_checkpoint_interval(0) {
   }
 
   /// Destructor
@@ -52,6 +56,8 @@ public:
   void reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const override;
 
 private:
+  std::shared_ptr<FlushableOutput> createFileOutput() const;
+
   std::shared_ptr<OutputRegistry> m_output_registry;
   std::vector<std::string> m_output_properties;
   size_t m_flush_size;
@@ -59,6 +65,13 @@ private:
   OutputConfig::OutputFileFormat m_output_format;
   std::string m_output_filename;
 
+  bool m_shard_enabled;
+  PixelRectangle m_shard_core_region;
+  int m_shard_margin;
+
+  std::shared_ptr<Checkpoint> m_checkpoint;
+  int m_checkpoint_interval;
+
 }; /* End of OutputFactory class */
 
 } /* namespace SourceXtractor */
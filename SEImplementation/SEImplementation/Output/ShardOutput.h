@@ -0,0 +1,65 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ShardOutput.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_OUTPUT_SHARDOUTPUT_H_
+#define _SEIMPLEMENTATION_OUTPUT_SHARDOUTPUT_H_
+
+#include <memory>
+
+#include "SEUtils/PixelRectangle.h"
+#include "SEFramework/Output/Output.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class ShardOutput
+ * @brief Writes only the sources owned by a shard
+ *
+ * A source is owned when the pixel that contains its centroid is inside the core region of the shard.
+ * Owned sources that reach the edge of the processed region may have been truncated by the segmentation,
+ * so they are counted and reported on flush.
+ */
+class ShardOutput : public Output {
+
+public:
+  ShardOutput(std::shared_ptr<Output> output, const PixelRectangle& core_region, int margin);
+
+  virtual ~ShardOutput() = default;
+
+  void outputSource(const SourceInterface& source) override;
+
+  size_t flush() override;
+
+  void nextPart() override {
+    m_output->nextPart();
+  }
+
+private:
+  std::shared_ptr<Output> m_output;
+  PixelRectangle m_core_region;
+  int m_margin;
+  size_t m_truncated, m_reported_truncated;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_OUTPUT_SHARDOUTPUT_H_ */
@@ -23,6 +23,7 @@
 #define _SEIMPLEMENTATION_PLUGIN_APERTUREPHOTOMETRY_APERTUREPHOTOMETRYCONFIG_H
 
 #include <Configuration/Configuration.h>
+#include "SEFramework/Aperture/Aperture.h"
 
 namespace SourceXtractor {
 
@@ -30,6 +31,8 @@ class AperturePhotometryConfig: public Euclid::Configuration::Configuration {
 public:
   explicit AperturePhotometryConfig(long manager_id);
 
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
   void initialize(const UserValues& args) override;
 
   std::vector<float> getAperturesForImage(unsigned image_id) const;
@@ -40,11 +43,17 @@ public:
     return m_output_images;
   }
 
+  ApertureOverlap getOverlap() const {
+    return m_overlap;
+  }
+
 private:
   // Map the image id to the apertures
   std::map<unsigned, std::vector<float>> m_apertures;
   // List of images for which we write a column
   std::map<std::string, std::vector<unsigned>> m_output_images;
+  // How the pixel coverage is computed
+  ApertureOverlap m_overlap;
 };
 
 }
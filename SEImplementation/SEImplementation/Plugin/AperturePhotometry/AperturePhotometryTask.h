@@ -35,11 +35,13 @@ public:
   virtual ~AperturePhotometryTask() = default;
 
   AperturePhotometryTask(const std::vector<SeFloat> &apertures, unsigned int instance,
-                         SeFloat magnitude_zero_point, bool use_symmetry)
+                         SeFloat magnitude_zero_point, bool use_symmetry,
+                         ApertureOverlap overlap = ApertureOverlap::SAMPLED)
     : m_apertures(apertures),
       m_instance(instance),
       m_magnitude_zero_point(magnitude_zero_point),
-      m_use_symmetry(use_symmetry) {}
+      m_use_symmetry(use_symmetry),
+      m_overlap(overlap) {}
 
   void computeProperties(SourceInterface &source) const override;
 
@@ -48,7 +50,7 @@ private:
   unsigned int m_instance;
   SeFloat m_magnitude_zero_point;
   bool m_use_symmetry;
-
+  ApertureOverlap m_overlap;
 };
 
 }
@@ -24,6 +24,7 @@
 #ifndef _SEIMPLEMENTATION_PLUGIN_APERTUREPHOTOMETRY_APERTUREPHOTOMETRYTASKFACTORY_H_
 #define _SEIMPLEMENTATION_PLUGIN_APERTUREPHOTOMETRY_APERTUREPHOTOMETRYTASKFACTORY_H_
 
+#include "SEFramework/Aperture/Aperture.h"
 #include "SEFramework/Task/TaskFactory.h"
 #include "SEUtils/Types.h"
 
@@ -47,7 +48,8 @@ namespace SourceXtractor {
  */
 class AperturePhotometryTaskFactory : public TaskFactory {
 public:
-  AperturePhotometryTaskFactory() : m_magnitude_zero_point(0), m_symmetry_usage(true) {}
+  AperturePhotometryTaskFactory() : m_magnitude_zero_point(0), m_symmetry_usage(true),
+                                    m_overlap(ApertureOverlap::SAMPLED) {}
 
   /// Destructor
   virtual ~AperturePhotometryTaskFactory() = default;
@@ -63,6 +65,7 @@ public:
 private:
   SeFloat m_magnitude_zero_point;
   bool m_symmetry_usage;
+  ApertureOverlap m_overlap;
 
   // Apertures for a given image ID
   std::map<unsigned, std::vector<float>> m_aperture_config;
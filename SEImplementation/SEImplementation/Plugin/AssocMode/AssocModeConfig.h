@@ -62,6 +62,8 @@ public:
     std::vector<double> assoc_columns;
     double source_radius_pixels;
     unsigned int group_id;
+    // match radius of this entry in detection pixels, or 0 to use the assoc radius
+    double match_radius;
   };
 
   explicit AssocModeConfig(long manager_id);
@@ -90,6 +92,11 @@ public:
     return m_custom_column_names;
   }
 
+  /// If true, the assoc segmentation publishes the catalog sorted by row and releases the groups progressively
+  bool isStreaming() const {
+    return m_streaming;
+  }
+
 private:
   void readCommonConfig(const UserValues& args);
   void readConfigFromParams(const UserValues& args);
@@ -99,6 +106,9 @@ private:
   void checkConfig();
   void printConfig();
   void readCatalogs(const std::string& filename, const std::vector<int>& columns, AssocCoordType assoc_coord_type);
+  void readIndex();
+  void buildIndex();
+  static std::shared_ptr<Euclid::Table::TableReader> openCatalog(const std::string& filename);
   AssocCoordType getCoordinateType(const UserValues& args) const;
 
   std::vector<CatalogEntry> readTable(const Euclid::Table::Table& table, const std::vector<int>& columns,
@@ -109,6 +119,7 @@ private:
   double m_default_pixel_size;
   int m_pixel_size_column;
   int m_group_id_column;
+  int m_match_radius_column;
 
   std::vector<std::vector<CatalogEntry>> m_catalogs;
   std::vector<int> m_columns;
@@ -117,6 +128,9 @@ private:
 
   std::map<std::string, unsigned int>  m_assoc_columns;
   std::string m_filename;
+  std::string m_index_filename;
+  double m_index_cell_size;
+  bool m_streaming;
 
   AssocCoordType m_assoc_coord_type;
 };
@@ -45,6 +45,9 @@ private:
   std::vector<KdTree<AssocModeConfig::CatalogEntry>> m_catalogs;
   AssocModeConfig::AssocMode m_assoc_mode;
   double m_radius;
+  // largest of the assoc radius and the per-entry match radii
+  double m_max_radius;
+  bool m_has_match_radius;
 };
 
 }
@@ -0,0 +1,134 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * AssocSkyIndex.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_PLUGIN_ASSOCMODE_ASSOCSKYINDEX_H_
+#define _SEIMPLEMENTATION_PLUGIN_ASSOCMODE_ASSOCSKYINDEX_H_
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "SEFramework/CoordinateSystem/CoordinateSystem.h"
+#include "SEImplementation/Plugin/AssocMode/AssocModeConfig.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class AssocSkyIndex
+ * @brief On-disk assoc catalog partitioned in sky cells
+ *
+ * @details
+ *  The sky is split in declination zones of cell-size degrees, and each zone in right ascension cells
+ *  no wider than cell-size degrees on the sky. The entries are stored grouped by cell, so the entries
+ *  that fall on an image can be read without loading the whole catalog.
+ *
+ *  The file starts with a header and the directory of the cells, followed by the entries as
+ *  fixed-size records of doubles. It uses the byte order of the machine that built it.
+ */
+class AssocSkyIndex {
+public:
+  using CatalogEntry = AssocModeConfig::CatalogEntry;
+
+  /**
+   * @class Builder
+   * @brief Writes an index from a stream of entries, without keeping them in memory
+   *
+   * The entries are spooled to a temporary file next to the index, and sorted by cell on finish().
+   */
+  class Builder {
+  public:
+    Builder(const std::string& path, double cell_size, std::size_t assoc_columns_nb);
+
+    virtual ~Builder();
+
+    /// Only the world coordinates of the entry are used to place it
+    void add(const CatalogEntry& entry);
+
+    void finish();
+
+  private:
+    std::string m_path, m_tmp_path;
+    double m_cell_size;
+    std::size_t m_assoc_columns_nb;
+    std::vector<std::uint64_t> m_zones;
+    std::vector<std::uint64_t> m_counts;
+    double m_max_match_radius;
+    double m_max_source_radius;
+    std::ofstream m_tmp;
+    std::vector<double> m_record;
+  };
+
+  explicit AssocSkyIndex(const std::string& path);
+
+  virtual ~AssocSkyIndex() = default;
+
+  std::size_t getAssocColumnsNb() const {
+    return m_assoc_columns_nb;
+  }
+
+  std::uint64_t getEntriesNb() const {
+    return m_offsets.back();
+  }
+
+  /// Largest per-entry match radius, in detection pixels
+  double getMaxMatchRadius() const {
+    return m_max_match_radius;
+  }
+
+  /// Largest per-entry source radius, in detection pixels
+  double getMaxSourceRadius() const {
+    return m_max_source_radius;
+  }
+
+  /**
+   * Read the entries that fall on an image, plus a margin
+   *
+   * @param coordinate_system
+   *    Coordinate system of the image, used to compute the footprint and the pixel coordinates of the entries
+   * @param margin
+   *    Margin around the image, in pixels
+   */
+  std::vector<CatalogEntry> query(const CoordinateSystem& coordinate_system, int width, int height,
+                                  double margin) const;
+
+  /// Read all the entries, without pixel coordinates
+  std::vector<CatalogEntry> readAll() const;
+
+private:
+  void readRecords(std::ifstream& file, std::uint64_t first, std::uint64_t last,
+                   const std::function<void(const double*)>& callback) const;
+
+  std::string m_path;
+  double m_cell_size;
+  std::size_t m_assoc_columns_nb;
+  double m_max_match_radius;
+  double m_max_source_radius;
+  std::vector<std::uint64_t> m_zones;
+  std::vector<std::uint64_t> m_offsets;
+  std::uint64_t m_data_offset;
+};
+
+}  // namespace SourceXtractor
+
+#endif /* _SEIMPLEMENTATION_PLUGIN_ASSOCMODE_ASSOCSKYINDEX_H_ */
@@ -26,6 +26,7 @@
 
 #include <vector>
 #include "Configuration/Configuration.h"
+#include "SEFramework/Aperture/Aperture.h"
 
 namespace SourceXtractor {
 
@@ -44,10 +45,12 @@ public:
 
   SeFloat getAutoKronFactor() const;
   SeFloat getAutoKronMinrad() const;
+  ApertureOverlap getAutoOverlap() const;
 
 private:
   SeFloat m_kron_factor = 2.5;
   SeFloat m_kron_minrad = 3.5;
+  ApertureOverlap m_overlap = ApertureOverlap::SAMPLED;
 };
 
 } /* namespace SourceXtractor */
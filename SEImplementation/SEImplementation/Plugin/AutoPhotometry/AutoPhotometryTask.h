@@ -35,12 +35,14 @@ public:
   /// Destructor
   virtual ~AutoPhotometryTask() = default;
 
-  AutoPhotometryTask(unsigned instance, SeFloat magnitude_zero_point, SeFloat kron_factor, SeFloat kron_minrad, bool use_symmetry) :
+  AutoPhotometryTask(unsigned instance, SeFloat magnitude_zero_point, SeFloat kron_factor, SeFloat kron_minrad, bool use_symmetry,
+                     ApertureOverlap overlap = ApertureOverlap::SAMPLED) :
     m_instance(instance),
     m_magnitude_zero_point(magnitude_zero_point),
     m_kron_factor(kron_factor),
     m_kron_minrad(kron_minrad),
-    m_use_symmetry(use_symmetry) {}
+    m_use_symmetry(use_symmetry),
+    m_overlap(overlap) {}
 
   void computeProperties(SourceInterface& source) const override;
 
@@ -50,6 +52,7 @@ private:
   SeFloat m_kron_factor;
   SeFloat m_kron_minrad;
   bool m_use_symmetry;
+  ApertureOverlap m_overlap;
 };
 
 }
@@ -25,6 +25,7 @@
 #define _SEIMPLEMENTATION_PLUGIN_AUTOPHOTOMETRY_AUTOPHOTOMETRYTASKFACTORY_H_
 
 #include "SEUtils/Types.h"
+#include "SEFramework/Aperture/Aperture.h"
 #include "SEFramework/Task/TaskFactory.h"
 
 
@@ -51,6 +52,7 @@ private:
   SeFloat m_kron_factor;
   SeFloat m_kron_minrad;
   bool    m_symmetry_usage;
+  ApertureOverlap m_overlap;
   std::vector<std::pair<std::string, unsigned int>> m_auto_names;
   std::vector<unsigned> m_images;
 };
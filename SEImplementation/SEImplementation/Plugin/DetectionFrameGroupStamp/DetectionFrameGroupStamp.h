@@ -25,6 +25,7 @@
 #define _SEIMPLEMENTATION_PLUGIN_DETECTIONFRAMEGROUPSTAMP_DETECTIONFRAMEGROUPSTAMP_H_
 
 
+#include "SEUtils/MemoryAccounting.h"
 #include "SEFramework/Property/Property.h"
 #include "SEFramework/Image/Image.h"
 
@@ -40,7 +41,9 @@ public:
       std::shared_ptr<DetectionImage> thresholded_stamp, PixelCoordinate top_left,
       std::shared_ptr<WeightImage> variance_stamp) :
         m_stamp(stamp), m_thresholded_stamp(thresholded_stamp),
-        m_variance_stamp(variance_stamp), m_top_left(top_left) {}
+        m_variance_stamp(variance_stamp), m_top_left(top_left),
+        m_memory(MemoryAccounting::GROUPS, stampSize(m_stamp) + stampSize(m_thresholded_stamp) +
+                                           stampSize(m_variance_stamp)) {}
 
   // Returns the stamp image
   const DetectionImage& getStamp() const {
@@ -64,6 +67,12 @@ private:
   std::shared_ptr<DetectionImage> m_stamp, m_thresholded_stamp;
   std::shared_ptr<WeightImage> m_variance_stamp;
   PixelCoordinate m_top_left;
+  MemoryAccounting::Allocation m_memory;
+
+  template <typename T>
+  static int64_t stampSize(const std::shared_ptr<Image<T>>& stamp) {
+    return stamp ? int64_t(stamp->getWidth()) * stamp->getHeight() * sizeof(T) : 0;
+  }
 
 };
 
@@ -25,6 +25,7 @@
 
 #include <vector>
 
+#include "SEUtils/MemoryAccounting.h"
 #include "SEFramework/Property/Property.h"
 #include "SEFramework/Image/Image.h"
 
@@ -48,7 +49,9 @@ public:
       std::vector<DetectionImage::PixelType> values,
       std::vector<DetectionImage::PixelType> filtered_values,
       std::vector<WeightImage::PixelType> variances)
-    : m_values(std::move(values)), m_filtered_values(filtered_values), m_variances(variances) {}
+    : m_values(std::move(values)), m_filtered_values(filtered_values), m_variances(variances),
+      m_memory(MemoryAccounting::SOURCES, (m_values.size() + m_filtered_values.size()) * sizeof(DetectionImage::PixelType) +
+                                          m_variances.size() * sizeof(WeightImage::PixelType)) {}
 
   const std::vector<DetectionImage::PixelType>& getValues() const {
     return m_values;
@@ -67,6 +70,7 @@ private:
   std::vector<DetectionImage::PixelType> m_values;
   std::vector<DetectionImage::PixelType> m_filtered_values;
   std::vector<DetectionImage::PixelType> m_variances;
+  MemoryAccounting::Allocation m_memory;
 
 }; /* End of DetectionFramePixelValues class */
 
@@ -44,6 +44,7 @@ public:
 
   // TaskFactory implementation
   std::shared_ptr<Task> createTask(const PropertyId& property_id) const override;
+  std::set<PropertyId> getRequiredProperties(const PropertyId& property_id) const override;
 };
 
 } /* namespace SourceXtractor */
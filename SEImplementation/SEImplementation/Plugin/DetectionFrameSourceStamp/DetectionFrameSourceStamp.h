@@ -23,6 +23,7 @@
 #ifndef _SEIMPLEMENTATION_PROPERTY_DETECTIONFRAMESOURCESTAMP_H
 #define _SEIMPLEMENTATION_PROPERTY_DETECTIONFRAMESOURCESTAMP_H
 
+#include "SEUtils/MemoryAccounting.h"
 #include "SEFramework/Property/Property.h"
 #include "SEFramework/Image/VectorImage.h"
 
@@ -53,7 +54,9 @@ public:
                             std::shared_ptr<DetectionVectorImage> threshold_map_stamp) :
     m_stamp(stamp), m_filtered_stamp(filtered_stamp), m_thresholded_stamp(thresholded_stamp),
     m_threshold_map_stamp(threshold_map_stamp), m_variance_stamp(variance_stamp),
-    m_top_left(top_left) {}
+    m_top_left(top_left),
+    m_memory(MemoryAccounting::SOURCES, stampSize(m_stamp) + stampSize(m_filtered_stamp) +
+             stampSize(m_thresholded_stamp) + stampSize(m_threshold_map_stamp) + stampSize(m_variance_stamp)) {}
 
   // Returns the stamp image
   const DetectionVectorImage& getStamp() const {
@@ -89,6 +92,12 @@ private:
   std::shared_ptr<DetectionVectorImage> m_thresholded_stamp, m_threshold_map_stamp;
   std::shared_ptr<WeightVectorImage> m_variance_stamp;
   PixelCoordinate m_top_left;
+  MemoryAccounting::Allocation m_memory;
+
+  template <typename T>
+  static int64_t stampSize(const std::shared_ptr<VectorImage<T>>& stamp) {
+    return stamp ? stamp->getData().size() * sizeof(T) : 0;
+  }
 
 }; /* End of DetectionFrameSourceStamp class */
 
@@ -133,12 +133,15 @@ public:
   /// The signature of a function that evaluates the dependent parameter. It gets
   /// as parameters the values of those parameters on which this one depends.
   using ValueFunc = std::function<double(const std::shared_ptr<CoordinateSystem>&, const std::vector<double>&)>;
+
+  /// Evaluates the dependent parameter for each set of values at once, into the output vector.
+  /// Only the uncertainty propagation uses it: the minimizer goes through ValueFunc.
+  using BatchValueFunc = std::function<void(const std::shared_ptr<CoordinateSystem>&,
+                                            const std::vector<std::vector<double>>&, std::vector<double>&)>;
   
   FlexibleModelFittingDependentParameter(int id, ValueFunc value_calculator,
-                                         std::vector<std::shared_ptr<FlexibleModelFittingParameter>> parameters)
-          : FlexibleModelFittingParameter(id),
-            m_value_calculator(value_calculator),
-            m_parameters(parameters) { }
+                                         std::vector<std::shared_ptr<FlexibleModelFittingParameter>> parameters,
+                                         BatchValueFunc batch_value_calculator = nullptr);
 
   std::shared_ptr<ModelFitting::BasicParameter> create(
                                   FlexibleModelFittingParameterManager& parameter_manager,
@@ -157,6 +160,7 @@ public:
 private:
 
   ValueFunc m_value_calculator;
+  BatchValueFunc m_batch_value_calculator;
   std::vector<std::shared_ptr<FlexibleModelFittingParameter>> m_parameters;
   
 };
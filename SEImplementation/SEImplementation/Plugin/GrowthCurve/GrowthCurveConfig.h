@@ -19,6 +19,7 @@
 #define _SEIMPLEMENTATION_PLUGIN_GROWTHCURVE_GROWTHCURVECONFIG_H_
 
 #include <Configuration/Configuration.h>
+#include "SEFramework/Aperture/Aperture.h"
 
 namespace SourceXtractor {
 
@@ -39,8 +40,13 @@ public:
     return m_nsamples;
   }
 
+  ApertureOverlap getOverlap() const {
+    return m_overlap;
+  }
+
 public:
   int m_nsamples = 0;
+  ApertureOverlap m_overlap = ApertureOverlap::SAMPLED;
 };
 
 }  // end of namespace SourceXtractor
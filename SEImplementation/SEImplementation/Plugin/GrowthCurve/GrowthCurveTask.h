@@ -18,6 +18,7 @@
 #ifndef _SEIMPLEMENTATION_PLUGIN_GROWTHCURVE_GROWTHCURVETASK_H_
 #define _SEIMPLEMENTATION_PLUGIN_GROWTHCURVE_GROWTHCURVETASK_H_
 
+#include "SEFramework/Aperture/Aperture.h"
 #include "SEFramework/Task/SourceTask.h"
 
 namespace SourceXtractor {
@@ -26,13 +27,14 @@ class GrowthCurveTask : public SourceTask {
 public:
   virtual ~GrowthCurveTask() = default;
 
-  GrowthCurveTask(unsigned instance, bool use_symmetry);
+  GrowthCurveTask(unsigned instance, bool use_symmetry, ApertureOverlap overlap = ApertureOverlap::SAMPLED);
 
   void computeProperties(SourceInterface& source) const override;
 
 private:
   unsigned m_instance;
   bool m_use_symmetry;
+  ApertureOverlap m_overlap;
 };
 
 } // end of namespace SourceXtractor
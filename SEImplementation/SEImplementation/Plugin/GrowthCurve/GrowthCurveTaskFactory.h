@@ -18,6 +18,7 @@
 #ifndef _SEIMPLEMENTATION_PLUGIN_GROWTHCURVE_GROWTHCURVETASKFACTORY_H_
 #define _SEIMPLEMENTATION_PLUGIN_GROWTHCURVE_GROWTHCURVETASKFACTORY_H_
 
+#include "SEFramework/Aperture/Aperture.h"
 #include "SEFramework/Task/TaskFactory.h"
 
 namespace SourceXtractor {
@@ -37,6 +38,7 @@ public:
 private:
   int                   m_nsamples     = 0;
   bool                  m_use_symmetry = false;
+  ApertureOverlap       m_overlap      = ApertureOverlap::SAMPLED;
   std::vector<unsigned> m_images;
 };
 
@@ -41,6 +41,7 @@ public:
 
   // TaskFactory implementation
   std::shared_ptr<Task> createTask(const PropertyId& property_id) const override;
+  std::set<PropertyId> getRequiredProperties(const PropertyId& property_id) const override;
 
   void reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const override;
   void configure(Euclid::Configuration::ConfigManager& manager) override;
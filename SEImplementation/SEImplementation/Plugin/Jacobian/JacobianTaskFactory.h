@@ -25,6 +25,8 @@
 #ifndef _SEIMPLEMENTATION_PLUGIN_JACOBIAN_JACOBIANTASKFACTORY_H_
 #define _SEIMPLEMENTATION_PLUGIN_JACOBIAN_JACOBIANTASKFACTORY_H_
 
+#include <map>
+
 #include "SEFramework/Task/TaskFactory.h"
 
 namespace SourceXtractor {
@@ -34,6 +36,13 @@ public:
   virtual ~JacobianTaskFactory() = default;
 
   std::shared_ptr<Task> createTask(const PropertyId& property_id) const override;
+
+  void reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const override;
+  void configure(Euclid::Configuration::ConfigManager& manager) override;
+
+private:
+  /// Frames sharing the geometry of an earlier frame copy its jacobians
+  std::map<int, int> m_geometry_references;
 };
 
 } // end SourceXtractor
@@ -0,0 +1,145 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * LazyMeasurementFrame.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_PLUGIN_MEASUREMENTFRAME_LAZYMEASUREMENTFRAME_H_
+#define _SEIMPLEMENTATION_PLUGIN_MEASUREMENTFRAME_LAZYMEASUREMENTFRAME_H_
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "SEFramework/Frame/Frame.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class LazyMeasurementFrame
+ * @brief A measurement frame whose background and variance are only modelled when a source first needs them
+ *
+ * @details
+ *  The geometry, coordinate system, gain and saturation come from the image header and are known upfront,
+ *  so the overlap of a source with the frame can be decided without building it.
+ *  Frames sharing a LoadedFrames instance are unloaded, least recently used first, above its limit. The memory
+ *  is freed once the sources still holding an unloaded frame release it. Until then, the next request takes
+ *  that frame back instead of building a second one.
+ *  The frame is built without holding its mutex: other requests wait for it, but the state can still be queried.
+ */
+class LazyMeasurementFrame {
+public:
+  using Builder = std::function<std::shared_ptr<MeasurementImageFrame>()>;
+
+  /// Least recently used list of the loaded frames
+  class LoadedFrames {
+  public:
+    /// A limit of 0 keeps every frame once loaded
+    explicit LoadedFrames(std::size_t max_loaded) : m_max_loaded(max_loaded) {}
+
+    std::size_t getLoadedCount() const;
+
+  private:
+    /// Move the frame to the front, and unload the least recently used frames above the limit
+    void touch(LazyMeasurementFrame* frame);
+    void remove(LazyMeasurementFrame* frame);
+
+    mutable std::mutex m_mutex;
+    std::size_t m_max_loaded;
+    std::list<LazyMeasurementFrame*> m_frames;
+
+    friend class LazyMeasurementFrame;
+  };
+
+  LazyMeasurementFrame(int width, int height, std::shared_ptr<CoordinateSystem> coordinate_system,
+                       SeFloat gain, SeFloat saturation, Builder builder,
+                       std::shared_ptr<LoadedFrames> loaded_frames = nullptr);
+
+  /// Wraps a frame that is already built, i.e. the detection frame
+  explicit LazyMeasurementFrame(std::shared_ptr<MeasurementImageFrame> frame);
+
+  virtual ~LazyMeasurementFrame();
+
+  LazyMeasurementFrame(const LazyMeasurementFrame&) = delete;
+  LazyMeasurementFrame& operator=(const LazyMeasurementFrame&) = delete;
+
+  int getWidth() const {
+    return m_width;
+  }
+
+  int getHeight() const {
+    return m_height;
+  }
+
+  std::shared_ptr<CoordinateSystem> getCoordinateSystem() const {
+    return m_coordinate_system;
+  }
+
+  SeFloat getGain() const {
+    return m_gain;
+  }
+
+  SeFloat getSaturation() const {
+    return m_saturation;
+  }
+
+  /// Build the frame if needed
+  std::shared_ptr<MeasurementImageFrame> getFrame();
+
+  /// These depend on the background model, so the frame is built once to know them
+  WeightImage::PixelType getVarianceThreshold();
+  SeFloat getBackgroundMedianRms();
+
+  bool isLoaded() const;
+
+  /// Number of times the frame has been built
+  int getLoadCount() const;
+
+  /// Release the reference kept on the frame, if it can be built again. It is taken back while still in use
+  void unload();
+
+private:
+  int m_width, m_height;
+  std::shared_ptr<CoordinateSystem> m_coordinate_system;
+  SeFloat m_gain, m_saturation;
+  Builder m_builder;
+  std::shared_ptr<LoadedFrames> m_loaded_frames;
+
+  mutable std::mutex m_mutex;
+  /// Notified when a build ends
+  std::condition_variable m_built;
+  bool m_building;
+  std::shared_ptr<MeasurementImageFrame> m_frame;
+  std::weak_ptr<MeasurementImageFrame> m_unloaded_frame;
+  WeightImage::PixelType m_variance_threshold;
+  SeFloat m_background_rms;
+  int m_load_count;
+
+  // Guarded by the mutex of m_loaded_frames
+  bool m_listed;
+  std::list<LazyMeasurementFrame*>::iterator m_list_position;
+};
+
+} // namespace SourceXtractor
+
+#endif /* _SEIMPLEMENTATION_PLUGIN_MEASUREMENTFRAME_LAZYMEASUREMENTFRAME_H_ */
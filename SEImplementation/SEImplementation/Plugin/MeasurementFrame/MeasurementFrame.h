@@ -31,15 +31,26 @@
 #include "SEFramework/Image/ConstantImage.h"
 #include "SEFramework/CoordinateSystem/CoordinateSystem.h"
 
+#include "SEImplementation/Plugin/MeasurementFrame/LazyMeasurementFrame.h"
+
 namespace SourceXtractor {
 
 class MeasurementFrame : public Property {
 public:
-  explicit MeasurementFrame(std::shared_ptr<MeasurementImageFrame> measurement_frame) : m_measurement_frame(measurement_frame) {
+  explicit MeasurementFrame(std::shared_ptr<LazyMeasurementFrame> measurement_frame) : m_measurement_frame(measurement_frame) {
+  }
+
+  explicit MeasurementFrame(std::shared_ptr<MeasurementImageFrame> measurement_frame)
+    : m_measurement_frame(std::make_shared<LazyMeasurementFrame>(measurement_frame)) {
   }
 
 protected:
+  // Builds the frame if it is not loaded
   std::shared_ptr<MeasurementImageFrame> getFrame() const {
+    return m_measurement_frame->getFrame();
+  }
+
+  const std::shared_ptr<LazyMeasurementFrame>& getLazyFrame() const {
     return m_measurement_frame;
   }
 
@@ -49,7 +60,7 @@ protected:
   friend class MeasurementFrameImagesTask;
 
 private:
-  std::shared_ptr<MeasurementImageFrame> m_measurement_frame;
+  std::shared_ptr<LazyMeasurementFrame> m_measurement_frame;
 };
 
 }
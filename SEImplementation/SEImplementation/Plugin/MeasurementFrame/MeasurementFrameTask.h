@@ -26,6 +26,8 @@
 
 #include "SEFramework/Task/SourceTask.h"
 
+#include "SEImplementation/Plugin/MeasurementFrame/LazyMeasurementFrame.h"
+
 namespace SourceXtractor {
 
 class MeasurementFrameTask : public SourceTask {
@@ -36,7 +38,7 @@ public:
    */
   virtual ~MeasurementFrameTask() = default;
 
-  MeasurementFrameTask(unsigned int instance, std::shared_ptr<MeasurementImageFrame> measurement_frame) :
+  MeasurementFrameTask(unsigned int instance, std::shared_ptr<LazyMeasurementFrame> measurement_frame) :
     m_instance(instance),
     m_measurement_frame(measurement_frame) {}
 
@@ -44,7 +46,7 @@ public:
 
 private:
   unsigned int m_instance;
-  std::shared_ptr<MeasurementImageFrame> m_measurement_frame;
+  std::shared_ptr<LazyMeasurementFrame> m_measurement_frame;
 };
 
 class DefaultMeasurementFrameTask : public SourceTask {
@@ -28,6 +28,8 @@
 
 #include "SEFramework/Task/TaskFactory.h"
 
+#include "SEImplementation/Plugin/MeasurementFrame/LazyMeasurementFrame.h"
+
 namespace SourceXtractor {
 
 class MeasurementFrameTaskFactory : public TaskFactory {
@@ -44,7 +46,7 @@ public:
   void configure(Euclid::Configuration::ConfigManager& manager) override;
 
 private:
-  std::map<int, std::shared_ptr<MeasurementImageFrame>> m_measurement_frames;
+  std::map<int, std::shared_ptr<LazyMeasurementFrame>> m_measurement_frames;
 };
 
 }
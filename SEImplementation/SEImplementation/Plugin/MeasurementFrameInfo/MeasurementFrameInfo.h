@@ -23,6 +23,8 @@
 #include "SEFramework/Property/Property.h"
 #include "SEFramework/CoordinateSystem/CoordinateSystem.h"
 
+#include "SEImplementation/Plugin/MeasurementFrame/LazyMeasurementFrame.h"
+
 namespace SourceXtractor {
 
 class MeasurementFrameInfo : public Property {
@@ -36,6 +38,12 @@ public:
         m_gain(gain), m_saturation(saturation),
         m_variance_threshold(variance_threshold), m_background_median_rms(background_median_rms) {}
 
+  /// The variance threshold and the background RMS are taken from the frame, building it, on first use
+  explicit MeasurementFrameInfo(std::shared_ptr<LazyMeasurementFrame> frame)
+      : m_width(frame->getWidth()), m_height(frame->getHeight()),
+        m_gain(frame->getGain()), m_saturation(frame->getSaturation()),
+        m_variance_threshold(0), m_background_median_rms(0), m_frame(frame) {}
+
   double getGain() const {
     return m_gain;
   }
@@ -53,11 +61,11 @@ public:
   }
 
   SeFloat getVarianceThreshold() const {
-    return m_variance_threshold;
+    return m_frame ? m_frame->getVarianceThreshold() : m_variance_threshold;
   }
 
   SeFloat getBackgroundMedianRms() const {
-    return m_background_median_rms;
+    return m_frame ? m_frame->getBackgroundMedianRms() : m_background_median_rms;
   }
 
 private:
@@ -70,6 +78,8 @@ private:
   double m_variance_threshold;
   double m_background_median_rms;
 
+  std::shared_ptr<LazyMeasurementFrame> m_frame;
+
 };
 
 }
@@ -23,6 +23,8 @@
 #ifndef _SEIMPLEMENTATION_TASK_MEASUREMENTFRAMEPIXELCENTROIDTASKFACTORY_H
 #define _SEIMPLEMENTATION_TASK_MEASUREMENTFRAMEPIXELCENTROIDTASKFACTORY_H
 
+#include <map>
+
 #include "SEFramework/Task/TaskFactory.h"
 
 namespace SourceXtractor {
@@ -41,6 +43,13 @@ public:
 
   // TaskFactory implementation
   std::shared_ptr<Task> createTask(const PropertyId& property_id) const override;
+
+  void reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const override;
+  void configure(Euclid::Configuration::ConfigManager& manager) override;
+
+private:
+  /// Frames sharing the geometry of an earlier frame copy its centroid
+  std::map<int, int> m_geometry_references;
 };
 
 } /* namespace SourceXtractor */
@@ -24,6 +24,7 @@
 #ifndef _SEIMPLEMENTATION_PLUGIN_MEASUREMENTFRAMERECTANGLE_MEASUREMENTFRAMERECTANGLETASKFACTORY_H_
 #define _SEIMPLEMENTATION_PLUGIN_MEASUREMENTFRAMERECTANGLE_MEASUREMENTFRAMERECTANGLETASKFACTORY_H_
 
+#include <map>
 
 #include "SEFramework/Task/TaskFactory.h"
 
@@ -42,6 +43,8 @@ public:
 
 private:
   bool m_no_detection_image = false;
+  /// Frames sharing the geometry of an earlier frame copy its rectangle
+  std::map<int, int> m_geometry_references;
 
 };
 
@@ -47,6 +47,14 @@ public:
       return nullptr;
     }
   }
+
+  std::set<PropertyId> getRequiredProperties(const PropertyId& property_id) const override {
+    if (property_id == PropertyId::create<PeakValue>()) {
+      return {PropertyId::create<PixelCoordinateList>(), PropertyId::create<DetectionFramePixelValues>()};
+    } else {
+      return {};
+    }
+  }
 };
 
 
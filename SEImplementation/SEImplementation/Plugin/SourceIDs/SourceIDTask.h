@@ -45,10 +45,19 @@ public:
     source.setProperty<SourceID>(getNewId(), detection_id);
   }
 
+  /// Start numbering the sources from the given identifier, i.e. past the ones restored from a checkpoint
+  static void setNextId(unsigned int next_id) {
+    getCounter() = next_id;
+  }
+
 private:
-  static unsigned int getNewId() {
+  static std::atomic<std::uint32_t>& getCounter() {
     static std::atomic<std::uint32_t> s_id(1);
-    return s_id++;
+    return s_id;
+  }
+
+  static unsigned int getNewId() {
+    return getCounter()++;
   }
 
 };
@@ -31,6 +31,12 @@ class VignetConfig : public Euclid::Configuration::Configuration {
 
 public:
 
+  /// How the measurement frame pixels are mapped to the detection frame
+  enum class Resampling {
+    EXACT,  ///< Full WCS transformation for every pixel
+    AFFINE  ///< Local affine approximation, falling back to EXACT if it is not within tolerance
+  };
+
   explicit VignetConfig(long manager_id);
 
   virtual ~VignetConfig() = default;
@@ -47,9 +53,19 @@ public:
     return m_vignet_default_pixval;
   }
 
+  Resampling getResampling() const {
+    return m_resampling;
+  }
+
+  double getAffineTolerance() const {
+    return m_affine_tolerance;
+  }
+
 private:
   std::array<int, 2> m_vignet_size;
   double m_vignet_default_pixval;
+  Resampling m_resampling;
+  double m_affine_tolerance;
 
 };
 
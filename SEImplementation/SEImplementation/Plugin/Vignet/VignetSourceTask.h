@@ -31,10 +31,21 @@
 namespace SourceXtractor {
 class VignetSourceTask : public SourceTask {
 public:
-  VignetSourceTask(unsigned instance, std::array<int, 2> vignet_size, double vignet_default_pixval) :
+  /**
+   * @param use_affine
+   *    Map the vignet pixels into the detection frame with a local affine approximation
+   *    instead of two full WCS transformations per pixel
+   * @param affine_tolerance
+   *    Maximum deviation, in detection pixels, allowed for the affine approximation. Beyond this,
+   *    the exact transformation is used.
+   */
+  VignetSourceTask(unsigned instance, std::array<int, 2> vignet_size, double vignet_default_pixval,
+                   bool use_affine = false, double affine_tolerance = 0.01) :
     m_instance(instance),
     m_vignet_size(vignet_size),
-    m_vignet_default_pixval((SeFloat) vignet_default_pixval) {};
+    m_vignet_default_pixval((SeFloat) vignet_default_pixval),
+    m_use_affine(use_affine),
+    m_affine_tolerance(affine_tolerance) {};
 
   virtual ~VignetSourceTask() = default;
 
@@ -44,6 +55,8 @@ private:
   unsigned m_instance;
   std::array<int, 2> m_vignet_size;
   SeFloat m_vignet_default_pixval;
+  bool m_use_affine;
+  double m_affine_tolerance;
 }; // End of VignetSourceTask class
 
 } // namespace SourceXtractor
@@ -26,11 +26,13 @@
 
 #include <limits>
 #include "SEFramework/Task/TaskFactory.h"
+#include "SEImplementation/Plugin/Vignet/VignetConfig.h"
 
 namespace SourceXtractor {
 class VignetTaskFactory : public TaskFactory {
 public:
-  VignetTaskFactory():m_vignet_default_pixval(std::numeric_limits<double>::quiet_NaN()) {}
+  VignetTaskFactory():m_vignet_default_pixval(std::numeric_limits<double>::quiet_NaN()),
+                      m_resampling(VignetConfig::Resampling::EXACT), m_affine_tolerance(0.01) {}
 
   virtual ~VignetTaskFactory() = default;
 
@@ -44,6 +46,8 @@ public:
 private:
   std::array<int, 2> m_vignet_size;
   double m_vignet_default_pixval;
+  VignetConfig::Resampling m_resampling;
+  double m_affine_tolerance;
   std::vector<unsigned> m_images;
 }; // end of VignetTaskFactory class
 
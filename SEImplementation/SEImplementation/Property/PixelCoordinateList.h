@@ -22,6 +22,7 @@
 #ifndef _SEIMPLEMENTATION_PIXELCOORDINATELIST_H
 #define _SEIMPLEMENTATION_PIXELCOORDINATELIST_H
 
+#include "SEUtils/MemoryAccounting.h"
 #include "SEUtils/PixelCoordinate.h"
 #include "SEFramework/Property/Property.h"
 
@@ -35,7 +36,8 @@ class PixelCoordinateList : public Property {
 public:
   
   explicit PixelCoordinateList(std::vector<PixelCoordinate> coordinate_list)
-      : m_coordinate_list(std::move(coordinate_list)) {
+      : m_coordinate_list(std::move(coordinate_list)),
+        m_memory(MemoryAccounting::SOURCES, m_coordinate_list.size() * sizeof(PixelCoordinate)) {
   }
 
   virtual ~PixelCoordinateList() = default;
@@ -51,6 +53,7 @@ public:
 private:
 
   std::vector<PixelCoordinate> m_coordinate_list;
+  MemoryAccounting::Allocation m_memory;
   
 }; /* End of PixelCoordinateList class */
 
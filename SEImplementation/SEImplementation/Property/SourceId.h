@@ -51,12 +51,50 @@ public:
     return m_detection_id;
   }
 
+  /// Identifier that will be given to the next source. Any source created before has a lower one
+  static unsigned int getNextId() {
+    return getCounter();
+  }
+
+  /**
+   * While it exists, the SourceIds created by the calling thread are numbered on their own, without
+   * taking identifiers from the sources of the other threads. They must be set again before the sources
+   * are sent down the pipeline, see FramesAheadLabelling.
+   */
+  class LocalNumbering {
+  public:
+    LocalNumbering() : m_counter(1), m_previous(getLocalCounter()) {
+      getLocalCounter() = &m_counter;
+    }
+
+    ~LocalNumbering() {
+      getLocalCounter() = m_previous;
+    }
+
+    LocalNumbering(const LocalNumbering&) = delete;
+    LocalNumbering& operator=(const LocalNumbering&) = delete;
+
+  private:
+    std::atomic<uint32_t> m_counter;
+    std::atomic<uint32_t>* m_previous;
+  };
+
 private:
   unsigned int m_source_id, m_detection_id;
 
-  static unsigned int getNewId() {
+  static std::atomic<uint32_t>& getCounter() {
     static std::atomic<uint32_t> s_id(1);
-    return s_id++;
+    return s_id;
+  }
+
+  static std::atomic<uint32_t>*& getLocalCounter() {
+    static thread_local std::atomic<uint32_t>* s_local_counter = nullptr;
+    return s_local_counter;
+  }
+
+  static unsigned int getNewId() {
+    auto local_counter = getLocalCounter();
+    return local_counter ? (*local_counter)++ : getCounter()++;
   }
 
 
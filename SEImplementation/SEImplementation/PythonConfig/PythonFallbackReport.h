@@ -0,0 +1,87 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * @file PythonFallbackReport.h
+ */
+
+#ifndef _SEIMPLEMENTATION_PYTHONFALLBACKREPORT_H
+#define _SEIMPLEMENTATION_PYTHONFALLBACKREPORT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SourceXtractor {
+
+/**
+ * @class PythonFallbackReport
+ * @brief Counts the calls to the configuration expressions that could not be compiled
+ *
+ * Expressions that Pyston can not compile are evaluated by calling Python, which requires the GIL and
+ * serializes the threads using them. The report lists them with the number of calls and the time spent,
+ * GIL waits included, so they can be rewritten into something that compiles.
+ */
+class PythonFallbackReport {
+public:
+
+  struct Counter {
+    explicit Counter(std::string name) : m_name(std::move(name)), m_calls(0), m_nanoseconds(0) {}
+
+    const std::string m_name;
+    std::atomic<uint64_t> m_calls;
+    std::atomic<int64_t> m_nanoseconds;
+  };
+
+  /// Accounts the time between construction and destruction, for the given number of calls
+  class Timer {
+  public:
+    explicit Timer(Counter& counter, uint64_t calls = 1)
+      : m_counter(counter), m_calls(calls), m_start(std::chrono::steady_clock::now()) {}
+
+    ~Timer() {
+      auto elapsed = std::chrono::steady_clock::now() - m_start;
+      m_counter.m_calls.fetch_add(m_calls, std::memory_order_relaxed);
+      m_counter.m_nanoseconds.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+    }
+
+  private:
+    Counter& m_counter;
+    uint64_t m_calls;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  static PythonFallbackReport& getInstance();
+
+  /// Returns the counter for an expression evaluated through Python
+  std::shared_ptr<Counter> registerExpression(const std::string& name);
+
+  /// Log the expressions that have been called, the most expensive first
+  void logReport() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector<std::shared_ptr<Counter>> m_counters;
+};
+
+} // end SourceXtractor
+
+#endif // _SEIMPLEMENTATION_PYTHONFALLBACKREPORT_H
@@ -13,6 +13,7 @@
 #include "SEFramework/Source/SourceFactory.h"
 #include "SEFramework/Pipeline/Segmentation.h"
 
+#include "SEImplementation/Configuration/GroupingConfig.h"
 #include "SEImplementation/Plugin/AssocMode/AssocModeConfig.h"
 
 namespace SourceXtractor {
@@ -27,16 +28,29 @@ public:
 
   virtual ~AssocSegmentation() = default;
 
-  AssocSegmentation(std::shared_ptr<SourceFactory> source_factory, std::vector<AssocModeConfig::CatalogEntry> source_list)
-      : m_source_factory(source_factory), m_source_list(source_list) {
-    assert(source_factory != nullptr);
-  }
+  /**
+   * @param streaming
+   *  If true, the entries are published sorted by row, the members of a group one after the other, and the groups
+   *  are released as the sweep advances. Otherwise they are published in the order of the catalog,
+   *  and released at the end of the frame.
+   */
+  AssocSegmentation(std::shared_ptr<SourceFactory> source_factory, std::vector<AssocModeConfig::CatalogEntry> source_list,
+                    bool streaming = false);
 
   void labelImage(Segmentation::LabellingListener& listener, std::shared_ptr<const DetectionImageFrame> frame) override;
 
+  /**
+   * The sweep releases everything published so far on each change of row, which only gives the same groups as
+   * a release at the end of the frame if the grouping does not merge sources across groups of the catalog
+   */
+  static bool isStreamingSupported(GroupingConfig::Algorithm grouping);
+
 private:
   std::shared_ptr<SourceFactory> m_source_factory;
   std::vector<AssocModeConfig::CatalogEntry> m_source_list;
+  bool m_streaming;
+  /// Row at which each entry is reached by the sweep, the first row of its group (only when streaming)
+  std::vector<int> m_sweep_rows;
 };
 
 }
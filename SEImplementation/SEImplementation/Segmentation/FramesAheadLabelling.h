@@ -0,0 +1,80 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * FramesAheadLabelling.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_SEGMENTATION_FRAMESAHEADLABELLING_H_
+#define _SEIMPLEMENTATION_SEGMENTATION_FRAMESAHEADLABELLING_H_
+
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "SEFramework/Frame/Frame.h"
+#include "SEFramework/Pipeline/Segmentation.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class FramesAheadLabelling
+ * @brief Labels the next detection frames on their own threads while the current one is processed
+ *
+ * The sources found ahead are kept until the pipeline reaches their frame, and then sent in the
+ * order the wrapped labelling found them, with new SourceIds taken at that point: the output and
+ * the detection identifiers are the same as when labelling the frames one after the other.
+ * The wrapped labelling must not keep state between calls to labelImage.
+ */
+class FramesAheadLabelling : public Segmentation::Labelling {
+public:
+
+  /**
+   * @param labelling
+   *    Labelling of each frame
+   * @param frames
+   *    Detection frames, in the order they are processed
+   * @param filter
+   *    Filter of the segmentation, set on the frames before labelling them ahead
+   * @param frames_ahead
+   *    Number of frames labelled after the current one
+   */
+  FramesAheadLabelling(std::shared_ptr<Segmentation::Labelling> labelling,
+                       std::vector<std::shared_ptr<DetectionImageFrame>> frames,
+                       std::shared_ptr<DetectionImageFrame::ImageFilter> filter, unsigned frames_ahead);
+
+  virtual ~FramesAheadLabelling();
+
+  void labelImage(Segmentation::LabellingListener& listener, std::shared_ptr<const DetectionImageFrame> frame) override;
+
+private:
+  class RecordingListener;
+
+  std::shared_ptr<Segmentation::Labelling> m_labelling;
+  std::vector<std::shared_ptr<DetectionImageFrame>> m_frames;
+  std::shared_ptr<DetectionImageFrame::ImageFilter> m_filter;
+  unsigned m_frames_ahead;
+
+  // Labelling started ahead, by frame index
+  std::map<size_t, std::future<std::unique_ptr<RecordingListener>>> m_jobs;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_SEGMENTATION_FRAMESAHEADLABELLING_H_ */
@@ -28,6 +28,7 @@
 #include "SEFramework/Frame/Frame.h"
 #include "SEFramework/Source/SourceFactory.h"
 #include "SEFramework/Pipeline/Segmentation.h"
+#include "SEUtils/PixelRectangle.h"
 
 namespace SourceXtractor {
 
@@ -44,9 +45,18 @@ public:
    */
   virtual ~LutzSegmentation() = default;
 
-  explicit LutzSegmentation(std::shared_ptr<SourceFactory> source_factory, int window_size = 0)
+  /**
+   * @param region
+   *    If not empty, only this region of the image is labelled
+   * @param streaming
+   *    Release the groups fully behind the window, and the tiles of all images behind it
+   */
+  explicit LutzSegmentation(std::shared_ptr<SourceFactory> source_factory, int window_size = 0,
+                            const PixelRectangle& region = PixelRectangle(), bool streaming = false)
       : m_source_factory(source_factory),
-        m_window_size(window_size) {
+        m_window_size(window_size),
+        m_region(region),
+        m_streaming(streaming) {
     assert(source_factory != nullptr);
   }
 
@@ -55,6 +65,8 @@ public:
 private:
   std::shared_ptr<SourceFactory> m_source_factory;
   int m_window_size;
+  PixelRectangle m_region;
+  bool m_streaming;
 };
 
 } /* namespace SourceXtractor */
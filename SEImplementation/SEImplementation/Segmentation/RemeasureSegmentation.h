@@ -0,0 +1,74 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * RemeasureSegmentation.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEIMPLEMENTATION_SEGMENTATION_REMEASURESEGMENTATION_H_
+#define _SEIMPLEMENTATION_SEGMENTATION_REMEASURESEGMENTATION_H_
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SEFramework/Pipeline/Segmentation.h"
+#include "SEFramework/Source/SourceFactory.h"
+#include "SEImplementation/Configuration/RemeasureConfig.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class RemeasureSegmentation
+ * @brief Rebuilds the sources of a previous run from its partition check image
+ *
+ * @details
+ *  The partition image of the detection frame is read by strips, and each source is published as soon as the strip
+ *  with its last row has been read. The sources keep the identifiers of the previous catalog, and the pixels
+ *  of sources missing from it (i.e. filtered out of the output) are ignored.
+ */
+class RemeasureSegmentation : public Segmentation::Labelling {
+public:
+
+  /**
+   * @param partition_image_paths
+   *    Partition image of each detection frame, indexed by the HDU index of the frame
+   */
+  RemeasureSegmentation(std::shared_ptr<SourceFactory> source_factory,
+                        std::vector<std::string> partition_image_paths,
+                        std::shared_ptr<const RemeasureConfig::SourceMap> sources)
+      : m_source_factory(source_factory), m_partition_image_paths(std::move(partition_image_paths)),
+        m_sources(sources) {
+    assert(source_factory != nullptr);
+    assert(sources != nullptr);
+  }
+
+  virtual ~RemeasureSegmentation() = default;
+
+  void labelImage(Segmentation::LabellingListener& listener, std::shared_ptr<const DetectionImageFrame> frame) override;
+
+private:
+  std::shared_ptr<SourceFactory> m_source_factory;
+  std::vector<std::string> m_partition_image_paths;
+  std::shared_ptr<const RemeasureConfig::SourceMap> m_sources;
+};
+
+} /* namespace SourceXtractor */
+
+#endif /* _SEIMPLEMENTATION_SEGMENTATION_REMEASURESEGMENTATION_H_ */
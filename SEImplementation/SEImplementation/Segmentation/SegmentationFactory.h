@@ -27,8 +27,10 @@
 #include "SEFramework/Task/TaskProvider.h"
 #include "SEFramework/Configuration/Configurable.h"
 #include "SEFramework/Pipeline/Segmentation.h"
+#include "SEUtils/PixelRectangle.h"
 
 #include "SEImplementation/Configuration/SegmentationConfig.h"
+#include "SEImplementation/Configuration/RemeasureConfig.h"
 #include "SEImplementation/Plugin/AssocMode/AssocModeConfig.h"
 
 
@@ -62,12 +64,28 @@ private:
   std::shared_ptr<TaskProvider> m_task_provider;
 
   int m_lutz_window_size;
+  bool m_streaming;
   int m_bfs_max_delta;
 
   std::string m_model_path;
   double m_ml_threshold;
 
   std::vector<std::vector<AssocModeConfig::CatalogEntry>> m_catalogs;
+  bool m_assoc_streaming;
+
+  // Sources of a previous run, read from its partition image instead of segmenting the detection image
+  std::vector<std::string> m_remeasure_partition_images;
+  std::shared_ptr<const RemeasureConfig::SourceMap> m_remeasured_sources;
+
+  // Region of the detection image labelled when running as a shard
+  PixelRectangle m_shard_region;
+
+  // Frames labelled ahead of the one being processed
+  int m_frames_ahead;
+  std::vector<std::shared_ptr<DetectionImageFrame>> m_detection_frames;
+
+  template <typename LabellingType, typename... Args>
+  void setLabelling(Segmentation& segmentation, Args... args) const;
 
 }; /* End of SegmentationFactory class */
 
@@ -26,18 +26,26 @@
 
 #include "SEImplementation/Background/SimpleBackgroundAnalyzer.h"
 #include "SEImplementation/Background/SE/SEBackgroundLevelAnalyzer.h"
+#include "SEImplementation/Checkpoint/CheckpointBackgroundAnalyzer.h"
+#include "SEImplementation/Configuration/CheckpointConfig.h"
 
 namespace SourceXtractor {
 
-std::shared_ptr<BackgroundAnalyzer> BackgroundAnalyzerFactory::createBackgroundAnalyzer() const {
-  return createBackgroundAnalyzer(m_weight_type);
+std::shared_ptr<BackgroundAnalyzer> BackgroundAnalyzerFactory::createBackgroundAnalyzer(
+    const std::string& checkpoint_name) const {
+  return createBackgroundAnalyzer(m_weight_type, checkpoint_name);
 }
 
 std::shared_ptr<BackgroundAnalyzer> BackgroundAnalyzerFactory::createBackgroundAnalyzer(
-    WeightImageConfig::WeightType weight_type) const {
+    WeightImageConfig::WeightType weight_type, const std::string& checkpoint_name) const {
   // make a SE2 background if cell size and smoothing box are given
   if (m_cell_size.size() > 0 && m_smoothing_box.size() > 0) {
-      return std::make_shared<SEBackgroundLevelAnalyzer>(m_cell_size, m_smoothing_box, weight_type);
+    auto analyzer = std::make_shared<SEBackgroundLevelAnalyzer>(m_cell_size, m_smoothing_box, weight_type);
+    // Only the mesh based model is worth storing, the simple one is cheaper to recompute than to read
+    if (m_checkpoint && !checkpoint_name.empty()) {
+      return std::make_shared<CheckpointBackgroundAnalyzer>(analyzer, m_checkpoint, checkpoint_name);
+    }
+    return analyzer;
   } else {
     // make a simple background
     return std::make_shared<SimpleBackgroundAnalyzer>();
@@ -48,6 +56,7 @@ BackgroundAnalyzerFactory::BackgroundAnalyzerFactory(long manager_id)
     : Configuration(manager_id), m_weight_type(WeightImageConfig::WeightType::WEIGHT_TYPE_NONE) {
   declareDependency<SE2BackgroundConfig>();
   declareDependency<WeightImageConfig>();
+  declareDependency<CheckpointConfig>();
 }
 
 void BackgroundAnalyzerFactory::initialize(const UserValues&) {
@@ -56,6 +65,7 @@ void BackgroundAnalyzerFactory::initialize(const UserValues&) {
   m_cell_size = se2background_config.getCellSize();
   m_smoothing_box = se2background_config.getSmoothingBox();
   m_weight_type = weight_image_config.getWeightType();
+  m_checkpoint = getDependency<CheckpointConfig>().getCheckpoint();
 }
 
 }
@@ -22,34 +22,20 @@
  */
 
 #include "SEFramework/Image/ProcessedImage.h"
+#include "SEFramework/CoordinateSystem/OffsetCoordinateSystem.h"
 #include "SEFramework/FITS/FitsWriter.h"
+#include "SEFramework/Image/SubImage.h"
 #include "SEImplementation/Configuration/DetectionImageConfig.h"
 #include "SEImplementation/Configuration/MeasurementImageConfig.h"
 #include "SEImplementation/Configuration/MeasurementFrameConfig.h"
 #include "SEImplementation/Configuration/CheckImagesConfig.h"
+#include "SEImplementation/Configuration/ShardConfig.h"
+#include "SEImplementation/Image/RegionWriteableImage.h"
 
 #include "SEImplementation/CheckImages/CheckImages.h"
 
 namespace SourceXtractor {
 
-namespace {
-
-std::string addNumberToFilename(boost::filesystem::path original_filename, size_t number, bool add_number) {
-  if (add_number) {
-    auto filename = original_filename.stem();
-    filename += "_" + std::to_string(number);
-    filename += original_filename.extension();
-
-    filename = original_filename.parent_path() / filename;
-
-    return filename.native();
-  } else {
-    return original_filename.native();
-  }
-}
-
-}
-
 std::unique_ptr<CheckImages> CheckImages::m_instance;
 
 CheckImages::CheckImages() {
@@ -60,6 +46,41 @@ void CheckImages::reportConfigDependencies(Euclid::Configuration::ConfigManager
   manager.registerConfiguration<DetectionImageConfig>();
   manager.registerConfiguration<MeasurementImageConfig>();
   manager.registerConfiguration<MeasurementFrameConfig>();
+  manager.registerConfiguration<ShardConfig>();
+}
+
+template <typename T>
+std::shared_ptr<WriteableImage<T>> CheckImages::newDetectionCheckImage(const boost::filesystem::path& filename,
+                                                                       size_t index, bool add_number) const {
+  auto& detection_image = m_detection_images.at(index);
+  auto& region = m_detection_regions.at(index);
+  auto numbered_filename = CheckImagesConfig::addNumberToFilename(filename, index, add_number);
+
+  if (region.getWidth() == detection_image->getWidth() && region.getHeight() == detection_image->getHeight()) {
+    return FitsWriter::newImage<T>(numbered_filename, detection_image->getWidth(), detection_image->getHeight(),
+                                   m_coordinate_systems.at(index));
+  }
+
+  auto region_image = FitsWriter::newImage<T>(numbered_filename, region.getWidth(), region.getHeight(),
+      std::make_shared<OffsetCoordinateSystem>(m_coordinate_systems.at(index), region.getTopLeft()));
+  return RegionWriteableImage<T>::create(region_image, region.getTopLeft(),
+                                         detection_image->getWidth(), detection_image->getHeight());
+}
+
+template <typename T>
+void CheckImages::writeDetectionCheckImage(std::shared_ptr<Image<T>> image, const boost::filesystem::path& filename,
+                                           size_t index) const {
+  auto& region = m_detection_regions.at(index);
+  auto numbered_filename = CheckImagesConfig::addNumberToFilename(filename, index, m_coordinate_systems.size() > 1);
+
+  if (region.getWidth() == image->getWidth() && region.getHeight() == image->getHeight()) {
+    FitsWriter::writeFile(*image, numbered_filename, m_coordinate_systems.at(index));
+    return;
+  }
+
+  auto region_image = SubImage<T>::create(image, region.getTopLeft(), region.getWidth(), region.getHeight());
+  FitsWriter::writeFile(*region_image, numbered_filename,
+      std::make_shared<OffsetCoordinateSystem>(m_coordinate_systems.at(index), region.getTopLeft()));
 }
 
 std::shared_ptr<WriteableImage<SeFloat>> CheckImages::getWriteableCheckImage(std::string id, int width, int height) {
@@ -104,6 +125,7 @@ void CheckImages::configure(Euclid::Configuration::ConfigManager& manager) {
   m_measurement_variance_filename = config.getMeasurementVarianceFilename();
 
   size_t detection_images_nb = manager.getConfiguration<DetectionImageConfig>().getExtensionsNb();
+  auto& shard_config = manager.getConfiguration<ShardConfig>();
 
   m_check_image_ml_detection.resize(detection_images_nb);
 
@@ -113,41 +135,35 @@ void CheckImages::configure(Euclid::Configuration::ConfigManager& manager) {
 
     m_detection_images.emplace_back(detection_image);
     m_coordinate_systems.emplace_back(coordinate_system);
+    m_detection_regions.emplace_back(
+        shard_config.getProcessedRegion(detection_image->getWidth(), detection_image->getHeight()));
 
     if (m_segmentation_filename != "") {
-      m_segmentation_images.emplace_back(FitsWriter::newImage<int>(
-          addNumberToFilename(m_segmentation_filename, i, detection_images_nb>1),
-          detection_image->getWidth(), detection_image->getHeight(), coordinate_system));
+      m_segmentation_images.emplace_back(newDetectionCheckImage<int>(m_segmentation_filename, i, detection_images_nb>1));
     }
 
     if (m_partition_filename != "") {
-      m_partition_images.emplace_back(FitsWriter::newImage<int>(
-          addNumberToFilename(m_partition_filename, i, detection_images_nb>1),
-          detection_image->getWidth(), detection_image->getHeight(), coordinate_system));
+      m_partition_images.emplace_back(newDetectionCheckImage<int>(m_partition_filename, i, detection_images_nb>1));
     }
 
     if (m_group_filename != "") {
-      m_group_images.emplace_back(FitsWriter::newImage<int>(
-          addNumberToFilename(m_group_filename, i, detection_images_nb>1),
-          detection_image->getWidth(), detection_image->getHeight(), coordinate_system));
+      m_group_images.emplace_back(newDetectionCheckImage<int>(m_group_filename, i, detection_images_nb>1));
     }
 
     if (m_auto_aperture_filename != "") {
-      m_auto_aperture_images.emplace_back(FitsWriter::newImage<int>(
-          addNumberToFilename(m_auto_aperture_filename, i, detection_images_nb>1),
-          detection_image->getWidth(), detection_image->getHeight(), coordinate_system));
+      m_auto_aperture_images.emplace_back(newDetectionCheckImage<int>(m_auto_aperture_filename, i, detection_images_nb>1));
+      m_auto_aperture_changes.emplace_back(
+        std::make_shared<IntChanges>(m_auto_aperture_images.back(), DeferredWriteableImage<int>::MergeMode::REPLACE));
     }
 
     if (m_aperture_filename != "") {
-      m_aperture_images.emplace_back(FitsWriter::newImage<int>(
-          addNumberToFilename(m_aperture_filename, i, detection_images_nb>1),
-          detection_image->getWidth(), detection_image->getHeight(), coordinate_system));
+      m_aperture_images.emplace_back(newDetectionCheckImage<int>(m_aperture_filename, i, detection_images_nb>1));
+      m_aperture_changes.emplace_back(
+        std::make_shared<IntChanges>(m_aperture_images.back(), DeferredWriteableImage<int>::MergeMode::REPLACE));
     }
 
     if (m_moffat_filename != "") {
-      m_moffat_images.emplace_back(FitsWriter::newImage<SeFloat>(
-          addNumberToFilename(m_moffat_filename, i, detection_images_nb>1),
-          detection_image->getWidth(), detection_image->getHeight(), coordinate_system));
+      m_moffat_images.emplace_back(newDetectionCheckImage<SeFloat>(m_moffat_filename, i, detection_images_nb>1));
     }
   }
 
@@ -166,12 +182,13 @@ void CheckImages::configure(Euclid::Configuration::ConfigManager& manager) {
       info.m_measurement_image->getWidth(),
       info.m_measurement_image->getHeight(),
       info.m_coordinate_system,
-      frames.at(info.m_id)->getImage(LayerSubtractedImage)
+      frames.at(info.m_id)
     };
   }
 }
 
-std::shared_ptr<WriteableImage<int>> CheckImages::getMeasurementAutoApertureImage(unsigned int frame_number) {
+std::shared_ptr<WriteableImage<int>> CheckImages::getMeasurementAutoApertureImage(unsigned int frame_number,
+                                                                          unsigned int source_id) {
   if (m_auto_aperture_filename.empty()) {
     return nullptr;
   }
@@ -195,10 +212,15 @@ std::shared_ptr<WriteableImage<int>> CheckImages::getMeasurementAutoApertureImag
           frame_info.m_coordinate_system
         ))).first;
   }
-  return LockedWriteableImage<int>::create(i->second);
+  auto& changes = m_measurement_auto_aperture_changes[frame_number];
+  if (!changes) {
+    changes = std::make_shared<IntChanges>(i->second, DeferredWriteableImage<int>::MergeMode::REPLACE);
+  }
+  return DeferredWriteableImage<int>::create(changes, source_id);
 }
 
-std::shared_ptr<WriteableImage<int>> CheckImages::getMeasurementApertureImage(unsigned int frame_number) {
+std::shared_ptr<WriteableImage<int>> CheckImages::getMeasurementApertureImage(unsigned int frame_number,
+                                                                      unsigned int source_id) {
   if (m_aperture_filename.empty()) {
     return nullptr;
   }
@@ -222,11 +244,15 @@ std::shared_ptr<WriteableImage<int>> CheckImages::getMeasurementApertureImage(un
           frame_info.m_coordinate_system
         ))).first;
   }
-  return LockedWriteableImage<int>::create(i->second);
+  auto& changes = m_measurement_aperture_changes[frame_number];
+  if (!changes) {
+    changes = std::make_shared<IntChanges>(i->second, DeferredWriteableImage<int>::MergeMode::REPLACE);
+  }
+  return DeferredWriteableImage<int>::create(changes, source_id);
 }
 
 std::shared_ptr<WriteableImage<MeasurementImage::PixelType>>
-CheckImages::getModelFittingImage(unsigned int frame_number) {
+CheckImages::getModelFittingImage(unsigned int frame_number, unsigned int source_id) {
   if (m_model_fitting_image_filename.empty() && m_residual_filename.empty()) {
     return nullptr;
   }
@@ -257,10 +283,16 @@ CheckImages::getModelFittingImage(unsigned int frame_number) {
     }
     i = m_check_image_model_fitting.emplace(std::make_pair(frame_number, writeable_image)).first;
   }
-  return LockedWriteableImage<MeasurementImage::PixelType>::create(i->second);
+  auto& changes = m_model_fitting_changes[frame_number];
+  if (!changes) {
+    changes = std::make_shared<PixelChanges>(
+        i->second, DeferredWriteableImage<MeasurementImage::PixelType>::MergeMode::ADD);
+  }
+  return DeferredWriteableImage<MeasurementImage::PixelType>::create(changes, source_id);
 }
 
-std::shared_ptr<WriteableImage<MeasurementImage::PixelType>> CheckImages::getPsfImage(unsigned int frame_number) {
+std::shared_ptr<WriteableImage<MeasurementImage::PixelType>> CheckImages::getPsfImage(unsigned int frame_number,
+                                                                                      unsigned int source_id) {
   if (m_psf_filename.empty()) {
     return nullptr;
   }
@@ -284,7 +316,12 @@ std::shared_ptr<WriteableImage<MeasurementImage::PixelType>> CheckImages::getPsf
           frame_info.m_coordinate_system
         ))).first;
   }
-  return LockedWriteableImage<MeasurementImage::PixelType>::create(i->second);
+  auto& changes = m_psf_changes[frame_number];
+  if (!changes) {
+    changes = std::make_shared<PixelChanges>(
+        i->second, DeferredWriteableImage<MeasurementImage::PixelType>::MergeMode::ADD);
+  }
+  return DeferredWriteableImage<MeasurementImage::PixelType>::create(changes, source_id);
 }
 
 std::shared_ptr<WriteableImage<MeasurementImage::PixelType>>
@@ -315,39 +352,59 @@ std::shared_ptr<WriteableImage<MeasurementImage::PixelType>>
   return LockedWriteableImage<MeasurementImage::PixelType>::create(i->second);
 }
 
+void CheckImages::mergeDeferredChanges() {
+  std::lock_guard<std::mutex> lock(m_access_mutex);
+
+  for (auto& changes : m_auto_aperture_changes) {
+    changes->merge();
+  }
+  for (auto& changes : m_aperture_changes) {
+    changes->merge();
+  }
+  for (auto& changes : m_measurement_auto_aperture_changes) {
+    changes.second->merge();
+  }
+  for (auto& changes : m_measurement_aperture_changes) {
+    changes.second->merge();
+  }
+  for (auto& changes : m_model_fitting_changes) {
+    changes.second->merge();
+  }
+  for (auto& changes : m_psf_changes) {
+    changes.second->merge();
+  }
+}
+
 void CheckImages::saveImages() {
+  mergeDeferredChanges();
+
   std::lock_guard<std::mutex> lock(m_access_mutex);
 
   auto detection_images_nb = m_coordinate_systems.size();
   for (size_t i = 0; i < detection_images_nb; i++) {
     // if possible, save the background image
     if (i < m_background_images.size() && m_background_images.at(i) != nullptr && m_background_filename != "") {
-      FitsWriter::writeFile(*m_background_images.at(i),
-          addNumberToFilename(m_background_filename, i, detection_images_nb>1), m_coordinate_systems.at(i));
+      writeDetectionCheckImage(m_background_images.at(i), m_background_filename, i);
     }
 
     // if possible, save the variance image
     if (i < m_variance_images.size() && m_variance_images.at(i) != nullptr && m_variance_filename != "") {
-      FitsWriter::writeFile(*m_variance_images.at(i),
-          addNumberToFilename(m_variance_filename, i, detection_images_nb>1), m_coordinate_systems.at(i));
+      writeDetectionCheckImage(m_variance_images.at(i), m_variance_filename, i);
     }
 
     // if possible, save the filtered image
     if (i < m_filtered_images.size() && m_filtered_images.at(i) != nullptr && m_filtered_filename != "") {
-      FitsWriter::writeFile(*m_filtered_images.at(i),
-          addNumberToFilename(m_filtered_filename, i, detection_images_nb>1), m_coordinate_systems.at(i));
+      writeDetectionCheckImage(m_filtered_images.at(i), m_filtered_filename, i);
     }
 
     // if possible, save the thresholded image
     if (i < m_thresholded_images.size() && m_thresholded_images.at(i) != nullptr && m_thresholded_filename != "") {
-      FitsWriter::writeFile(*m_thresholded_images.at(i),
-          addNumberToFilename(m_thresholded_filename, i, detection_images_nb>1), m_coordinate_systems.at(i));
+      writeDetectionCheckImage(m_thresholded_images.at(i), m_thresholded_filename, i);
     }
 
     // if possible, save the SNR image
     if (i < m_snr_images.size() && m_snr_images.at(i) != nullptr && m_snr_filename != "") {
-      FitsWriter::writeFile(*m_snr_images.at(i),
-          addNumberToFilename(m_snr_filename, i, detection_images_nb>1), m_coordinate_systems.at(i));
+      writeDetectionCheckImage(m_snr_images.at(i), m_snr_filename, i);
     }
   }
 
@@ -384,7 +441,8 @@ void CheckImages::saveImages() {
     for (auto &ci : m_check_image_model_fitting) {
       auto& frame_info = m_measurement_frames.at(ci.first);
 
-      auto residual_image = SubtractImage<SeFloat>::create(frame_info.m_subtracted_image, ci.second);
+      auto subtracted_image = frame_info.m_frame->getFrame()->getImage(LayerSubtractedImage);
+      auto residual_image = SubtractImage<SeFloat>::create(subtracted_image, ci.second);
       auto filename = m_residual_filename.stem();
       filename += "_" + frame_info.m_label;
       filename += m_residual_filename.extension();
@@ -0,0 +1,272 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * Checkpoint.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "Table/FitsReader.h"
+
+#include "SEImplementation/Output/FitsTableWriter.h"
+#include "SEImplementation/Property/PixelCoordinateList.h"
+
+#include "SEImplementation/Checkpoint/Checkpoint.h"
+
+namespace fs = boost::filesystem;
+using Euclid::Table::Row;
+using Euclid::Table::ColumnInfo;
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("Checkpoint");
+
+static const std::string JOURNAL_FILE {"groups.dat"};
+static const std::string ROWS_PREFIX {"rows_"};
+static const std::string KEY_COLUMN {"checkpoint_key"};
+static const std::string PIXELS_COLUMN {"checkpoint_pixels"};
+
+// Rows read at once from the stored catalogs
+static const std::size_t CHUNK_SIZE = 100000;
+
+Checkpoint::Checkpoint(const std::string& directory) : m_directory(directory), m_run(0) {
+  fs::create_directories(m_directory);
+  loadJournal();
+  loadRows();
+  if (!m_completed.empty()) {
+    logger.info() << "Resuming from " << m_directory << ": " << m_completed.size() << " groups already measured";
+  }
+}
+
+Checkpoint::~Checkpoint() {
+  try {
+    if (m_rows_writer) {
+      m_rows_writer->close();
+    }
+  } catch (const std::exception& e) {
+    logger.error() << "Failed to close the checkpoint catalog: " << e.what();
+  }
+}
+
+std::string Checkpoint::getPath(const std::string& filename) const {
+  return (fs::path(m_directory) / filename).string();
+}
+
+// Mixing function of splitmix64
+static std::uint64_t mixPixel(std::uint64_t value) {
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+Checkpoint::GroupKey Checkpoint::getGroupKey(unsigned int frame, const SourceGroupInterface& group) {
+  // The pixels are hashed separately and summed, as the order of the sources and pixels is not preserved
+  bool empty = true;
+  PixelCoordinate first;
+  std::uint64_t pixels_hash = 0, nb_pixels = 0;
+  for (auto& source : group) {
+    for (auto& pixel : source.getProperty<PixelCoordinateList>().getCoordinateList()) {
+      if (empty || pixel.m_y < first.m_y || (pixel.m_y == first.m_y && pixel.m_x < first.m_x)) {
+        first = pixel;
+        empty = false;
+      }
+      pixels_hash += mixPixel((static_cast<std::uint64_t>(pixel.m_y) << 32) | static_cast<std::uint32_t>(pixel.m_x));
+      ++nb_pixels;
+    }
+  }
+  pixels_hash = mixPixel(pixels_hash ^ nb_pixels);
+
+  if (frame >= (1u << 16) || first.m_x < 0 || first.m_y < 0 || first.m_x >= (1 << 24) || first.m_y >= (1 << 24)) {
+    throw Elements::Exception() << "The group at " << first.m_x << "," << first.m_y << " of frame " << frame
+                                << " can not be stored in the checkpoint";
+  }
+  std::uint64_t position = (static_cast<std::uint64_t>(frame) << 48) | (static_cast<std::uint64_t>(first.m_y) << 24) |
+                           static_cast<std::uint64_t>(first.m_x);
+
+  return {static_cast<std::int64_t>(position), static_cast<std::int64_t>(pixels_hash)};
+}
+
+std::int64_t Checkpoint::getMaxStoredValue(const std::string& column) const {
+  std::int64_t max_value = 0;
+  for (auto& frame_rows : m_stored_rows) {
+    for (auto& row : frame_rows.second) {
+      auto index = row.getColumnInfo()->find(column);
+      if (!index) {
+        break;
+      }
+      if (auto value = boost::get<std::int64_t>(&row[*index])) {
+        max_value = std::max(max_value, *value);
+      }
+      else if (auto value = boost::get<std::int32_t>(&row[*index])) {
+        max_value = std::max<std::int64_t>(max_value, *value);
+      }
+    }
+  }
+  return max_value;
+}
+
+std::vector<Row> Checkpoint::takeStoredRows(unsigned int frame) {
+  std::vector<Row> rows;
+  auto i = m_stored_rows.find(frame);
+  if (i != m_stored_rows.end()) {
+    rows = std::move(i->second);
+    m_stored_rows.erase(i);
+  }
+  return rows;
+}
+
+void Checkpoint::commit(const std::vector<Row>& rows, const std::vector<GroupKey>& row_keys,
+                        const std::vector<GroupKey>& group_keys) {
+  if (!rows.empty()) {
+    auto column_info = rows.front().getColumnInfo();
+    if (column_info != m_source_column_info) {
+      std::vector<Euclid::Table::ColumnDescription> descriptions;
+      for (std::size_t i = 0; i < column_info->size(); ++i) {
+        descriptions.emplace_back(column_info->getDescription(i));
+      }
+      descriptions.emplace_back(KEY_COLUMN, typeid(std::int64_t));
+      descriptions.emplace_back(PIXELS_COLUMN, typeid(std::int64_t));
+      m_stored_column_info = std::make_shared<ColumnInfo>(std::move(descriptions));
+      m_source_column_info = column_info;
+    }
+
+    std::vector<Row> stored_rows;
+    stored_rows.reserve(rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      std::vector<Row::cell_type> cells;
+      cells.reserve(rows[i].size() + 2);
+      for (std::size_t j = 0; j < rows[i].size(); ++j) {
+        cells.emplace_back(rows[i][j]);
+      }
+      cells.emplace_back(row_keys[i].m_position);
+      cells.emplace_back(row_keys[i].m_pixels);
+      stored_rows.emplace_back(std::move(cells), m_stored_column_info);
+    }
+
+    if (!m_rows_writer) {
+      std::stringstream filename;
+      filename << ROWS_PREFIX << std::setw(4) << std::setfill('0') << m_run << ".fits";
+      m_rows_writer.reset(new FitsTableWriter(getPath(filename.str()), true));
+      m_rows_writer->setHduName("CHECKPOINT");
+    }
+    // The block is flushed to disk before returning
+    m_rows_writer->addRows(stored_rows);
+  }
+
+  // Only now the groups are complete
+  std::ofstream journal(getPath(JOURNAL_FILE), std::ios::binary | std::ios::app);
+  for (auto& key : group_keys) {
+    journal.write(reinterpret_cast<const char*>(&key.m_position), sizeof(key.m_position));
+    journal.write(reinterpret_cast<const char*>(&key.m_pixels), sizeof(key.m_pixels));
+    m_completed.insert(key);
+  }
+  journal.flush();
+  if (!journal) {
+    throw Elements::Exception() << "Failed to write the checkpoint journal in " << m_directory;
+  }
+}
+
+void Checkpoint::loadJournal() {
+  auto path = getPath(JOURNAL_FILE);
+  if (!fs::exists(path)) {
+    return;
+  }
+
+  std::ifstream journal(path, std::ios::binary);
+  GroupKey key;
+  std::uintmax_t valid_size = 0;
+  while (journal.read(reinterpret_cast<char*>(&key.m_position), sizeof(key.m_position)) &&
+         journal.read(reinterpret_cast<char*>(&key.m_pixels), sizeof(key.m_pixels))) {
+    m_completed.insert(key);
+    valid_size += sizeof(key.m_position) + sizeof(key.m_pixels);
+  }
+  journal.close();
+
+  // Drop a key partially written when the previous run was interrupted
+  if (fs::file_size(path) != valid_size) {
+    fs::resize_file(path, valid_size);
+  }
+}
+
+void Checkpoint::loadRows() {
+  std::vector<fs::path> files;
+  for (auto& entry : fs::directory_iterator(m_directory)) {
+    auto filename = entry.path().filename().string();
+    if (boost::starts_with(filename, ROWS_PREFIX) && boost::ends_with(filename, ".fits")) {
+      files.emplace_back(entry.path());
+    }
+  }
+  // Zero-padded, so this is the order of the runs
+  std::sort(files.begin(), files.end());
+  m_run = files.size();
+
+  std::size_t nb_rows = 0;
+  for (auto& file : files) {
+    try {
+      Euclid::Table::FitsReader reader(file.string());
+      std::shared_ptr<ColumnInfo> column_info;
+      while (reader.hasMoreRows()) {
+        auto table = reader.read(CHUNK_SIZE);
+        for (auto& row : table) {
+          // The key is in the last two columns, and it is not part of the catalog
+          std::size_t key_index = row.size() - 2;
+          if (!column_info) {
+            std::vector<Euclid::Table::ColumnDescription> descriptions;
+            for (std::size_t i = 0; i < key_index; ++i) {
+              descriptions.emplace_back(row.getColumnInfo()->getDescription(i));
+            }
+            column_info = std::make_shared<ColumnInfo>(std::move(descriptions));
+          }
+
+          GroupKey key {boost::get<std::int64_t>(row[key_index]), boost::get<std::int64_t>(row[key_index + 1])};
+          if (!isCompleted(key)) {
+            continue;
+          }
+          std::vector<Row::cell_type> cells;
+          cells.reserve(key_index);
+          for (std::size_t i = 0; i < key_index; ++i) {
+            cells.emplace_back(row[i]);
+          }
+          m_stored_rows[getKeyFrame(key)].emplace_back(std::move(cells), column_info);
+          ++nb_rows;
+        }
+      }
+    }
+    catch (const std::exception& e) {
+      // Keys are only written once the rows are on disk, so a file that can not be read
+      // has been interrupted while writing its first block
+      logger.warn() << "Ignoring the checkpoint catalog " << file.string() << ": " << e.what();
+    }
+  }
+
+  if (nb_rows > 0) {
+    logger.info() << "Loaded " << nb_rows << " rows from the checkpoint";
+  }
+}
+
+} /* namespace SourceXtractor */
@@ -0,0 +1,125 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointBackgroundAnalyzer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <fitsio.h>
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+
+#include "SEFramework/FITS/FitsReader.h"
+
+#include "SEImplementation/Checkpoint/CheckpointBackgroundAnalyzer.h"
+
+namespace fs = boost::filesystem;
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("Checkpoint");
+
+// Rows of pixels written at once
+static const int STRIP_HEIGHT = 256;
+
+static void writeImage(const Image<SeFloat>& image, const std::string& path) {
+  auto tmp_path = path + ".tmp";
+  int status = 0;
+  fitsfile *fptr = nullptr;
+  long naxes[2] = {image.getWidth(), image.getHeight()};
+
+  fits_create_file(&fptr, ("!" + tmp_path).c_str(), &status);
+  fits_create_img(fptr, FLOAT_IMG, 2, naxes, &status);
+
+  std::vector<float> buffer;
+  for (int y = 0; y < image.getHeight() && status == 0; y += STRIP_HEIGHT) {
+    int height = std::min(STRIP_HEIGHT, image.getHeight() - y);
+    auto chunk = image.getChunk(0, y, image.getWidth(), height);
+    buffer.resize(image.getWidth() * height);
+    for (int iy = 0; iy < height; ++iy) {
+      for (int ix = 0; ix < image.getWidth(); ++ix) {
+        buffer[ix + iy * image.getWidth()] = chunk->getValue(ix, iy);
+      }
+    }
+    fits_write_img(fptr, TFLOAT, static_cast<LONGLONG>(y) * image.getWidth() + 1, buffer.size(), buffer.data(), &status);
+  }
+
+  int write_status = status;
+  status = 0;
+  if (fptr) {
+    fits_close_file(fptr, &status);
+  }
+  if (write_status != 0 || status != 0) {
+    char err_txt[31];
+    fits_get_errstatus(write_status ? write_status : status, err_txt);
+    throw Elements::Exception() << "Failed to write " << path << " status: "
+                                << (write_status ? write_status : status) << " = " << err_txt;
+  }
+  fs::rename(tmp_path, path);
+}
+
+CheckpointBackgroundAnalyzer::CheckpointBackgroundAnalyzer(std::shared_ptr<BackgroundAnalyzer> analyzer,
+                                                           std::shared_ptr<Checkpoint> checkpoint,
+                                                           const std::string& name)
+  : m_analyzer(std::move(analyzer)), m_checkpoint(std::move(checkpoint)), m_name(name) {}
+
+BackgroundModel CheckpointBackgroundAnalyzer::analyzeBackground(
+    std::shared_ptr<DetectionImage> image, std::shared_ptr<WeightImage> variance_map,
+    std::shared_ptr<Image<unsigned char>> mask, WeightImage::PixelType variance_threshold) const {
+  auto level_path = m_checkpoint->getPath(m_name + "_background.fits");
+  auto variance_path = m_checkpoint->getPath(m_name + "_variance.fits");
+  auto values_path = m_checkpoint->getPath(m_name + "_background.txt");
+
+  if (fs::exists(values_path)) {
+    std::ifstream values(values_path);
+    SeFloat scaling_factor, median_rms;
+    if (values >> scaling_factor >> median_rms) {
+      logger.info() << "Using the background of " << m_name << " from the checkpoint";
+      return BackgroundModel(FitsReader<SeFloat>::readFile(level_path), FitsReader<SeFloat>::readFile(variance_path),
+                             scaling_factor, median_rms);
+    }
+    logger.warn() << "Can not parse " << values_path << ", the background will be recomputed";
+  }
+
+  auto model = m_analyzer->analyzeBackground(image, variance_map, mask, variance_threshold);
+
+  writeImage(*model.getLevelMap(), level_path);
+  writeImage(*model.getVarianceMap(), variance_path);
+
+  auto tmp_values_path = values_path + ".tmp";
+  {
+    std::ofstream values(tmp_values_path);
+    values.precision(9);
+    values << model.getScalingFactor() << " " << model.getMedianRms() << std::endl;
+    if (!values) {
+      throw Elements::Exception() << "Failed to write " << values_path;
+    }
+  }
+  fs::rename(tmp_values_path, values_path);
+
+  return model;
+}
+
+} /* namespace SourceXtractor */
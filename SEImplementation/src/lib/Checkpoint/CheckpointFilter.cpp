@@ -0,0 +1,65 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointFilter.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+
+#include "SEImplementation/Checkpoint/CheckpointGroupKey.h"
+#include "SEImplementation/Property/SourceId.h"
+
+#include "SEImplementation/Checkpoint/CheckpointFilter.h"
+
+namespace SourceXtractor {
+
+CheckpointFilter::CheckpointFilter(std::shared_ptr<Checkpoint> checkpoint)
+  : m_checkpoint(std::move(checkpoint)), m_skipped(0) {}
+
+void CheckpointFilter::receiveSource(std::unique_ptr<SourceGroupInterface> group) {
+  // All the sources of a group come from the same frame
+  auto detection_id = group->cbegin()->getProperty<SourceId>().getDetectionId();
+  unsigned int frame;
+  {
+    std::lock_guard<std::mutex> lock(m_boundaries_mutex);
+    frame = std::upper_bound(m_boundaries.begin(), m_boundaries.end(), detection_id) - m_boundaries.begin();
+  }
+
+  auto key = Checkpoint::getGroupKey(frame, *group);
+  if (m_checkpoint->isCompleted(key)) {
+    ++m_skipped;
+    return;
+  }
+
+  for (auto& source : *group) {
+    source.setProperty<CheckpointGroupKey>(key);
+  }
+  sendSource(std::move(group));
+}
+
+void CheckpointFilter::receiveProcessSignal(const ProcessSourcesEvent& event) {
+  sendProcessSignal(event);
+}
+
+void CheckpointFilter::endFrame() {
+  std::lock_guard<std::mutex> lock(m_boundaries_mutex);
+  m_boundaries.emplace_back(SourceId::getNextId());
+}
+
+} /* namespace SourceXtractor */
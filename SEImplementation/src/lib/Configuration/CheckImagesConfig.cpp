@@ -93,6 +93,21 @@ std::map<std::string, Configuration::OptionDescriptionList> CheckImagesConfig::g
   }}};
 }
 
+std::string CheckImagesConfig::addNumberToFilename(boost::filesystem::path original_filename, size_t number,
+                                                   bool add_number) {
+  if (add_number) {
+    auto filename = original_filename.stem();
+    filename += "_" + std::to_string(number);
+    filename += original_filename.extension();
+
+    filename = original_filename.parent_path() / filename;
+
+    return filename.native();
+  } else {
+    return original_filename.native();
+  }
+}
+
 void CheckImagesConfig::initialize(const UserValues& args) {
   m_model_fitting_filename = args.find(CHECK_MODEL_FITTING)->second.as<std::string>();
   m_model_fitting_residual_filename = args.find(CHECK_RESIDUAL)->second.as<std::string>();
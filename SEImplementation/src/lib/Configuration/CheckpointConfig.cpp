@@ -0,0 +1,152 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointConfig.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+
+#include "ElementsKernel/Exception.h"
+
+#include "SEImplementation/Checkpoint/Checkpoint.h"
+
+#include "SEImplementation/Configuration/CheckpointConfig.h"
+
+using namespace Euclid::Configuration;
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace SourceXtractor {
+
+static const std::string CHECKPOINT_DIR {"checkpoint-dir"};
+static const std::string CHECKPOINT_INTERVAL {"checkpoint-interval"};
+
+static const std::string OPTIONS_FILE {"options.txt"};
+
+// Options that can change between the runs sharing a checkpoint, as they do not affect the results
+static const std::vector<std::string> IGNORED_OPTIONS_PREFIXES {
+  "checkpoint-", "config-file", "log-", "progress-", "thread-count", "frame-pipelining", "tile-",
+  "output-catalog-filename", "output-flush-size", "property-report"
+};
+
+static std::string formatValue(const po::variable_value& value) {
+  std::stringstream str;
+  const auto& any = value.value();
+  if (auto v = boost::any_cast<std::string>(&any)) {
+    str << *v;
+  }
+  else if (auto v = boost::any_cast<int>(&any)) {
+    str << *v;
+  }
+  else if (auto v = boost::any_cast<double>(&any)) {
+    str.precision(17);
+    str << *v;
+  }
+  else if (auto v = boost::any_cast<bool>(&any)) {
+    str << *v;
+  }
+  else if (auto v = boost::any_cast<fs::path>(&any)) {
+    str << v->string();
+  }
+  else if (auto v = boost::any_cast<std::vector<std::string>>(&any)) {
+    for (auto& e : *v) {
+      str << e << ";";
+    }
+  }
+  else if (auto v = boost::any_cast<std::vector<int>>(&any)) {
+    for (auto& e : *v) {
+      str << e << ";";
+    }
+  }
+  else if (auto v = boost::any_cast<std::vector<double>>(&any)) {
+    str.precision(17);
+    for (auto& e : *v) {
+      str << e << ";";
+    }
+  }
+  else {
+    str << "?";
+  }
+  return str.str();
+}
+
+CheckpointConfig::CheckpointConfig(long manager_id) : Configuration(manager_id), m_interval(300) {}
+
+auto CheckpointConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Checkpoint",
+      {
+        {CHECKPOINT_DIR.c_str(), po::value<std::string>()->default_value(""),
+         "Directory where the state of the run is saved, and resumed from if it already exists"},
+        {CHECKPOINT_INTERVAL.c_str(), po::value<int>()->default_value(300),
+         "Minimum time, in seconds, between two saves of the measured groups"}
+      }
+  }};
+}
+
+void CheckpointConfig::initialize(const UserValues& args) {
+  auto directory = args.at(CHECKPOINT_DIR).as<std::string>();
+  m_interval = args.at(CHECKPOINT_INTERVAL).as<int>();
+  if (directory.empty()) {
+    return;
+  }
+  if (m_interval < 0) {
+    throw Elements::Exception() << "The checkpoint interval can not be negative";
+  }
+
+  fs::create_directories(directory);
+  checkOptions(args);
+  m_checkpoint = std::make_shared<Checkpoint>(directory);
+}
+
+void CheckpointConfig::checkOptions(const UserValues& args) const {
+  std::stringstream options;
+  for (auto& option : args) {
+    bool ignored = false;
+    for (auto& prefix : IGNORED_OPTIONS_PREFIXES) {
+      ignored |= boost::starts_with(option.first, prefix);
+    }
+    if (!ignored && !option.second.empty()) {
+      options << option.first << "=" << formatValue(option.second) << "\n";
+    }
+  }
+
+  auto options_path = (fs::path(args.at(CHECKPOINT_DIR).as<std::string>()) / OPTIONS_FILE).string();
+  if (fs::exists(options_path)) {
+    std::ifstream stored_file(options_path);
+    std::stringstream stored;
+    stored << stored_file.rdbuf();
+    if (stored.str() != options.str()) {
+      throw Elements::Exception() << "The checkpoint in " << args.at(CHECKPOINT_DIR).as<std::string>()
+                                  << " was created with different options, use another directory or remove it";
+    }
+  }
+  else {
+    std::ofstream stored_file(options_path);
+    stored_file << options.str();
+    if (!stored_file) {
+      throw Elements::Exception() << "Failed to write " << options_path;
+    }
+  }
+}
+
+} /* namespace SourceXtractor */
@@ -22,11 +22,14 @@
 #include "Configuration/ConfigManager.h"
 
 #include "SEFramework/Image/ConstantImage.h"
+#include "SEFramework/Image/PaddedImage.h"
 #include "SEFramework/Image/ProcessedImage.h"
+#include "SEFramework/Image/SubImage.h"
 
 #include "SEImplementation/Background/BackgroundAnalyzerFactory.h"
 #include "SEImplementation/Configuration/BackgroundConfig.h"
 #include "SEImplementation/Configuration/DetectionImageConfig.h"
+#include "SEImplementation/Configuration/ShardConfig.h"
 #include "SEImplementation/Configuration/WeightImageConfig.h"
 
 #include "SEImplementation/CheckImages/CheckImages.h"
@@ -38,11 +41,43 @@ namespace po = boost::program_options;
 
 namespace SourceXtractor {
 
+namespace {
+
+// Model the background of a region only, the maps are extended to the whole image by replicating their edges
+BackgroundModel analyzeRegionBackground(const BackgroundAnalyzer& background_analyzer,
+                                        std::shared_ptr<DetectionImage> image, std::shared_ptr<WeightImage> weight_image,
+                                        WeightImage::PixelType variance_threshold, const PixelRectangle& region) {
+  if (region.getWidth() == image->getWidth() && region.getHeight() == image->getHeight()) {
+    return background_analyzer.analyzeBackground(image, weight_image,
+        ConstantImage<unsigned char>::create(image->getWidth(), image->getHeight(), false), variance_threshold);
+  }
+
+  auto region_image = SubImage<DetectionImage::PixelType>::create(
+      image, region.getTopLeft(), region.getWidth(), region.getHeight());
+  std::shared_ptr<WeightImage> region_weight;
+  if (weight_image) {
+    region_weight = SubImage<WeightImage::PixelType>::create(
+        weight_image, region.getTopLeft(), region.getWidth(), region.getHeight());
+  }
+  auto model = background_analyzer.analyzeBackground(region_image, region_weight,
+      ConstantImage<unsigned char>::create(region.getWidth(), region.getHeight(), false), variance_threshold);
+
+  return BackgroundModel(
+      PaddedImage<SeFloat, ReplicateCoordinates>::create(
+          model.getLevelMap(), image->getWidth(), image->getHeight(), region.getTopLeft()),
+      PaddedImage<SeFloat, ReplicateCoordinates>::create(
+          model.getVarianceMap(), image->getWidth(), image->getHeight(), region.getTopLeft()),
+      model.getScalingFactor(), model.getMedianRms());
+}
+
+}
+
 DetectionFrameConfig::DetectionFrameConfig(long manager_id) : Configuration(manager_id) {
   declareDependency<WeightImageConfig>();
   declareDependency<DetectionImageConfig>();
   declareDependency<BackgroundConfig>();
   declareDependency<BackgroundAnalyzerFactory>();
+  declareDependency<ShardConfig>();
 }
 
 void DetectionFrameConfig::initialize(const UserValues& ) {
@@ -64,9 +99,13 @@ void DetectionFrameConfig::initialize(const UserValues& ) {
         detection_image_saturation, interpolation_gap);
     detection_frame->setLabel(boost::filesystem::path(detection_image_path).stem().string());
 
-    auto background_analyzer = getDependency<BackgroundAnalyzerFactory>().createBackgroundAnalyzer();
-    auto background_model = background_analyzer->analyzeBackground(detection_frame->getOriginalImage(), weight_image,
-        ConstantImage<unsigned char>::create(detection_image->getWidth(), detection_image->getHeight(), false), detection_frame->getVarianceThreshold());
+    auto background_analyzer = getDependency<BackgroundAnalyzerFactory>().createBackgroundAnalyzer(
+        "detection_" + std::to_string(i));
+    // A shard only models the background around its region
+    auto region = getDependency<ShardConfig>().getProcessedRegion(detection_image->getWidth(),
+                                                                  detection_image->getHeight());
+    auto background_model = analyzeRegionBackground(*background_analyzer, detection_frame->getOriginalImage(),
+        weight_image, detection_frame->getVarianceThreshold(), region);
 
     detection_frame->setBackgroundLevel(background_model.getLevelMap(), background_model.getMedianRms());
 
@@ -17,78 +17,161 @@
 
 #include <boost/filesystem.hpp>
 
+#include "ElementsKernel/Logging.h"
+
 #include "SEFramework/Image/ConstantImage.h"
 #include "SEFramework/Image/ProcessedImage.h"
 
 #include "SEImplementation/Background/BackgroundAnalyzerFactory.h"
+#include "SEImplementation/Configuration/CheckImagesConfig.h"
 #include "SEImplementation/Configuration/MeasurementImageConfig.h"
+#include "SEImplementation/Configuration/MultiThreadingConfig.h"
 #include "SEImplementation/CheckImages/CheckImages.h"
 
 #include "SEImplementation/Configuration/MeasurementFrameConfig.h"
 
 using namespace Euclid::Configuration;
+namespace po = boost::program_options;
 
 namespace SourceXtractor {
 
+static Elements::Logging logger = Elements::Logging::getLogger("Config");
+
+static const std::string LAZY_FRAMES {"measurement-frames-lazy"};
+static const std::string MAX_LOADED_FRAMES {"measurement-frames-max-loaded"};
+
 MeasurementFrameConfig::MeasurementFrameConfig(long manager_id) : Configuration(manager_id) {
   declareDependency<MeasurementImageConfig>();
   declareDependency<BackgroundAnalyzerFactory>();
+  declareDependency<CheckImagesConfig>();
+  declareDependency<MultiThreadingConfig>();
 }
 
-void MeasurementFrameConfig::initialize(const UserValues&) {
-  const auto& image_infos = getDependency<MeasurementImageConfig>().getImageInfos();
-  const auto& background_analyzer_factory = getDependency<BackgroundAnalyzerFactory>();
+auto MeasurementFrameConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return { {"Measurement frames", {
+      {LAZY_FRAMES.c_str(), po::value<bool>()->default_value(false),
+          "Model the background of a measurement frame when a source first needs it, instead of at start-up"},
+      {MAX_LOADED_FRAMES.c_str(), po::value<int>()->default_value(0),
+          "Maximum number of lazy measurement frames kept loaded, the least recently used are released once no source "
+          "uses them (0 = no limit)"},
+  }}};
+}
 
-  for (auto& image_info : image_infos) {
-    auto measurement_frame = std::make_shared<MeasurementImageFrame>(
-        image_info.m_measurement_image,
-        image_info.m_weight_image,
-        image_info.m_weight_threshold,
-        image_info.m_coordinate_system,
-        image_info.m_gain,
-        image_info.m_saturation_level,
-        false);
-
-    auto background_analyzer = background_analyzer_factory.createBackgroundAnalyzer(image_info.m_weight_type);
-    auto background_model = background_analyzer->analyzeBackground(
+/**
+ * The background model is kept by the caller, so a frame built again does not model it again.
+ * Its images are interpolated by tiles from a coarse mesh, so keeping it costs little memory.
+ */
+static std::shared_ptr<MeasurementImageFrame> buildFrame(
+    const MeasurementImageConfig::MeasurementImageInfo& image_info,
+    const BackgroundAnalyzerFactory& background_analyzer_factory,
+    std::shared_ptr<BackgroundModel>& background_model_cache) {
+  auto measurement_frame = std::make_shared<MeasurementImageFrame>(
+      image_info.m_measurement_image,
+      image_info.m_weight_image,
+      image_info.m_weight_threshold,
+      image_info.m_coordinate_system,
+      image_info.m_gain,
+      image_info.m_saturation_level,
+      false);
+
+  if (!background_model_cache) {
+    auto background_analyzer = background_analyzer_factory.createBackgroundAnalyzer(
+        image_info.m_weight_type, "measurement_" + std::to_string(image_info.m_id));
+    background_model_cache = std::make_shared<BackgroundModel>(background_analyzer->analyzeBackground(
         image_info.m_measurement_image,
         image_info.m_weight_image,
         ConstantImage<unsigned char>::create(image_info.m_measurement_image->getWidth(),
             image_info.m_measurement_image->getHeight(), false),
-        measurement_frame->getVarianceThreshold());
+        measurement_frame->getVarianceThreshold()));
+  }
+  const auto& background_model = *background_model_cache;
 
-    if (image_info.m_is_background_constant) {
-      measurement_frame->setBackgroundLevel(image_info.m_constant_background_value);
-    } else {
-      measurement_frame->setBackgroundLevel(background_model.getLevelMap(), background_model.getMedianRms());
-    }
+  if (image_info.m_is_background_constant) {
+    measurement_frame->setBackgroundLevel(image_info.m_constant_background_value);
+  } else {
+    measurement_frame->setBackgroundLevel(background_model.getLevelMap(), background_model.getMedianRms());
+  }
 
-    std::stringstream label;
-    label << boost::filesystem::path(image_info.m_path).stem().string() << "_" << image_info.m_image_hdu;
-    measurement_frame->setLabel(label.str());
-
-    if (image_info.m_weight_image != nullptr) {
-      if (image_info.m_absolute_weight) {
-        measurement_frame->setVarianceMap(image_info.m_weight_image);
-      } else {
-        auto scaled_image = MultiplyImage<SeFloat>::create(
-            image_info.m_weight_image,
-            background_model.getScalingFactor());
-        measurement_frame->setVarianceMap(scaled_image);
-        if (image_info.m_weight_threshold < std::numeric_limits<WeightImage::PixelType>::max())
-          measurement_frame->setVarianceThreshold(image_info.m_weight_threshold*background_model.getScalingFactor());
-      }
+  std::stringstream label;
+  label << boost::filesystem::path(image_info.m_path).stem().string() << "_" << image_info.m_image_hdu;
+  measurement_frame->setLabel(label.str());
+
+  if (image_info.m_weight_image != nullptr) {
+    if (image_info.m_absolute_weight) {
+      measurement_frame->setVarianceMap(image_info.m_weight_image);
     } else {
-      measurement_frame->setVarianceMap(background_model.getVarianceMap());
+      auto scaled_image = MultiplyImage<SeFloat>::create(
+          image_info.m_weight_image,
+          background_model.getScalingFactor());
+      measurement_frame->setVarianceMap(scaled_image);
+      if (image_info.m_weight_threshold < std::numeric_limits<WeightImage::PixelType>::max())
+        measurement_frame->setVarianceThreshold(image_info.m_weight_threshold*background_model.getScalingFactor());
     }
+  } else {
+    measurement_frame->setVarianceMap(background_model.getVarianceMap());
+  }
+
+  return measurement_frame;
+}
+
+void MeasurementFrameConfig::initialize(const UserValues& args) {
+  const auto& image_infos = getDependency<MeasurementImageConfig>().getImageInfos();
+  const auto& background_analyzer_factory = getDependency<BackgroundAnalyzerFactory>();
+  const auto& check_images_config = getDependency<CheckImagesConfig>();
+
+  auto max_loaded = args.at(MAX_LOADED_FRAMES).as<int>();
+  if (max_loaded < 0) {
+    throw Elements::Exception() << "Invalid " << MAX_LOADED_FRAMES << " value: " << max_loaded;
+  }
+
+  // The background and variance check images cover every frame, so they need all of them upfront
+  bool lazy = args.at(LAZY_FRAMES).as<bool>();
+  if (lazy && (!check_images_config.getMeasurementBackgroundFilename().empty() ||
+               !check_images_config.getMeasurementVarianceFilename().empty())) {
+    logger.info() << "Measurement background or variance check images requested, the frames are loaded upfront";
+    lazy = false;
+  }
+
+  std::shared_ptr<LazyMeasurementFrame::LoadedFrames> loaded_frames;
+  if (lazy && max_loaded > 0) {
+    loaded_frames = std::make_shared<LazyMeasurementFrame::LoadedFrames>(max_loaded);
+  }
+
+  for (auto& image_info : image_infos) {
+    // The image information outlives the frames, as it belongs to the configuration
+    std::shared_ptr<BackgroundModel> background_model;
+    auto builder = [&image_info, &background_analyzer_factory, background_model]() mutable {
+      return buildFrame(image_info, background_analyzer_factory, background_model);
+    };
+    auto measurement_frame = std::make_shared<LazyMeasurementFrame>(
+        image_info.m_measurement_image->getWidth(), image_info.m_measurement_image->getHeight(),
+        image_info.m_coordinate_system, image_info.m_gain, image_info.m_saturation_level,
+        builder, loaded_frames);
 
     m_measurement_frames[image_info.m_id] = measurement_frame;
+  }
 
-    CheckImages::getInstance().addMeasurementBackgroundCheckImage(image_info.m_id, measurement_frame->getBackgroundLevelMap());
-    CheckImages::getInstance().addMeasurementVarianceCheckImage(image_info.m_id, measurement_frame->getImage(FrameImageLayer::LayerVarianceMap));
+  if (!lazy) {
+    // The frames are independent, i.e. the planes of a data cube, so their backgrounds are modeled concurrently
+    auto& thread_pool = getDependency<MultiThreadingConfig>().getThreadPool();
+    if (thread_pool) {
+      for (auto& frame : m_measurement_frames) {
+        auto measurement_frame = frame.second;
+        thread_pool->submit([measurement_frame]() { measurement_frame->getFrame(); });
+      }
+      thread_pool->block();
+    }
+
+    for (auto& image_info : image_infos) {
+      auto frame = m_measurement_frames.at(image_info.m_id)->getFrame();
+      CheckImages::getInstance().addMeasurementBackgroundCheckImage(image_info.m_id, frame->getBackgroundLevelMap());
+      CheckImages::getInstance().addMeasurementVarianceCheckImage(image_info.m_id, frame->getImage(FrameImageLayer::LayerVarianceMap));
+    }
   }
 
+  if (lazy) {
+    logger.info() << "The " << image_infos.size() << " measurement frames will be loaded on demand";
+  }
 }
 
 }
-
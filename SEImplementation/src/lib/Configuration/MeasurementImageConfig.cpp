@@ -99,7 +99,20 @@ WeightImageConfig::WeightType getWeightType(const std::string& type_string, cons
   return weight_type_map[weight_type_name];
 }
 
-std::shared_ptr<WeightImage> createWeightMap(const PyMeasurementImage& py_image) {
+// The layers of a data cube are read through a single source, which parses the header once
+using CubeKey = std::pair<std::string, int>;
+
+std::shared_ptr<FitsImageSource> getCubeLayer(std::map<CubeKey, std::shared_ptr<FitsImageSource>>& cubes,
+                                              const std::string& file, int hdu, int layer) {
+  auto& cube = cubes[CubeKey(file, hdu)];
+  if (!cube) {
+    cube = std::make_shared<FitsImageSource>(file, hdu, ImageTile::FloatImage);
+  }
+  return cube->createLayer(layer);
+}
+
+std::shared_ptr<WeightImage> createWeightMap(const PyMeasurementImage& py_image,
+                                             std::map<CubeKey, std::shared_ptr<FitsImageSource>>& cubes) {
   auto weight_type = getWeightType(py_image.weight_type, py_image.weight_file);
 
   // without an image nothing can be done
@@ -117,12 +130,15 @@ std::shared_ptr<WeightImage> createWeightMap(const PyMeasurementImage& py_image)
     throw Elements::Exception() << "Please give an appropriate weight type for image: " << py_image.weight_file;
   }
 
-  auto weight_image_source =
-      std::make_shared<FitsImageSource>(py_image.weight_file, py_image.weight_hdu+1, ImageTile::FloatImage);
-  std::shared_ptr<WeightImage> weight_map = BufferedImage<WeightImage::PixelType>::create(weight_image_source);
+  std::shared_ptr<FitsImageSource> weight_image_source;
   if (py_image.is_data_cube) {
-    weight_image_source->setLayer(py_image.weight_layer);
+    weight_image_source = getCubeLayer(cubes, py_image.weight_file, py_image.weight_hdu+1, py_image.weight_layer);
   }
+  else {
+    weight_image_source =
+        std::make_shared<FitsImageSource>(py_image.weight_file, py_image.weight_hdu+1, ImageTile::FloatImage);
+  }
+  std::shared_ptr<WeightImage> weight_map = BufferedImage<WeightImage::PixelType>::create(weight_image_source);
 
   logger.debug() << "w: " << weight_map->getWidth() << " h: " << weight_map->getHeight()
       << " t: " << py_image.weight_type << " s: " << py_image.weight_scaling;
@@ -162,6 +178,10 @@ void MeasurementImageConfig::initialize(const UserValues&) {
   auto images = getDependency<PythonConfig>().getInterpreter().getMeasurementImages();
 
   if (images.size() > 0) {
+    std::map<CubeKey, std::shared_ptr<FitsImageSource>> cubes;
+    // Layers of the same cube share the coordinate system, so the transformations done for the first hold for all
+    std::map<CubeKey, std::pair<std::shared_ptr<CoordinateSystem>, int>> cube_geometries;
+
     for (auto& p : images) {
       PyMeasurementImage& py_image = p.second;
       validateImagePaths(py_image);
@@ -185,15 +205,28 @@ void MeasurementImageConfig::initialize(const UserValues&) {
       info.m_image_layer = py_image.image_layer;
       info.m_weight_layer = py_image.weight_layer;
 
-      auto fits_image_source =
-          std::make_shared<FitsImageSource>(py_image.file, py_image.image_hdu+1, ImageTile::FloatImage);
-
+      std::shared_ptr<FitsImageSource> fits_image_source;
       if (py_image.is_data_cube) {
-        fits_image_source->setLayer(py_image.image_layer);
+        fits_image_source = getCubeLayer(cubes, py_image.file, py_image.image_hdu+1, py_image.image_layer);
+      }
+      else {
+        fits_image_source =
+            std::make_shared<FitsImageSource>(py_image.file, py_image.image_hdu+1, ImageTile::FloatImage);
       }
 
       info.m_measurement_image = createMeasurementImage(fits_image_source, py_image.flux_scale);
-      info.m_coordinate_system = std::make_shared<WCS>(*fits_image_source);
+      if (py_image.is_data_cube) {
+        auto& geometry = cube_geometries[CubeKey(py_image.file, py_image.image_hdu+1)];
+        if (!geometry.first) {
+          geometry = std::make_pair(std::make_shared<WCS>(*fits_image_source), py_image.id);
+        }
+        info.m_coordinate_system = geometry.first;
+        info.m_geometry_id = geometry.second;
+      }
+      else {
+        info.m_coordinate_system = std::make_shared<WCS>(*fits_image_source);
+        info.m_geometry_id = py_image.id;
+      }
 
       info.m_gain = py_image.gain / flux_scale;
       info.m_saturation_level = py_image.saturation * flux_scale;
@@ -205,7 +238,7 @@ void MeasurementImageConfig::initialize(const UserValues&) {
       info.m_is_background_constant = py_image.is_background_constant;
       info.m_constant_background_value = py_image.constant_background_value;
 
-      auto weight_map = createWeightMap(py_image);
+      auto weight_map = createWeightMap(py_image, cubes);
 
       if (weight_map != nullptr && flux_scale != 1. && py_image.weight_absolute) {
         info.m_weight_image = MultiplyImage<WeightImage::PixelType>::create(
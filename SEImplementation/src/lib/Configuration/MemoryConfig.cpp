@@ -30,26 +30,45 @@ namespace SourceXtractor {
 
 static const std::string MAX_TILE_MEMORY {"tile-memory-limit"};
 static const std::string TILE_SIZE {"tile-size"};
+static const std::string TILE_MMAP {"tile-mmap"};
+static const std::string TILE_WRITE_BACK {"tile-write-back"};
+static const std::string MEMORY_SOFT_LIMIT {"memory-soft-limit"};
+static const std::string MEMORY_REPORT {"memory-report"};
 
-MemoryConfig::MemoryConfig(long manager_id) : Configuration(manager_id), m_max_memory(512), m_tile_size(256) {
+MemoryConfig::MemoryConfig(long manager_id) : Configuration(manager_id), m_max_memory(512), m_tile_size(256), m_memory_mapping(false), m_write_back(false), m_soft_limit(0), m_report(false) {
 }
 
 auto MemoryConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
   return { {"Memory usage", {
       {MAX_TILE_MEMORY.c_str(), po::value<int>()->default_value(512), "Maximum memory used for image tiles cache in megabytes"},
       {TILE_SIZE.c_str(), po::value<int>()->default_value(256), "Image tiles size in pixels"},
+      {TILE_MMAP.c_str(), po::value<bool>()->default_value(false),
+          "Read uncompressed, non-scaled FITS images through a memory mapping, bypassing cfitsio"},
+      {TILE_WRITE_BACK.c_str(), po::value<bool>()->default_value(false),
+          "Write modified image tiles asynchronously from a dedicated I/O thread"},
+      {MEMORY_SOFT_LIMIT.c_str(), po::value<int>()->default_value(0),
+          "Memory in megabytes, besides the tiles, above which no more groups are measured until some are done (0 = no limit)"},
+      {MEMORY_REPORT.c_str(), po::value<bool>()->default_value(false),
+          "Account the memory held by the pipeline, and log its high-water marks at the end"},
   }}};
 }
 
 void MemoryConfig::initialize(const UserValues& args) {
   m_max_memory = args.at(MAX_TILE_MEMORY).as<int>();
   m_tile_size = args.at(TILE_SIZE).as<int>();
+  m_memory_mapping = args.at(TILE_MMAP).as<bool>();
+  m_write_back = args.at(TILE_WRITE_BACK).as<bool>();
+  m_soft_limit = args.at(MEMORY_SOFT_LIMIT).as<int>();
+  m_report = args.at(MEMORY_REPORT).as<bool>();
   if (m_max_memory <= 0) {
     throw Elements::Exception() << "Invalid " << MAX_TILE_MEMORY << " value: " << m_max_memory;
   }
   if (m_tile_size <= 0) {
     throw Elements::Exception() << "Invalid " << TILE_SIZE << " value: " << m_tile_size;
   }
+  if (m_soft_limit < 0) {
+    throw Elements::Exception() << "Invalid " << MEMORY_SOFT_LIMIT << " value: " << m_soft_limit;
+  }
 }
 
 } /* namespace SourceXtractor */
@@ -29,10 +29,12 @@
 #include "ElementsKernel/Logging.h"
 
 #include "ModelFitting/Engine/LeastSquareEngineManager.h"
+#include "ModelFitting/Parameters/ParameterUpdateBatch.h"
 
 #include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingParameter.h"
 #include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingConverterFactory.h"
 #include "SEImplementation/PythonConfig/ObjectInfo.h"
+#include "SEImplementation/PythonConfig/PythonFallbackReport.h"
 #include "SEImplementation/Configuration/PythonConfig.h"
 #include "SEImplementation/Configuration/ModelFittingConfig.h"
 #include "Pyston/GIL.h"
@@ -59,6 +61,25 @@ static Elements::Logging logger = Elements::Logging::getLogger("Config");
 
 namespace SourceXtractor {
 
+/**
+ * Log if the expression compiled. If it did not, it is registered in the report of the expressions
+ * evaluated by Python, and the counter to use is returned.
+ */
+template<typename Tree>
+static std::shared_ptr<PythonFallbackReport::Counter> checkCompiled(const std::string& readable, const Tree& wrapped) {
+  if (!wrapped.isCompiled()) {
+    logger.warn() << "Could not compile " << readable << ": " << wrapped.reason()->what();
+    wrapped.reason()->log(log4cpp::Priority::DEBUG, logger);
+    return PythonFallbackReport::getInstance().registerExpression(readable);
+  }
+
+  logger.info() << readable << " compiled";
+  Pyston::GraphvizGenerator gv(readable);
+  wrapped.getTree()->visit(gv);
+  logger.debug() << gv.str();
+  return nullptr;
+}
+
 template<typename Signature>
 struct FunctionFromPython {
 };
@@ -66,21 +87,18 @@ struct FunctionFromPython {
 template<>
 struct FunctionFromPython<double(const SourceInterface&)> {
   static
-  std::function<double(const SourceInterface&)> get(const char *readable,
+  std::function<double(const SourceInterface&)> get(const std::string& readable,
                                                  Pyston::ExpressionTreeBuilder& builder,
                                                  py::object py_func,
                                                  const AssocModeConfig& config) {
     auto wrapped = builder.build<double(const AttributeSet&)>(py_func, ObjectInfo(config));
 
-    if (!wrapped.isCompiled()) {
-      logger.warn() << "Could not compile " << readable << ": " << wrapped.reason()->what();
-      wrapped.reason()->log(log4cpp::Priority::DEBUG, logger);
-    }
-    else {
-      logger.info() << readable << " compiled";
-      Pyston::GraphvizGenerator gv(readable);
-      wrapped.getTree()->visit(gv);
-      logger.debug() << gv.str();
+    auto counter = checkCompiled(readable, wrapped);
+    if (counter) {
+      return [wrapped, config, counter](const SourceInterface& o) -> double {
+        PythonFallbackReport::Timer timer(*counter);
+        return wrapped(ObjectInfo(o, config));
+      };
     }
 
     return [wrapped, config](const SourceInterface& o) -> double {
@@ -89,46 +107,73 @@ struct FunctionFromPython<double(const SourceInterface&)> {
   }
 };
 
+/**
+ * Dependent parameters also get a function evaluating a batch of parameter values at once, used by the
+ * propagation of the uncertainties. When the expression is evaluated by Python, the GIL is acquired once
+ * for the whole batch. During the minimization, the dependent parameters are evaluated together after
+ * each update of the engine values, and the GIL taken by the first one is kept until the last one.
+ */
 template<>
 struct FunctionFromPython<double(const Pyston::Context&, const std::vector<double>&)> {
+  using Function = std::function<double(const Pyston::Context&, const std::vector<double>&)>;
+  using BatchFunction = std::function<void(const Pyston::Context&, const std::vector<std::vector<double>>&,
+                                           std::vector<double>&)>;
+
   static
-  std::function<double(const Pyston::Context&, const std::vector<double>&)>
-    get(const char *readable, Pyston::ExpressionTreeBuilder& builder, py::object py_func,
+  std::pair<Function, BatchFunction>
+    get(const std::string& readable, Pyston::ExpressionTreeBuilder& builder, py::object py_func,
         size_t nparams) {
     auto wrapped = builder.build<double(const std::vector<double>&)>(py_func, nparams);
-    if (!wrapped.isCompiled()) {
-      logger.warn() << "Could not compile " << readable << ": " << wrapped.reason()->what();
-      wrapped.reason()->log(log4cpp::Priority::DEBUG, logger);
-    }
-    else {
-      logger.info() << readable << " compiled";
-      Pyston::GraphvizGenerator gv(readable);
-      wrapped.getTree()->visit(gv);
-      logger.debug() << gv.str();
+
+    auto counter = checkCompiled(readable, wrapped);
+    if (counter) {
+      auto function = [wrapped, counter](const Pyston::Context& context, const std::vector<double>& params) {
+        PythonFallbackReport::Timer timer(*counter);
+        if (auto batch = ModelFitting::ParameterUpdateBatch::current()) {
+          static const char s_gil_key = 0;
+          batch->hold(&s_gil_key, []() { return std::make_shared<Pyston::GILLocker>(); });
+        }
+        return wrapped(context, params);
+      };
+      auto batch = [wrapped, counter](const Pyston::Context& context, const std::vector<std::vector<double>>& params,
+                                      std::vector<double>& out) {
+        PythonFallbackReport::Timer timer(*counter, params.size());
+        // Each call acquires the GIL again, which is cheap when the thread holds it already
+        Pyston::GILLocker locker;
+        out.resize(params.size());
+        for (size_t i = 0; i < params.size(); ++i) {
+          out[i] = wrapped(context, params[i]);
+        }
+      };
+      return {function, batch};
     }
 
-    return wrapped;
+    auto batch = [wrapped](const Pyston::Context& context, const std::vector<std::vector<double>>& params,
+                           std::vector<double>& out) {
+      out.resize(params.size());
+      for (size_t i = 0; i < params.size(); ++i) {
+        out[i] = wrapped(context, params[i]);
+      }
+    };
+    return {wrapped, batch};
   }
 };
 
 template<>
 struct FunctionFromPython<double(double, const SourceInterface&)> {
   static
-  std::function<double(double, const SourceInterface&)> get(const char *readable,
+  std::function<double(double, const SourceInterface&)> get(const std::string& readable,
                                                             Pyston::ExpressionTreeBuilder& builder,
                                                             py::object py_func,
                                                             const AssocModeConfig& config) {
     auto wrapped = builder.build<double(double, const AttributeSet&)>(py_func, ObjectInfo(config));
 
-    if (!wrapped.isCompiled()) {
-      logger.warn() << "Could not compile " << readable << ": " << wrapped.reason()->what();
-      wrapped.reason()->log(log4cpp::Priority::DEBUG, logger);
-    }
-    else {
-      logger.info() << readable << " compiled";
-      Pyston::GraphvizGenerator gv(readable);
-      wrapped.getTree()->visit(gv);
-      logger.debug() << gv.str();
+    auto counter = checkCompiled(readable, wrapped);
+    if (counter) {
+      return [wrapped, config, counter](double a, const SourceInterface& o) -> double {
+        PythonFallbackReport::Timer timer(*counter);
+        return wrapped(a, ObjectInfo(o, config));
+      };
     }
 
     return [wrapped, config](double a, const SourceInterface& o) -> double {
@@ -183,7 +228,7 @@ void ModelFittingConfig::initializeInner() {
   /* Constant parameters */
   for (auto& p : getDependency<PythonConfig>().getInterpreter().getConstantParameters()) {
     auto value_func = FunctionFromPython<double(const SourceInterface&)>::get(
-      "Constant parameter", expr_builder, p.second.attr("get_value"), getDependency<AssocModeConfig>()
+      "Constant parameter " + std::to_string(p.first), expr_builder, p.second.attr("get_value"), getDependency<AssocModeConfig>()
     );
 
     m_parameters[p.first] = std::make_shared<FlexibleModelFittingConstantParameter>(
@@ -193,7 +238,7 @@ void ModelFittingConfig::initializeInner() {
   /* Free parameters */
   for (auto& p : getDependency<PythonConfig>().getInterpreter().getFreeParameters()) {
     auto init_value_func = FunctionFromPython<double(const SourceInterface&)>::get(
-      "Free parameter", expr_builder, p.second.attr("get_init_value"), getDependency<AssocModeConfig>()
+      "Free parameter " + std::to_string(p.first), expr_builder, p.second.attr("get_init_value"), getDependency<AssocModeConfig>()
     );
 
     auto py_range_obj = p.second.attr("get_range")();
@@ -203,15 +248,15 @@ void ModelFittingConfig::initializeInner() {
 
     if (type_string == "Unbounded") {
       auto factor_func = FunctionFromPython<double(double, const SourceInterface&)>::get(
-        "Unbounded", expr_builder, py_range_obj.attr("get_normalization_factor"), getDependency<AssocModeConfig>()
+        "Unbounded normalization of " + std::to_string(p.first), expr_builder, py_range_obj.attr("get_normalization_factor"), getDependency<AssocModeConfig>()
       );
       converter = std::make_shared<FlexibleModelFittingUnboundedConverterFactory>(factor_func);
     } else if (type_string == "Range") {
       auto min_func = FunctionFromPython<double(double, const SourceInterface&)>::get(
-        "Range min", expr_builder, py_range_obj.attr("get_min"), getDependency<AssocModeConfig>()
+        "Range min of " + std::to_string(p.first), expr_builder, py_range_obj.attr("get_min"), getDependency<AssocModeConfig>()
       );
       auto max_func = FunctionFromPython<double(double, const SourceInterface&)>::get(
-        "Range max", expr_builder, py_range_obj.attr("get_max"), getDependency<AssocModeConfig>()
+        "Range max of " + std::to_string(p.first), expr_builder, py_range_obj.attr("get_max"), getDependency<AssocModeConfig>()
       );
 
       auto range_func = [min_func, max_func] (double init, const SourceInterface& o) -> std::pair<double, double> {
@@ -243,16 +288,22 @@ void ModelFittingConfig::initializeInner() {
     }
 
     auto dependent = FunctionFromPython<double(const Pyston::Context&, const std::vector<double>&)>
-      ::get("Dependent parameter", expr_builder, py_func, params.size());
+      ::get("Dependent parameter " + std::to_string(p.first), expr_builder, py_func, params.size());
 
     auto dependent_func = [dependent](const std::shared_ptr<CoordinateSystem> &cs, const std::vector<double> &params) -> double {
       Pyston::Context context;
       context["coordinate_system"] = cs;
-      return dependent(context, params);
+      return dependent.first(context, params);
+    };
+    auto dependent_batch_func = [dependent](const std::shared_ptr<CoordinateSystem> &cs,
+                                            const std::vector<std::vector<double>> &params, std::vector<double>& out) {
+      Pyston::Context context;
+      context["coordinate_system"] = cs;
+      dependent.second(context, params, out);
     };
 
     m_parameters[p.first] = std::make_shared<FlexibleModelFittingDependentParameter>(
-                                                      p.first, dependent_func, params);
+                                                      p.first, dependent_func, params, dependent_batch_func);
   }
 
   for (auto& p : getDependency<PythonConfig>().getInterpreter().getConstantModels()) {
@@ -362,10 +413,10 @@ void ModelFittingConfig::initializeInner() {
     auto param = m_parameters.at(param_id);
 
     auto value_func = FunctionFromPython<double(const SourceInterface&)>::get(
-      "Prior mean", expr_builder, prior.attr("value"), getDependency<AssocModeConfig>()
+      "Prior mean " + std::to_string(p.first), expr_builder, prior.attr("value"), getDependency<AssocModeConfig>()
     );
     auto sigma_func = FunctionFromPython<double(const SourceInterface&)>::get(
-      "Prior sigma", expr_builder, prior.attr("sigma"), getDependency<AssocModeConfig>()
+      "Prior sigma " + std::to_string(p.first), expr_builder, prior.attr("sigma"), getDependency<AssocModeConfig>()
     );
 
     m_priors[p.first] = std::make_shared<FlexibleModelFittingPrior>(param, value_func, sigma_func);
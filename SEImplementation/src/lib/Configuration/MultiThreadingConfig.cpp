@@ -32,13 +32,17 @@ namespace SourceXtractor {
 
 static const std::string THREADS_NB {"thread-count"};
 static const std::string MAX_QUEUE_SIZE {"thread-max-queue-size"};
+static const std::string FRAME_PIPELINING {"thread-frame-pipelining"};
 
-MultiThreadingConfig::MultiThreadingConfig(long manager_id) : Configuration(manager_id), m_threads_nb(-1), m_max_queue_size(1000) {}
+MultiThreadingConfig::MultiThreadingConfig(long manager_id) : Configuration(manager_id), m_threads_nb(-1), m_max_queue_size(1000),
+                                                               m_frame_pipelining(false) {}
 
 auto MultiThreadingConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
   return { {"Multi-threading", {
       {THREADS_NB.c_str(), po::value<int>()->default_value(-1), "Number of worker threads (-1=automatic, 0=disable all multithreading)"},
-      {MAX_QUEUE_SIZE.c_str(), po::value<int>()->default_value(1000), "Limit the size of the internal queues"}
+      {MAX_QUEUE_SIZE.c_str(), po::value<int>()->default_value(1000), "Limit the size of the internal queues"},
+      {FRAME_PIPELINING.c_str(), po::value<bool>()->default_value(false),
+          "Start the segmentation of the next detection frame while the previous one is still being measured"}
   }}};
 }
 
@@ -58,6 +62,8 @@ void MultiThreadingConfig::initialize(const UserValues& args) {
   if (m_max_queue_size <= 0) {
     throw Elements::Exception(MAX_QUEUE_SIZE + " must be strictly positive");
   }
+
+  m_frame_pipelining = args.at(FRAME_PIPELINING).as<bool>();
 }
 
 } // SourceXtractor namespace
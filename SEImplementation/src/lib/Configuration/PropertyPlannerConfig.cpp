@@ -0,0 +1,52 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * PropertyPlannerConfig.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "SEImplementation/Configuration/PropertyPlannerConfig.h"
+
+using namespace Euclid::Configuration;
+namespace po = boost::program_options;
+
+namespace SourceXtractor {
+
+static const std::string PROPERTY_PLANNING {"property-planning"};
+static const std::string PROPERTY_REPORT {"property-report"};
+
+PropertyPlannerConfig::PropertyPlannerConfig(long manager_id) : Configuration(manager_id),
+    m_property_planning(false), m_property_report(false) {}
+
+auto PropertyPlannerConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Property planning",
+      {
+        {PROPERTY_PLANNING.c_str(), po::value<bool>()->default_value(false),
+         "Compute the properties needed by the catalog group by group, following their declared dependencies"},
+        {PROPERTY_REPORT.c_str(), po::value<bool>()->default_value(false),
+         "Report the time spent on each property, and the properties computed but not used"}
+      }
+  }};
+}
+
+void PropertyPlannerConfig::initialize(const UserValues& args) {
+  m_property_planning = args.at(PROPERTY_PLANNING).as<bool>();
+  m_property_report = args.at(PROPERTY_REPORT).as<bool>();
+}
+
+} /* namespace SourceXtractor */
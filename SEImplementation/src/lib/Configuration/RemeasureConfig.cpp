@@ -0,0 +1,131 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * RemeasureConfig.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/filesystem.hpp>
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+
+#include "Table/AsciiReader.h"
+#include "Table/CastVisitor.h"
+#include "Table/FitsReader.h"
+
+#include "SEImplementation/Configuration/CheckImagesConfig.h"
+#include "SEImplementation/Configuration/DetectionImageConfig.h"
+#include "SEImplementation/Configuration/RemeasureConfig.h"
+
+using namespace Euclid::Configuration;
+using Euclid::Table::CastVisitor;
+namespace po = boost::program_options;
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("RemeasureConfig");
+
+static const std::string REMEASURE_CATALOG {"remeasure-catalog"};
+static const std::string REMEASURE_PARTITION_IMAGE {"remeasure-partition-image"};
+
+static const std::string SOURCE_ID_COLUMN {"source_id"};
+static const std::string DETECTION_ID_COLUMN {"detection_id"};
+static const std::string GROUP_ID_COLUMN {"group_id"};
+
+// Number of rows read at once from the previous catalog
+static const long CHUNK_ROWS = 100000;
+
+RemeasureConfig::RemeasureConfig(long manager_id) : Configuration(manager_id) {
+  declareDependency<DetectionImageConfig>();
+}
+
+auto RemeasureConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Re-measurement",
+      {
+        {REMEASURE_CATALOG.c_str(), po::value<std::string>()->default_value(""),
+         "Catalog of a previous run, with its source_id, detection_id and group_id columns. "
+         "Its sources are measured again instead of segmenting the detection image"},
+        {REMEASURE_PARTITION_IMAGE.c_str(), po::value<std::string>()->default_value(""),
+         "Partition check image of the same run, giving the pixels of each source"}
+      }
+  }};
+}
+
+void RemeasureConfig::initialize(const UserValues& args) {
+  auto catalog_path = args.at(REMEASURE_CATALOG).as<std::string>();
+  auto partition_image_path = args.at(REMEASURE_PARTITION_IMAGE).as<std::string>();
+  if (catalog_path.empty() && partition_image_path.empty()) {
+    return;
+  }
+  if (catalog_path.empty() || partition_image_path.empty()) {
+    throw Elements::Exception() << "The re-measurement requires both " << REMEASURE_CATALOG
+                                << " and " << REMEASURE_PARTITION_IMAGE;
+  }
+
+  // One partition image was written for each detection image, in its primary HDU
+  size_t detection_images_nb = std::max<size_t>(getDependency<DetectionImageConfig>().getExtensionsNb(), 1);
+  for (size_t i = 0; i < detection_images_nb; ++i) {
+    m_partition_image_paths.emplace_back(
+        CheckImagesConfig::addNumberToFilename(partition_image_path, i, detection_images_nb > 1));
+    if (!boost::filesystem::exists(m_partition_image_paths.back())) {
+      throw Elements::Exception() << "The partition image " << m_partition_image_paths.back() << " does not exist";
+    }
+  }
+
+  std::shared_ptr<Euclid::Table::TableReader> reader;
+  try {
+    reader = std::make_shared<Euclid::Table::FitsReader>(catalog_path);
+  } catch (...) {
+    // If FITS not successful try reading as ascii
+    reader = std::make_shared<Euclid::Table::AsciiReader>(catalog_path);
+  }
+
+  auto sources = std::make_shared<SourceMap>();
+  try {
+    while (reader->hasMoreRows()) {
+      auto table = reader->read(CHUNK_ROWS);
+      auto column_info = table.getColumnInfo();
+      auto source_id_index = column_info->find(SOURCE_ID_COLUMN);
+      auto detection_id_index = column_info->find(DETECTION_ID_COLUMN);
+      auto group_id_index = column_info->find(GROUP_ID_COLUMN);
+      if (!source_id_index || !detection_id_index || !group_id_index) {
+        throw Elements::Exception() << "The columns " << SOURCE_ID_COLUMN << ", " << DETECTION_ID_COLUMN
+                                    << " and " << GROUP_ID_COLUMN << " are required";
+      }
+
+      for (auto& row : table) {
+        auto source_id = boost::apply_visitor(CastVisitor<int64_t>{}, row[*source_id_index]);
+        SourceInfo info {
+          static_cast<unsigned int>(boost::apply_visitor(CastVisitor<int64_t>{}, row[*detection_id_index])),
+          static_cast<unsigned int>(boost::apply_visitor(CastVisitor<int64_t>{}, row[*group_id_index]))
+        };
+        if (!sources->emplace(static_cast<unsigned int>(source_id), info).second) {
+          throw Elements::Exception() << "Duplicated source_id " << source_id;
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    throw Elements::Exception() << "Can not read the catalog to re-measure " << catalog_path << " (" << e.what() << ")";
+  }
+
+  logger.info() << "Re-measuring the " << sources->size() << " sources of " << catalog_path;
+  m_sources = sources;
+}
+
+} /* namespace SourceXtractor */
@@ -48,14 +48,18 @@ static const std::string SEGMENTATION_ALGORITHM {"segmentation-algorithm" };
 static const std::string SEGMENTATION_USE_FILTERING {"segmentation-use-filtering" };
 static const std::string SEGMENTATION_FILTER {"segmentation-filter" };
 static const std::string SEGMENTATION_LUTZ_WINDOW_SIZE {"segmentation-lutz-window-size" };
+static const std::string SEGMENTATION_STREAMING {"segmentation-streaming" };
 static const std::string SEGMENTATION_BFS_MAX_DELTA {"segmentation-bfs-max-delta" };
 static const std::string SEGMENTATION_ML_MODEL {"segmentation-ml-model" };
 static const std::string SEGMENTATION_ML_THRESHOLD {"segmentation-ml-threshold" };
+static const std::string SEGMENTATION_FRAMES_AHEAD {"segmentation-frames-ahead" };
 
 SegmentationConfig::SegmentationConfig(long manager_id) : Configuration(manager_id), m_selected_algorithm(Algorithm::UNKNOWN)
     , m_lutz_window_size(0)
+    , m_streaming(false)
     , m_bfs_max_delta(1000)
-    , m_ml_threshold(0.9) {}
+    , m_ml_threshold(0.9)
+    , m_frames_ahead(0) {}
 
 std::map<std::string, Configuration::OptionDescriptionList> SegmentationConfig::getProgramOptions() {
   return { {"Detection image", {
@@ -67,12 +71,16 @@ std::map<std::string, Configuration::OptionDescriptionList> SegmentationConfig::
           "Loads a filter"},
       {SEGMENTATION_LUTZ_WINDOW_SIZE.c_str(), po::value<int>()->default_value(0),
           "Lutz sliding window size (0=disable)"},
+      {SEGMENTATION_STREAMING.c_str(), po::bool_switch(),
+          "Release the groups and the image tiles behind the Lutz window, so memory is bounded by the image width"},
       {SEGMENTATION_BFS_MAX_DELTA.c_str(), po::value<int>()->default_value(1000),
           "BFS algorithm max source x/y size (default=1000)"},
       {SEGMENTATION_ML_MODEL.c_str(), po::value<std::string>()->default_value(""),
           "ONNX model to use with machine learning segmentation"},
       {SEGMENTATION_ML_THRESHOLD.c_str(), po::value<double>()->default_value(0.9),
           "Probability threshold for ML detection"},
+      {SEGMENTATION_FRAMES_AHEAD.c_str(), po::value<int>()->default_value(0),
+          "Number of detection frames labelled concurrently ahead of the one being processed (0=disable)"},
   }}};
 }
 
@@ -108,13 +116,37 @@ void SegmentationConfig::preInitialize(const UserValues& args) {
   }
 
   m_lutz_window_size = args.at(SEGMENTATION_LUTZ_WINDOW_SIZE).as<int>();
+  m_streaming = args.at(SEGMENTATION_STREAMING).as<bool>();
   m_bfs_max_delta = args.at(SEGMENTATION_BFS_MAX_DELTA).as<int>();
   m_onnx_model_path = args.at(SEGMENTATION_ML_MODEL).as<std::string>();
   m_ml_threshold = args.at(SEGMENTATION_ML_THRESHOLD).as<double>();
+  m_frames_ahead = args.at(SEGMENTATION_FRAMES_AHEAD).as<int>();
 
   if (m_selected_algorithm == Algorithm::ML && m_onnx_model_path == "") {
     throw Elements::Exception() << "Machine learning segmentation requested but no ONNX model was provided";
   }
+
+  if (m_frames_ahead < 0) {
+    throw Elements::Exception() << SEGMENTATION_FRAMES_AHEAD << " can not be negative";
+  }
+  if (m_frames_ahead > 0) {
+    if (m_selected_algorithm != Algorithm::LUTZ && m_selected_algorithm != Algorithm::BFS) {
+      throw Elements::Exception() << SEGMENTATION_FRAMES_AHEAD << " is only supported with the LUTZ and BFS segmentations";
+    }
+    // The sources of a frame are sent while it is labelled, and the tiles released behind it
+    if (m_streaming) {
+      throw Elements::Exception() << SEGMENTATION_FRAMES_AHEAD << " can not be used with " << SEGMENTATION_STREAMING;
+    }
+  }
+
+  if (m_streaming) {
+    if (m_selected_algorithm != Algorithm::LUTZ) {
+      throw Elements::Exception() << SEGMENTATION_STREAMING << " is only supported with the LUTZ segmentation";
+    }
+    if (m_lutz_window_size <= 0) {
+      throw Elements::Exception() << SEGMENTATION_STREAMING << " requires " << SEGMENTATION_LUTZ_WINDOW_SIZE;
+    }
+  }
 }
 
 std::shared_ptr<DetectionImageFrame::ImageFilter> SegmentationConfig::getDefaultFilter() const {
@@ -0,0 +1,105 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ShardConfig.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "ElementsKernel/Exception.h"
+
+#include "SEImplementation/Configuration/ShardConfig.h"
+
+using namespace Euclid::Configuration;
+namespace po = boost::program_options;
+
+namespace SourceXtractor {
+
+static const std::string SHARD_REGION {"shard-region"};
+static const std::string SHARD_MARGIN {"shard-margin"};
+
+ShardConfig::ShardConfig(long manager_id) : Configuration(manager_id), m_enabled(false), m_margin(0) {}
+
+auto ShardConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Sharding",
+      {
+        {SHARD_REGION.c_str(), po::value<std::string>()->default_value(""),
+         "Region of the detection image owned by this process as xmin,ymin,xmax,ymax (the first pixel is 1,1)"},
+        {SHARD_MARGIN.c_str(), po::value<int>()->default_value(200),
+         "Margin around the shard region, in pixels, that is processed so the groups crossing it are complete"}
+      }
+  }};
+}
+
+void ShardConfig::initialize(const UserValues& args) {
+  auto region = args.at(SHARD_REGION).as<std::string>();
+  m_margin = args.at(SHARD_MARGIN).as<int>();
+  if (region.empty()) {
+    return;
+  }
+  if (m_margin < 0) {
+    throw Elements::Exception() << "The shard margin can not be negative";
+  }
+  m_core_region = parseRegion(region);
+  m_enabled = true;
+}
+
+PixelRectangle ShardConfig::parseRegion(const std::string& region) {
+  std::vector<std::string> parts;
+  boost::split(parts, region, boost::is_any_of(","));
+  std::vector<int> values;
+  try {
+    for (auto& part : parts) {
+      values.emplace_back(boost::lexical_cast<int>(boost::trim_copy(part)));
+    }
+  } catch (const boost::bad_lexical_cast&) {
+    throw Elements::Exception() << "Can't parse the shard region: " << region;
+  }
+  if (values.size() != 4 || values[0] < 1 || values[1] < 1 || values[0] > values[2] || values[1] > values[3]) {
+    throw Elements::Exception() << "Invalid shard region (expected xmin,ymin,xmax,ymax): " << region;
+  }
+
+  // The option uses the FITS convention, the first pixel is 1
+  return PixelRectangle(PixelCoordinate(values[0] - 1, values[1] - 1), PixelCoordinate(values[2] - 1, values[3] - 1));
+}
+
+PixelRectangle ShardConfig::getProcessedRegion() const {
+  if (!m_enabled) {
+    return PixelRectangle();
+  }
+  auto min = m_core_region.getTopLeft(), max = m_core_region.getBottomRight();
+  return PixelRectangle(PixelCoordinate(std::max(0, min.m_x - m_margin), std::max(0, min.m_y - m_margin)),
+                        PixelCoordinate(max.m_x + m_margin, max.m_y + m_margin));
+}
+
+PixelRectangle ShardConfig::getProcessedRegion(int width, int height) const {
+  if (!m_enabled) {
+    return PixelRectangle(PixelCoordinate(0, 0), PixelCoordinate(width - 1, height - 1));
+  }
+  auto region = getProcessedRegion();
+  auto min = region.getTopLeft(), max = region.getBottomRight();
+  if (min.m_x >= width || min.m_y >= height) {
+    throw Elements::Exception() << "The shard region is outside of the " << width << "x" << height << " image";
+  }
+  return PixelRectangle(min, PixelCoordinate(std::min(max.m_x, width - 1), std::min(max.m_y, height - 1)));
+}
+
+} /* namespace SourceXtractor */
@@ -0,0 +1,47 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * TracingConfig.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "SEImplementation/Configuration/TracingConfig.h"
+
+using namespace Euclid::Configuration;
+namespace po = boost::program_options;
+
+namespace SourceXtractor {
+
+static const std::string TRACE_FILE {"trace-file"};
+
+TracingConfig::TracingConfig(long manager_id) : Configuration(manager_id) {}
+
+auto TracingConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Tracing",
+      {
+        {TRACE_FILE.c_str(), po::value<std::string>()->default_value(""),
+         "Record the timeline of the pipeline stages into this file, in the Chrome trace-event format"}
+      }
+  }};
+}
+
+void TracingConfig::initialize(const UserValues& args) {
+  m_trace_file = args.at(TRACE_FILE).as<std::string>();
+}
+
+} /* namespace SourceXtractor */
@@ -15,8 +15,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include "SEFramework/Pipeline/Tracer.h"
 #include "SEImplementation/Grouping/AssocGrouping.h"
 #include "SEImplementation/Plugin/AssocMode/AssocMode.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
 
 namespace SourceXtractor {
 
@@ -26,13 +28,23 @@ AssocGrouping::AssocGrouping(std::shared_ptr<SourceGroupFactory> group_factory,
 }
 
 std::set<PropertyId> AssocGrouping::requiredProperties() const {
-  return { PropertyId::create<AssocMode>(), };
+  return { PropertyId::create<AssocMode>(), PropertyId::create<PixelBoundaries>(), };
 }
 
 /// Handles a new Source
 void AssocGrouping::receiveSource(std::unique_ptr<SourceInterface> source) {
+  Tracer::Scope trace_scope("grouping", "Group source");
+
   auto source_id = source->getProperty<AssocMode>().getGroupId();
 
+  // Entries without a group id are groups of their own, as the assoc segmentation assumes when streaming
+  if (source_id == 0) {
+    auto new_group = m_group_factory->createSourceGroup();
+    new_group->addSource(std::move(source));
+    m_single_groups.emplace_back(std::move(new_group));
+    return;
+  }
+
   if (m_source_groups.find(source_id) == m_source_groups.end()) {
     auto new_group = m_group_factory->createSourceGroup();
     m_source_groups[source_id] = std::move(new_group);
@@ -53,16 +65,15 @@ void AssocGrouping::receiveSource(std::unique_ptr<SourceInterface> source) {
 
 /// Handles a ProcessSourcesEvent to trigger the processing of some of the Sources stored in SourceGrouping
 void AssocGrouping::receiveProcessSignal(const ProcessSourcesEvent& event) {
+  Tracer::Scope trace_scope("grouping", "Flush groups");
+
   std::vector<unsigned int> groups_to_process;
 
   // We iterate through all the SourceGroups we have
   for (auto const& it : m_source_groups) {
-    // We look at its Sources and if we find at least one that needs to be processed
-    for (auto& source : *it.second) {
-      if (event.m_selection_criteria->mustBeProcessed(source)) {
-        groups_to_process.push_back(it.first);
-        break;
-      }
+    // We look at its Sources to know if it needs to be processed
+    if (event.m_selection_criteria->groupMustBeProcessed(*it.second)) {
+      groups_to_process.push_back(it.first);
     }
   }
 
@@ -72,6 +83,15 @@ void AssocGrouping::receiveProcessSignal(const ProcessSourcesEvent& event) {
     sendSource(std::move(m_source_groups[group_id]));
     m_source_groups.erase(group_id);
   }
+
+  for (auto it = m_single_groups.begin(); it != m_single_groups.end();) {
+    if (event.m_selection_criteria->groupMustBeProcessed(**it)) {
+      sendSource(std::move(*it));
+      it = m_single_groups.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 } // SourceXtractor namespace
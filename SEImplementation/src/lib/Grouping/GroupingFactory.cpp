@@ -20,6 +20,7 @@
 #include "SEImplementation/Grouping/SplitSourcesGrouping.h"
 #include "SEImplementation/Grouping/AssocGrouping.h"
 #include "SEImplementation/Grouping/MoffatGrouping.h"
+#include "SEImplementation/Grouping/RemeasureGrouping.h"
 
 namespace SourceXtractor {
 
@@ -29,6 +30,7 @@ GroupingFactory::GroupingFactory(std::shared_ptr<SourceGroupFactory> source_grou
 
 void GroupingFactory::reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const {
   manager.registerConfiguration<GroupingConfig>();
+  manager.registerConfiguration<RemeasureConfig>();
 }
 
 void GroupingFactory::configure(Euclid::Configuration::ConfigManager& manager)  {
@@ -53,12 +55,17 @@ void GroupingFactory::configure(Euclid::Configuration::ConfigManager& manager)
       break;
   }
   m_hard_limit = grouping_config.getHardLimit();
+  m_remeasured_sources = manager.getConfiguration<RemeasureConfig>().getSources();
 }
 
 std::shared_ptr<SourceGroupingInterface> GroupingFactory::createGrouping() const {
   assert(m_grouping_criteria != nullptr);
   assert(m_source_group_factory != nullptr);
 
+  if (m_remeasured_sources) {
+    return std::make_shared<RemeasureGrouping>(m_source_group_factory, m_remeasured_sources);
+  }
+
   // return optimized grouping if available, if not uses general grouping with criteria
   switch (m_algorithm) {
     case GroupingConfig::Algorithm::SPLIT_SOURCES:
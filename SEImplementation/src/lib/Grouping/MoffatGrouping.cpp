@@ -19,6 +19,7 @@
 
 #include <set>
 
+#include "SEFramework/Pipeline/Tracer.h"
 #include "SEImplementation/Grouping/MoffatGrouping.h"
 #include "SEImplementation/Grouping/MoffatCriteria.h"
 
@@ -26,6 +27,7 @@
 #include "SEImplementation/Plugin/MoffatModelFitting/MoffatModelEvaluator.h"
 #include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
 #include "SEImplementation/Plugin/PeakValue/PeakValue.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
 
 namespace SourceXtractor {
 
@@ -53,11 +55,13 @@ std::set<PropertyId> MoffatGrouping::requiredProperties() const {
     PropertyId::create<PixelCentroid>(),
     PropertyId::create<PeakValue>(),
     PropertyId::create<MoffatModelEvaluator>(),
+    PropertyId::create<PixelBoundaries>(),
   };
 }
 
 /// Handles a new Source
 void MoffatGrouping::receiveSource(std::unique_ptr<SourceInterface> source) {
+  Tracer::Scope trace_scope("grouping", "Group source");
 
   // Encapsulates the source unique_ptr
   auto& centroid = source->getProperty<PixelCentroid>();
@@ -106,17 +110,25 @@ void MoffatGrouping::receiveSource(std::unique_ptr<SourceInterface> source) {
 
 /// Handles a ProcessSourcesEvent to trigger the processing of some of the Sources stored in SourceGrouping
 void MoffatGrouping::receiveProcessSignal(const ProcessSourcesEvent& event) {
+  Tracer::Scope trace_scope("grouping", "Flush groups");
+
   std::vector<size_t> groups_to_process;
 
   // We iterate through all the SourceGroups we have
   for (auto const& it : m_groups) {
-    // We look at its Sources and if we find at least one that needs to be processed
+    // We look at its Sources and if we find at least one that needs to be processed, or all of them if the
+    // criteria requires the whole group, we put it in groups_to_process
+    bool whole_group = event.m_selection_criteria->requiresWholeGroup();
+    bool selected = whole_group;
     for (auto& source : *it.second) {
-      if (event.m_selection_criteria->mustBeProcessed(*source->m_source)) {
-        groups_to_process.push_back(it.first);
+      if (event.m_selection_criteria->mustBeProcessed(*source->m_source) != whole_group) {
+        selected = !whole_group;
         break;
       }
     }
+    if (selected) {
+      groups_to_process.push_back(it.first);
+    }
   }
 
   // For each SourceGroup that we put in groups_to_process,
@@ -34,6 +34,10 @@ bool OverlappingBoundariesCriteria::shouldGroup(const SourceInterface& first, co
           first_boundaries.getMax().m_y < second_boundaries.getMin().m_y);
 }
 
+std::set<PropertyId> OverlappingBoundariesCriteria::requiredProperties() const {
+  return { PropertyId::create<PixelBoundaries>(), };
+}
+
 
 } // SourceXtractor namespace
 
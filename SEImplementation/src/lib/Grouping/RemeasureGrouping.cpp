@@ -0,0 +1,87 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * RemeasureGrouping.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <vector>
+
+#include "SEFramework/Pipeline/Tracer.h"
+#include "SEImplementation/Plugin/GroupInfo/GroupInfo.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceID.h"
+
+#include "SEImplementation/Grouping/RemeasureGrouping.h"
+
+namespace SourceXtractor {
+
+RemeasureGrouping::RemeasureGrouping(std::shared_ptr<SourceGroupFactory> group_factory,
+                                     std::shared_ptr<const RemeasureConfig::SourceMap> sources)
+    : m_group_factory(group_factory), m_sources(sources) {
+  for (auto& source : *m_sources) {
+    ++m_group_sizes[source.second.m_group_id];
+  }
+}
+
+std::set<PropertyId> RemeasureGrouping::requiredProperties() const {
+  // Set by the segmentation
+  return {};
+}
+
+void RemeasureGrouping::receiveSource(std::unique_ptr<SourceInterface> source) {
+  Tracer::Scope trace_scope("grouping", "Group source");
+
+  auto group_id = m_sources->at(source->getProperty<SourceID>().getId()).m_group_id;
+
+  auto& group = m_source_groups[group_id];
+  if (!group) {
+    group = m_group_factory->createSourceGroup();
+  }
+  group->addSource(std::move(source));
+
+  if (group->size() >= m_group_sizes.at(group_id)) {
+    sendGroup(group_id);
+  }
+}
+
+void RemeasureGrouping::receiveProcessSignal(const ProcessSourcesEvent& event) {
+  Tracer::Scope trace_scope("grouping", "Flush groups");
+
+  std::vector<unsigned int> groups_to_process;
+  for (auto const& it : m_source_groups) {
+    if (event.m_selection_criteria->groupMustBeProcessed(*it.second)) {
+      groups_to_process.push_back(it.first);
+    }
+  }
+
+  for (auto group_id : groups_to_process) {
+    sendGroup(group_id);
+  }
+}
+
+void RemeasureGrouping::sendGroup(unsigned int group_id) {
+  auto i = m_source_groups.find(group_id);
+  auto group = std::move(i->second);
+  m_source_groups.erase(i);
+
+  // Keep the id of the previous run, so the catalogs can be joined by group too
+  group->setProperty<GroupInfo>(group_id);
+  sendSource(std::move(group));
+}
+
+} // SourceXtractor namespace
@@ -15,8 +15,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include "SEFramework/Pipeline/Tracer.h"
 #include "SEImplementation/Grouping/SplitSourcesGrouping.h"
 #include "SEImplementation/Property/SourceId.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
 
 namespace SourceXtractor {
 
@@ -26,11 +28,14 @@ SplitSourcesGrouping::SplitSourcesGrouping(std::shared_ptr<SourceGroupFactory> g
 }
 
 std::set<PropertyId> SplitSourcesGrouping::requiredProperties() const {
-  return {};
+  // The boundaries select the groups to process when the segmentation is streaming
+  return { PropertyId::create<PixelBoundaries>(), };
 }
 
 /// Handles a new Source
 void SplitSourcesGrouping::receiveSource(std::unique_ptr<SourceInterface> source) {
+  Tracer::Scope trace_scope("grouping", "Group source");
+
   auto source_id = source->getProperty<SourceId>().getDetectionId();
 
   if (m_source_groups.find(source_id) == m_source_groups.end()) {
@@ -53,16 +58,15 @@ void SplitSourcesGrouping::receiveSource(std::unique_ptr<SourceInterface> source
 
 /// Handles a ProcessSourcesEvent to trigger the processing of some of the Sources stored in SourceGrouping
 void SplitSourcesGrouping::receiveProcessSignal(const ProcessSourcesEvent& event) {
+  Tracer::Scope trace_scope("grouping", "Flush groups");
+
   std::vector<unsigned int> groups_to_process;
 
   // We iterate through all the SourceGroups we have
   for (auto const& it : m_source_groups) {
-    // We look at its Sources and if we find at least one that needs to be processed
-    for (auto& source : *it.second) {
-      if (event.m_selection_criteria->mustBeProcessed(source)) {
-        groups_to_process.push_back(it.first);
-        break;
-      }
+    // We look at its Sources to know if it needs to be processed
+    if (event.m_selection_criteria->groupMustBeProcessed(*it.second)) {
+      groups_to_process.push_back(it.first);
     }
   }
 
@@ -28,13 +28,16 @@
 #include "SEImplementation/Measurement/MultithreadedMeasurement.h"
 #include "SEImplementation/Configuration/OutputConfig.h"
 #include "SEImplementation/Configuration/MultiThreadingConfig.h"
+#include "SEImplementation/Configuration/PropertyPlannerConfig.h"
+#include "SEImplementation/Configuration/SegmentationConfig.h"
 
 namespace SourceXtractor {
 
 std::unique_ptr<Measurement> MeasurementFactory::getMeasurement() const {
   if (m_threads_nb > 0) {
-    auto source_to_row = m_output_registry->getSourceToRowConverter(m_output_properties);
-    return std::unique_ptr<Measurement>(new MultithreadedMeasurement(source_to_row, m_thread_pool, m_max_queue));
+    auto request_properties = m_output_registry->getSourcePropertyRequester(m_output_properties);
+    return std::unique_ptr<Measurement>(new MultithreadedMeasurement(request_properties, m_thread_pool, m_max_queue,
+                                                                     m_property_planning, m_hold_tile_rows));
   } else {
     return std::unique_ptr<Measurement>(new DummyMeasurement());
   }
@@ -43,6 +46,8 @@ std::unique_ptr<Measurement> MeasurementFactory::getMeasurement() const {
 void MeasurementFactory::reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const {
   manager.registerConfiguration<OutputConfig>();
   manager.registerConfiguration<MultiThreadingConfig>();
+  manager.registerConfiguration<PropertyPlannerConfig>();
+  manager.registerConfiguration<SegmentationConfig>();
 }
 
 void MeasurementFactory::configure(Euclid::Configuration::ConfigManager& manager) {
@@ -50,6 +55,8 @@ void MeasurementFactory::configure(Euclid::Configuration::ConfigManager& manager
   m_threads_nb = manager.getConfiguration<MultiThreadingConfig>().getThreadsNb();
   m_thread_pool = manager.getConfiguration<MultiThreadingConfig>().getThreadPool();
   m_max_queue = manager.getConfiguration<MultiThreadingConfig>().getMaxQueueSize();
+  m_property_planning = manager.getConfiguration<PropertyPlannerConfig>().getPropertyPlanning();
+  m_hold_tile_rows = manager.getConfiguration<SegmentationConfig>().isStreaming();
 }
 
 }
@@ -21,10 +21,17 @@
  *      Author: mschefer
  */
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <ElementsKernel/Logging.h>
 #include <csignal>
 
+#include "SEFramework/Image/TileManager.h"
+#include "SEFramework/Pipeline/Tracer.h"
+#include "SEFramework/Task/PropertyPlanner.h"
+#include "SEUtils/MemoryAccounting.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
 #include "SEImplementation/Plugin/SourceIDs/SourceID.h"
 #include "SEImplementation/Measurement/MultithreadedMeasurement.h"
 
@@ -79,12 +86,40 @@ void MultithreadedMeasurement::receiveSource(std::unique_ptr<SourceGroupInterfac
     source.getProperty<SourceID>();
   }
 
+  // Over the soft memory limit, wait for the groups being measured to be released
+  auto& memory_accounting = MemoryAccounting::getInstance();
+  if (memory_accounting.isOverSoftLimit()) {
+    Tracer::Scope trace_scope("measurement", "Wait for memory");
+    memory_accounting.waitBelowSoftLimit([this]() {
+      return m_groups_in_flight > 0 && !m_thread_pool->checkForException(false);
+    });
+  }
+
+  // The first row of the group must stay loaded until it is measured
+  int first_row = std::numeric_limits<int>::max();
+  if (m_hold_tile_rows) {
+    for (auto& source : *source_group) {
+      first_row = std::min(first_row, source.getProperty<PixelBoundaries>().getMin().m_y);
+    }
+    TileManager::getInstance()->holdRowsFrom(first_row);
+  }
+
   // Put the new SourceGroup into the input queue
+  ++m_groups_in_flight;
   auto order_number = m_group_counter;
-  auto lambda = [this, order_number, source_group = std::move(source_group)]() mutable {
+  auto lambda = [this, order_number, first_row, source_group = std::move(source_group)]() mutable {
     // Trigger measurements
-    for (auto& source : *source_group) {
-      m_source_to_row(source);
+    {
+      Tracer::Scope trace_scope("measurement", "Measure group");
+      if (m_property_planning) {
+        PropertyPlanner::getInstance().execute(*source_group);
+      }
+      for (auto& source : *source_group) {
+        m_request_properties(source);
+      }
+    }
+    if (m_hold_tile_rows) {
+      TileManager::getInstance()->unholdRowsFrom(first_row);
     }
     // Pass to the output thread
     {
@@ -102,6 +137,7 @@ void MultithreadedMeasurement::receiveSource(std::unique_ptr<SourceGroupInterfac
 
 void MultithreadedMeasurement::outputThreadStatic(MultithreadedMeasurement *measurement) {
   logger.debug() << "Starting output thread";
+  Tracer::getInstance().setThreadName("Measurement output");
   try {
     measurement->outputThreadLoop();
   }
@@ -129,6 +165,7 @@ void MultithreadedMeasurement::outputThreadLoop() {
     while (!m_output_queue.empty()) {
       sendSource(std::move(m_output_queue.front().second));
       m_output_queue.pop_front();
+      --m_groups_in_flight;
     }
 
     if (m_input_done && m_thread_pool->running() + m_thread_pool->queued() == 0 &&
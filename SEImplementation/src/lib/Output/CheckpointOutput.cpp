@@ -0,0 +1,133 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * CheckpointOutput.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ElementsKernel/Logging.h"
+
+#include "SEImplementation/Checkpoint/CheckpointGroupKey.h"
+
+#include "SEImplementation/Output/CheckpointOutput.h"
+
+using Euclid::Table::Row;
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("Checkpoint");
+
+CheckpointOutput::CheckpointOutput(std::shared_ptr<FlushableOutput> output,
+                                   FlushableOutput::SourceToRowConverter source_to_row,
+                                   std::shared_ptr<Checkpoint> checkpoint, int interval)
+  : m_output(std::move(output)), m_source_to_row(std::move(source_to_row)), m_checkpoint(std::move(checkpoint)),
+    m_interval(interval), m_last_commit(std::chrono::steady_clock::now()), m_part(0),
+    m_group_id_offset(m_checkpoint->getMaxStoredValue("group_id")), m_in_group(false), m_group_key{0, 0} {
+  replayPart();
+}
+
+CheckpointOutput::~CheckpointOutput() {
+  // The group being received may be incomplete, so it is not stored
+  try {
+    commit();
+  } catch (const std::exception& e) {
+    logger.error() << "Failed to store the last groups in the checkpoint: " << e.what();
+  }
+}
+
+void CheckpointOutput::outputSource(const SourceInterface& source) {
+  const auto& key = source.getProperty<CheckpointGroupKey>().getKey();
+  if (m_in_group && key != m_group_key) {
+    endGroup();
+  }
+  m_in_group = true;
+  m_group_key = key;
+
+  auto row = m_source_to_row(source);
+  if (m_group_id_offset > 0) {
+    row = shiftGroupId(row);
+  }
+  m_group_rows.emplace_back(row);
+  m_output->outputRow(std::move(row));
+}
+
+size_t CheckpointOutput::flush() {
+  if (m_in_group) {
+    endGroup();
+  }
+  commit();
+  return m_output->flush();
+}
+
+void CheckpointOutput::nextPart() {
+  m_output->nextPart();
+  ++m_part;
+  replayPart();
+}
+
+void CheckpointOutput::replayPart() {
+  for (auto& row : m_checkpoint->takeStoredRows(m_part)) {
+    m_output->outputRow(std::move(row));
+  }
+}
+
+void CheckpointOutput::endGroup() {
+  for (auto& row : m_group_rows) {
+    m_pending_rows.emplace_back(std::move(row));
+    m_pending_row_keys.emplace_back(m_group_key);
+  }
+  m_group_rows.clear();
+  m_pending_group_keys.emplace_back(m_group_key);
+  m_in_group = false;
+
+  if (std::chrono::steady_clock::now() - m_last_commit >= m_interval) {
+    commit();
+  }
+}
+
+void CheckpointOutput::commit() {
+  if (!m_pending_group_keys.empty()) {
+    m_checkpoint->commit(m_pending_rows, m_pending_row_keys, m_pending_group_keys);
+    logger.debug() << "Stored " << m_pending_group_keys.size() << " groups in the checkpoint";
+    m_pending_rows.clear();
+    m_pending_row_keys.clear();
+    m_pending_group_keys.clear();
+  }
+  m_last_commit = std::chrono::steady_clock::now();
+}
+
+Row CheckpointOutput::shiftGroupId(const Row& row) {
+  auto index = row.getColumnInfo()->find("group_id");
+  if (!index) {
+    return row;
+  }
+  std::vector<Row::cell_type> cells;
+  cells.reserve(row.size());
+  for (std::size_t i = 0; i < row.size(); ++i) {
+    cells.emplace_back(row[i]);
+  }
+  if (auto value = boost::get<std::int64_t>(&cells[*index])) {
+    *value += m_group_id_offset;
+  }
+  else if (auto value = boost::get<std::int32_t>(&cells[*index])) {
+    *value += static_cast<std::int32_t>(m_group_id_offset);
+  }
+  return Row(std::move(cells), row.getColumnInfo());
+}
+
+} /* namespace SourceXtractor */
@@ -0,0 +1,415 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * FitsTableWriter.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+
+#include <ElementsKernel/Exception.h>
+#include <ElementsKernel/Logging.h>
+#include <NdArray/NdArray.h>
+
+#include "SEImplementation/Output/FitsTableWriter.h"
+
+namespace SourceXtractor {
+
+using Euclid::NdArray::NdArray;
+using Euclid::Table::Row;
+
+static Elements::Logging logger = Elements::Logging::getLogger("FitsTableWriter");
+
+namespace {
+
+void checkStatus(int status, const std::string& filename, const std::string& what) {
+  if (status != 0) {
+    char error_message[32];
+    fits_get_errstatus(status, error_message);
+    throw Elements::Exception() << what << ": " << filename
+                                << " status: " << status << " = " << error_message;
+  }
+}
+
+template <typename T>
+struct FitsType;
+
+template <>
+struct FitsType<bool> {
+  using buffer_type = char;
+  static constexpr int datatype = TLOGICAL;
+  static constexpr char tform = 'L';
+};
+
+template <>
+struct FitsType<std::int32_t> {
+  using buffer_type = int;
+  static constexpr int datatype = TINT;
+  static constexpr char tform = 'J';
+};
+
+template <>
+struct FitsType<std::int64_t> {
+  using buffer_type = LONGLONG;
+  static constexpr int datatype = TLONGLONG;
+  static constexpr char tform = 'K';
+};
+
+template <>
+struct FitsType<float> {
+  using buffer_type = float;
+  static constexpr int datatype = TFLOAT;
+  static constexpr char tform = 'E';
+};
+
+template <>
+struct FitsType<double> {
+  using buffer_type = double;
+  static constexpr int datatype = TDOUBLE;
+  static constexpr char tform = 'D';
+};
+
+template <typename T>
+std::vector<std::size_t> getShape(const std::vector<T>& cell) {
+  return {cell.size()};
+}
+
+template <typename T>
+std::vector<std::size_t> getShape(const NdArray<T>& cell) {
+  return cell.shape();
+}
+
+template <typename T>
+bool hasShape(const std::vector<T>& cell, const std::vector<std::size_t>& shape) {
+  return cell.size() == shape.front();
+}
+
+template <typename T>
+bool hasShape(const NdArray<T>& cell, const std::vector<std::size_t>& shape) {
+  return cell.shape() == shape;
+}
+
+}  // end of anonymous namespace
+
+class FitsTableWriter::ColumnWriter {
+public:
+  ColumnWriter(std::string name, std::size_t index) : m_name(std::move(name)), m_index(index) {}
+
+  virtual ~ColumnWriter() = default;
+
+  const std::string& getName() const {
+    return m_name;
+  }
+
+  virtual std::string getTForm() const = 0;
+
+  /// Shape of the cells, in FITS order (fastest axis first). Empty if no TDIM is needed.
+  virtual std::vector<long> getTDim() const {
+    return {};
+  }
+
+  /// Write the cells [begin, end) of the block, starting at the (1-based) row first_row of the table
+  virtual void write(fitsfile* fptr, int colnum, long long first_row,
+                     const std::vector<Row>& rows, std::size_t begin, std::size_t end, int* status) = 0;
+
+protected:
+  std::string m_name;
+  std::size_t m_index;
+};
+
+namespace {
+
+template <typename T>
+class ScalarColumnWriter : public FitsTableWriter::ColumnWriter {
+public:
+  using ColumnWriter::ColumnWriter;
+
+  std::string getTForm() const override {
+    return std::string(1, FitsType<T>::tform);
+  }
+
+  void write(fitsfile* fptr, int colnum, long long first_row,
+             const std::vector<Row>& rows, std::size_t begin, std::size_t end, int* status) override {
+    m_buffer.resize(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+      m_buffer[i - begin] = boost::get<T>(rows[i][m_index]);
+    }
+    fits_write_col(fptr, FitsType<T>::datatype, colnum, first_row, 1, m_buffer.size(), m_buffer.data(), status);
+  }
+
+private:
+  std::vector<typename FitsType<T>::buffer_type> m_buffer;
+};
+
+/// Fixed-size vector columns, stored as repeated elements of a single cell
+template <typename T, typename CellType>
+class ArrayColumnWriter : public FitsTableWriter::ColumnWriter {
+public:
+  ArrayColumnWriter(std::string name, std::size_t index, const CellType& first_cell, bool with_tdim)
+    : ColumnWriter(std::move(name), index), m_shape(getShape(first_cell)), m_with_tdim(with_tdim) {
+    m_repeat = 1;
+    for (auto d : m_shape) {
+      m_repeat *= d;
+    }
+  }
+
+  std::string getTForm() const override {
+    return std::to_string(m_repeat) + FitsType<T>::tform;
+  }
+
+  std::vector<long> getTDim() const override {
+    if (!m_with_tdim) {
+      return {};
+    }
+    // NdArray is row major, while the first axis of TDIM varies the fastest
+    return std::vector<long>(m_shape.rbegin(), m_shape.rend());
+  }
+
+  void write(fitsfile* fptr, int colnum, long long first_row,
+             const std::vector<Row>& rows, std::size_t begin, std::size_t end, int* status) override {
+    if (m_repeat == 0) {
+      return;
+    }
+    m_buffer.resize((end - begin) * m_repeat);
+    auto out = m_buffer.begin();
+    for (std::size_t i = begin; i < end; ++i) {
+      const auto& cell = boost::get<CellType>(rows[i][m_index]);
+      if (!hasShape(cell, m_shape)) {
+        throw Elements::Exception() << "The size of the column " << m_name
+                                    << " can not change between rows in a FITS table";
+      }
+      out = std::copy(cell.begin(), cell.end(), out);
+    }
+    fits_write_col(fptr, FitsType<T>::datatype, colnum, first_row, 1, m_buffer.size(), m_buffer.data(), status);
+  }
+
+private:
+  std::vector<std::size_t> m_shape;
+  bool m_with_tdim;
+  std::size_t m_repeat;
+  std::vector<typename FitsType<T>::buffer_type> m_buffer;
+};
+
+class StringColumnWriter : public FitsTableWriter::ColumnWriter {
+public:
+  StringColumnWriter(std::string name, std::size_t index, std::size_t width)
+    : ColumnWriter(std::move(name), index), m_width(std::max<std::size_t>(width, 1)) {}
+
+  std::string getTForm() const override {
+    return std::to_string(m_width) + 'A';
+  }
+
+  void write(fitsfile* fptr, int colnum, long long first_row,
+             const std::vector<Row>& rows, std::size_t begin, std::size_t end, int* status) override {
+    // cfitsio would silently truncate the values longer than the column width
+    m_buffer.resize(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+      const auto& value = boost::get<std::string>(rows[i][m_index]);
+      if (value.size() > m_width) {
+        throw Elements::Exception() << "The value '" << value << "' of the column " << m_name
+                                    << " is longer than the " << m_width
+                                    << " characters of the column in the FITS table";
+      }
+      m_buffer[i - begin] = const_cast<char*>(value.c_str());
+    }
+    fits_write_col(fptr, TSTRING, colnum, first_row, 1, m_buffer.size(), m_buffer.data(), status);
+  }
+
+private:
+  std::size_t m_width;
+  std::vector<char*> m_buffer;
+};
+
+template <typename T>
+std::unique_ptr<FitsTableWriter::ColumnWriter> createVectorWriter(const std::string& name, std::size_t index,
+                                                                  const Row& first_row) {
+  return std::unique_ptr<FitsTableWriter::ColumnWriter>(new ArrayColumnWriter<T, std::vector<T>>(
+    name, index, boost::get<std::vector<T>>(first_row[index]), false));
+}
+
+template <typename T>
+std::unique_ptr<FitsTableWriter::ColumnWriter> createNdArrayWriter(const std::string& name, std::size_t index,
+                                                                   const Row& first_row) {
+  return std::unique_ptr<FitsTableWriter::ColumnWriter>(new ArrayColumnWriter<T, NdArray<T>>(
+    name, index, boost::get<NdArray<T>>(first_row[index]), true));
+}
+
+std::unique_ptr<FitsTableWriter::ColumnWriter> createColumnWriter(const std::vector<Row>& rows, std::size_t index) {
+  const auto& description = rows.front().getColumnInfo()->getDescription(index);
+  const auto& name = description.name;
+  const auto& type = description.type;
+  const auto& first_row = rows.front();
+
+  using Writer = std::unique_ptr<FitsTableWriter::ColumnWriter>;
+  if (type == typeid(bool)) {
+    return Writer(new ScalarColumnWriter<bool>(name, index));
+  }
+  if (type == typeid(std::int32_t)) {
+    return Writer(new ScalarColumnWriter<std::int32_t>(name, index));
+  }
+  if (type == typeid(std::int64_t)) {
+    return Writer(new ScalarColumnWriter<std::int64_t>(name, index));
+  }
+  if (type == typeid(float)) {
+    return Writer(new ScalarColumnWriter<float>(name, index));
+  }
+  if (type == typeid(double)) {
+    return Writer(new ScalarColumnWriter<double>(name, index));
+  }
+  if (type == typeid(std::string)) {
+    std::size_t width = 0;
+    for (const auto& row : rows) {
+      width = std::max(width, boost::get<std::string>(row[index]).size());
+    }
+    return Writer(new StringColumnWriter(name, index, width));
+  }
+  if (type == typeid(std::vector<std::int32_t>)) {
+    return createVectorWriter<std::int32_t>(name, index, first_row);
+  }
+  if (type == typeid(std::vector<std::int64_t>)) {
+    return createVectorWriter<std::int64_t>(name, index, first_row);
+  }
+  if (type == typeid(std::vector<float>)) {
+    return createVectorWriter<float>(name, index, first_row);
+  }
+  if (type == typeid(std::vector<double>)) {
+    return createVectorWriter<double>(name, index, first_row);
+  }
+  if (type == typeid(NdArray<std::int32_t>)) {
+    return createNdArrayWriter<std::int32_t>(name, index, first_row);
+  }
+  if (type == typeid(NdArray<std::int64_t>)) {
+    return createNdArrayWriter<std::int64_t>(name, index, first_row);
+  }
+  if (type == typeid(NdArray<float>)) {
+    return createNdArrayWriter<float>(name, index, first_row);
+  }
+  if (type == typeid(NdArray<double>)) {
+    return createNdArrayWriter<double>(name, index, first_row);
+  }
+  throw Elements::Exception() << "Unsupported type for the FITS column " << name;
+}
+
+}  // end of anonymous namespace
+
+FitsTableWriter::FitsTableWriter(const std::string& filename, bool override_file)
+  : m_filename(filename), m_override_file(override_file), m_fptr(nullptr), m_row_count(0) {}
+
+FitsTableWriter::~FitsTableWriter() {
+  try {
+    close();
+  } catch (const std::exception& e) {
+    logger.error() << "Failed to close " << m_filename << ": " << e.what();
+  }
+}
+
+void FitsTableWriter::setHduName(const std::string& hdu_name) {
+  if (m_fptr != nullptr) {
+    throw Elements::Exception() << "The HDU name must be set before writing to " << m_filename;
+  }
+  m_hdu_name = hdu_name;
+}
+
+void FitsTableWriter::createTable(const std::vector<Row>& rows) {
+  int status = 0;
+  if (m_override_file || !boost::filesystem::exists(m_filename)) {
+    // The '!' prefix tells cfitsio to replace an existing file
+    fits_create_file(&m_fptr, ("!" + m_filename).c_str(), &status);
+  } else {
+    fits_open_file(&m_fptr, m_filename.c_str(), READWRITE, &status);
+  }
+  checkStatus(status, m_filename, "Can't open the output catalog");
+
+  auto column_info = rows.front().getColumnInfo();
+  std::vector<std::string> tforms, units;
+  std::vector<char*> ttype_ptrs, tform_ptrs, tunit_ptrs;
+
+  for (std::size_t i = 0; i < column_info->size(); ++i) {
+    m_columns.emplace_back(createColumnWriter(rows, i));
+    tforms.emplace_back(m_columns.back()->getTForm());
+    units.emplace_back(column_info->getDescription(i).unit);
+  }
+  for (std::size_t i = 0; i < m_columns.size(); ++i) {
+    ttype_ptrs.emplace_back(const_cast<char*>(m_columns[i]->getName().c_str()));
+    tform_ptrs.emplace_back(const_cast<char*>(tforms[i].c_str()));
+    tunit_ptrs.emplace_back(const_cast<char*>(units[i].c_str()));
+  }
+
+  // Appended at the end of the file, after a default primary HDU if the file is new
+  fits_create_tbl(m_fptr, BINARY_TBL, 0, m_columns.size(), ttype_ptrs.data(), tform_ptrs.data(),
+                  tunit_ptrs.data(), m_hdu_name.empty() ? nullptr : m_hdu_name.c_str(), &status);
+  checkStatus(status, m_filename, "Can't create the catalog table");
+
+  for (std::size_t i = 0; i < m_columns.size(); ++i) {
+    auto tdim = m_columns[i]->getTDim();
+    if (!tdim.empty()) {
+      fits_write_tdim(m_fptr, i + 1, tdim.size(), tdim.data(), &status);
+    }
+    const auto& description = column_info->getDescription(i).description;
+    if (!description.empty()) {
+      std::string keyword = "TTYPE" + std::to_string(i + 1);
+      fits_modify_comment(m_fptr, keyword.c_str(), description.c_str(), &status);
+    }
+  }
+  checkStatus(status, m_filename, "Can't write the column headers");
+}
+
+void FitsTableWriter::addRows(const std::vector<Row>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+  if (m_fptr == nullptr) {
+    createTable(rows);
+  }
+
+  // cfitsio writes in place when the block fits in its buffers, so columns are written
+  // for as many rows as it recommends at a time
+  int status = 0;
+  long chunk_size = 0;
+  fits_get_rowsize(m_fptr, &chunk_size, &status);
+  checkStatus(status, m_filename, "Can't get the optimal number of rows");
+  chunk_size = std::max(chunk_size, 1l);
+
+  for (std::size_t begin = 0; begin < rows.size(); begin += chunk_size) {
+    std::size_t end = std::min(rows.size(), begin + chunk_size);
+    for (std::size_t c = 0; c < m_columns.size(); ++c) {
+      m_columns[c]->write(m_fptr, c + 1, m_row_count + begin + 1, rows, begin, end, &status);
+    }
+    checkStatus(status, m_filename, "Can't write the catalog rows");
+  }
+  m_row_count += rows.size();
+
+  // Update NAXIS2 and flush the buffers so the file is consistent between blocks
+  fits_flush_file(m_fptr, &status);
+  checkStatus(status, m_filename, "Can't flush the output catalog");
+}
+
+void FitsTableWriter::close() {
+  if (m_fptr != nullptr) {
+    int status = 0;
+    fits_close_file(m_fptr, &status);
+    m_fptr = nullptr;
+    checkStatus(status, m_filename, "Can't close the output catalog");
+  }
+}
+
+}  // namespace SourceXtractor
@@ -0,0 +1,90 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * IdRenumbering.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+
+#include "ElementsKernel/Exception.h"
+
+#include "SEImplementation/Output/IdRenumbering.h"
+
+using Euclid::Table::Row;
+
+namespace SourceXtractor {
+
+IdRenumbering::IdRenumbering(const std::vector<std::string>& columns) : m_columns(columns) {
+  for (auto& column : m_columns) {
+    m_offsets[column] = 0;
+    m_max_ids[column] = 0;
+  }
+}
+
+void IdRenumbering::nextShard() {
+  for (auto& column : m_columns) {
+    m_offsets[column] += m_max_ids[column];
+    m_max_ids[column] = 0;
+  }
+}
+
+void IdRenumbering::updateMaxId(const std::string& column, std::int64_t id) {
+  auto& max_id = m_max_ids.at(column);
+  max_id = std::max(max_id, id);
+}
+
+std::int64_t IdRenumbering::getOffset(const std::string& column) const {
+  return m_offsets.at(column);
+}
+
+Row IdRenumbering::apply(const Row& row) {
+  auto column_info = row.getColumnInfo();
+  std::vector<Row::cell_type> cells;
+  cells.reserve(row.size());
+  for (std::size_t i = 0; i < row.size(); ++i) {
+    cells.emplace_back(row[i]);
+  }
+  for (auto& column : m_columns) {
+    auto index = column_info->find(column);
+    if (!index) {
+      continue;
+    }
+    auto id = getId(cells[*index], column);
+    updateMaxId(column, id);
+    if (boost::get<std::int32_t>(&cells[*index])) {
+      cells[*index] = static_cast<std::int32_t>(id + m_offsets[column]);
+    }
+    else {
+      cells[*index] = id + m_offsets[column];
+    }
+  }
+  return Row(std::move(cells), column_info);
+}
+
+std::int64_t IdRenumbering::getId(const Row::cell_type& cell, const std::string& column) {
+  if (auto value = boost::get<std::int32_t>(&cell)) {
+    return *value;
+  }
+  if (auto value = boost::get<std::int64_t>(&cell)) {
+    return *value;
+  }
+  throw Elements::Exception() << "The id column " << column << " is not an integer column";
+}
+
+} /* namespace SourceXtractor */
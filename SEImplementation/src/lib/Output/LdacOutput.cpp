@@ -125,7 +125,7 @@ void LdacOutput::outputSource(const SourceInterface& source) {
 
     writeHeaders();
 
-    m_fits_writer = std::make_shared<FitsWriter>(m_filename);
+    m_fits_writer = std::make_shared<FitsTableWriter>(m_filename);
 
 
     if (m_part_nb >= 1) {
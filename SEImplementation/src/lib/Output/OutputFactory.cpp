@@ -27,18 +27,36 @@
 
 #include "SEFramework/Output/OutputRegistry.h"
 
+#include "SEImplementation/Configuration/CheckpointConfig.h"
 #include "SEImplementation/Configuration/DetectionImageConfig.h"
+#include "SEImplementation/Configuration/ShardConfig.h"
 
 #include "SEImplementation/Output/AsciiOutput.h"
+#include "SEImplementation/Output/CheckpointOutput.h"
 #include "SEImplementation/Output/FitsOutput.h"
 #include "SEImplementation/Output/LdacOutput.h"
 #include "SEImplementation/Output/OutputFactory.h"
+#include "SEImplementation/Output/ShardOutput.h"
 
 using Euclid::make_unique;
 
 namespace SourceXtractor {
 
 std::shared_ptr<Output> OutputFactory::createOutput() const {
+  auto file_output = createFileOutput();
+  std::shared_ptr<Output> output = file_output;
+  if (m_checkpoint) {
+    output = std::make_shared<CheckpointOutput>(file_output,
+                                                m_output_registry->getSourceToRowConverter(m_output_properties),
+                                                m_checkpoint, m_checkpoint_interval);
+  }
+  if (m_shard_enabled) {
+    return std::make_shared<ShardOutput>(output, m_shard_core_region, m_shard_margin);
+  }
+  return output;
+}
+
+std::shared_ptr<FlushableOutput> OutputFactory::createFileOutput() const {
   auto source_to_row = m_output_registry->getSourceToRowConverter(m_output_properties);
 
   if (m_output_filename != "") {
@@ -58,6 +76,8 @@ std::shared_ptr<Output> OutputFactory::createOutput() const {
 
 void OutputFactory::reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const {
   manager.registerConfiguration<OutputConfig>();
+  manager.registerConfiguration<ShardConfig>();
+  manager.registerConfiguration<CheckpointConfig>();
 }
 
 void OutputFactory::configure(Euclid::Configuration::ConfigManager& manager) {
@@ -67,6 +87,15 @@ void OutputFactory::configure(Euclid::Configuration::ConfigManager& manager) {
   m_output_filename = output_config.getOutputFile();
   m_output_format = output_config.getOutputFileFormat();
 
+  auto& shard_config = manager.getConfiguration<ShardConfig>();
+  m_shard_enabled = shard_config.isEnabled();
+  m_shard_core_region = shard_config.getCoreRegion();
+  m_shard_margin = shard_config.getMargin();
+
+  auto& checkpoint_config = manager.getConfiguration<CheckpointConfig>();
+  m_checkpoint = checkpoint_config.getCheckpoint();
+  m_checkpoint_interval = checkpoint_config.getInterval();
+
   if (m_output_filename != "") {
     // Check if we can, at least, create it.
     // Otherwise, the error will be triggered only at the end of the full process!
@@ -0,0 +1,75 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ShardOutput.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cmath>
+
+#include "ElementsKernel/Logging.h"
+
+#include "SEImplementation/Plugin/DetectionFrameInfo/DetectionFrameInfo.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
+#include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
+
+#include "SEImplementation/Output/ShardOutput.h"
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("ShardOutput");
+
+ShardOutput::ShardOutput(std::shared_ptr<Output> output, const PixelRectangle& core_region, int margin)
+  : m_output(std::move(output)), m_core_region(core_region), m_margin(margin),
+    m_truncated(0), m_reported_truncated(0) {}
+
+void ShardOutput::outputSource(const SourceInterface& source) {
+  const auto& centroid = source.getProperty<PixelCentroid>();
+  // Pixel centers are at integer coordinates
+  int x = static_cast<int>(std::floor(centroid.getCentroidX() + 0.5));
+  int y = static_cast<int>(std::floor(centroid.getCentroidY() + 0.5));
+
+  auto core_min = m_core_region.getTopLeft(), core_max = m_core_region.getBottomRight();
+  if (x < core_min.m_x || x > core_max.m_x || y < core_min.m_y || y > core_max.m_y) {
+    return;
+  }
+
+  // Edges of the processed region that are not edges of the image
+  const auto& frame_info = source.getProperty<DetectionFrameInfo>();
+  const auto& boundaries = source.getProperty<PixelBoundaries>();
+  int min_x = core_min.m_x - m_margin, min_y = core_min.m_y - m_margin;
+  int max_x = core_max.m_x + m_margin, max_y = core_max.m_y + m_margin;
+  if ((min_x > 0 && boundaries.getMin().m_x <= min_x) || (min_y > 0 && boundaries.getMin().m_y <= min_y) ||
+      (max_x < frame_info.getWidth() - 1 && boundaries.getMax().m_x >= max_x) ||
+      (max_y < frame_info.getHeight() - 1 && boundaries.getMax().m_y >= max_y)) {
+    ++m_truncated;
+  }
+
+  m_output->outputSource(source);
+}
+
+size_t ShardOutput::flush() {
+  if (m_truncated > m_reported_truncated) {
+    logger.warn() << m_truncated << " sources owned by the shard reach the end of the margin,"
+                  << " their measurements may differ from a single run. Consider a larger --shard-margin";
+    m_reported_truncated = m_truncated;
+  }
+  return m_output->flush();
+}
+
+} /* namespace SourceXtractor */
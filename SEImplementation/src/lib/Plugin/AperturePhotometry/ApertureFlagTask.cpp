@@ -71,10 +71,11 @@ void ApertureFlagTask::computeProperties(SourceInterface &source) const {
   source.setProperty<ApertureFlag>(all_flags);
 
   // draw check image for all apertures
-  auto aperture_check_img = CheckImages::getInstance().getDetectionApertureImage(detection_frame_info.getHduIndex());
+  unsigned int src_id = source.getProperty<SourceID>().getId();
+  auto aperture_check_img = CheckImages::getInstance().getDetectionApertureImage(
+      detection_frame_info.getHduIndex(), src_id);
   if (aperture_check_img) {
 	  for (auto aperture_diameter : m_apertures) {
-		  unsigned int src_id = source.getProperty<SourceID>().getId();
 		  auto aperture = std::make_shared<CircularAperture>(aperture_diameter / 2.);
 		  drawAperture<int>(aperture, centroid_x, centroid_y, aperture_check_img, static_cast<unsigned>(src_id));
 	  }
@@ -19,16 +19,43 @@
  * @author Alejandro Alvarez Ayllon
  */
 
+#include <boost/algorithm/string.hpp>
+
+#include "ElementsKernel/Exception.h"
 #include "SEImplementation/Plugin/AperturePhotometry/AperturePhotometryConfig.h"
 #include "SEImplementation/Configuration/PythonConfig.h"
 
+namespace po = boost::program_options;
+
 namespace SourceXtractor {
 
-AperturePhotometryConfig::AperturePhotometryConfig(long manager_id): Configuration(manager_id) {
+static const std::string APERTURE_OVERLAP {"aperture-overlap"};
+
+static const std::string APERTURE_OVERLAP_SAMPLED {"SAMPLED"};
+static const std::string APERTURE_OVERLAP_EXACT {"EXACT"};
+
+AperturePhotometryConfig::AperturePhotometryConfig(long manager_id): Configuration(manager_id),
+                                                                      m_overlap(ApertureOverlap::SAMPLED) {
   declareDependency<PythonConfig>();
 }
 
-void AperturePhotometryConfig::initialize(const Euclid::Configuration::Configuration::UserValues& /*args*/) {
+auto AperturePhotometryConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Aperture photometry", {
+      {APERTURE_OVERLAP.c_str(), po::value<std::string>()->default_value(APERTURE_OVERLAP_SAMPLED),
+          "Pixel coverage of the apertures [sampled|exact]. Exact computes the geometric overlap with each pixel"},
+  }}};
+}
+
+void AperturePhotometryConfig::initialize(const Euclid::Configuration::Configuration::UserValues& args) {
+  auto overlap_name = boost::to_upper_copy(args.at(APERTURE_OVERLAP).as<std::string>());
+  if (overlap_name == APERTURE_OVERLAP_SAMPLED) {
+    m_overlap = ApertureOverlap::SAMPLED;
+  } else if (overlap_name == APERTURE_OVERLAP_EXACT) {
+    m_overlap = ApertureOverlap::EXACT;
+  } else {
+    throw Elements::Exception() << "Unknown aperture overlap : " << overlap_name;
+  }
+
   auto& py = getDependency<PythonConfig>().getInterpreter();
 
   // Used to get the image corresponding to a given aperture ID
@@ -71,7 +71,7 @@ void AperturePhotometryTask::computeProperties(SourceInterface &source) const {
 
   for (auto aperture_diameter : m_apertures) {
     auto aperture = std::make_shared<TransformedAperture>(
-      std::make_shared<CircularAperture>(aperture_diameter / 2.),
+      std::make_shared<CircularAperture>(aperture_diameter / 2., m_overlap),
       jacobian.asTuple()
     );
 
@@ -114,9 +114,9 @@ void AperturePhotometryTask::computeProperties(SourceInterface &source) const {
   source.setIndexedProperty<AperturePhotometry>(m_instance, fluxes, fluxes_error, mags, mags_error, flags);
 
   // draw the apertures onto the checkimage
-  auto aperture_check_img = CheckImages::getInstance().getMeasurementApertureImage(m_instance);
+  auto src_id = source.getProperty<SourceID>().getId();
+  auto aperture_check_img = CheckImages::getInstance().getMeasurementApertureImage(m_instance, src_id);
   if (aperture_check_img) {
-    auto src_id = source.getProperty<SourceID>().getId();
     for (auto aperture_diameter : m_apertures) {
     	auto aperture = std::make_shared<TransformedAperture>(std::make_shared<CircularAperture>(aperture_diameter / 2.),
     			jacobian.asTuple());
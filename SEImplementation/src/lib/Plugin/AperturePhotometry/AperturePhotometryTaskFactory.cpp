@@ -48,7 +48,8 @@ std::shared_ptr<Task> AperturePhotometryTaskFactory::createTask(const PropertyId
       m_aperture_config.at(instance),
       instance,
       m_magnitude_zero_point,
-      m_symmetry_usage
+      m_symmetry_usage,
+      m_overlap
     );
   } else if (property_id.getTypeId() == typeid(AperturePhotometryArray)) {
     return std::make_shared<AperturePhotometryArrayTask>(
@@ -101,6 +102,7 @@ void AperturePhotometryTaskFactory::configure(Euclid::Configuration::ConfigManag
   m_aperture_config = aperture_config.getApertures();
   m_magnitude_zero_point = manager.getConfiguration<MagnitudeConfig>().getMagnitudeZeroPoint();
   m_symmetry_usage = manager.getConfiguration<WeightImageConfig>().symmetryUsage();
+  m_overlap = aperture_config.getOverlap();
 
   for (unsigned int i = 0; i < image_infos.size(); ++i) {
     for (auto a : aperture_config.getAperturesForImage(image_infos[i].m_id)) {
@@ -17,6 +17,7 @@
 
 #include <map>
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 #include <fstream>
 
 #include <CCfits/CCfits>
@@ -34,6 +35,7 @@
 #include "SEImplementation/Plugin/AssocMode/AssocModePartitionStep.h"
 
 #include "SEImplementation/Plugin/AssocMode/AssocModeConfig.h"
+#include "SEImplementation/Plugin/AssocMode/AssocSkyIndex.h"
 
 using namespace Euclid::Configuration;
 namespace po = boost::program_options;
@@ -52,11 +54,18 @@ static const std::string ASSOC_COORD_TYPE { "assoc-coord-type" };
 static const std::string ASSOC_SOURCE_SIZES { "assoc-source-sizes" };
 static const std::string ASSOC_DEFAULT_PIXEL_SIZE { "assoc-default-pixel-size" };
 static const std::string ASSOC_GROUP_ID { "assoc-group-id" };
+static const std::string ASSOC_MATCH_RADIUS { "assoc-match-radius" };
+static const std::string ASSOC_INDEX { "assoc-index" };
+static const std::string ASSOC_INDEX_CELL_SIZE { "assoc-index-cell-size" };
+static const std::string ASSOC_STREAMING { "assoc-streaming" };
 static const std::string ASSOC_CONFIG { "assoc-config" };
 static const std::string ASSOC_TEST { "assoc-test" };
 
 namespace {
 
+// Number of rows read at once when building an assoc index
+const long INDEX_CHUNK_ROWS = 100000;
+
 const std::map<std::string, AssocModeConfig::AssocMode> assoc_mode_table {
   std::make_pair("", AssocModeConfig::AssocMode::UNKNOWN),
   std::make_pair("FIRST", AssocModeConfig::AssocMode::FIRST),
@@ -103,7 +112,8 @@ std::vector<int> parseColumnList(const std::string& arg) {
 }
 
 AssocModeConfig::AssocModeConfig(long manager_id) : Configuration(manager_id), m_assoc_mode(AssocMode::UNKNOWN),
-    m_assoc_radius(0.), m_default_pixel_size(10), m_pixel_size_column(-1), m_group_id_column(-1) {
+    m_assoc_radius(0.), m_default_pixel_size(10), m_pixel_size_column(-1), m_group_id_column(-1),
+    m_match_radius_column(-1), m_index_cell_size(1.), m_streaming(false) {
   declareDependency<DetectionImageConfig>();
   declareDependency<PartitionStepConfig>();
 
@@ -133,6 +143,14 @@ std::map<std::string, Configuration::OptionDescriptionList> AssocModeConfig::get
           "Default source size (in reference frame pixels)"},
       {ASSOC_GROUP_ID.c_str(), po::value<int>()->default_value(-1),
           "Column containing the group id"},
+      {ASSOC_MATCH_RADIUS.c_str(), po::value<int>()->default_value(-1),
+          "Column containing the match radius of each entry (in pixels of the detection image)"},
+      {ASSOC_INDEX.c_str(), po::value<std::string>(),
+          "Sky index of the assoc catalog, built from the assoc catalog if it does not exist (WORLD coordinates only)"},
+      {ASSOC_INDEX_CELL_SIZE.c_str(), po::value<double>()->default_value(1.0),
+          "Size of the cells of a new assoc index (in degrees)"},
+      {ASSOC_STREAMING.c_str(), po::bool_switch(),
+          "Segment the assoc catalog sorted by row, releasing the groups progressively"},
       {ASSOC_CONFIG.c_str(), po::value<std::string>(),
           "Text file containing the assoc columns configuration"},
       {ASSOC_TEST.c_str(), po::bool_switch(),
@@ -155,9 +173,13 @@ void AssocModeConfig::initialize(const UserValues& args) {
   // sanity check that the configuration is coherent
 
   // read the catalogs
-  if (m_filename != "") {
+  if (m_filename != "" || m_index_filename != "") {
     checkConfig();
-    readCatalogs(m_filename, m_columns, m_assoc_coord_type);
+    if (m_index_filename != "") {
+      readIndex();
+    } else {
+      readCatalogs(m_filename, m_columns, m_assoc_coord_type);
+    }
 
     if (args.at(ASSOC_TEST).as<bool>()) {
       printConfig();
@@ -202,6 +224,12 @@ void AssocModeConfig::readCommonConfig(const UserValues& args) {
   if (args.find(ASSOC_CATALOG) != args.end()) {
     m_filename = args.at(ASSOC_CATALOG).as<std::string>();
   }
+
+  if (args.find(ASSOC_INDEX) != args.end()) {
+    m_index_filename = args.at(ASSOC_INDEX).as<std::string>();
+  }
+  m_index_cell_size = args.at(ASSOC_INDEX_CELL_SIZE).as<double>();
+  m_streaming = args.at(ASSOC_STREAMING).as<bool>();
 }
 
 void AssocModeConfig::readConfigFromParams(const UserValues& args) {
@@ -210,6 +238,7 @@ void AssocModeConfig::readConfigFromParams(const UserValues& args) {
 
   m_pixel_size_column = args.at(ASSOC_SOURCE_SIZES).as<int>() - 1; // config uses 1 as first column
   m_group_id_column = args.at(ASSOC_GROUP_ID).as<int>() - 1; // config uses 1 as first column
+  m_match_radius_column = args.at(ASSOC_MATCH_RADIUS).as<int>() - 1; // config uses 1 as first column
 
   m_assoc_coord_type = getCoordinateType(args);
 }
@@ -262,6 +291,11 @@ void AssocModeConfig::readConfigFromFile(const std::string& filename) {
     m_assoc_columns.erase("group_id");
   }
 
+  if (m_assoc_columns.find("match_radius") != m_assoc_columns.end()) {
+    m_match_radius_column = m_assoc_columns.at("match_radius");
+    m_assoc_columns.erase("match_radius");
+  }
+
   for (auto& column_info : m_assoc_columns) {
     m_custom_column_names.push_back(column_info.first);
     m_columns_idx.push_back(column_info.second);
@@ -300,16 +334,19 @@ AssocModeConfig::AssocCoordType AssocModeConfig::getCoordinateType(const UserVal
   return assoc_coord_type;
 }
 
+std::shared_ptr<Euclid::Table::TableReader> AssocModeConfig::openCatalog(const std::string& filename) {
+  try {
+    return std::make_shared<Euclid::Table::FitsReader>(filename);
+  } catch (...) {
+    // If FITS not successful try reading as ascii
+    return std::make_shared<Euclid::Table::AsciiReader>(filename);
+  }
+}
+
 void AssocModeConfig::readCatalogs(const std::string& filename,
     const std::vector<int>& columns, AssocCoordType assoc_coord_type) {
   try {
-    std::shared_ptr<Euclid::Table::TableReader> reader;
-    try {
-      reader = std::make_shared<Euclid::Table::FitsReader>(filename);
-    } catch (...) {
-      // If FITS not successful try reading as ascii
-      reader = std::make_shared<Euclid::Table::AsciiReader>(filename);
-    }
+    auto reader = openCatalog(filename);
     auto table = reader->read();
 
     size_t exts_nb = getDependency<DetectionImageConfig>().getExtensionsNb();
@@ -333,6 +370,64 @@ void AssocModeConfig::readCatalogs(const std::string& filename,
   }
 }
 
+void AssocModeConfig::buildIndex() {
+  logger.info() << "Building the assoc index " << m_index_filename << " from " << m_filename;
+  try {
+    auto reader = openCatalog(m_filename);
+    AssocSkyIndex::Builder builder(m_index_filename, m_index_cell_size, m_columns_idx.size());
+    // Only a chunk of the catalog is in memory at any time
+    while (reader->hasMoreRows()) {
+      for (auto& entry : readTable(reader->read(INDEX_CHUNK_ROWS), m_columns, m_columns_idx, true)) {
+        builder.add(entry);
+      }
+    }
+    builder.finish();
+  } catch (const std::exception& e) {
+    throw Elements::Exception() << "Can't build the assoc index " << m_index_filename
+                                << " from " << m_filename << " (" << e.what() << ")";
+  }
+}
+
+void AssocModeConfig::readIndex() {
+  if (m_assoc_coord_type != AssocCoordType::WORLD) {
+    throw Elements::Exception() << "The assoc index requires WORLD coordinates";
+  }
+  if (!boost::filesystem::exists(m_index_filename)) {
+    if (m_filename == "") {
+      throw Elements::Exception() << "The assoc index does not exist and there is no assoc catalog to build it: "
+                                  << m_index_filename;
+    }
+    buildIndex();
+  }
+
+  AssocSkyIndex index(m_index_filename);
+  if (index.getAssocColumnsNb() != m_columns_idx.size()) {
+    throw Elements::Exception() << "The assoc index " << m_index_filename << " has " << index.getAssocColumnsNb()
+                                << " assoc columns, but " << m_columns_idx.size() << " are configured";
+  }
+
+  size_t exts_nb = getDependency<DetectionImageConfig>().getExtensionsNb();
+  if (exts_nb == 0) {
+    // No detection image
+    m_catalogs.emplace_back(index.readAll());
+    return;
+  }
+
+  // Only the cells that overlap each detection image are read, with a margin for the match radius and
+  // for the entries whose source radius reaches into the image
+  double margin = std::max(m_assoc_radius, index.getMaxMatchRadius()) + index.getMaxSourceRadius();
+  for (size_t i = 0; i < exts_nb; i++) {
+    auto coordinate_system = getDependency<DetectionImageConfig>().getCoordinateSystem(i);
+    auto image = getDependency<DetectionImageConfig>().getDetectionImage(i);
+    if (coordinate_system == nullptr) {
+      throw Elements::Exception() << "The assoc index requires detection images with a coordinate system";
+    }
+    m_catalogs.emplace_back(index.query(*coordinate_system, image->getWidth(), image->getHeight(), margin));
+    logger.info() << "Read " << m_catalogs.back().size() << " of " << index.getEntriesNb()
+                  << " entries from the assoc index for detection image " << i;
+  }
+}
+
 std::vector<AssocModeConfig::CatalogEntry> AssocModeConfig::readTable(
     const Euclid::Table::Table& table, const std::vector<int>& columns,
     const std::vector<int>& copy_columns, bool use_world, std::shared_ptr<CoordinateSystem> coordinate_system) {
@@ -361,7 +456,7 @@ std::vector<AssocModeConfig::CatalogEntry> AssocModeConfig::readTable(
         world_coord = coordinate_system->imageToWorld(coord);
       }
     }
-    catalog.emplace_back(CatalogEntry { coord, world_coord, 1.0, {}, 1.0, 0 });
+    catalog.emplace_back(CatalogEntry { coord, world_coord, 1.0, {}, 1.0, 0, 0. });
     if (columns.size() == 3 && columns.at(2) >= 0) {
       catalog.back().weight = boost::apply_visitor(CastVisitor<double>{}, row[columns.at(2)]);
     }
@@ -386,6 +481,10 @@ std::vector<AssocModeConfig::CatalogEntry> AssocModeConfig::readTable(
       catalog.back().group_id = boost::apply_visitor(CastVisitor<int64_t>{}, row[m_group_id_column]);
     }
 
+    if (m_match_radius_column >= 0) {
+      catalog.back().match_radius = boost::apply_visitor(CastVisitor<double>{}, row[m_match_radius_column]);
+    }
+
     if (m_pixel_size_column >= 0) {
       catalog.back().source_radius_pixels = boost::apply_visitor(CastVisitor<double>{}, row[m_pixel_size_column]);
     } else {
@@ -399,7 +498,7 @@ std::map<std::string, unsigned int>  AssocModeConfig::parseConfigFile(const std:
     std::map<std::string, unsigned int> columns;
 
     const std::vector<std::string> reserved_names {
-      "x", "y", "ra", "dec", "weight", "group_id", "source_radius_pixel"
+      "x", "y", "ra", "dec", "weight", "group_id", "source_radius_pixel", "match_radius"
     };
 
     std::ifstream config_file(filename);
@@ -147,9 +147,16 @@ AssocModeConfig::CatalogEntry getAssocEntryMagSumImpl(const std::vector<AssocMod
 
 AssocModeTask::AssocModeTask(const std::vector<std::vector<AssocModeConfig::CatalogEntry>>& catalogs,
                              AssocModeConfig::AssocMode assoc_mode, double radius) :
-                             m_assoc_mode(assoc_mode), m_radius(radius) {
+                             m_assoc_mode(assoc_mode), m_radius(radius), m_max_radius(radius),
+                             m_has_match_radius(false) {
   for (auto& catalog : catalogs) {
     m_catalogs.emplace_back(catalog);
+    for (auto& entry : catalog) {
+      if (entry.match_radius > 0) {
+        m_has_match_radius = true;
+        m_max_radius = std::max(m_max_radius, entry.match_radius);
+      }
+    }
   }
 }
 
@@ -164,7 +171,18 @@ void AssocModeTask::computeProperties(SourceInterface &source) const {
   auto hdu_index = source.getProperty<DetectionFrameInfo>().getHduIndex();
   const auto& catalog = m_catalogs.at(hdu_index);
 
-  auto nearby_catalog_entries = catalog.findPointsWithinRadius(Tree::Coord { x, y }, m_radius);
+  auto nearby_catalog_entries = catalog.findPointsWithinRadius(Tree::Coord { x, y }, m_max_radius);
+
+  if (m_has_match_radius) {
+    // Entries with their own match radius
+    nearby_catalog_entries.erase(std::remove_if(nearby_catalog_entries.begin(), nearby_catalog_entries.end(),
+        [this, x, y](const AssocModeConfig::CatalogEntry& entry) {
+          double radius = entry.match_radius > 0 ? entry.match_radius : m_radius;
+          auto dx = entry.coord.m_x - x;
+          auto dy = entry.coord.m_y - y;
+          return dx * dx + dy * dy > radius * radius;
+        }), nearby_catalog_entries.end());
+  }
 
   if (nearby_catalog_entries.size() == 0) {
     // No match
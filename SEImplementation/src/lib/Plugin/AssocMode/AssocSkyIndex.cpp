@@ -0,0 +1,369 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * AssocSkyIndex.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "ElementsKernel/Exception.h"
+
+#include "SEImplementation/Plugin/AssocMode/AssocSkyIndex.h"
+
+namespace SourceXtractor {
+
+namespace {
+
+const char INDEX_MAGIC[8] = {'S', 'E', 'A', 'S', 'S', 'O', 'C', '2'};
+
+// Layout of the records, followed by the assoc columns
+enum RecordField {
+  RECORD_RA = 0, RECORD_DEC, RECORD_WEIGHT, RECORD_SOURCE_RADIUS, RECORD_MATCH_RADIUS, RECORD_GROUP_ID,
+  RECORD_FIXED_FIELDS
+};
+
+// Memory used to sort the spooled entries by cell before writing them to the index
+const std::size_t BUILD_BUFFER_BYTES = 64 * 1024 * 1024;
+
+// Number of records read at once from the index
+const std::uint64_t READ_CHUNK_RECORDS = 64 * 1024;
+
+// Number of points sampled along each side of the image to find its footprint
+const int FOOTPRINT_STEPS = 32;
+
+constexpr double DEG_TO_RAD = M_PI / 180.;
+
+/// First cell of each declination zone, plus the total number of cells at the end
+std::vector<std::uint64_t> computeZones(double cell_size) {
+  if (!(cell_size > 0 && cell_size <= 180)) {
+    throw Elements::Exception() << "Invalid assoc index cell size: " << cell_size;
+  }
+  auto zones_nb = static_cast<std::size_t>(std::ceil(180. / cell_size));
+  std::vector<std::uint64_t> zones{0};
+  for (std::size_t z = 0; z < zones_nb; ++z) {
+    double dec_low = -90. + z * cell_size, dec_high = std::min(90., dec_low + cell_size);
+    // The widest parallel of the zone sets the number of cells
+    double min_abs_dec = (dec_low <= 0 && dec_high >= 0) ? 0. : std::min(std::abs(dec_low), std::abs(dec_high));
+    auto ra_cells = static_cast<std::uint64_t>(std::ceil(360. * std::cos(min_abs_dec * DEG_TO_RAD) / cell_size));
+    zones.push_back(zones.back() + std::max<std::uint64_t>(ra_cells, 1));
+  }
+  return zones;
+}
+
+std::size_t getZone(const std::vector<std::uint64_t>& zones, double cell_size, double dec) {
+  auto z = static_cast<long>(std::floor((dec + 90.) / cell_size));
+  return static_cast<std::size_t>(std::max(0l, std::min(z, static_cast<long>(zones.size()) - 2)));
+}
+
+double normalizeRa(double ra) {
+  ra = std::fmod(ra, 360.);
+  return ra < 0 ? ra + 360. : ra;
+}
+
+/// Index of the cell within the zone
+std::uint64_t getRaCell(const std::vector<std::uint64_t>& zones, std::size_t zone, double ra) {
+  auto ra_cells = zones[zone + 1] - zones[zone];
+  auto c = static_cast<std::uint64_t>(normalizeRa(ra) / 360. * ra_cells);
+  return std::min(c, ra_cells - 1);
+}
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void readValue(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+AssocSkyIndex::CatalogEntry makeEntry(const double* record, std::size_t assoc_columns_nb) {
+  AssocSkyIndex::CatalogEntry entry;
+  entry.world_coord = WorldCoordinate(record[RECORD_RA], record[RECORD_DEC]);
+  entry.weight = record[RECORD_WEIGHT];
+  entry.assoc_columns.assign(record + RECORD_FIXED_FIELDS, record + RECORD_FIXED_FIELDS + assoc_columns_nb);
+  entry.source_radius_pixels = record[RECORD_SOURCE_RADIUS];
+  entry.group_id = static_cast<unsigned int>(record[RECORD_GROUP_ID]);
+  entry.match_radius = record[RECORD_MATCH_RADIUS];
+  return entry;
+}
+
+}  // end of anonymous namespace
+
+AssocSkyIndex::Builder::Builder(const std::string& path, double cell_size, std::size_t assoc_columns_nb)
+  : m_path(path), m_tmp_path(path + ".tmp"), m_cell_size(cell_size), m_assoc_columns_nb(assoc_columns_nb),
+    m_zones(computeZones(cell_size)), m_counts(m_zones.back(), 0), m_max_match_radius(0),
+    m_max_source_radius(0),
+    m_tmp(m_tmp_path, std::ios::binary | std::ios::trunc), m_record(RECORD_FIXED_FIELDS + assoc_columns_nb) {
+  if (!m_tmp) {
+    throw Elements::Exception() << "Can't create the temporary assoc index file: " << m_tmp_path;
+  }
+}
+
+AssocSkyIndex::Builder::~Builder() {
+  if (m_tmp.is_open()) {
+    m_tmp.close();
+  }
+  std::remove(m_tmp_path.c_str());
+}
+
+void AssocSkyIndex::Builder::add(const CatalogEntry& entry) {
+  if (entry.assoc_columns.size() != m_assoc_columns_nb) {
+    throw Elements::Exception() << "Wrong number of assoc columns for the assoc index";
+  }
+  if (!std::isfinite(entry.world_coord.m_alpha) || !std::isfinite(entry.world_coord.m_delta)) {
+    throw Elements::Exception() << "Invalid coordinates in the assoc catalog";
+  }
+
+  auto zone = getZone(m_zones, m_cell_size, entry.world_coord.m_delta);
+  std::uint64_t cell = m_zones[zone] + getRaCell(m_zones, zone, entry.world_coord.m_alpha);
+
+  m_record[RECORD_RA] = normalizeRa(entry.world_coord.m_alpha);
+  m_record[RECORD_DEC] = entry.world_coord.m_delta;
+  m_record[RECORD_WEIGHT] = entry.weight;
+  m_record[RECORD_SOURCE_RADIUS] = entry.source_radius_pixels;
+  m_record[RECORD_MATCH_RADIUS] = entry.match_radius;
+  m_record[RECORD_GROUP_ID] = entry.group_id;
+  std::copy(entry.assoc_columns.begin(), entry.assoc_columns.end(), m_record.begin() + RECORD_FIXED_FIELDS);
+
+  writeValue(m_tmp, cell);
+  m_tmp.write(reinterpret_cast<const char*>(m_record.data()), m_record.size() * sizeof(double));
+  ++m_counts[cell];
+  m_max_match_radius = std::max(m_max_match_radius, entry.match_radius);
+  m_max_source_radius = std::max(m_max_source_radius, entry.source_radius_pixels);
+}
+
+void AssocSkyIndex::Builder::finish() {
+  m_tmp.close();
+  if (m_tmp.fail()) {
+    throw Elements::Exception() << "Failed to write the temporary assoc index file: " << m_tmp_path;
+  }
+
+  std::uint64_t cells_nb = m_counts.size();
+  std::vector<std::uint64_t> offsets(cells_nb + 1, 0);
+  for (std::uint64_t c = 0; c < cells_nb; ++c) {
+    offsets[c + 1] = offsets[c] + m_counts[c];
+  }
+
+  std::ofstream out(m_path, std::ios::binary | std::ios::trunc);
+  out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+  writeValue(out, static_cast<std::uint64_t>(m_assoc_columns_nb));
+  writeValue(out, m_cell_size);
+  writeValue(out, m_max_match_radius);
+  writeValue(out, m_max_source_radius);
+  writeValue(out, cells_nb);
+  out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+  std::uint64_t data_offset = out.tellp();
+
+  // Scatter the spooled records into their cells, buffering as many as allowed
+  std::size_t record_size = RECORD_FIXED_FIELDS + m_assoc_columns_nb;
+  std::size_t record_bytes = record_size * sizeof(double);
+  std::vector<std::vector<double>> buffers(cells_nb);
+  std::vector<std::uint64_t> written(cells_nb, 0);
+  std::size_t buffered_bytes = 0;
+
+  auto flush_buffers = [&]() {
+    for (std::uint64_t c = 0; c < cells_nb; ++c) {
+      if (buffers[c].empty()) {
+        continue;
+      }
+      out.seekp(data_offset + (offsets[c] + written[c]) * record_bytes);
+      out.write(reinterpret_cast<const char*>(buffers[c].data()), buffers[c].size() * sizeof(double));
+      written[c] += buffers[c].size() / record_size;
+      std::vector<double>().swap(buffers[c]);
+    }
+    buffered_bytes = 0;
+  };
+
+  std::ifstream in(m_tmp_path, std::ios::binary);
+  std::uint64_t cell;
+  while (readValue(in, cell), in.read(reinterpret_cast<char*>(m_record.data()), record_bytes)) {
+    buffers[cell].insert(buffers[cell].end(), m_record.begin(), m_record.end());
+    buffered_bytes += record_bytes;
+    if (buffered_bytes >= BUILD_BUFFER_BYTES) {
+      flush_buffers();
+    }
+  }
+  flush_buffers();
+
+  out.close();
+  if (out.fail()) {
+    throw Elements::Exception() << "Failed to write the assoc index: " << m_path;
+  }
+}
+
+AssocSkyIndex::AssocSkyIndex(const std::string& path) : m_path(path) {
+  std::ifstream in(m_path, std::ios::binary);
+  char magic[sizeof(INDEX_MAGIC)];
+  in.read(magic, sizeof(magic));
+  if (!in || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0) {
+    throw Elements::Exception() << "Not an assoc index: " << m_path;
+  }
+
+  std::uint64_t assoc_columns_nb, cells_nb;
+  readValue(in, assoc_columns_nb);
+  readValue(in, m_cell_size);
+  readValue(in, m_max_match_radius);
+  readValue(in, m_max_source_radius);
+  readValue(in, cells_nb);
+  m_assoc_columns_nb = assoc_columns_nb;
+
+  m_zones = computeZones(m_cell_size);
+  if (!in || m_zones.back() != cells_nb) {
+    throw Elements::Exception() << "Corrupted assoc index: " << m_path;
+  }
+  m_offsets.resize(cells_nb + 1);
+  in.read(reinterpret_cast<char*>(m_offsets.data()), m_offsets.size() * sizeof(std::uint64_t));
+  if (!in) {
+    throw Elements::Exception() << "Corrupted assoc index: " << m_path;
+  }
+  m_data_offset = in.tellg();
+}
+
+void AssocSkyIndex::readRecords(std::ifstream& file, std::uint64_t first, std::uint64_t last,
+                                const std::function<void(const double*)>& callback) const {
+  std::size_t record_size = RECORD_FIXED_FIELDS + m_assoc_columns_nb;
+  std::vector<double> buffer;
+  file.seekg(m_data_offset + first * record_size * sizeof(double));
+  while (first < last) {
+    auto n = std::min(last - first, READ_CHUNK_RECORDS);
+    buffer.resize(n * record_size);
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(double))) {
+      throw Elements::Exception() << "Failed to read the assoc index: " << m_path;
+    }
+    for (std::uint64_t i = 0; i < n; ++i) {
+      callback(buffer.data() + i * record_size);
+    }
+    first += n;
+  }
+}
+
+std::vector<AssocSkyIndex::CatalogEntry> AssocSkyIndex::query(const CoordinateSystem& coordinate_system,
+                                                              int width, int height, double margin) const {
+  double min_x = -margin, min_y = -margin, max_x = width + margin, max_y = height + margin;
+  auto inside = [&](const ImageCoordinate& c) {
+    return c.m_x >= min_x && c.m_x <= max_x && c.m_y >= min_y && c.m_y <= max_y;
+  };
+
+  // The extrema of the coordinates are on the border of the footprint, unless it contains a pole
+  auto center = coordinate_system.imageToWorld(ImageCoordinate((min_x + max_x) / 2., (min_y + max_y) / 2.));
+  double dec_min = center.m_delta, dec_max = center.m_delta;
+  double dra_min = 0, dra_max = 0;
+  auto add_point = [&](double x, double y) {
+    try {
+      auto w = coordinate_system.imageToWorld(ImageCoordinate(x, y));
+      dec_min = std::min(dec_min, w.m_delta);
+      dec_max = std::max(dec_max, w.m_delta);
+      double dra = std::fmod(w.m_alpha - center.m_alpha + 540., 360.) - 180.;
+      dra_min = std::min(dra_min, dra);
+      dra_max = std::max(dra_max, dra);
+    }
+    catch (const InvalidCoordinatesException&) {
+    }
+  };
+  for (int i = 0; i <= FOOTPRINT_STEPS; ++i) {
+    double x = min_x + (max_x - min_x) * i / FOOTPRINT_STEPS;
+    double y = min_y + (max_y - min_y) * i / FOOTPRINT_STEPS;
+    add_point(x, min_y);
+    add_point(x, max_y);
+    add_point(min_x, y);
+    add_point(max_x, y);
+  }
+
+  bool full_ra = dra_max - dra_min >= 180.;
+  for (double pole : {-90., 90.}) {
+    try {
+      if (inside(coordinate_system.worldToImage(WorldCoordinate(0., pole)))) {
+        (pole < 0 ? dec_min : dec_max) = pole;
+        full_ra = true;
+      }
+    }
+    catch (const InvalidCoordinatesException&) {
+    }
+  }
+
+  // Right ascension intervals, within [0, 360)
+  std::vector<std::pair<double, double>> ra_ranges;
+  if (full_ra) {
+    ra_ranges.emplace_back(0., 360.);
+  }
+  else {
+    double ra_start = normalizeRa(center.m_alpha + dra_min), ra_end = ra_start + (dra_max - dra_min);
+    if (ra_end < 360.) {
+      ra_ranges.emplace_back(ra_start, ra_end);
+    }
+    else {
+      ra_ranges.emplace_back(ra_start, 360.);
+      ra_ranges.emplace_back(0., ra_end - 360.);
+    }
+  }
+
+  std::vector<CatalogEntry> entries;
+  std::ifstream file(m_path, std::ios::binary);
+  auto add_entry = [&](const double* record) {
+    auto entry = makeEntry(record, m_assoc_columns_nb);
+    try {
+      entry.coord = coordinate_system.worldToImage(entry.world_coord);
+    }
+    catch (const InvalidCoordinatesException&) {
+      return;
+    }
+    if (inside(entry.coord)) {
+      entries.emplace_back(std::move(entry));
+    }
+  };
+
+  auto zone_min = getZone(m_zones, m_cell_size, dec_min), zone_max = getZone(m_zones, m_cell_size, dec_max);
+  for (auto zone = zone_min; zone <= zone_max; ++zone) {
+    // Near the poles both sides of a wrapped range may fall on the same cells
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> cell_ranges;
+    for (auto& ra_range : ra_ranges) {
+      auto first_cell = getRaCell(m_zones, zone, ra_range.first);
+      auto last_cell = ra_range.second >= 360. ? m_zones[zone + 1] - m_zones[zone] - 1
+                                               : getRaCell(m_zones, zone, ra_range.second);
+      cell_ranges.emplace_back(first_cell, last_cell);
+    }
+    std::sort(cell_ranges.begin(), cell_ranges.end());
+    if (cell_ranges.size() > 1 && cell_ranges[1].first <= cell_ranges[0].second + 1) {
+      cell_ranges[0].second = std::max(cell_ranges[0].second, cell_ranges[1].second);
+      cell_ranges.pop_back();
+    }
+
+    // Cells of a zone are contiguous in the file, so each range is read at once
+    for (auto& cell_range : cell_ranges) {
+      readRecords(file, m_offsets[m_zones[zone] + cell_range.first], m_offsets[m_zones[zone] + cell_range.second + 1],
+                  add_entry);
+    }
+  }
+  return entries;
+}
+
+std::vector<AssocSkyIndex::CatalogEntry> AssocSkyIndex::readAll() const {
+  std::vector<CatalogEntry> entries;
+  std::ifstream file(m_path, std::ios::binary);
+  readRecords(file, 0, getEntriesNb(), [&](const double* record) {
+    entries.emplace_back(makeEntry(record, m_assoc_columns_nb));
+  });
+  return entries;
+}
+
+}  // namespace SourceXtractor
@@ -21,6 +21,9 @@
  *      Author: mkuemmel@usm.lmu.de
  */
 
+#include <boost/algorithm/string.hpp>
+
+#include "ElementsKernel/Exception.h"
 #include "SEUtils/Types.h"
 
 #include "Configuration/ProgramOptionsHelper.h"
@@ -34,18 +37,33 @@ namespace SourceXtractor {
 namespace {
 const std::string AUTO_KRON_FACTOR {"auto-kron-factor"};
 const std::string AUTO_KRON_MINRAD {"auto-kron-min-radius"};
+const std::string AUTO_OVERLAP {"auto-overlap"};
+
+const std::string AUTO_OVERLAP_SAMPLED {"SAMPLED"};
+const std::string AUTO_OVERLAP_EXACT {"EXACT"};
 }
 
 auto AutoPhotometryConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
   return {{"Auto (Kron) photometry options", {
       {AUTO_KRON_FACTOR.c_str(), po::value<double>()->default_value(2.5), "Scale factor for AUTO (Kron) photometry"},
       {AUTO_KRON_MINRAD.c_str(), po::value<double>()->default_value(3.5), "Minimum radius for AUTO (Kron) photometry"},
+      {AUTO_OVERLAP.c_str(), po::value<std::string>()->default_value(AUTO_OVERLAP_SAMPLED),
+          "Pixel coverage of the AUTO (Kron) aperture [sampled|exact]. Sampled only uses the pixel center"},
   }}};
 }
 
 void AutoPhotometryConfig::initialize(const UserValues& args) {
   m_kron_factor = SeFloat(args.at(AUTO_KRON_FACTOR).as<double>());;
   m_kron_minrad = SeFloat(args.at(AUTO_KRON_MINRAD).as<double>());;
+
+  auto overlap_name = boost::to_upper_copy(args.at(AUTO_OVERLAP).as<std::string>());
+  if (overlap_name == AUTO_OVERLAP_SAMPLED) {
+    m_overlap = ApertureOverlap::SAMPLED;
+  } else if (overlap_name == AUTO_OVERLAP_EXACT) {
+    m_overlap = ApertureOverlap::EXACT;
+  } else {
+    throw Elements::Exception() << "Unknown AUTO aperture overlap : " << overlap_name;
+  }
 }
 
 SeFloat AutoPhotometryConfig::getAutoKronFactor() const {
@@ -54,5 +72,8 @@ SeFloat AutoPhotometryConfig::getAutoKronFactor() const {
 SeFloat AutoPhotometryConfig::getAutoKronMinrad() const {
   return m_kron_minrad;
 }
+ApertureOverlap AutoPhotometryConfig::getAutoOverlap() const {
+  return m_overlap;
+}
 
 } // SourceXtractor namespace
@@ -82,9 +82,10 @@ void AutoPhotometryFlagTask::computeProperties(SourceInterface& source) const {
   source.setProperty<AutoPhotometryFlag>(global_flag);
 
   // Draw the aperture
-  auto aperture_check_img = CheckImages::getInstance().getDetectionAutoApertureImage(detection_frame_info.getHduIndex());
+  auto src_id = source.getProperty<SourceID>().getId();
+  auto aperture_check_img = CheckImages::getInstance().getDetectionAutoApertureImage(
+      detection_frame_info.getHduIndex(), src_id);
   if (aperture_check_img) {
-    auto src_id = source.getProperty<SourceID>().getId();
     drawAperture<int>(ell_aper, centroid_x, centroid_y, aperture_check_img, src_id);
   }
 }
@@ -74,7 +74,7 @@ void AutoPhotometryTask::computeProperties(SourceInterface &source) const {
 
   // create the elliptical aperture
   auto ell_aper = std::make_shared<TransformedAperture>(
-    std::make_shared<EllipticalAperture>(cxx, cyy, cxy, kron_radius_auto),
+    std::make_shared<EllipticalAperture>(cxx, cyy, cxy, kron_radius_auto, m_overlap),
     jacobian.asTuple());
 
   auto measurement = measureFlux(ell_aper, centroid_x, centroid_y, measurement_image, variance_map, variance_threshold,
@@ -97,10 +97,9 @@ void AutoPhotometryTask::computeProperties(SourceInterface &source) const {
   source.setIndexedProperty<AutoPhotometry>(m_instance, measurement.m_flux, flux_error, mag, mag_error, measurement.m_flags);
 
   // Draw the aperture
-  auto aperture_check_img = CheckImages::getInstance().getMeasurementAutoApertureImage(m_instance);
+  auto src_id = source.getProperty<SourceID>().getId();
+  auto aperture_check_img = CheckImages::getInstance().getMeasurementAutoApertureImage(m_instance, src_id);
   if (aperture_check_img) {
-    auto src_id = source.getProperty<SourceID>().getId();
-
     drawAperture<int>(ell_aper, centroid_x, centroid_y, aperture_check_img, static_cast<unsigned>(src_id));
   }
 }
@@ -45,7 +45,7 @@
 namespace SourceXtractor {
 
 AutoPhotometryTaskFactory::AutoPhotometryTaskFactory() : m_magnitude_zero_point(0), m_kron_factor(0), m_kron_minrad(0),
-                                                         m_symmetry_usage(false) {}
+                                                         m_symmetry_usage(false), m_overlap(ApertureOverlap::SAMPLED) {}
 
 void AutoPhotometryTaskFactory::reportConfigDependencies(Euclid::Configuration::ConfigManager &manager) const {
   manager.registerConfiguration<MagnitudeConfig>();
@@ -60,6 +60,7 @@ void AutoPhotometryTaskFactory::configure(Euclid::Configuration::ConfigManager &
   m_kron_factor = manager.getConfiguration<AutoPhotometryConfig>().getAutoKronFactor();
   m_kron_minrad = manager.getConfiguration<AutoPhotometryConfig>().getAutoKronMinrad();
   m_symmetry_usage = manager.getConfiguration<WeightImageConfig>().symmetryUsage();
+  m_overlap = manager.getConfiguration<AutoPhotometryConfig>().getAutoOverlap();
 
   auto& measurement_config = manager.getConfiguration<MeasurementImageConfig>();
   const auto& image_infos = measurement_config.getImageInfos();
@@ -79,7 +80,7 @@ void AutoPhotometryTaskFactory::registerPropertyInstances(SourceXtractor::Output
 std::shared_ptr<Task> AutoPhotometryTaskFactory::createTask(const PropertyId &property_id) const {
   if (property_id.getTypeId() == typeid(AutoPhotometry)) {
     return std::make_shared<AutoPhotometryTask>(property_id.getIndex(), m_magnitude_zero_point, m_kron_factor,
-                                                m_kron_minrad, m_symmetry_usage);
+                                                m_kron_minrad, m_symmetry_usage, m_overlap);
   } else if (property_id == PropertyId::create<AutoPhotometryFlag>()) {
     return std::make_shared<AutoPhotometryFlagTask>(m_kron_factor, m_kron_minrad);
   } else if (property_id == PropertyId::create<AutoPhotometryArray>()) {
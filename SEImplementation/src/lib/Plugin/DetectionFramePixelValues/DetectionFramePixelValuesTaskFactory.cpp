@@ -22,6 +22,8 @@
 
 #include "Configuration/ConfigManager.h"
 
+#include "SEImplementation/Property/PixelCoordinateList.h"
+#include "SEImplementation/Plugin/DetectionFrameSourceStamp/DetectionFrameSourceStamp.h"
 #include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValues.h"
 #include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValuesTask.h"
 #include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValuesTaskFactory.h"
@@ -38,6 +40,14 @@ std::shared_ptr<Task> DetectionFramePixelValuesTaskFactory::createTask(const Pro
   }
 }
 
+std::set<PropertyId> DetectionFramePixelValuesTaskFactory::getRequiredProperties(const PropertyId& property_id) const {
+  if (property_id == PropertyId::create<DetectionFramePixelValues>()) {
+    return {PropertyId::create<PixelCoordinateList>(), PropertyId::create<DetectionFrameSourceStamp>()};
+  } else {
+    return {};
+  }
+}
+
 } // SEImplementation namespace
 
 
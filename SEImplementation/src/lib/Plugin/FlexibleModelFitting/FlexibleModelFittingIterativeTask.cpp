@@ -35,6 +35,7 @@
 #include "SEImplementation/Plugin/MeasurementFrameInfo/MeasurementFrameInfo.h"
 #include "SEImplementation/Plugin/Jacobian/Jacobian.h"
 #include "SEImplementation/Plugin/SourcePsf/SourcePsfProperty.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceID.h"
 
 #include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFitting.h"
 #include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingParameterManager.h"
@@ -612,7 +613,8 @@ void FlexibleModelFittingIterativeTask::updateCheckImages(SourceGroupInterface&
         auto frame_model = createFrameModel(src, pixel_scale, parameter_manager, frame, stamp_rect);
         auto final_stamp = frame_model.getImage();
 
-        auto debug_image = CheckImages::getInstance().getModelFittingImage(frame_index);
+        auto debug_image = CheckImages::getInstance().getModelFittingImage(
+            frame_index, src.getProperty<SourceID>().getId());
         if (debug_image) {
           ImageAccessor<SeFloat> debugAccessor(debug_image);
           for (int x = 0; x < final_stamp->getWidth(); x++) {
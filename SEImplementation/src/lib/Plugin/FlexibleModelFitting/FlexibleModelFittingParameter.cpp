@@ -22,6 +22,7 @@
  */
 
 #include <iostream>
+#include <map>
 
 #include <boost/version.hpp>
 #if BOOST_VERSION >= 106700
@@ -135,6 +136,23 @@ std::shared_ptr<ModelFitting::BasicParameter> createDependentParameterHelper(
 }
 
 
+FlexibleModelFittingDependentParameter::FlexibleModelFittingDependentParameter(
+    int id, ValueFunc value_calculator, std::vector<std::shared_ptr<FlexibleModelFittingParameter>> parameters,
+    BatchValueFunc batch_value_calculator)
+  : FlexibleModelFittingParameter(id), m_value_calculator(value_calculator),
+    m_batch_value_calculator(batch_value_calculator), m_parameters(parameters) {
+  if (!m_batch_value_calculator) {
+    m_batch_value_calculator = [value_calculator](const std::shared_ptr<CoordinateSystem>& cs,
+                                                  const std::vector<std::vector<double>>& params,
+                                                  std::vector<double>& out) {
+      out.resize(params.size());
+      for (size_t i = 0; i < params.size(); ++i) {
+        out[i] = value_calculator(cs, params[i]);
+      }
+    };
+  }
+}
+
 std::shared_ptr<ModelFitting::BasicParameter> FlexibleModelFittingDependentParameter::create(
                                                             FlexibleModelFittingParameterManager& parameter_manager,
                                                             ModelFitting::EngineParameterManager&,
@@ -186,20 +204,44 @@ std::vector<double> FlexibleModelFittingDependentParameter::getPartialDerivative
   std::vector<double> result(param_values.size());
   auto cs = source.getProperty<ReferenceCoordinates>().getCoordinateSystem();
 
-  for (unsigned int i = 0; i < result.size(); i++) {
-
-    auto f = [&](double x) {
-        auto params = param_values;
-        params[i] = x;
-        return m_value_calculator(cs, params);
-    };
-
+  auto derivative = [](const std::function<double(double)>& f, double x) {
 #if BOOST_VERSION >= 106700
-    result[i] = bmd::finite_difference_derivative(f, param_values[i]);
+    return bmd::finite_difference_derivative(f, x);
 #else
     // if boost's function is unavailable use our own function
-    result[i] = NumericalDerivative::centralDifference(f, param_values[i]);
+    return NumericalDerivative::centralDifference(f, x);
 #endif
+  };
+
+  // The points at which the derivatives sample the function only depend on the parameter values,
+  // so a first pass collects them, and they are evaluated in a single batch
+  std::vector<std::map<double, double>> samples(param_values.size());
+  for (unsigned int i = 0; i < result.size(); i++) {
+    derivative([&samples, i](double x) {
+      samples[i].emplace(x, 0.);
+      return 0.;
+    }, param_values[i]);
+  }
+
+  std::vector<std::vector<double>> batch;
+  for (unsigned int i = 0; i < result.size(); i++) {
+    for (auto& sample : samples[i]) {
+      batch.emplace_back(param_values);
+      batch.back()[i] = sample.first;
+    }
+  }
+
+  std::vector<double> values;
+  m_batch_value_calculator(cs, batch, values);
+
+  auto value_i = values.begin();
+  for (unsigned int i = 0; i < result.size(); i++) {
+    for (auto& sample : samples[i]) {
+      sample.second = *value_i++;
+    }
+    result[i] = derivative([&samples, i](double x) {
+      return samples[i].at(x);
+    }, param_values[i]);
   }
 
   return result;
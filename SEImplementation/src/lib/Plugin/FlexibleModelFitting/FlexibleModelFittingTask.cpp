@@ -52,6 +52,7 @@
 #include "SEImplementation/Plugin/MeasurementFrameGroupRectangle/MeasurementFrameGroupRectangle.h"
 #include "SEImplementation/Plugin/Jacobian/Jacobian.h"
 #include "SEImplementation/Plugin/DetectionFrameCoordinates/DetectionFrameCoordinates.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceID.h"
 
 #include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFitting.h"
 #include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingParameterManager.h"
@@ -354,7 +355,8 @@ void FlexibleModelFittingTask::updateCheckImages(SourceGroupInterface& group,
 
       auto stamp_rect = group.getProperty<MeasurementFrameGroupRectangle>(frame_index);
 
-      auto debug_image = CheckImages::getInstance().getModelFittingImage(frame_index);
+      auto debug_image = CheckImages::getInstance().getModelFittingImage(
+          frame_index, group.cbegin()->getProperty<SourceID>().getId());
       if (debug_image) {
         ImageAccessor<SeFloat> debugAccessor(debug_image);
         for (int x = 0; x < final_stamp->getWidth(); x++) {
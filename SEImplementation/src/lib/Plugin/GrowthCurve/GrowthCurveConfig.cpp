@@ -16,6 +16,8 @@
  */
 
 #include <boost/program_options.hpp>
+#include <boost/algorithm/string.hpp>
+#include "ElementsKernel/Exception.h"
 #include "SEImplementation/Plugin/GrowthCurve/GrowthCurveConfig.h"
 
 namespace po = boost::program_options;
@@ -24,12 +26,18 @@ using namespace Euclid::Configuration;
 namespace SourceXtractor {
 
 const static std::string GROWTH_NSAMPLES{"flux-growth-samples"};
+const static std::string GROWTH_OVERLAP{"flux-growth-overlap"};
+
+const static std::string GROWTH_OVERLAP_SAMPLED{"SAMPLED"};
+const static std::string GROWTH_OVERLAP_EXACT{"EXACT"};
 
 GrowthCurveConfig::GrowthCurveConfig(long managerId) : Configuration(managerId) {}
 
 auto GrowthCurveConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
   return {{"Growth curve", {
-    {GROWTH_NSAMPLES.c_str(), po::value<int>()->default_value(64), "Number of samples to take from the growth curve"}
+    {GROWTH_NSAMPLES.c_str(), po::value<int>()->default_value(64), "Number of samples to take from the growth curve"},
+    {GROWTH_OVERLAP.c_str(), po::value<std::string>()->default_value(GROWTH_OVERLAP_SAMPLED),
+     "Pixel coverage of the growth curve apertures [sampled|exact]"}
   }}};
 }
 
@@ -40,6 +48,14 @@ void GrowthCurveConfig::initialize(const Configuration::UserValues& args) {
       throw Elements::Exception() << GROWTH_NSAMPLES << " must be greater than 0";
     }
   }
+  auto overlap_name = boost::to_upper_copy(args.at(GROWTH_OVERLAP).as<std::string>());
+  if (overlap_name == GROWTH_OVERLAP_SAMPLED) {
+    m_overlap = ApertureOverlap::SAMPLED;
+  } else if (overlap_name == GROWTH_OVERLAP_EXACT) {
+    m_overlap = ApertureOverlap::EXACT;
+  } else {
+    throw Elements::Exception() << "Unknown growth curve overlap : " << overlap_name;
+  }
 }
 
 } // end of namespace SourceXtractor
@@ -60,8 +60,8 @@ static SeFloat getPixelValue(int x, int y, SeFloat centroid_x, SeFloat centroid_
   return pixel_value;
 }
 
-GrowthCurveTask::GrowthCurveTask(unsigned instance, bool use_symmetry)
-  : m_instance{instance}, m_use_symmetry{use_symmetry} {}
+GrowthCurveTask::GrowthCurveTask(unsigned instance, bool use_symmetry, ApertureOverlap overlap)
+  : m_instance{instance}, m_use_symmetry{use_symmetry}, m_overlap{overlap} {}
 
 void GrowthCurveTask::computeProperties(SourceInterface& source) const {
   const auto& measurement_frame_info = source.getProperty<MeasurementFrameInfo>(m_instance);
@@ -99,7 +99,7 @@ void GrowthCurveTask::computeProperties(SourceInterface& source) const {
   std::vector<double> fluxes(GROWTH_NSAMPLES);
   apertures.reserve(GROWTH_NSAMPLES);
   for (size_t step = 1; step <= GROWTH_NSAMPLES; ++step) {
-    apertures.emplace_back(step_size * step);
+    apertures.emplace_back(step_size * step, m_overlap);
   }
 
   // Boundaries for the computation
@@ -28,7 +28,7 @@ namespace SourceXtractor {
 
 std::shared_ptr<Task> GrowthCurveTaskFactory::createTask(const PropertyId& property_id) const {
   if (property_id.getTypeId() == typeid(GrowthCurve)) {
-    return std::make_shared<GrowthCurveTask>(property_id.getIndex(), m_use_symmetry);
+    return std::make_shared<GrowthCurveTask>(property_id.getIndex(), m_use_symmetry, m_overlap);
   }
   else if (property_id.getTypeId() == typeid(GrowthCurveResampled)) {
     return std::make_shared<GrowthCurveResampledTask>(m_images, m_nsamples);
@@ -45,6 +45,7 @@ void GrowthCurveTaskFactory::reportConfigDependencies(Euclid::Configuration::Con
 void GrowthCurveTaskFactory::configure(Euclid::Configuration::ConfigManager& manager) {
   m_nsamples = manager.getConfiguration<GrowthCurveConfig>().m_nsamples;
   m_use_symmetry = manager.getConfiguration<WeightImageConfig>().symmetryUsage();
+  m_overlap = manager.getConfiguration<GrowthCurveConfig>().getOverlap();
 
   auto& measurement_config = manager.getConfiguration<MeasurementImageConfig>();
   const auto& image_infos = measurement_config.getImageInfos();
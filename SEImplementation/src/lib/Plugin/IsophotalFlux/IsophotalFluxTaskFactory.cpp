@@ -23,6 +23,8 @@
 
 #include "SEImplementation/Configuration/MagnitudeConfig.h"
 
+#include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValues.h"
+#include "SEImplementation/Plugin/DetectionFrameInfo/DetectionFrameInfo.h"
 #include "SEImplementation/Plugin/IsophotalFlux/IsophotalFlux.h"
 #include "SEImplementation/Plugin/IsophotalFlux/IsophotalFluxTask.h"
 #include "SEImplementation/Plugin/IsophotalFlux/IsophotalFluxTaskFactory.h"
@@ -45,6 +47,14 @@ std::shared_ptr<Task> IsophotalFluxTaskFactory::createTask(const PropertyId& pro
   }
 }
 
+std::set<PropertyId> IsophotalFluxTaskFactory::getRequiredProperties(const PropertyId& property_id) const {
+  if (property_id == PropertyId::create<IsophotalFlux>()) {
+    return {PropertyId::create<DetectionFrameInfo>(), PropertyId::create<DetectionFramePixelValues>()};
+  } else {
+    return {};
+  }
+}
+
 }
 
 
@@ -21,6 +21,8 @@
  *      Author: Alejandro Alvarez Ayllon
  */
 
+#include "SEFramework/Task/CopyPropertyTask.h"
+#include "SEImplementation/Configuration/MeasurementImageConfig.h"
 #include "SEImplementation/Plugin/Jacobian/JacobianTaskFactory.h"
 #include "SEImplementation/Plugin/Jacobian/JacobianTask.h"
 #include "SEImplementation/Plugin/Jacobian/Jacobian.h"
@@ -28,13 +30,31 @@
 namespace SourceXtractor {
 
 std::shared_ptr<Task> JacobianTaskFactory::createTask(const SourceXtractor::PropertyId &property_id) const {
+  auto instance = property_id.getIndex();
+  auto reference = m_geometry_references.find(instance);
+  bool copy = reference != m_geometry_references.end();
+
   if (property_id.getTypeId() == typeid(JacobianGroup)) {
-    return std::make_shared<JacobianGroupTask>(property_id.getIndex());
+    if (copy) {
+      return std::make_shared<CopyGroupPropertyTask<JacobianGroup>>(instance, reference->second);
+    }
+    return std::make_shared<JacobianGroupTask>(instance);
   }
   else if (property_id.getTypeId() == typeid(JacobianSource)) {
-    return std::make_shared<JacobianSourceTask>(property_id.getIndex());
+    if (copy) {
+      return std::make_shared<CopySourcePropertyTask<JacobianSource>>(instance, reference->second);
+    }
+    return std::make_shared<JacobianSourceTask>(instance);
   }
   return nullptr;
 }
 
+void JacobianTaskFactory::reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const {
+  manager.registerConfiguration<MeasurementImageConfig>();
+}
+
+void JacobianTaskFactory::configure(Euclid::Configuration::ConfigManager& manager) {
+  m_geometry_references = manager.getConfiguration<MeasurementImageConfig>().getGeometryReferences();
+}
+
 } // end SourceXtractor
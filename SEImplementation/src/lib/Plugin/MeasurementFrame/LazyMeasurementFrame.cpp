@@ -0,0 +1,175 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * LazyMeasurementFrame.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ElementsKernel/Logging.h"
+
+#include "SEFramework/Pipeline/Tracer.h"
+
+#include "SEImplementation/Plugin/MeasurementFrame/LazyMeasurementFrame.h"
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("MeasurementFrame");
+
+std::size_t LazyMeasurementFrame::LoadedFrames::getLoadedCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_frames.size();
+}
+
+void LazyMeasurementFrame::LoadedFrames::touch(LazyMeasurementFrame* frame) {
+  // The frame mutexes are only taken after this one, and never held for long, so the victims can be unloaded
+  // here, before they can be listed again or destroyed
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // It may have been unloaded since it was returned
+  if (!frame->isLoaded()) {
+    return;
+  }
+
+  if (frame->m_listed) {
+    m_frames.splice(m_frames.begin(), m_frames, frame->m_list_position);
+  }
+  else {
+    frame->m_list_position = m_frames.insert(m_frames.begin(), frame);
+    frame->m_listed = true;
+  }
+
+  while (m_max_loaded > 0 && m_frames.size() > m_max_loaded) {
+    auto victim = m_frames.back();
+    victim->m_listed = false;
+    m_frames.pop_back();
+    victim->unload();
+  }
+}
+
+void LazyMeasurementFrame::LoadedFrames::remove(LazyMeasurementFrame* frame) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (frame->m_listed) {
+    m_frames.erase(frame->m_list_position);
+    frame->m_listed = false;
+  }
+}
+
+LazyMeasurementFrame::LazyMeasurementFrame(int width, int height,
+                                           std::shared_ptr<CoordinateSystem> coordinate_system,
+                                           SeFloat gain, SeFloat saturation, Builder builder,
+                                           std::shared_ptr<LoadedFrames> loaded_frames)
+  : m_width(width), m_height(height), m_coordinate_system(std::move(coordinate_system)),
+    m_gain(gain), m_saturation(saturation), m_builder(std::move(builder)),
+    m_loaded_frames(std::move(loaded_frames)), m_building(false), m_variance_threshold(0), m_background_rms(0),
+    m_load_count(0), m_listed(false) {}
+
+LazyMeasurementFrame::LazyMeasurementFrame(std::shared_ptr<MeasurementImageFrame> frame)
+  : m_width(frame->getOriginalImage()->getWidth()), m_height(frame->getOriginalImage()->getHeight()),
+    m_coordinate_system(frame->getCoordinateSystem()), m_gain(frame->getGain()),
+    m_saturation(frame->getSaturation()), m_building(false), m_frame(frame),
+    m_variance_threshold(frame->getVarianceThreshold()), m_background_rms(frame->getBackgroundMedianRms()),
+    m_load_count(1), m_listed(false) {}
+
+LazyMeasurementFrame::~LazyMeasurementFrame() {
+  if (m_loaded_frames) {
+    m_loaded_frames->remove(this);
+  }
+}
+
+std::shared_ptr<MeasurementImageFrame> LazyMeasurementFrame::getFrame() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_built.wait(lock, [this]() { return !m_building; });
+
+  // The sources may still hold the frame after it was unloaded
+  if (!m_frame) {
+    m_frame = m_unloaded_frame.lock();
+  }
+
+  auto frame = m_frame;
+  if (!frame) {
+    m_building = true;
+    lock.unlock();
+    try {
+      Tracer::Scope scope("measurement", "Load measurement frame");
+      frame = m_builder();
+    }
+    catch (...) {
+      lock.lock();
+      m_building = false;
+      m_built.notify_all();
+      throw;
+    }
+    lock.lock();
+
+    m_frame = frame;
+    m_variance_threshold = frame->getVarianceThreshold();
+    m_background_rms = frame->getBackgroundMedianRms();
+    ++m_load_count;
+    m_building = false;
+    m_built.notify_all();
+    logger.debug() << "Loaded the measurement frame " << frame->getLabel() << (m_load_count > 1 ? " again" : "");
+  }
+  lock.unlock();
+
+  // The list locks the frame mutexes, so ours must not be held
+  if (m_loaded_frames && m_builder) {
+    m_loaded_frames->touch(this);
+  }
+  return frame;
+}
+
+WeightImage::PixelType LazyMeasurementFrame::getVarianceThreshold() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_load_count > 0) {
+      return m_variance_threshold;
+    }
+  }
+  return getFrame()->getVarianceThreshold();
+}
+
+SeFloat LazyMeasurementFrame::getBackgroundMedianRms() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_load_count > 0) {
+      return m_background_rms;
+    }
+  }
+  return getFrame()->getBackgroundMedianRms();
+}
+
+bool LazyMeasurementFrame::isLoaded() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_frame != nullptr;
+}
+
+int LazyMeasurementFrame::getLoadCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_load_count;
+}
+
+void LazyMeasurementFrame::unload() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_builder && m_frame) {
+    m_unloaded_frame = m_frame;
+    m_frame.reset();
+  }
+}
+
+} // namespace SourceXtractor
@@ -23,7 +23,7 @@
 namespace SourceXtractor {
 
 void MeasurementFrameCoordinatesTask::computeProperties(SourceInterface& source) const {
-  auto coordinate_system = source.getProperty<MeasurementFrame>(m_instance).getFrame()->getCoordinateSystem();
+  auto coordinate_system = source.getProperty<MeasurementFrame>(m_instance).getLazyFrame()->getCoordinateSystem();
   source.setIndexedProperty<MeasurementFrameCoordinates>(m_instance, coordinate_system);
 }
 
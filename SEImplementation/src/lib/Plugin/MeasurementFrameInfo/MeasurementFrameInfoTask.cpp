@@ -24,13 +24,9 @@
 namespace SourceXtractor {
 
 void MeasurementFrameInfoTask::computeProperties(SourceInterface& source) const {
-  auto frame = source.getProperty<MeasurementFrame>(m_instance).getFrame();
-  auto width = frame->getOriginalImage()->getWidth();
-  auto height = frame->getOriginalImage()->getHeight();
-
-  source.setIndexedProperty<MeasurementFrameInfo>(m_instance, width, height,
-      frame->getGain(), frame->getSaturation(),
-      frame->getVarianceThreshold(), frame->getBackgroundMedianRms());
+  // The noise figures are only read from the frame, building it, when a measurement asks for them
+  auto frame = source.getProperty<MeasurementFrame>(m_instance).getLazyFrame();
+  source.setIndexedProperty<MeasurementFrameInfo>(m_instance, frame);
 }
 
 } // SEImplementation namespace
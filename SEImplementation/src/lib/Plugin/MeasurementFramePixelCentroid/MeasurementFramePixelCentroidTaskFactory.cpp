@@ -21,6 +21,8 @@
  *      Author: mschefer
  */
 
+#include "SEFramework/Task/CopyPropertyTask.h"
+#include "SEImplementation/Configuration/MeasurementImageConfig.h"
 #include "SEImplementation/Plugin/MeasurementFramePixelCentroid/MeasurementFramePixelCentroid.h"
 #include "SEImplementation/Plugin/MeasurementFramePixelCentroid/MeasurementFramePixelCentroidTask.h"
 #include "SEImplementation/Plugin/MeasurementFramePixelCentroid/MeasurementFramePixelCentroidTaskFactory.h"
@@ -29,10 +31,24 @@ namespace SourceXtractor {
 
 std::shared_ptr<Task> MeasurementFramePixelCentroidTaskFactory::createTask(const PropertyId& property_id) const {
   if (property_id.getTypeId() == PropertyId::create<MeasurementFramePixelCentroid>().getTypeId()) {
-    return std::make_shared<MeasurementFramePixelCentroidTask>(property_id.getIndex());
+    auto instance = property_id.getIndex();
+    auto reference = m_geometry_references.find(instance);
+    if (reference != m_geometry_references.end()) {
+      return std::make_shared<CopySourcePropertyTask<MeasurementFramePixelCentroid>>(instance, reference->second);
+    }
+    return std::make_shared<MeasurementFramePixelCentroidTask>(instance);
   } else {
     return nullptr;
   }
 }
 
+void MeasurementFramePixelCentroidTaskFactory::reportConfigDependencies(
+    Euclid::Configuration::ConfigManager& manager) const {
+  manager.registerConfiguration<MeasurementImageConfig>();
+}
+
+void MeasurementFramePixelCentroidTaskFactory::configure(Euclid::Configuration::ConfigManager& manager) {
+  m_geometry_references = manager.getConfiguration<MeasurementImageConfig>().getGeometryReferences();
+}
+
 }
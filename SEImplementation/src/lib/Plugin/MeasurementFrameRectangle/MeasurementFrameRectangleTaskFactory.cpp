@@ -23,7 +23,9 @@
 
 #include <iostream>
 
+#include "SEFramework/Task/CopyPropertyTask.h"
 #include "SEImplementation/Configuration/DetectionFrameConfig.h"
+#include "SEImplementation/Configuration/MeasurementImageConfig.h"
 
 #include "SEImplementation/Plugin/MeasurementFrameRectangle/MeasurementFrameRectangle.h"
 #include "SEImplementation/Plugin/MeasurementFrameRectangle/MeasurementFrameRectangleTask.h"
@@ -35,6 +37,10 @@ namespace SourceXtractor {
 
 std::shared_ptr<Task> MeasurementFrameRectangleTaskFactory::createTask(const PropertyId& property_id) const {
   auto instance = property_id.getIndex();
+  auto reference = m_geometry_references.find(instance);
+  if (reference != m_geometry_references.end()) {
+    return std::make_shared<CopySourcePropertyTask<MeasurementFrameRectangle>>(instance, reference->second);
+  }
   if (m_no_detection_image) {
     return std::make_shared<MeasurementFrameRectangleTaskNoDetect>(instance);
   } else {
@@ -45,10 +51,12 @@ std::shared_ptr<Task> MeasurementFrameRectangleTaskFactory::createTask(const Pro
 
 void MeasurementFrameRectangleTaskFactory::reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const {
   manager.registerConfiguration<DetectionFrameConfig>();
+  manager.registerConfiguration<MeasurementImageConfig>();
 }
 
 void MeasurementFrameRectangleTaskFactory::configure(Euclid::Configuration::ConfigManager& manager) {
   m_no_detection_image = manager.getConfiguration<DetectionFrameConfig>().getDetectionFrames().size() == 0;
+  m_geometry_references = manager.getConfiguration<MeasurementImageConfig>().getGeometryReferences();
 }
 
 
@@ -20,6 +20,9 @@
  * @author mschefer
  */
 
+#include "SEImplementation/Property/PixelCoordinateList.h"
+#include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValues.h"
+#include "SEImplementation/Plugin/PeakValue/PeakValue.h"
 #include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
 #include "SEImplementation/Plugin/PixelBoundaries/PixelBoundariesTask.h"
 #include "SEImplementation/Plugin/PixelBoundaries/PixelBoundariesTaskFactory.h"
@@ -36,5 +39,16 @@ std::shared_ptr<Task> PixelBoundariesTaskFactory::createTask(const PropertyId& p
   }
 }
 
+std::set<PropertyId> PixelBoundariesTaskFactory::getRequiredProperties(const PropertyId& property_id) const {
+  if (property_id == PropertyId::create<PixelBoundaries>()) {
+    return {PropertyId::create<PixelCoordinateList>()};
+  } else if (property_id == PropertyId::create<PixelBoundariesHalfMaximum>()) {
+    return {PropertyId::create<PixelCoordinateList>(), PropertyId::create<DetectionFramePixelValues>(),
+            PropertyId::create<PeakValue>()};
+  } else {
+    return {};
+  }
+}
+
 } // SEImplementation namespace
 
@@ -20,6 +20,9 @@
  * @author mschefer
  */
 
+#include "SEImplementation/Property/PixelCoordinateList.h"
+#include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValues.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
 #include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
 #include "SEImplementation/Plugin/PixelCentroid/PixelCentroidTask.h"
 #include "SEImplementation/Plugin/PixelCentroid/PixelCentroidTaskFactory.h"
@@ -34,6 +37,15 @@ std::shared_ptr<Task> PixelCentroidTaskFactory::createTask(const PropertyId& pro
   }
 }
 
+std::set<PropertyId> PixelCentroidTaskFactory::getRequiredProperties(const PropertyId& property_id) const {
+  if (property_id == PropertyId::create<PixelCentroid>()) {
+    return {PropertyId::create<PixelCoordinateList>(), PropertyId::create<DetectionFramePixelValues>(),
+            PropertyId::create<PixelBoundaries>()};
+  } else {
+    return {};
+  }
+}
+
 
 }
 
@@ -24,6 +24,7 @@
 #include <numeric>
 #include "SEImplementation/Plugin/Psf/PsfProperty.h"
 #include "SEImplementation/Plugin/MeasurementFrameGroupRectangle/MeasurementFrameGroupRectangle.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceID.h"
 #include "SEImplementation/CheckImages/CheckImages.h"
 #include "SEImplementation/Image/WriteableImageInterfaceTraits.h"
 #include "SEImplementation/Plugin/Psf/PsfTask.h"
@@ -73,7 +74,8 @@ void PsfTask::computeProperties(SourceXtractor::SourceGroupInterface &group) con
 
     // Check image
     if (group.size()) {
-      auto check_image = CheckImages::getInstance().getPsfImage(m_instance);
+      auto check_image = CheckImages::getInstance().getPsfImage(
+          m_instance, group.cbegin()->getProperty<SourceID>().getId());
       if (check_image) {
         auto x = component_value_getters["X_IMAGE"](group, m_instance);
         auto y = component_value_getters["Y_IMAGE"](group, m_instance);
@@ -21,6 +21,10 @@
  *      Author: mschefer
  */
 
+#include "SEImplementation/Property/PixelCoordinateList.h"
+#include "SEImplementation/Plugin/DetectionFramePixelValues/DetectionFramePixelValues.h"
+#include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
+#include "SEImplementation/Plugin/PeakValue/PeakValue.h"
 #include "SEImplementation/Plugin/ShapeParameters/ShapeParameters.h"
 #include "SEImplementation/Plugin/ShapeParameters/ShapeParametersTask.h"
 #include "SEImplementation/Plugin/ShapeParameters/ShapeParametersTaskFactory.h"
@@ -35,6 +39,15 @@ std::shared_ptr<Task> ShapeParametersTaskFactory::createTask(const PropertyId& p
   }
 }
 
+std::set<PropertyId> ShapeParametersTaskFactory::getRequiredProperties(const PropertyId& property_id) const {
+  if (property_id == PropertyId::create<ShapeParameters>()) {
+    return {PropertyId::create<PixelCoordinateList>(), PropertyId::create<DetectionFramePixelValues>(),
+            PropertyId::create<PixelCentroid>(), PropertyId::create<PeakValue>()};
+  } else {
+    return {};
+  }
+}
+
 }
 
 
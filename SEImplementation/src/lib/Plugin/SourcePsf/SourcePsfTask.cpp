@@ -18,6 +18,7 @@
 #include <numeric>
 #include "SEImplementation/Plugin/SourcePsf/SourcePsfProperty.h"
 #include "SEImplementation/Plugin/MeasurementFramePixelCentroid/MeasurementFramePixelCentroid.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceID.h"
 #include "SEImplementation/CheckImages/CheckImages.h"
 #include "SEImplementation/Image/WriteableImageInterfaceTraits.h"
 #include "SEImplementation/Plugin/SourcePsf/SourcePsfTask.h"
@@ -64,7 +65,8 @@ void SourcePsfTask::computeProperties(SourceXtractor::SourceInterface &source) c
     source.setIndexedProperty<SourcePsfProperty>(m_instance, m_vpsf->getPixelSampling(), psf_normalized);
 
     // Check image
-    auto check_image = CheckImages::getInstance().getPsfImage(m_instance);
+    auto check_image = CheckImages::getInstance().getPsfImage(
+        m_instance, source.getProperty<SourceID>().getId());
     if (check_image) {
       auto x = component_value_getters["X_IMAGE"](source, m_instance);
       auto y = component_value_getters["Y_IMAGE"](source, m_instance);
@@ -20,6 +20,7 @@
  */
 
 #include <AlexandriaKernel/StringUtils.h>
+#include <boost/algorithm/string.hpp>
 #include "SEFramework/Image/ProcessedImage.h"
 #include "SEImplementation/Plugin/Vignet/VignetConfig.h"
 
@@ -30,11 +31,18 @@ namespace SourceXtractor {
 
 static const std::string VIGNET_SIZE {"vignet-size" };
 static const std::string VIGNET_DEFAULT_PIXVAL {"vignet-default-pixval" };
+static const std::string VIGNET_RESAMPLING {"vignet-resampling" };
+static const std::string VIGNET_AFFINE_TOLERANCE {"vignet-affine-tolerance" };
+
+static const std::string VIGNET_RESAMPLING_EXACT {"EXACT" };
+static const std::string VIGNET_RESAMPLING_AFFINE {"AFFINE" };
 
 VignetConfig::VignetConfig(long manager_id) :
   Configuration(manager_id),
   m_vignet_size(),
-  m_vignet_default_pixval() {
+  m_vignet_default_pixval(),
+  m_resampling(Resampling::EXACT),
+  m_affine_tolerance(0.01) {
 }
 
 std::map<std::string, Configuration::OptionDescriptionList> VignetConfig::getProgramOptions() {
@@ -43,6 +51,10 @@ std::map<std::string, Configuration::OptionDescriptionList> VignetConfig::getPro
           "X- and Y-size of the vignet."},
 	      {VIGNET_DEFAULT_PIXVAL.c_str(), po::value<double>()->default_value(std::nan("")), //Note: the SE2 value is "1.0E30", but nan is more consistent
           "Default pixel value for the vignet data"},
+      {VIGNET_RESAMPLING.c_str(), po::value<std::string>()->default_value(VIGNET_RESAMPLING_EXACT),
+          "Mapping of the vignet pixels into the detection frame [exact|affine]"},
+      {VIGNET_AFFINE_TOLERANCE.c_str(), po::value<double>()->default_value(0.01),
+          "Maximum deviation (in detection pixels) allowed for the affine resampling"},
   }}};
 }
 
@@ -63,6 +75,22 @@ void VignetConfig::initialize(const UserValues& args) {
   if (args.find(VIGNET_DEFAULT_PIXVAL) != args.end()) {
     m_vignet_default_pixval = args.find(VIGNET_DEFAULT_PIXVAL)->second.as<double>();
   }
+  if (args.find(VIGNET_RESAMPLING) != args.end()) {
+    auto resampling_name = boost::to_upper_copy(args.find(VIGNET_RESAMPLING)->second.as<std::string>());
+    if (resampling_name == VIGNET_RESAMPLING_EXACT) {
+      m_resampling = Resampling::EXACT;
+    } else if (resampling_name == VIGNET_RESAMPLING_AFFINE) {
+      m_resampling = Resampling::AFFINE;
+    } else {
+      throw Elements::Exception() << "Unknown vignet resampling : " << resampling_name;
+    }
+  }
+  if (args.find(VIGNET_AFFINE_TOLERANCE) != args.end()) {
+    m_affine_tolerance = args.find(VIGNET_AFFINE_TOLERANCE)->second.as<double>();
+    if (m_affine_tolerance < 0) {
+      throw Elements::Exception() << VIGNET_AFFINE_TOLERANCE << " must be positive";
+    }
+  }
 }
 
 } // SourceXtractor namespace
@@ -22,6 +22,9 @@
  * @author mkuemmel@usm.lmu.de
  */
 
+#include <memory>
+
+#include "SEFramework/CoordinateSystem/LocalAffineMapping.h"
 #include "SEImplementation/Property/PixelCoordinateList.h"
 #include <SEImplementation/Plugin/MeasurementFrameInfo/MeasurementFrameInfo.h>
 #include <SEImplementation/Plugin/MeasurementFrameCoordinates/MeasurementFrameCoordinates.h>
@@ -66,6 +69,16 @@ void VignetSourceTask::computeProperties(SourceInterface& source) const {
   int x_end = x_start + m_vignet_size[0];
   int y_end = y_start + m_vignet_size[1];
 
+  // a single affine transformation is normally enough for the whole stamp
+  std::unique_ptr<LocalAffineMapping> affine_mapping;
+  if (m_use_affine) {
+    affine_mapping.reset(new LocalAffineMapping(*measurement_coordinate_system, *detection_coordinate_system,
+                                                x_start, y_start, x_end - 1, y_end - 1, m_affine_tolerance));
+    if (!affine_mapping->isValid()) {
+      affine_mapping.reset();
+    }
+  }
+
   // create and fill the vignet vector using the measurement frame
   std::vector<SeFloat> vignet_vector(m_vignet_size[0] * m_vignet_size[1], m_vignet_default_pixval);
   int index = 0;
@@ -77,8 +90,14 @@ void VignetSourceTask::computeProperties(SourceInterface& source) const {
         continue;
 
       // translate pixel coordinates to the detection frame
-      auto world_coord = measurement_coordinate_system->imageToWorld({static_cast<double>(ix), static_cast<double>(iy)});
-      auto detection_coord = detection_coordinate_system->worldToImage(world_coord);
+      ImageCoordinate detection_coord;
+      if (affine_mapping) {
+        detection_coord = (*affine_mapping)(ix, iy);
+      }
+      else {
+        auto world_coord = measurement_coordinate_system->imageToWorld({static_cast<double>(ix), static_cast<double>(iy)});
+        detection_coord = detection_coordinate_system->worldToImage(world_coord);
+      }
 
       // copy the pixel value if it is not masked, and if it does not correspond to a detection pixel
       // if it corresponds to a detection pixel, use it if it belongs to the source
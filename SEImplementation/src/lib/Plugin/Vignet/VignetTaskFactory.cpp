@@ -40,6 +40,8 @@ void VignetTaskFactory::configure(Euclid::Configuration::ConfigManager& manager)
   auto vignet_config = manager.getConfiguration<VignetConfig>();
   m_vignet_size = vignet_config.getVignetSize();
   m_vignet_default_pixval = vignet_config.getVignetDefaultPixval();
+  m_resampling = vignet_config.getResampling();
+  m_affine_tolerance = vignet_config.getAffineTolerance();
 
   auto& measurement_config = manager.getConfiguration<MeasurementImageConfig>();
   const auto& image_infos = measurement_config.getImageInfos();
@@ -53,7 +55,8 @@ void VignetTaskFactory::configure(Euclid::Configuration::ConfigManager& manager)
 
 std::shared_ptr<Task> VignetTaskFactory::createTask(const PropertyId& property_id) const {
   if (property_id.getTypeId() == typeid(Vignet)) {
-    return std::make_shared<VignetSourceTask>(property_id.getIndex(), m_vignet_size, m_vignet_default_pixval);
+    return std::make_shared<VignetSourceTask>(property_id.getIndex(), m_vignet_size, m_vignet_default_pixval,
+                                              m_resampling == VignetConfig::Resampling::AFFINE, m_affine_tolerance);
   }
   else if (property_id == PropertyId::create<VignetArray>()) {
     return std::make_shared<VignetArraySourceTask>(m_images);
@@ -17,6 +17,7 @@
 
 #include <ElementsKernel/Logging.h>
 #include "AlexandriaKernel/memory_tools.h"
+#include "SEFramework/Pipeline/Tracer.h"
 #include "SEImplementation/Prefetcher/Prefetcher.h"
 
 static Elements::Logging logger = Elements::Logging::getLogger("Prefetcher");
@@ -52,7 +53,11 @@ Prefetcher::~Prefetcher() {
 }
 
 void Prefetcher::receiveSource(std::unique_ptr<SourceInterface> message) {
-  m_semaphore.acquire();
+  {
+    // Blocked here when the queue is full
+    Tracer::Scope trace_scope("prefetch", "Wait for queue");
+    m_semaphore.acquire();
+  }
 
   intptr_t source_addr = reinterpret_cast<intptr_t>(message.get());
   {
@@ -62,8 +67,11 @@ void Prefetcher::receiveSource(std::unique_ptr<SourceInterface> message) {
 
   // Pre-fetch in separate threads
   auto lambda = [this, source_addr, message = std::move(message)]() mutable {
-    for (auto& prop : m_prefetch_set) {
-      message->getProperty(prop);
+    {
+      Tracer::Scope trace_scope("prefetch", "Prefetch source");
+      for (auto& prop : m_prefetch_set) {
+        message->getProperty(prop);
+      }
     }
     {
       std::lock_guard<std::mutex> lock(m_queue_mutex);
@@ -84,6 +92,7 @@ void Prefetcher::requestProperty(const PropertyId& property_id) {
 
 void Prefetcher::outputLoop() {
   logger.debug() << "Starting prefetcher output loop";
+  Tracer::getInstance().setThreadName("Prefetcher output");
 
   while (m_thread_pool->activeThreads() > 0) {
     std::unique_lock<std::mutex> output_lock(m_queue_mutex);
@@ -0,0 +1,64 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * @file PythonFallbackReport.cpp
+ */
+
+#include <algorithm>
+
+#include "ElementsKernel/Logging.h"
+
+#include "SEImplementation/PythonConfig/PythonFallbackReport.h"
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("PythonFallback");
+
+PythonFallbackReport& PythonFallbackReport::getInstance() {
+  static PythonFallbackReport report;
+  return report;
+}
+
+std::shared_ptr<PythonFallbackReport::Counter> PythonFallbackReport::registerExpression(const std::string& name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_counters.emplace_back(std::make_shared<Counter>(name));
+  return m_counters.back();
+}
+
+void PythonFallbackReport::logReport() const {
+  std::vector<std::shared_ptr<Counter>> called;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::copy_if(m_counters.begin(), m_counters.end(), std::back_inserter(called),
+                 [](const std::shared_ptr<Counter>& c) { return c->m_calls > 0; });
+  }
+  if (called.empty()) {
+    return;
+  }
+
+  std::sort(called.begin(), called.end(), [](const std::shared_ptr<Counter>& a, const std::shared_ptr<Counter>& b) {
+    return a->m_nanoseconds > b->m_nanoseconds;
+  });
+
+  logger.warn() << called.size() << " expressions were evaluated by Python, holding the GIL:";
+  for (auto& counter : called) {
+    logger.warn() << "    " << counter->m_name << ": " << counter->m_calls << " calls, "
+                  << counter->m_nanoseconds / 1e9 << " s";
+  }
+}
+
+} // end SourceXtractor
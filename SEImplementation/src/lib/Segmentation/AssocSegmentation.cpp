@@ -16,6 +16,14 @@
  */
 
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <tuple>
+
 #include "SEImplementation/Property/PixelCoordinateList.h"
 #include "SEImplementation/Property/SourceId.h"
 #include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
@@ -26,8 +34,75 @@
 
 namespace SourceXtractor {
 
+namespace {
+
+int getRow(const AssocModeConfig::CatalogEntry& entry) {
+  // Entries without valid pixel coordinates come last
+  if (!std::isfinite(entry.coord.m_y)) {
+    return std::numeric_limits<int>::max();
+  }
+  return static_cast<int>(std::max(std::min(std::floor(entry.coord.m_y), 1e9), -1e9));
+}
+
+}
+
+AssocSegmentation::AssocSegmentation(std::shared_ptr<SourceFactory> source_factory,
+                                     std::vector<AssocModeConfig::CatalogEntry> source_list, bool streaming)
+    : m_source_factory(source_factory), m_source_list(std::move(source_list)), m_streaming(streaming) {
+  assert(source_factory != nullptr);
+
+  if (!m_streaming) {
+    return;
+  }
+
+  // A group is reached at the first row of any of its members, entries without a group id (0) at their own row
+  std::map<unsigned int, int> group_rows;
+  for (auto& entry : m_source_list) {
+    if (entry.group_id != 0) {
+      auto row = getRow(entry);
+      auto i = group_rows.emplace(entry.group_id, row).first;
+      i->second = std::min(i->second, row);
+    }
+  }
+
+  std::vector<int> sweep_rows(m_source_list.size());
+  for (size_t i = 0; i < m_source_list.size(); ++i) {
+    auto& entry = m_source_list[i];
+    sweep_rows[i] = entry.group_id != 0 ? group_rows.at(entry.group_id) : getRow(entry);
+  }
+
+  // The members of a group are kept together, so every group published before a change of group is complete
+  std::vector<size_t> order(m_source_list.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this, &sweep_rows](size_t a, size_t b) {
+    auto group_a = m_source_list[a].group_id, group_b = m_source_list[b].group_id;
+    return std::tie(sweep_rows[a], group_a) < std::tie(sweep_rows[b], group_b);
+  });
+
+  std::vector<AssocModeConfig::CatalogEntry> sorted;
+  sorted.reserve(m_source_list.size());
+  m_sweep_rows.reserve(m_source_list.size());
+  for (auto i : order) {
+    sorted.emplace_back(std::move(m_source_list[i]));
+    m_sweep_rows.emplace_back(sweep_rows[i]);
+  }
+  m_source_list.swap(sorted);
+}
+
+bool AssocSegmentation::isStreamingSupported(GroupingConfig::Algorithm grouping) {
+  return grouping == GroupingConfig::Algorithm::ASSOC || grouping == GroupingConfig::Algorithm::NO_GROUPING ||
+         grouping == GroupingConfig::Algorithm::SPLIT_SOURCES;
+}
+
 void AssocSegmentation::labelImage(Segmentation::LabellingListener& listener, std::shared_ptr<const DetectionImageFrame> ) {
-  for (auto source_coordinate : m_source_list) {
+  for (size_t i = 0; i < m_source_list.size(); ++i) {
+    auto& source_coordinate = m_source_list[i];
+
+    // Moving to a new row, and so to a new group: everything published so far can be measured
+    if (m_streaming && i > 0 && m_sweep_rows[i] != m_sweep_rows[i - 1]) {
+      listener.requestProcessing(ProcessSourcesEvent(std::make_shared<SelectAllCriteria>()));
+    }
+
     auto source = m_source_factory->createSource();
     source->setProperty<SourceId>();
     source->setProperty<WorldCentroid>(source_coordinate.world_coord.m_alpha, source_coordinate.world_coord.m_delta);
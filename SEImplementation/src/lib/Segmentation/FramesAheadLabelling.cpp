@@ -0,0 +1,135 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * FramesAheadLabelling.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+
+#include "SEImplementation/Property/SourceId.h"
+#include "SEImplementation/Segmentation/FramesAheadLabelling.h"
+
+namespace SourceXtractor {
+
+/// Keeps what the labelling of a frame sends, to replay it once the pipeline reaches the frame
+class FramesAheadLabelling::RecordingListener : public Segmentation::LabellingListener {
+public:
+  explicit RecordingListener(const Segmentation::LabellingListener& listener) :
+    Segmentation::LabellingListener(listener, nullptr) {}
+
+  void publishSource(std::unique_ptr<SourceInterface> source) const override {
+    m_events.emplace_back();
+    m_events.back().m_source = std::move(source);
+  }
+
+  void notifyProgress(int position, int total) override {
+    m_events.emplace_back();
+    m_events.back().m_progress.reset(new SegmentationProgress{position, total});
+  }
+
+  void requestProcessing(const ProcessSourcesEvent& event) override {
+    m_events.emplace_back();
+    m_events.back().m_process.reset(new ProcessSourcesEvent(event));
+  }
+
+  void replay(Segmentation::LabellingListener& listener) {
+    for (auto& event : m_events) {
+      if (event.m_source) {
+        // Take the identifier now, as if the frame was being labelled
+        event.m_source->setProperty<SourceId>();
+        listener.publishSource(std::move(event.m_source));
+      }
+      else if (event.m_progress) {
+        listener.notifyProgress(event.m_progress->position, event.m_progress->total);
+      }
+      else {
+        listener.requestProcessing(*event.m_process);
+      }
+    }
+    m_events.clear();
+  }
+
+private:
+  struct Event {
+    std::unique_ptr<SourceInterface> m_source;
+    std::unique_ptr<SegmentationProgress> m_progress;
+    std::unique_ptr<ProcessSourcesEvent> m_process;
+  };
+
+  // publishSource is const in the listener interface
+  mutable std::vector<Event> m_events;
+};
+
+FramesAheadLabelling::FramesAheadLabelling(std::shared_ptr<Segmentation::Labelling> labelling,
+                                           std::vector<std::shared_ptr<DetectionImageFrame>> frames,
+                                           std::shared_ptr<DetectionImageFrame::ImageFilter> filter,
+                                           unsigned frames_ahead)
+    : m_labelling(labelling), m_frames(std::move(frames)), m_filter(filter), m_frames_ahead(frames_ahead) {
+}
+
+FramesAheadLabelling::~FramesAheadLabelling() {
+  // The labelling still running ahead uses the frames, wait for it
+  for (auto& job : m_jobs) {
+    if (job.second.valid()) {
+      job.second.wait();
+    }
+  }
+}
+
+void FramesAheadLabelling::labelImage(Segmentation::LabellingListener& listener,
+                                      std::shared_ptr<const DetectionImageFrame> frame) {
+  auto frame_iter = std::find_if(m_frames.begin(), m_frames.end(),
+                                 [&frame](const std::shared_ptr<DetectionImageFrame>& f) { return f == frame; });
+  if (frame_iter == m_frames.end()) {
+    m_labelling->labelImage(listener, frame);
+    return;
+  }
+
+  size_t index = frame_iter - m_frames.begin();
+  for (size_t ahead = index + 1; ahead <= index + m_frames_ahead && ahead < m_frames.size(); ++ahead) {
+    if (m_jobs.count(ahead)) {
+      continue;
+    }
+    auto labelling = m_labelling;
+    auto ahead_frame = m_frames[ahead];
+    auto filter = m_filter;
+    std::unique_ptr<RecordingListener> recording(new RecordingListener(listener));
+    m_jobs[ahead] = std::async(std::launch::async, [labelling, ahead_frame, filter](
+        std::unique_ptr<RecordingListener> recording) {
+      SourceId::LocalNumbering local_numbering;
+      if (filter != nullptr) {
+        ahead_frame->setFilter(filter);
+      }
+      labelling->labelImage(*recording, ahead_frame);
+      return recording;
+    }, std::move(recording));
+  }
+
+  auto job = m_jobs.find(index);
+  if (job == m_jobs.end()) {
+    m_labelling->labelImage(listener, frame);
+    return;
+  }
+
+  auto future = std::move(job->second);
+  m_jobs.erase(job);
+  future.get()->replay(listener);
+}
+
+} // end of namespace SourceXtractor
@@ -21,13 +21,18 @@
  */
 
 
+#include <algorithm>
+
 #include "SEFramework/Image/Image.h"
 #include "SEFramework/Image/ProcessedImage.h"
+#include "SEFramework/Image/SubImage.h"
+#include "SEFramework/Image/TileManager.h"
 #include "SEFramework/Source/SourceWithOnDemandProperties.h"
 
 #include "SEImplementation/Measurement/MultithreadedMeasurement.h"
 #include "SEImplementation/Property/PixelCoordinateList.h"
 #include "SEImplementation/Property/SourceId.h"
+#include "SEImplementation/Grouping/BoundingBoxSelectionCriteria.h"
 #include "SEImplementation/Grouping/LineSelectionCriteria.h"
 #include "SEImplementation/Segmentation/Lutz.h"
 
@@ -40,10 +45,14 @@ namespace {
 class LutzLabellingListener : public Lutz::LutzListener {
 public:
   LutzLabellingListener(Segmentation::LabellingListener& listener, std::shared_ptr<SourceFactory> source_factory,
-      int window_size) :
+      int window_size, bool streaming, int first_line = 0) :
     m_listener(listener),
     m_source_factory(source_factory),
-    m_window_size(window_size) {}
+    m_window_size(window_size),
+    m_streaming(streaming),
+    m_first_line(first_line),
+    m_released_tile_rows(0),
+    m_source_recorder(streaming ? new TileManager::SourceRecorder : nullptr) {}
 
   virtual ~LutzLabellingListener() = default;
 
@@ -58,16 +67,43 @@ public:
     m_listener.notifyProgress(line, total);
 
     if (m_window_size > 0 && line > m_window_size) {
-      m_listener.requestProcessing(
-        ProcessSourcesEvent(std::make_shared<LineSelectionCriteria>(line - m_window_size))
-      );
+      int window_start = m_first_line + line - m_window_size;
+      if (m_streaming) {
+        m_listener.requestProcessing(
+          ProcessSourcesEvent(std::make_shared<BoundingBoxSelectionCriteria>(window_start))
+        );
+        releaseTiles(window_start);
+      }
+      else {
+        m_listener.requestProcessing(
+          ProcessSourcesEvent(std::make_shared<LineSelectionCriteria>(window_start))
+        );
+      }
     }
   }
 
 private:
+  /**
+   * Release the tiles of the images read by the sweep one tile row behind the window. The measurement frames
+   * may not line up with the detection frame, so their tiles are left to the cache. The groups being measured
+   * hold their rows, see MultithreadedMeasurement.
+   */
+  void releaseTiles(int window_start) {
+    auto tile_manager = TileManager::getInstance();
+    int tile_rows = window_start / tile_manager->getTileHeight() - 1;
+    if (tile_rows > m_released_tile_rows) {
+      m_released_tile_rows = tile_rows;
+      tile_manager->releaseTilesBefore(tile_rows * tile_manager->getTileHeight(), m_source_recorder->getSources());
+    }
+  }
+
   Segmentation::LabellingListener& m_listener;
   std::shared_ptr<SourceFactory> m_source_factory;
   int m_window_size;
+  bool m_streaming;
+  int m_first_line;
+  int m_released_tile_rows;
+  std::unique_ptr<TileManager::SourceRecorder> m_source_recorder;
 };
 
 }
@@ -78,8 +114,24 @@ private:
 
 void LutzSegmentation::labelImage(Segmentation::LabellingListener& listener, std::shared_ptr<const DetectionImageFrame> frame) {
   Lutz lutz;
-  LutzLabellingListener lutz_listener(listener, m_source_factory, m_window_size);
-  lutz.labelImage(lutz_listener, *frame->getThresholdedImage());
+  auto thresholded_image = frame->getThresholdedImage();
+
+  if (m_region.getWidth() == 0) {
+    LutzLabellingListener lutz_listener(listener, m_source_factory, m_window_size, m_streaming);
+    lutz.labelImage(lutz_listener, *thresholded_image);
+    return;
+  }
+
+  // Label only the region, keeping the coordinates of the full image
+  auto min = m_region.getTopLeft(), max = m_region.getBottomRight();
+  int width = std::min(max.m_x, thresholded_image->getWidth() - 1) - min.m_x + 1;
+  int height = std::min(max.m_y, thresholded_image->getHeight() - 1) - min.m_y + 1;
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+  auto region_image = SubImage<DetectionImage::PixelType>::create(thresholded_image, min, width, height);
+  LutzLabellingListener lutz_listener(listener, m_source_factory, m_window_size, m_streaming, min.m_y);
+  lutz.labelImage(lutz_listener, *region_image, min);
 }
 
 } // Segmentation namespace
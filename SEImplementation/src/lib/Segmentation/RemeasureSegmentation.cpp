@@ -0,0 +1,139 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * RemeasureSegmentation.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+
+#include "SEFramework/FITS/FitsImageSource.h"
+#include "SEFramework/Image/BufferedImage.h"
+#include "SEFramework/Pipeline/Tracer.h"
+
+#include "SEImplementation/Plugin/SourceIDs/SourceID.h"
+#include "SEImplementation/Property/PixelCoordinateList.h"
+#include "SEImplementation/Property/SourceId.h"
+
+#include "SEImplementation/Segmentation/RemeasureSegmentation.h"
+
+namespace SourceXtractor {
+
+static Elements::Logging logger = Elements::Logging::getLogger("RemeasureSegmentation");
+
+namespace {
+
+// Rows read at once from the partition image
+const int STRIP_HEIGHT = 64;
+
+template <typename Callback>
+void forEachStrip(const Image<int>& image, Callback callback) {
+  for (int y = 0; y < image.getHeight(); y += STRIP_HEIGHT) {
+    int height = std::min(STRIP_HEIGHT, image.getHeight() - y);
+    callback(y, height, *image.getChunk(0, y, image.getWidth(), height));
+  }
+}
+
+}
+
+void RemeasureSegmentation::labelImage(Segmentation::LabellingListener& listener,
+                                       std::shared_ptr<const DetectionImageFrame> frame) {
+  Tracer::Scope trace_scope("segmentation", "Read partition image");
+
+  // Each detection frame has its own partition check image, with a single HDU
+  size_t frame_index = frame ? frame->getHduIndex() : 0;
+  if (frame_index >= m_partition_image_paths.size()) {
+    throw Elements::Exception() << "There is no partition image for the detection image " << frame_index;
+  }
+  auto& partition_image_path = m_partition_image_paths[frame_index];
+  auto partition_image = BufferedImage<int>::create(
+      std::make_shared<FitsImageSource>(partition_image_path, 1, ImageTile::IntImage));
+  if (frame && (partition_image->getWidth() != frame->getOriginalImage()->getWidth() ||
+                partition_image->getHeight() != frame->getOriginalImage()->getHeight())) {
+    throw Elements::Exception() << "The partition image " << partition_image_path
+                                << " does not match the size of the detection image";
+  }
+
+  // First pass: the last row of each source, so it can be published as soon as it is complete
+  std::unordered_map<unsigned int, int> last_rows;
+  size_t ignored_pixels = 0;
+  forEachStrip(*partition_image, [this, &last_rows, &ignored_pixels](int y, int height, const ImageChunk<int>& strip) {
+    for (int iy = 0; iy < height; ++iy) {
+      for (int ix = 0; ix < strip.getWidth(); ++ix) {
+        auto id = strip.getValue(ix, iy);
+        if (id <= 0) {
+          continue;
+        }
+        if (m_sources->count(id) == 0) {
+          ++ignored_pixels;
+          continue;
+        }
+        last_rows[id] = y + iy;
+      }
+    }
+  });
+
+  std::map<int, std::vector<unsigned int>> completed_at;
+  for (auto& last_row : last_rows) {
+    completed_at[last_row.second].emplace_back(last_row.first);
+  }
+  for (auto& ids : completed_at) {
+    std::sort(ids.second.begin(), ids.second.end());
+  }
+
+  // Second pass: gather the pixels, and publish the sources whose last row has been read
+  std::unordered_map<unsigned int, std::vector<PixelCoordinate>> pixels;
+  forEachStrip(*partition_image, [&](int y, int height, const ImageChunk<int>& strip) {
+    for (int iy = 0; iy < height; ++iy) {
+      for (int ix = 0; ix < strip.getWidth(); ++ix) {
+        auto id = strip.getValue(ix, iy);
+        if (id > 0 && last_rows.count(id)) {
+          pixels[id].emplace_back(ix, y + iy);
+        }
+      }
+
+      auto completed = completed_at.find(y + iy);
+      if (completed == completed_at.end()) {
+        continue;
+      }
+      for (auto id : completed->second) {
+        auto& info = m_sources->at(id);
+        auto source = m_source_factory->createSource();
+        source->setProperty<PixelCoordinateList>(std::move(pixels[id]));
+        source->setProperty<SourceId>(info.m_detection_id);
+        source->setProperty<SourceID>(id, info.m_detection_id);
+        pixels.erase(id);
+        listener.publishSource(std::move(source));
+      }
+    }
+    listener.notifyProgress(y + height, partition_image->getHeight());
+  });
+
+  if (ignored_pixels > 0) {
+    logger.info() << ignored_pixels << " pixels of the partition image belong to sources missing from the catalog";
+  }
+  logger.info() << "Re-measuring " << last_rows.size() << " sources of " << partition_image_path;
+}
+
+} // SourceXtractor namespace
@@ -28,10 +28,14 @@
 #include "SEFramework/Source/SourceWithOnDemandPropertiesFactory.h"
 #include "SEFramework/Image/ImageProcessingList.h"
 
+#include "SEImplementation/Configuration/DetectionFrameConfig.h"
+#include "SEImplementation/Configuration/ShardConfig.h"
 #include "SEImplementation/Segmentation/BackgroundConvolution.h"
 #include "SEImplementation/Segmentation/LutzSegmentation.h"
 #include "SEImplementation/Segmentation/BFSSegmentation.h"
 #include "SEImplementation/Segmentation/AssocSegmentation.h"
+#include "SEImplementation/Segmentation/RemeasureSegmentation.h"
+#include "SEImplementation/Segmentation/FramesAheadLabelling.h"
 
 #ifdef WITH_ML_SEGMENTATION
 #include "SEImplementation/Segmentation/MLSegmentation.h"
@@ -45,12 +49,18 @@ namespace SourceXtractor {
 
 SegmentationFactory::SegmentationFactory(std::shared_ptr<TaskProvider> task_provider)
     : m_algorithm(SegmentationConfig::Algorithm::UNKNOWN),
-      m_task_provider(task_provider), m_lutz_window_size(0), m_bfs_max_delta(0), m_ml_threshold(0.) {
+      m_task_provider(task_provider), m_lutz_window_size(0), m_streaming(false), m_bfs_max_delta(0),
+      m_ml_threshold(0.), m_assoc_streaming(false),
+      m_frames_ahead(0) {
 }
 
 void SegmentationFactory::reportConfigDependencies(Euclid::Configuration::ConfigManager& manager) const {
   manager.registerConfiguration<AssocModeConfig>();
+  manager.registerConfiguration<DetectionFrameConfig>();
+  manager.registerConfiguration<GroupingConfig>();
   manager.registerConfiguration<SegmentationConfig>();
+  manager.registerConfiguration<ShardConfig>();
+  manager.registerConfiguration<RemeasureConfig>();
 }
 
 void SegmentationFactory::configure(Euclid::Configuration::ConfigManager& manager) {
@@ -58,24 +68,70 @@ void SegmentationFactory::configure(Euclid::Configuration::ConfigManager& manage
   m_algorithm = segmentation_config.getAlgorithmOption();
   m_filter = segmentation_config.getFilter();
   m_lutz_window_size = segmentation_config.getLutzWindowSize();
+  m_streaming = segmentation_config.isStreaming();
   m_bfs_max_delta = segmentation_config.getBfsMaxDelta();
   m_model_path = segmentation_config.getOnnxModelPath();
   m_ml_threshold = segmentation_config.getMLThreashold();
 
   auto assoc_config = manager.getConfiguration<AssocModeConfig>();
   m_catalogs = assoc_config.getCatalogs();
+  m_assoc_streaming = assoc_config.isStreaming();
+  if (m_algorithm == SegmentationConfig::Algorithm::ASSOC && m_assoc_streaming &&
+      !AssocSegmentation::isStreamingSupported(manager.getConfiguration<GroupingConfig>().getAlgorithmOption())) {
+    throw Elements::Exception() << "The assoc streaming is only supported with the ASSOC, NONE and SPLIT groupings";
+  }
+
+  auto& shard_config = manager.getConfiguration<ShardConfig>();
+  if (shard_config.isEnabled() && m_algorithm != SegmentationConfig::Algorithm::LUTZ) {
+    throw Elements::Exception() << "Shard regions are only supported with the LUTZ segmentation";
+  }
+  m_shard_region = shard_config.getProcessedRegion();
+
+  auto& remeasure_config = manager.getConfiguration<RemeasureConfig>();
+  if (remeasure_config.isEnabled() && shard_config.isEnabled()) {
+    throw Elements::Exception() << "Shard regions can not be used when re-measuring a previous run";
+  }
+  m_remeasure_partition_images = remeasure_config.getPartitionImagePaths();
+  m_remeasured_sources = remeasure_config.getSources();
+
+  m_frames_ahead = segmentation_config.getFramesAhead();
+  if (m_frames_ahead > 0) {
+    if (remeasure_config.isEnabled()) {
+      throw Elements::Exception() << "Frames can not be labelled ahead when re-measuring a previous run";
+    }
+    m_detection_frames = manager.getConfiguration<DetectionFrameConfig>().getDetectionFrames();
+  }
+}
+
+template <typename LabellingType, typename... Args>
+void SegmentationFactory::setLabelling(Segmentation& segmentation, Args... args) const {
+  if (m_frames_ahead > 0 && m_detection_frames.size() > 1) {
+    segmentation.setLabelling<FramesAheadLabelling>(std::make_shared<LabellingType>(args...), m_detection_frames,
+                                                    m_filter, m_frames_ahead);
+  }
+  else {
+    segmentation.setLabelling<LabellingType>(args...);
+  }
 }
 
 std::shared_ptr<Segmentation> SegmentationFactory::createSegmentation() const {
   auto segmentation = std::make_shared<Segmentation>(m_filter);
+  if (m_remeasured_sources) {
+    segmentation->setLabelling<RemeasureSegmentation>(
+        std::make_shared<SourceWithOnDemandPropertiesFactory>(m_task_provider), m_remeasure_partition_images,
+        m_remeasured_sources);
+    return segmentation;
+  }
+
   switch (m_algorithm) {
     case SegmentationConfig::Algorithm::LUTZ:
       //FIXME Use a factory from parameter
-      segmentation->setLabelling<LutzSegmentation>(
-          std::make_shared<SourceWithOnDemandPropertiesFactory>(m_task_provider), m_lutz_window_size);
+      setLabelling<LutzSegmentation>(*segmentation,
+          std::make_shared<SourceWithOnDemandPropertiesFactory>(m_task_provider), m_lutz_window_size, m_shard_region,
+          m_streaming);
       break;
     case SegmentationConfig::Algorithm::BFS:
-      segmentation->setLabelling<BFSSegmentation>(
+      setLabelling<BFSSegmentation>(*segmentation,
           std::make_shared<SourceWithOnDemandPropertiesFactory>(m_task_provider), m_bfs_max_delta);
       break;
 #ifdef WITH_ML_SEGMENTATION
@@ -87,7 +143,7 @@ std::shared_ptr<Segmentation> SegmentationFactory::createSegmentation() const {
     case SegmentationConfig::Algorithm::ASSOC:
     {
       segmentation->setLabelling<AssocSegmentation>(
-          std::make_shared<SourceWithOnDemandPropertiesFactory>(m_task_provider), m_catalogs.at(0));
+          std::make_shared<SourceWithOnDemandPropertiesFactory>(m_task_provider), m_catalogs.at(0), m_assoc_streaming);
       break;
     }
     case SegmentationConfig::Algorithm::UNKNOWN:
@@ -0,0 +1,157 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * Checkpoint_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <fstream>
+#include <set>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <ElementsKernel/Temporary.h>
+
+#include "SEFramework/Source/SimpleSource.h"
+#include "SEFramework/Source/SimpleSourceGroup.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceIDTask.h"
+#include "SEImplementation/Property/PixelCoordinateList.h"
+
+#include "SEImplementation/Checkpoint/Checkpoint.h"
+
+using namespace SourceXtractor;
+
+static std::unique_ptr<SourceInterface> makeSource(std::vector<PixelCoordinate> pixels) {
+  std::unique_ptr<SourceInterface> source {new SimpleSource};
+  source->setProperty<PixelCoordinateList>(std::move(pixels));
+  return source;
+}
+
+BOOST_AUTO_TEST_SUITE (Checkpoint_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (GroupKey_test) {
+  SimpleSourceGroup group_a, group_b, group_c, group_d;
+  group_a.addSource(makeSource({{5, 3}, {4, 3}, {6, 4}}));
+  group_a.addSource(makeSource({{10, 2}, {11, 2}}));
+
+  // Same sources, different order of sources and pixels
+  group_b.addSource(makeSource({{11, 2}, {10, 2}}));
+  group_b.addSource(makeSource({{6, 4}, {4, 3}, {5, 3}}));
+
+  group_c.addSource(makeSource({{5, 3}, {4, 3}, {6, 4}}));
+
+  // Same first pixel, but not the same pixels
+  group_d.addSource(makeSource({{5, 3}, {4, 3}, {6, 4}}));
+  group_d.addSource(makeSource({{10, 2}, {11, 2}, {12, 2}}));
+
+  auto key = Checkpoint::getGroupKey(0, group_a);
+  BOOST_CHECK(key == Checkpoint::getGroupKey(0, group_b));
+  BOOST_CHECK(key != Checkpoint::getGroupKey(0, group_c));
+  BOOST_CHECK(key != Checkpoint::getGroupKey(0, group_d));
+  BOOST_CHECK_EQUAL(key.m_position, Checkpoint::getGroupKey(0, group_d).m_position);
+  BOOST_CHECK(key != Checkpoint::getGroupKey(1, group_a));
+
+  BOOST_CHECK_EQUAL(Checkpoint::getKeyFrame(key), 0);
+  BOOST_CHECK_EQUAL(Checkpoint::getKeyFrame(Checkpoint::getGroupKey(3, group_a)), 3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (Journal_test) {
+  Elements::TempDir directory;
+  auto path = directory.path().native();
+
+  {
+    Checkpoint checkpoint(path);
+    BOOST_CHECK_EQUAL(checkpoint.getCompletedCount(), 0);
+    checkpoint.commit({}, {}, {{1, 10}, {2, 20}, {3, 30}});
+    BOOST_CHECK(checkpoint.isCompleted({2, 20}));
+  }
+
+  // Simulate a run interrupted while writing a key
+  auto journal_path = (directory.path() / "groups.dat").native();
+  {
+    std::ofstream journal(journal_path, std::ios::binary | std::ios::app);
+    journal.write("abc", 3);
+  }
+
+  Checkpoint resumed(path);
+  BOOST_CHECK_EQUAL(resumed.getCompletedCount(), 3);
+  BOOST_CHECK(resumed.isCompleted({1, 10}));
+  BOOST_CHECK(resumed.isCompleted({3, 30}));
+  BOOST_CHECK(!resumed.isCompleted({3, 20}));
+  BOOST_CHECK(!resumed.isCompleted({4, 40}));
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(journal_path), 3 * 2 * sizeof(std::int64_t));
+  BOOST_CHECK(resumed.takeStoredRows(0).empty());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (ResumeSourceId_test) {
+  Elements::TempDir directory;
+  auto path = directory.path().native();
+  auto column_info = std::make_shared<Euclid::Table::ColumnInfo>(
+    std::vector<Euclid::Table::ColumnDescription>{{"source_id", typeid(std::int32_t)}});
+  SourceIDTask source_id_task;
+
+  auto measure = [&source_id_task](SourceInterface& source) {
+    source.setProperty<SourceId>();
+    source_id_task.computeProperties(source);
+    return static_cast<std::int32_t>(source.getProperty<SourceID>().getId());
+  };
+
+  // First run, interrupted after storing the first group
+  SourceIDTask::setNextId(1);
+  {
+    Checkpoint checkpoint(path);
+    SimpleSourceGroup group;
+    group.addSource(makeSource({{1, 1}}));
+    group.addSource(makeSource({{3, 1}}));
+    auto key = Checkpoint::getGroupKey(0, group);
+
+    std::vector<Euclid::Table::Row> rows;
+    for (auto& source : group) {
+      rows.emplace_back(std::vector<Euclid::Table::Row::cell_type>{measure(source)}, column_info);
+    }
+    checkpoint.commit(rows, {key, key}, {key});
+  }
+
+  // The resumed run starts its counter again, and numbers the new sources past the stored ones
+  SourceIDTask::setNextId(1);
+  Checkpoint resumed(path);
+  BOOST_CHECK_EQUAL(resumed.getMaxStoredValue("source_id"), 2);
+  SourceIDTask::setNextId(resumed.getMaxStoredValue("source_id") + 1);
+
+  std::set<std::int32_t> source_ids;
+  for (auto& row : resumed.takeStoredRows(0)) {
+    BOOST_CHECK(source_ids.insert(boost::get<std::int32_t>(row[0])).second);
+  }
+  BOOST_CHECK_EQUAL(source_ids.size(), 2);
+
+  for (int i = 0; i < 3; ++i) {
+    auto source = makeSource({{i, 5}});
+    BOOST_CHECK(source_ids.insert(measure(*source)).second);
+  }
+  BOOST_CHECK_EQUAL(*source_ids.rbegin(), 5);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
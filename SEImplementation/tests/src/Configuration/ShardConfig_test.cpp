@@ -0,0 +1,102 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ShardConfig_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "ElementsKernel/Exception.h"
+
+#include "SEImplementation/Configuration/ShardConfig.h"
+
+using namespace SourceXtractor;
+namespace po = boost::program_options;
+
+struct ShardConfigFixture {
+  ShardConfig config {0};
+
+  void initialize(const std::string& region, int margin) {
+    Euclid::Configuration::Configuration::UserValues args;
+    args["shard-region"] = po::variable_value(boost::any(region), false);
+    args["shard-margin"] = po::variable_value(boost::any(margin), false);
+    config.initialize(args);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (ShardConfig_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( parse_region_test ) {
+  // The option starts at 1, the region at 0
+  auto region = ShardConfig::parseRegion("1, 11,100,200");
+  BOOST_CHECK_EQUAL(region.getTopLeft().m_x, 0);
+  BOOST_CHECK_EQUAL(region.getTopLeft().m_y, 10);
+  BOOST_CHECK_EQUAL(region.getBottomRight().m_x, 99);
+  BOOST_CHECK_EQUAL(region.getBottomRight().m_y, 199);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( parse_invalid_region_test ) {
+  BOOST_CHECK_THROW(ShardConfig::parseRegion("1,1,100"), Elements::Exception);
+  BOOST_CHECK_THROW(ShardConfig::parseRegion("1,1,100,x"), Elements::Exception);
+  BOOST_CHECK_THROW(ShardConfig::parseRegion("0,1,100,100"), Elements::Exception);
+  BOOST_CHECK_THROW(ShardConfig::parseRegion("50,1,10,100"), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( disabled_test, ShardConfigFixture ) {
+  initialize("", 10);
+  BOOST_CHECK(!config.isEnabled());
+
+  auto region = config.getProcessedRegion(300, 200);
+  BOOST_CHECK_EQUAL(region.getWidth(), 300);
+  BOOST_CHECK_EQUAL(region.getHeight(), 200);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( processed_region_test, ShardConfigFixture ) {
+  initialize("5,101,100,200", 10);
+  BOOST_CHECK(config.isEnabled());
+
+  // The margin is clipped to the image
+  auto region = config.getProcessedRegion(105, 300);
+  BOOST_CHECK_EQUAL(region.getTopLeft().m_x, 0);
+  BOOST_CHECK_EQUAL(region.getTopLeft().m_y, 90);
+  BOOST_CHECK_EQUAL(region.getBottomRight().m_x, 104);
+  BOOST_CHECK_EQUAL(region.getBottomRight().m_y, 209);
+
+  BOOST_CHECK_THROW(config.getProcessedRegion(50, 50), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( negative_margin_test, ShardConfigFixture ) {
+  BOOST_CHECK_THROW(initialize("1,1,100,100", -1), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
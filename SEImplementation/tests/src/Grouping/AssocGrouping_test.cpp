@@ -0,0 +1,126 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * AssocGrouping_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Source/SimpleSourceFactory.h"
+#include "SEFramework/Source/SimpleSourceGroupFactory.h"
+#include "SEImplementation/Plugin/AssocMode/AssocMode.h"
+
+#include "SEImplementation/Grouping/AssocGrouping.h"
+
+using namespace SourceXtractor;
+
+/// Keeps the assoc group ids of the sources of each group received
+class GroupRecorder : public PipelineReceiver<SourceGroupInterface> {
+public:
+  void receiveSource(std::unique_ptr<SourceGroupInterface> group) override {
+    std::vector<unsigned int> ids;
+    for (auto& source : *group) {
+      ids.push_back(source.getProperty<AssocMode>().getGroupId());
+    }
+    std::sort(ids.begin(), ids.end());
+    m_groups.emplace_back(ids);
+  }
+
+  void receiveProcessSignal(const ProcessSourcesEvent&) override {
+  }
+
+  std::vector<std::vector<unsigned int>> m_groups;
+};
+
+struct AssocGroupingFixture {
+  std::shared_ptr<GroupRecorder> recorder = std::make_shared<GroupRecorder>();
+  SimpleSourceFactory source_factory;
+
+  std::unique_ptr<SourceInterface> createSource(unsigned int group_id) {
+    auto source = source_factory.createSource();
+    source->setProperty<AssocMode>(true, std::vector<double>{}, 1., group_id);
+    return source;
+  }
+
+  void flush(AssocGrouping& grouping) {
+    grouping.receiveProcessSignal(ProcessSourcesEvent(std::make_shared<SelectAllCriteria>()));
+    std::sort(recorder->m_groups.begin(), recorder->m_groups.end());
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (AssocGrouping_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( group_id_test, AssocGroupingFixture ) {
+  AssocGrouping grouping(std::make_shared<SimpleSourceGroupFactory>(), 0);
+  grouping.setNextStage(recorder);
+
+  for (unsigned int group_id : {2, 1, 2, 3, 1, 1}) {
+    grouping.receiveSource(createSource(group_id));
+  }
+  BOOST_CHECK(recorder->m_groups.empty());
+
+  flush(grouping);
+  std::vector<std::vector<unsigned int>> expected {{1, 1, 1}, {2, 2}, {3}};
+  BOOST_CHECK(recorder->m_groups == expected);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( no_group_id_test, AssocGroupingFixture ) {
+  AssocGrouping grouping(std::make_shared<SimpleSourceGroupFactory>(), 0);
+  grouping.setNextStage(recorder);
+
+  // The entries without a group id are not grouped together, whether they are flushed at once or not
+  grouping.receiveSource(createSource(0));
+  grouping.receiveSource(createSource(4));
+  grouping.receiveSource(createSource(0));
+  flush(grouping);
+  grouping.receiveSource(createSource(0));
+  flush(grouping);
+
+  std::vector<std::vector<unsigned int>> expected {{0}, {0}, {0}, {4}};
+  BOOST_CHECK(recorder->m_groups == expected);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( hard_limit_test, AssocGroupingFixture ) {
+  AssocGrouping grouping(std::make_shared<SimpleSourceGroupFactory>(), 2);
+  grouping.setNextStage(recorder);
+
+  for (int i = 0; i < 5; ++i) {
+    grouping.receiveSource(createSource(1));
+  }
+  BOOST_CHECK_EQUAL(recorder->m_groups.size(), 2);
+
+  flush(grouping);
+  std::vector<std::vector<unsigned int>> expected {{1}, {1, 1}, {1, 1}};
+  BOOST_CHECK(recorder->m_groups == expected);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,79 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * BoundingBoxSelectionCriteria_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Source/SimpleSource.h"
+#include "SEFramework/Source/SimpleSourceGroup.h"
+
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
+
+#include "SEImplementation/Grouping/BoundingBoxSelectionCriteria.h"
+
+using namespace SourceXtractor;
+
+namespace {
+
+std::unique_ptr<SourceInterface> createSource(int min_y, int max_y) {
+  std::unique_ptr<SimpleSource> source(new SimpleSource);
+  source->setProperty<PixelBoundaries>(0, min_y, 10, max_y);
+  return std::move(source);
+}
+
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (BoundingBoxSelectionCriteria_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( Source_test ) {
+  BoundingBoxSelectionCriteria criteria(10);
+
+  // Only sources that end before the line are behind the window
+  BOOST_CHECK(criteria.mustBeProcessed(*createSource(0, 9)));
+  BOOST_CHECK(!criteria.mustBeProcessed(*createSource(0, 10)));
+  BOOST_CHECK(!criteria.mustBeProcessed(*createSource(12, 15)));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( Group_test ) {
+  BoundingBoxSelectionCriteria criteria(10);
+  BOOST_CHECK(criteria.requiresWholeGroup());
+
+  SimpleSourceGroup done;
+  done.addSource(createSource(0, 5));
+  done.addSource(createSource(2, 9));
+  BOOST_CHECK(criteria.groupMustBeProcessed(done));
+
+  // A single source still in the window holds the whole group back
+  SimpleSourceGroup pending;
+  pending.addSource(createSource(0, 5));
+  pending.addSource(createSource(8, 12));
+  BOOST_CHECK(!criteria.groupMustBeProcessed(pending));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
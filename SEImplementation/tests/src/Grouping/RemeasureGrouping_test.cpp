@@ -0,0 +1,99 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Source/SimpleSourceFactory.h"
+#include "SEFramework/Source/SimpleSourceGroupFactory.h"
+#include "SEImplementation/Plugin/GroupInfo/GroupInfo.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceID.h"
+
+#include "SEImplementation/Grouping/RemeasureGrouping.h"
+
+using namespace SourceXtractor;
+
+/// Keeps the group id and the source ids of each group received
+class GroupRecorder : public PipelineReceiver<SourceGroupInterface> {
+public:
+  void receiveSource(std::unique_ptr<SourceGroupInterface> group) override {
+    std::vector<int> ids;
+    for (auto& source : *group) {
+      ids.push_back(source.getProperty<SourceID>().getId());
+    }
+    m_groups.emplace_back(group->getProperty<GroupInfo>().getGroupId(), ids);
+  }
+
+  void receiveProcessSignal(const ProcessSourcesEvent&) override {
+  }
+
+  std::vector<std::pair<unsigned int, std::vector<int>>> m_groups;
+};
+
+struct RemeasureGroupingFixture {
+  std::shared_ptr<RemeasureConfig::SourceMap> sources = std::make_shared<RemeasureConfig::SourceMap>();
+  std::shared_ptr<GroupRecorder> recorder = std::make_shared<GroupRecorder>();
+  SimpleSourceFactory source_factory;
+
+  RemeasureGroupingFixture() {
+    // source id -> detection id, group id
+    (*sources)[1] = {1, 7};
+    (*sources)[2] = {1, 7};
+    (*sources)[3] = {3, 5};
+    (*sources)[4] = {4, 9};
+    (*sources)[5] = {4, 9};
+  }
+
+  std::unique_ptr<SourceInterface> createSource(unsigned int id) {
+    auto source = source_factory.createSource();
+    source->setProperty<SourceID>(id, sources->at(id).m_detection_id);
+    return source;
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (RemeasureGrouping_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( complete_groups_test, RemeasureGroupingFixture ) {
+  RemeasureGrouping grouping(std::make_shared<SimpleSourceGroupFactory>(), sources);
+  grouping.setNextStage(recorder);
+
+  grouping.receiveSource(createSource(2));
+  grouping.receiveSource(createSource(3));
+  BOOST_REQUIRE_EQUAL(recorder->m_groups.size(), 1);
+  BOOST_CHECK_EQUAL(recorder->m_groups[0].first, 5);
+
+  grouping.receiveSource(createSource(4));
+  grouping.receiveSource(createSource(1));
+  BOOST_REQUIRE_EQUAL(recorder->m_groups.size(), 2);
+  BOOST_CHECK_EQUAL(recorder->m_groups[1].first, 7);
+  BOOST_CHECK_EQUAL(recorder->m_groups[1].second.size(), 2);
+
+  // Source 5 never comes, its group is sent at the end of the frame
+  grouping.receiveProcessSignal(ProcessSourcesEvent(std::make_shared<SelectAllCriteria>()));
+  BOOST_REQUIRE_EQUAL(recorder->m_groups.size(), 3);
+  BOOST_CHECK_EQUAL(recorder->m_groups[2].first, 9);
+  BOOST_CHECK(recorder->m_groups[2].second == std::vector<int>{4});
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
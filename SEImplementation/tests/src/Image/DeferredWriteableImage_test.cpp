@@ -0,0 +1,123 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * DeferredWriteableImage_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+#include "SEFramework/Image/ImageAccessor.h"
+#include "SEFramework/Image/VectorImage.h"
+#include "SEImplementation/Image/DeferredWriteableImage.h"
+
+using namespace SourceXtractor;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (DeferredWriteableImage_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (Replace_test) {
+  std::shared_ptr<WriteableImage<int>> target = VectorImage<int>::create(100, 100);
+
+  {
+    auto deferred = DeferredWriteableImage<int>::create(target, DeferredWriteableImage<int>::MergeMode::REPLACE);
+    deferred->setValue(10, 20, 5);
+    deferred->setValue(70, 90, 6);
+    BOOST_CHECK_EQUAL(deferred->getChunk(10, 20, 1, 1)->getValue(0, 0), 5);
+
+    // Not committed yet
+    BOOST_CHECK_EQUAL(ImageAccessor<int>(target).getValue(10, 20), 0);
+  }
+
+  ImageAccessor<int> accessor(target);
+  BOOST_CHECK_EQUAL(accessor.getValue(10, 20), 5);
+  BOOST_CHECK_EQUAL(accessor.getValue(70, 90), 6);
+  BOOST_CHECK_EQUAL(accessor.getValue(11, 20), 0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (ConcurrentAdd_test) {
+  std::shared_ptr<WriteableImage<float>> target = VectorImage<float>::create(300, 200);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([target]() {
+      for (int i = 0; i < 10; ++i) {
+        std::shared_ptr<WriteableImage<float>> deferred = DeferredWriteableImage<float>::create(
+          target, DeferredWriteableImage<float>::MergeMode::ADD);
+        ImageAccessor<float> accessor(deferred);
+        for (int y = 10; y < 150; ++y) {
+          for (int x = 20; x < 290; ++x) {
+            deferred->setValue(x, y, accessor.getValue(x, y) + 1.f);
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // No accumulation is lost
+  ImageAccessor<float> accessor(target);
+  for (int y = 0; y < 200; ++y) {
+    for (int x = 0; x < 300; ++x) {
+      float expected = (y >= 10 && y < 150 && x >= 20 && x < 290) ? 40.f : 0.f;
+      BOOST_CHECK_EQUAL(accessor.getValue(x, y), expected);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE (Pending_test) {
+  std::shared_ptr<WriteableImage<int>> target = VectorImage<int>::create(100, 100);
+  auto pending = std::make_shared<DeferredWriteableImage<int>::PendingChanges>(
+    target, DeferredWriteableImage<int>::MergeMode::REPLACE);
+
+  // Finished in the reverse order of their keys
+  for (unsigned int key : {3, 1, 2}) {
+    auto deferred = DeferredWriteableImage<int>::create(pending, key);
+    deferred->setValue(10, 20, key);
+    deferred->setValue(key, 0, key);
+  }
+  BOOST_CHECK_EQUAL(ImageAccessor<int>(target).getValue(10, 20), 0);
+
+  pending->merge();
+
+  // Applied in the order of the keys, so the highest one wins
+  ImageAccessor<int> accessor(target);
+  BOOST_CHECK_EQUAL(accessor.getValue(10, 20), 3);
+  for (int key = 1; key <= 3; ++key) {
+    BOOST_CHECK_EQUAL(accessor.getValue(key, 0), key);
+  }
+
+  // Nothing left to apply
+  target->setValue(10, 20, 0);
+  pending->merge();
+  BOOST_CHECK_EQUAL(ImageAccessor<int>(target).getValue(10, 20), 0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,81 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * RegionWriteableImage_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Image/VectorImage.h"
+
+#include "SEImplementation/Image/RegionWriteableImage.h"
+
+using namespace SourceXtractor;
+
+struct RegionWriteableImageFixture {
+  // Pixels 2 to 4 along x and 1 to 2 along y of a 10x5 image
+  std::shared_ptr<VectorImage<int>> m_region = VectorImage<int>::create(3, 2);
+  std::shared_ptr<RegionWriteableImage<int>> m_image =
+      RegionWriteableImage<int>::create(m_region, PixelCoordinate(2, 1), 10, 5, -1);
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (RegionWriteableImage_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( write_test, RegionWriteableImageFixture ) {
+  BOOST_CHECK_EQUAL(m_image->getWidth(), 10);
+  BOOST_CHECK_EQUAL(m_image->getHeight(), 5);
+
+  for (int y = 0; y < 5; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      m_image->setValue(x, y, x + 10 * y);
+    }
+  }
+  std::vector<int> expected {12, 13, 14, 22, 23, 24};
+  BOOST_CHECK(m_region->getData() == expected);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( read_test, RegionWriteableImageFixture ) {
+  m_region->getData() = {1, 2, 3, 4, 5, 6};
+
+  // Inside the region, and across its edge
+  auto inside = m_image->getChunk(3, 1, 2, 2);
+  BOOST_CHECK_EQUAL(inside->getValue(0, 0), 2);
+  BOOST_CHECK_EQUAL(inside->getValue(1, 1), 6);
+
+  auto across = m_image->getChunk(1, 0, 3, 3);
+  std::vector<int> expected {-1, -1, -1, -1, 1, 2, -1, 4, 5};
+  for (int y = 0; y < 3; ++y) {
+    for (int x = 0; x < 3; ++x) {
+      BOOST_CHECK_EQUAL(across->getValue(x, y), expected[x + 3 * y]);
+    }
+  }
+
+  auto outside = m_image->getChunk(6, 3, 2, 2);
+  BOOST_CHECK_EQUAL(outside->getValue(1, 1), -1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
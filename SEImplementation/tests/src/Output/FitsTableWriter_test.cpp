@@ -0,0 +1,130 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * FitsTableWriter_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <ElementsKernel/Exception.h>
+#include <ElementsKernel/Temporary.h>
+#include <NdArray/NdArray.h>
+
+#include "SEImplementation/Output/FitsTableWriter.h"
+
+using namespace SourceXtractor;
+using Euclid::NdArray::NdArray;
+using Euclid::Table::ColumnDescription;
+using Euclid::Table::ColumnInfo;
+using Euclid::Table::Row;
+
+struct FitsTableWriterFixture {
+  Elements::TempFile m_tmp_fits;
+  std::shared_ptr<ColumnInfo> m_column_info = std::make_shared<ColumnInfo>(std::vector<ColumnDescription>{
+    ColumnDescription{"source_id", typeid(std::int32_t)},
+    ColumnDescription{"flux", typeid(double), "count", "Total flux"},
+    ColumnDescription{"aperture_flux", typeid(std::vector<float>)},
+    ColumnDescription{"vignet", typeid(NdArray<float>)},
+  });
+
+  std::vector<Row> makeRows(int first, int n, std::size_t aperture_count = 3) {
+    std::vector<Row> rows;
+    for (int i = first; i < first + n; ++i) {
+      std::vector<float> apertures(aperture_count, i);
+      NdArray<float> vignet({2, 3}, std::vector<float>{0.f + i, 1.f + i, 2.f + i, 3.f + i, 4.f + i, 5.f + i});
+      rows.emplace_back(std::vector<Row::cell_type>{i, i * 10., apertures, vignet}, m_column_info);
+    }
+    return rows;
+  }
+
+  fitsfile* openTable() {
+    fitsfile* fptr = nullptr;
+    int status = 0;
+    fits_open_table(&fptr, m_tmp_fits.path().native().c_str(), READONLY, &status);
+    BOOST_REQUIRE_EQUAL(status, 0);
+    return fptr;
+  }
+};
+
+BOOST_AUTO_TEST_SUITE (FitsTableWriter_test)
+
+BOOST_FIXTURE_TEST_CASE( write_blocks_test, FitsTableWriterFixture ) {
+  {
+    FitsTableWriter writer(m_tmp_fits.path().native(), true);
+    writer.setHduName("CATALOG");
+    writer.addRows(makeRows(0, 100));
+    writer.addRows(makeRows(100, 50));
+    BOOST_CHECK_EQUAL(writer.getRowCount(), 150);
+  }
+
+  auto fptr = openTable();
+  int status = 0;
+  long nrows = 0;
+  char extname[FLEN_VALUE];
+  fits_get_num_rows(fptr, &nrows, &status);
+  fits_read_key(fptr, TSTRING, "EXTNAME", extname, nullptr, &status);
+  BOOST_CHECK_EQUAL(nrows, 150);
+  BOOST_CHECK_EQUAL(std::string(extname), "CATALOG");
+
+  std::vector<double> flux(nrows);
+  fits_read_col(fptr, TDOUBLE, 2, 1, 1, nrows, nullptr, flux.data(), nullptr, &status);
+  for (int i = 0; i < nrows; ++i) {
+    BOOST_CHECK_EQUAL(flux[i], i * 10.);
+  }
+
+  std::vector<float> apertures(3);
+  fits_read_col(fptr, TFLOAT, 3, 120, 1, 3, nullptr, apertures.data(), nullptr, &status);
+  BOOST_CHECK_EQUAL(apertures[2], 119.f);
+
+  // TDIM follows the FITS convention, the fastest axis first
+  int naxis = 0;
+  long naxes[2];
+  std::vector<float> vignet(6);
+  fits_read_tdim(fptr, 4, 2, &naxis, naxes, &status);
+  fits_read_col(fptr, TFLOAT, 4, 5, 1, 6, nullptr, vignet.data(), nullptr, &status);
+  BOOST_CHECK_EQUAL(naxis, 2);
+  BOOST_CHECK_EQUAL(naxes[0], 3);
+  BOOST_CHECK_EQUAL(naxes[1], 2);
+  BOOST_CHECK_EQUAL(vignet[5], 9.f);
+
+  fits_close_file(fptr, &status);
+  BOOST_CHECK_EQUAL(status, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE( variable_size_test, FitsTableWriterFixture ) {
+  FitsTableWriter writer(m_tmp_fits.path().native(), true);
+  writer.addRows(makeRows(0, 10));
+  BOOST_CHECK_THROW(writer.addRows(makeRows(10, 10, 4)), Elements::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE( string_width_test, FitsTableWriterFixture ) {
+  auto column_info = std::make_shared<ColumnInfo>(std::vector<ColumnDescription>{
+    ColumnDescription{"name", typeid(std::string)},
+  });
+  auto makeRow = [&column_info](const std::string& name) {
+    return Row(std::vector<Row::cell_type>{name}, column_info);
+  };
+
+  FitsTableWriter writer(m_tmp_fits.path().native(), true);
+  writer.addRows({makeRow("ab"), makeRow("abcd")});
+  writer.addRows({makeRow("wxyz")});
+  BOOST_CHECK_THROW(writer.addRows({makeRow("abcde")}), Elements::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
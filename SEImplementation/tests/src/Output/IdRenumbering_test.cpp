@@ -0,0 +1,92 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * IdRenumbering_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <ElementsKernel/Exception.h>
+
+#include "SEImplementation/Output/IdRenumbering.h"
+
+using namespace SourceXtractor;
+using Euclid::Table::ColumnDescription;
+using Euclid::Table::ColumnInfo;
+using Euclid::Table::Row;
+
+struct IdRenumberingFixture {
+  std::shared_ptr<ColumnInfo> m_column_info = std::make_shared<ColumnInfo>(std::vector<ColumnDescription>{
+    ColumnDescription{"source_id", typeid(std::int32_t)},
+    ColumnDescription{"group_id", typeid(std::int64_t)},
+    ColumnDescription{"flux", typeid(double)},
+  });
+  IdRenumbering m_renumbering {{"source_id", "group_id"}};
+
+  std::pair<std::int64_t, std::int64_t> apply(std::int32_t source_id, std::int64_t group_id) {
+    auto row = m_renumbering.apply(Row({source_id, group_id, 1.}, m_column_info));
+    return {boost::get<std::int32_t>(row[0]), boost::get<std::int64_t>(row[1])};
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (IdRenumbering_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( shift_test, IdRenumberingFixture ) {
+  m_renumbering.nextShard();
+  BOOST_CHECK((apply(2, 1) == std::pair<std::int64_t, std::int64_t>(2, 1)));
+  BOOST_CHECK((apply(5, 3) == std::pair<std::int64_t, std::int64_t>(5, 3)));
+
+  // Each shard starts past the largest ids of the previous ones, whatever their order
+  m_renumbering.nextShard();
+  BOOST_CHECK_EQUAL(m_renumbering.getOffset("source_id"), 5);
+  BOOST_CHECK_EQUAL(m_renumbering.getOffset("group_id"), 3);
+  BOOST_CHECK((apply(1, 1) == std::pair<std::int64_t, std::int64_t>(6, 4)));
+
+  m_renumbering.nextShard();
+  BOOST_CHECK((apply(1, 2) == std::pair<std::int64_t, std::int64_t>(7, 6)));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( check_image_ids_test, IdRenumberingFixture ) {
+  // Ids only seen in a check image are skipped too
+  m_renumbering.nextShard();
+  apply(3, 1);
+  m_renumbering.updateMaxId("source_id", 10);
+  m_renumbering.nextShard();
+  BOOST_CHECK_EQUAL(m_renumbering.getOffset("source_id"), 10);
+  BOOST_CHECK_EQUAL(m_renumbering.getOffset("group_id"), 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( not_integer_test, IdRenumberingFixture ) {
+  IdRenumbering renumbering({"flux"});
+  renumbering.nextShard();
+  BOOST_CHECK_THROW(renumbering.apply(Row({std::int32_t(1), std::int64_t(1), 1.}, m_column_info)),
+                    Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
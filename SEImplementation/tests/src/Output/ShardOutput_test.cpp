@@ -0,0 +1,111 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * ShardOutput_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Source/SimpleSource.h"
+#include "SEImplementation/Plugin/DetectionFrameInfo/DetectionFrameInfo.h"
+#include "SEImplementation/Plugin/PixelBoundaries/PixelBoundaries.h"
+#include "SEImplementation/Plugin/PixelCentroid/PixelCentroid.h"
+
+#include "SEImplementation/Output/ShardOutput.h"
+
+using namespace SourceXtractor;
+
+/// Keeps the centroids of the sources written
+class RecordingOutput : public Output {
+public:
+  void outputSource(const SourceInterface& source) override {
+    auto& centroid = source.getProperty<PixelCentroid>();
+    m_centroids.emplace_back(centroid.getCentroidX(), centroid.getCentroidY());
+  }
+
+  size_t flush() override {
+    return m_centroids.size();
+  }
+
+  void nextPart() override {
+  }
+
+  std::vector<std::pair<double, double>> m_centroids;
+};
+
+struct ShardOutputFixture {
+  std::shared_ptr<RecordingOutput> recorder = std::make_shared<RecordingOutput>();
+
+  // Pixels 10 to 19 along both axes, of a 100x100 image
+  PixelRectangle core_region {PixelCoordinate(10, 10), PixelCoordinate(19, 19)};
+
+  void output(ShardOutput& shard_output, double x, double y) {
+    SimpleSource source;
+    source.setProperty<PixelCentroid>(x, y);
+    source.setProperty<PixelBoundaries>(int(x) - 1, int(y) - 1, int(x) + 1, int(y) + 1);
+    source.setProperty<DetectionFrameInfo>(100, 100, 1., 0., 0., 0.);
+    shard_output.outputSource(source);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (ShardOutput_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( ownership_test, ShardOutputFixture ) {
+  ShardOutput shard_output(recorder, core_region, 5);
+
+  // The pixel containing the centroid decides, pixel centers are at integer coordinates
+  output(shard_output, 9.25, 15);
+  output(shard_output, 9.5, 15);
+  output(shard_output, 19.25, 15);
+  output(shard_output, 19.5, 15);
+  output(shard_output, 15, 9.25);
+  output(shard_output, 15, 19.5);
+  output(shard_output, 15, 15);
+
+  std::vector<std::pair<double, double>> expected {{9.5, 15}, {19.25, 15}, {15, 15}};
+  BOOST_CHECK(recorder->m_centroids == expected);
+  BOOST_CHECK_EQUAL(shard_output.flush(), 3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( abutting_shards_test, ShardOutputFixture ) {
+  // Every source is written by exactly one of two abutting shards
+  auto right_recorder = std::make_shared<RecordingOutput>();
+  ShardOutput left(recorder, core_region, 5);
+  ShardOutput right(right_recorder, PixelRectangle(PixelCoordinate(20, 10), PixelCoordinate(29, 19)), 5);
+
+  for (double x = 15; x < 25; x += 0.25) {
+    output(left, x, 12);
+    output(right, x, 12);
+  }
+  BOOST_CHECK_EQUAL(recorder->m_centroids.size() + right_recorder->m_centroids.size(), 40);
+  BOOST_CHECK_EQUAL(recorder->m_centroids.back().first, 19.25);
+  BOOST_CHECK_EQUAL(right_recorder->m_centroids.front().first, 19.5);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
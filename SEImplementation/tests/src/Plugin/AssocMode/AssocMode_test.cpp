@@ -160,6 +160,25 @@ BOOST_FIXTURE_TEST_CASE(CheckAssocMax, AssocModeFixture) {
   BOOST_CHECK_CLOSE(assoc_mode_property.getAssocValues().at(1), 7.0, 0.001);
 }
 
+BOOST_FIXTURE_TEST_CASE(CheckAssocMatchRadius, AssocModeFixture) {
+  source.setProperty<PixelCentroid>(100, 100);
+
+  // Entries with their own match radius, the second one uses the assoc radius
+  std::vector<std::vector<AssocModeConfig::CatalogEntry>> radius_catalog { {
+    { {110, 100}, {}, 1.0, {2.0}, 0., 0, 20. },
+    { {100, 104}, {}, 1.0, {3.0}, 0., 0, 0. },
+    { {100, 103}, {}, 1.0, {50.0}, 0., 0, 1. },
+  } };
+
+  AssocModeTask assoc_mode_task(radius_catalog, AssocModeConfig::AssocMode::SUM, 5.0);
+  assoc_mode_task.computeProperties(source);
+
+  auto assoc_mode_property = source.getProperty<AssocMode>();
+
+  BOOST_CHECK(assoc_mode_property.getMatch());
+  BOOST_CHECK_CLOSE(assoc_mode_property.getAssocValues().at(0), 5.0, 0.001);
+}
+
 BOOST_FIXTURE_TEST_CASE(CheckLargeCatalog, AssocModeFixture) {
   boost::random::mt19937 rng { (unsigned int) time(NULL) } ;
   std::vector<AssocModeConfig::CatalogEntry> large_catalog;
@@ -0,0 +1,136 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * AssocSkyIndex_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <boost/test/unit_test.hpp>
+
+#include <ElementsKernel/Temporary.h>
+
+#include "SEImplementation/Plugin/AssocMode/AssocSkyIndex.h"
+
+using namespace SourceXtractor;
+
+/**
+ * Plate carree projection, wrapping around the right ascension origin
+ */
+class WrappingCoordinateSystem : public CoordinateSystem {
+public:
+  WrappingCoordinateSystem(double ra0, double dec0, double scale) : m_ra0(ra0), m_dec0(dec0), m_scale(scale) {}
+
+  WorldCoordinate imageToWorld(ImageCoordinate c) const override {
+    return {std::fmod(m_ra0 + c.m_x * m_scale + 360., 360.), m_dec0 + c.m_y * m_scale};
+  }
+
+  ImageCoordinate worldToImage(WorldCoordinate w) const override {
+    double dra = std::fmod(w.m_alpha - m_ra0 + 540., 360.) - 180.;
+    return {dra / m_scale, (w.m_delta - m_dec0) / m_scale};
+  }
+
+private:
+  double m_ra0, m_dec0, m_scale;
+};
+
+struct AssocSkyIndexFixture {
+  Elements::TempFile m_index_file;
+  std::vector<AssocModeConfig::CatalogEntry> m_entries;
+
+  AssocSkyIndexFixture() {
+    double id = 0;
+    for (double dec = -89.5; dec < 90; dec += 0.5) {
+      for (double ra = 0; ra < 360; ra += 0.5) {
+        m_entries.emplace_back(AssocModeConfig::CatalogEntry{{}, {ra, dec}, 1.0, {id++}, 2.0, 0, 0.});
+      }
+    }
+    AssocSkyIndex::Builder builder(m_index_file.path().native(), 1.0, 1);
+    for (auto& entry : m_entries) {
+      builder.add(entry);
+    }
+    builder.finish();
+  }
+
+  /// Ids of the entries that fall on the image, without the index
+  std::set<double> bruteForce(const CoordinateSystem& coordinate_system, int width, int height, double margin) {
+    std::set<double> ids;
+    for (auto& entry : m_entries) {
+      auto c = coordinate_system.worldToImage(entry.world_coord);
+      if (c.m_x >= -margin && c.m_x <= width + margin && c.m_y >= -margin && c.m_y <= height + margin) {
+        ids.insert(entry.assoc_columns[0]);
+      }
+    }
+    return ids;
+  }
+
+  static std::set<double> getIds(const std::vector<AssocModeConfig::CatalogEntry>& entries) {
+    std::set<double> ids;
+    for (auto& entry : entries) {
+      ids.insert(entry.assoc_columns[0]);
+    }
+    return ids;
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (AssocSkyIndex_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( read_all_test, AssocSkyIndexFixture ) {
+  AssocSkyIndex index(m_index_file.path().native());
+  BOOST_CHECK_EQUAL(index.getAssocColumnsNb(), 1);
+  BOOST_CHECK_EQUAL(index.getEntriesNb(), m_entries.size());
+  BOOST_CHECK_EQUAL(index.getMaxSourceRadius(), 2.0);
+  BOOST_CHECK_EQUAL(index.readAll().size(), m_entries.size());
+}
+
+BOOST_FIXTURE_TEST_CASE( query_test, AssocSkyIndexFixture ) {
+  AssocSkyIndex index(m_index_file.path().native());
+  WrappingCoordinateSystem coordinate_system(10.2, 20.3, 0.01);
+
+  auto entries = index.query(coordinate_system, 400, 300, 10);
+  BOOST_CHECK_LT(entries.size(), m_entries.size() / 1000);
+  BOOST_CHECK(getIds(entries) == bruteForce(coordinate_system, 400, 300, 10));
+  for (auto& entry : entries) {
+    BOOST_CHECK_EQUAL(entry.source_radius_pixels, 2.0);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE( query_wrap_test, AssocSkyIndexFixture ) {
+  AssocSkyIndex index(m_index_file.path().native());
+  WrappingCoordinateSystem coordinate_system(358.9, -45.1, 0.01);
+
+  auto entries = index.query(coordinate_system, 400, 400, 0);
+  BOOST_CHECK(!entries.empty());
+  BOOST_CHECK(getIds(entries) == bruteForce(coordinate_system, 400, 400, 0));
+}
+
+BOOST_FIXTURE_TEST_CASE( not_an_index_test, AssocSkyIndexFixture ) {
+  Elements::TempFile other_file;
+  std::ofstream(other_file.path().native()) << "SIMPLE";
+  BOOST_CHECK_THROW(AssocSkyIndex(other_file.path().native()), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,86 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Source/SimpleSource.h"
+
+#include "SEImplementation/Plugin/FlexibleModelFitting/FlexibleModelFittingParameter.h"
+#include "SEImplementation/Plugin/ReferenceCoordinates/ReferenceCoordinates.h"
+
+using namespace SourceXtractor;
+
+struct FlexibleModelFittingParameterFixture {
+  SimpleSource source;
+  std::vector<std::shared_ptr<FlexibleModelFittingParameter>> dependees {
+    std::make_shared<FlexibleModelFittingConstantParameter>(0, [](const SourceInterface&) { return 0.; }),
+    std::make_shared<FlexibleModelFittingConstantParameter>(1, [](const SourceInterface&) { return 0.; })
+  };
+
+  static double value(const std::shared_ptr<CoordinateSystem>&, const std::vector<double>& params) {
+    return params[0] * params[1] + params[0] * params[0];
+  }
+
+  FlexibleModelFittingParameterFixture() {
+    source.setProperty<ReferenceCoordinates>(nullptr);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (FlexibleModelFittingParameter_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( partial_derivatives_test, FlexibleModelFittingParameterFixture ) {
+  FlexibleModelFittingDependentParameter dependent(2, value, dependees);
+
+  auto derivatives = dependent.getPartialDerivatives(source, {3., 5.});
+  BOOST_REQUIRE_EQUAL(derivatives.size(), 2);
+  BOOST_CHECK_CLOSE(derivatives[0], 11., 1e-4);
+  BOOST_CHECK_CLOSE(derivatives[1], 3., 1e-4);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( batch_test, FlexibleModelFittingParameterFixture ) {
+  int batches = 0, evaluations = 0;
+  auto batch = [&batches, &evaluations](const std::shared_ptr<CoordinateSystem>& cs,
+                                        const std::vector<std::vector<double>>& params, std::vector<double>& out) {
+    ++batches;
+    out.clear();
+    for (auto& p : params) {
+      ++evaluations;
+      out.emplace_back(value(cs, p));
+    }
+  };
+
+  FlexibleModelFittingDependentParameter dependent(2, value, dependees, batch);
+  FlexibleModelFittingDependentParameter scalar(2, value, dependees);
+
+  auto derivatives = dependent.getPartialDerivatives(source, {-1.5, 2.});
+  BOOST_CHECK_EQUAL(batches, 1);
+  BOOST_CHECK_GE(evaluations, 4);
+
+  // Same sampling points, so the same result
+  auto expected = scalar.getPartialDerivatives(source, {-1.5, 2.});
+  BOOST_CHECK_EQUAL_COLLECTIONS(derivatives.begin(), derivatives.end(), expected.begin(), expected.end());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
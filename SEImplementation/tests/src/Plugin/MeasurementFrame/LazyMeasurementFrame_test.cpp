@@ -0,0 +1,212 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Image/VectorImage.h"
+
+#include "SEImplementation/Plugin/MeasurementFrame/LazyMeasurementFrame.h"
+
+using namespace SourceXtractor;
+
+struct LazyMeasurementFrameFixture {
+  std::atomic<int> builds{0};
+
+  LazyMeasurementFrame::Builder builder() {
+    return [this]() {
+      ++builds;
+      auto frame = std::make_shared<MeasurementImageFrame>(VectorImage<SeFloat>::create(10, 8));
+      frame->setBackgroundLevel(VectorImage<SeFloat>::create(10, 8), 2.5);
+      return frame;
+    };
+  }
+
+  std::shared_ptr<LazyMeasurementFrame> create(std::shared_ptr<LazyMeasurementFrame::LoadedFrames> loaded = nullptr) {
+    return std::make_shared<LazyMeasurementFrame>(10, 8, nullptr, 1.5, 60000., builder(), loaded);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (LazyMeasurementFrame_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Deferred_test, LazyMeasurementFrameFixture ) {
+  auto lazy = create();
+
+  // The header values do not need the frame
+  BOOST_CHECK_EQUAL(lazy->getWidth(), 10);
+  BOOST_CHECK_EQUAL(lazy->getHeight(), 8);
+  BOOST_CHECK_EQUAL(lazy->getGain(), 1.5);
+  BOOST_CHECK_EQUAL(lazy->getSaturation(), 60000.);
+  BOOST_CHECK(!lazy->isLoaded());
+  BOOST_CHECK_EQUAL(builds, 0);
+
+  BOOST_CHECK_EQUAL(lazy->getBackgroundMedianRms(), 2.5);
+  BOOST_CHECK(lazy->isLoaded());
+  auto frame = lazy->getFrame();
+  BOOST_CHECK_EQUAL(lazy->getFrame(), frame);
+  BOOST_CHECK_EQUAL(builds, 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Concurrent_test, LazyMeasurementFrameFixture ) {
+  auto lazy = create();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([lazy]() {
+      lazy->getFrame();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(builds, 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Building_test, LazyMeasurementFrameFixture ) {
+  std::atomic<bool> started{false}, release{false};
+  auto build = builder();
+  auto lazy = std::make_shared<LazyMeasurementFrame>(10, 8, nullptr, 1.5, 60000., [&]() {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+    return build();
+  });
+
+  std::thread loader([lazy]() {
+    lazy->getFrame();
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  // The state can be queried while the frame is being built
+  BOOST_CHECK(!lazy->isLoaded());
+  BOOST_CHECK_EQUAL(lazy->getLoadCount(), 0);
+  lazy->unload();
+
+  release = true;
+  loader.join();
+  BOOST_CHECK(lazy->isLoaded());
+  BOOST_CHECK_EQUAL(builds, 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( ConcurrentUnload_test, LazyMeasurementFrameFixture ) {
+  auto loaded = std::make_shared<LazyMeasurementFrame::LoadedFrames>(1);
+  std::vector<std::shared_ptr<LazyMeasurementFrame>> frames{create(loaded), create(loaded), create(loaded)};
+
+  // Frames are unloaded by a thread while others use them
+  std::atomic<int> missing{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&frames, &missing, i]() {
+      for (int j = 0; j < 100; ++j) {
+        if (!frames[(i + j) % frames.size()]->getFrame()) {
+          ++missing;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(missing, 0);
+  BOOST_CHECK_LE(loaded->getLoadedCount(), 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Unload_test, LazyMeasurementFrameFixture ) {
+  auto loaded = std::make_shared<LazyMeasurementFrame::LoadedFrames>(2);
+  auto a = create(loaded), b = create(loaded), c = create(loaded);
+
+  auto frame_a = a->getFrame();
+  b->getFrame();
+  a->getFrame();
+  c->getFrame();
+
+  // b is the least recently used
+  BOOST_CHECK_EQUAL(loaded->getLoadedCount(), 2);
+  BOOST_CHECK(a->isLoaded());
+  BOOST_CHECK(!b->isLoaded());
+  BOOST_CHECK(c->isLoaded());
+
+  // Still known without building it again
+  BOOST_CHECK_EQUAL(b->getBackgroundMedianRms(), 2.5);
+  BOOST_CHECK_EQUAL(b->getLoadCount(), 1);
+
+  b->getFrame();
+  BOOST_CHECK_EQUAL(b->getLoadCount(), 2);
+  BOOST_CHECK(!a->isLoaded());
+  BOOST_CHECK_EQUAL(builds, 4);
+
+  // References taken before stay valid
+  BOOST_CHECK_EQUAL(frame_a->getBackgroundMedianRms(), 2.5);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( InUse_test, LazyMeasurementFrameFixture ) {
+  auto loaded = std::make_shared<LazyMeasurementFrame::LoadedFrames>(1);
+  auto a = create(loaded), b = create(loaded);
+
+  auto frame_a = a->getFrame();
+  b->getFrame();
+  BOOST_CHECK(!a->isLoaded());
+
+  // Still used by a source, so taken back instead of built again
+  BOOST_CHECK_EQUAL(a->getFrame(), frame_a);
+  BOOST_CHECK_EQUAL(a->getLoadCount(), 1);
+  BOOST_CHECK(!b->isLoaded());
+
+  // Released by everyone, so freed and built again
+  std::weak_ptr<MeasurementImageFrame> weak_a = frame_a;
+  frame_a.reset();
+  b->getFrame();
+  BOOST_CHECK(weak_a.expired());
+  a->getFrame();
+  BOOST_CHECK_EQUAL(a->getLoadCount(), 2);
+  BOOST_CHECK_EQUAL(builds, 4);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( Wrapped_test, LazyMeasurementFrameFixture ) {
+  auto frame = std::make_shared<MeasurementImageFrame>(VectorImage<SeFloat>::create(4, 3));
+  LazyMeasurementFrame lazy(frame);
+  BOOST_CHECK_EQUAL(lazy.getWidth(), 4);
+  BOOST_CHECK_EQUAL(lazy.getHeight(), 3);
+  lazy.unload();
+  BOOST_CHECK_EQUAL(lazy.getFrame(), frame);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
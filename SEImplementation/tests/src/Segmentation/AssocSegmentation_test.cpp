@@ -0,0 +1,106 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "SEFramework/Source/SimpleSourceFactory.h"
+#include "SEImplementation/Plugin/AssocMode/AssocMode.h"
+
+#include "SEImplementation/Segmentation/AssocSegmentation.h"
+
+using namespace SourceXtractor;
+
+/// Writes the group id of each source, and a '|' for each request to process them
+class SequenceRecorder : public PipelineReceiver<SourceInterface> {
+public:
+  void receiveSource(std::unique_ptr<SourceInterface> source) override {
+    m_sequence << source->getProperty<AssocMode>().getGroupId() << ' ';
+  }
+
+  void receiveProcessSignal(const ProcessSourcesEvent&) override {
+    m_sequence << "| ";
+  }
+
+  std::stringstream m_sequence;
+};
+
+struct AssocSegmentationFixture {
+  std::vector<AssocModeConfig::CatalogEntry> catalog {
+    {ImageCoordinate(5, 50), WorldCoordinate(0, 0), 1., {}, 1., 2, 0.},
+    {ImageCoordinate(5, 10), WorldCoordinate(0, 0), 1., {}, 1., 1, 0.},
+    {ImageCoordinate(5, std::numeric_limits<double>::quiet_NaN()), WorldCoordinate(0, 0), 1., {}, 1., 3, 0.},
+    {ImageCoordinate(5, 60.5), WorldCoordinate(0, 0), 1., {}, 1., 1, 0.},
+    {ImageCoordinate(5, 30.2), WorldCoordinate(0, 0), 1., {}, 1., 0, 0.},
+    {ImageCoordinate(8, 30.7), WorldCoordinate(0, 0), 1., {}, 1., 0, 0.},
+    {ImageCoordinate(2, 45), WorldCoordinate(0, 0), 1., {}, 1., 0, 0.},
+  };
+  std::shared_ptr<SequenceRecorder> recorder = std::make_shared<SequenceRecorder>();
+
+  std::string segment(bool streaming) {
+    Segmentation segmentation(nullptr);
+    segmentation.setLabelling<AssocSegmentation>(std::make_shared<SimpleSourceFactory>(), catalog, streaming);
+    segmentation.setNextStage(recorder);
+    segmentation.processFrame(nullptr);
+    return recorder->m_sequence.str();
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (AssocSegmentation_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( catalog_order_test, AssocSegmentationFixture ) {
+  BOOST_CHECK_EQUAL(segment(false), "2 1 3 1 0 0 0 | ");
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( streaming_test, AssocSegmentationFixture ) {
+  // Group 1 is reached at row 10 and published whole, entries without a position come last.
+  // Entries without a group id are groups of their own, released at their row.
+  BOOST_CHECK_EQUAL(segment(true), "1 1 | 0 0 | 0 | 2 | 3 | ");
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( streaming_overlapping_test, AssocSegmentationFixture ) {
+  // Two sources of radius 5 overlap, but sit on different rows: only a shared group id keeps them together,
+  // so the groupings on the pixels would split them
+  catalog = {
+    {ImageCoordinate(5, 20), WorldCoordinate(0, 0), 1., {}, 5., 0, 0.},
+    {ImageCoordinate(6, 23), WorldCoordinate(0, 0), 1., {}, 5., 0, 0.},
+    {ImageCoordinate(20, 20), WorldCoordinate(0, 0), 1., {}, 5., 4, 0.},
+    {ImageCoordinate(21, 23), WorldCoordinate(0, 0), 1., {}, 5., 4, 0.},
+  };
+  BOOST_CHECK_EQUAL(segment(true), "0 4 4 | 0 | ");
+
+  BOOST_CHECK(AssocSegmentation::isStreamingSupported(GroupingConfig::Algorithm::ASSOC));
+  BOOST_CHECK(AssocSegmentation::isStreamingSupported(GroupingConfig::Algorithm::NO_GROUPING));
+  BOOST_CHECK(AssocSegmentation::isStreamingSupported(GroupingConfig::Algorithm::SPLIT_SOURCES));
+  BOOST_CHECK(!AssocSegmentation::isStreamingSupported(GroupingConfig::Algorithm::OVERLAPPING));
+  BOOST_CHECK(!AssocSegmentation::isStreamingSupported(GroupingConfig::Algorithm::MOFFAT));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
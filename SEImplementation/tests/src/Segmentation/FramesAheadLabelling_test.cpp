@@ -0,0 +1,121 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * FramesAheadLabelling_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "SEFramework/Image/ConstantImage.h"
+#include "SEFramework/Source/SimpleSource.h"
+#include "SEImplementation/Property/SourceId.h"
+#include "SEImplementation/Segmentation/FramesAheadLabelling.h"
+
+using namespace SourceXtractor;
+
+/// Publishes as many sources as the index of the frame plus one, the last ones slower to label
+class CountingLabelling : public Segmentation::Labelling {
+public:
+  explicit CountingLabelling(const std::vector<std::shared_ptr<DetectionImageFrame>>& frames) : m_frames(frames) {}
+
+  void labelImage(Segmentation::LabellingListener& listener, std::shared_ptr<const DetectionImageFrame> frame) override {
+    size_t index = std::find(m_frames.begin(), m_frames.end(), frame) - m_frames.begin();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_threads[index] = std::this_thread::get_id();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 * (m_frames.size() - index)));
+    for (size_t i = 0; i <= index; ++i) {
+      std::unique_ptr<SourceInterface> source(new SimpleSource);
+      source->setProperty<SourceId>();
+      listener.publishSource(std::move(source));
+    }
+    listener.requestProcessing(ProcessSourcesEvent(nullptr));
+  }
+
+  std::vector<std::shared_ptr<DetectionImageFrame>> m_frames;
+  std::map<size_t, std::thread::id> m_threads;
+  std::mutex m_mutex;
+};
+
+/// Records the sources and the processing requests, in the order they are received
+struct Receiver : public PipelineReceiver<SourceInterface> {
+  void receiveSource(std::unique_ptr<SourceInterface> source) override {
+    m_events.push_back(source->getProperty<SourceId>().getSourceId());
+  }
+
+  void receiveProcessSignal(const ProcessSourcesEvent&) override {
+    m_events.push_back(0);
+  }
+
+  std::vector<unsigned> m_events;
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (FramesAheadLabelling_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( replay_in_order_test ) {
+  std::vector<std::shared_ptr<DetectionImageFrame>> frames;
+  for (int i = 0; i < 4; ++i) {
+    frames.emplace_back(std::make_shared<DetectionImageFrame>(ConstantImage<DetectionImage::PixelType>::create(4, 4, 0)));
+  }
+
+  auto labelling = std::make_shared<CountingLabelling>(frames);
+  auto receiver = std::make_shared<Receiver>();
+
+  Segmentation segmentation(nullptr);
+  segmentation.setLabelling<FramesAheadLabelling>(labelling, frames, nullptr, 2);
+  segmentation.setNextStage(receiver);
+
+  auto first_id = SourceId::getNextId();
+  for (auto& frame : frames) {
+    segmentation.processFrame(frame);
+  }
+
+  // Same sources, identifiers and requests as when labelling one frame after the other
+  std::vector<unsigned> expected;
+  unsigned id = first_id;
+  for (size_t frame_index = 0; frame_index < frames.size(); ++frame_index) {
+    for (size_t i = 0; i <= frame_index; ++i) {
+      expected.push_back(id++);
+    }
+    // From the labelling, then from the segmentation at the end of the frame
+    expected.push_back(0);
+    expected.push_back(0);
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(receiver->m_events.begin(), receiver->m_events.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(SourceId::getNextId(), id);
+
+  // Only the first frame is labelled by the calling thread
+  BOOST_CHECK(labelling->m_threads[0] == std::this_thread::get_id());
+  for (size_t frame_index = 1; frame_index < frames.size(); ++frame_index) {
+    BOOST_CHECK(labelling->m_threads[frame_index] != std::this_thread::get_id());
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,144 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * RemeasureSegmentation_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "ElementsKernel/Temporary.h"
+
+#include "SEFramework/FITS/FitsWriter.h"
+#include "SEFramework/Image/TileManager.h"
+#include "SEFramework/Image/VectorImage.h"
+#include "SEFramework/Source/SimpleSourceFactory.h"
+#include "SEImplementation/Configuration/CheckImagesConfig.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceID.h"
+#include "SEImplementation/Property/PixelCoordinateList.h"
+#include "SEImplementation/Property/SourceId.h"
+
+#include "SEImplementation/Segmentation/RemeasureSegmentation.h"
+
+using namespace SourceXtractor;
+
+/// Counts the pixels of each source id, and keeps the detection id
+class SourceRecorder : public PipelineReceiver<SourceInterface> {
+public:
+  void receiveSource(std::unique_ptr<SourceInterface> source) override {
+    auto& source_id = source->getProperty<SourceID>();
+    m_pixels[source_id.getId()] = source->getProperty<PixelCoordinateList>().getCoordinateList().size();
+    m_detection_ids[source_id.getId()] = source->getProperty<SourceId>().getDetectionId();
+  }
+
+  void receiveProcessSignal(const ProcessSourcesEvent&) override {
+  }
+
+  std::map<int, size_t> m_pixels;
+  std::map<int, unsigned int> m_detection_ids;
+};
+
+struct RemeasureSegmentationFixture {
+  Elements::TempDir directory;
+  std::string partition_path = (directory.path() / "partition.fits").native();
+  std::vector<std::string> partition_paths;
+  std::shared_ptr<RemeasureConfig::SourceMap> sources = std::make_shared<RemeasureConfig::SourceMap>();
+  std::shared_ptr<SourceRecorder> recorder = std::make_shared<SourceRecorder>();
+
+  RemeasureSegmentationFixture() {
+    // Sources 3 and 7 on the first detection image, 12 on the second; 9 is missing from the catalog
+    std::vector<int> first {
+      0, 3, 3, 0, 0,
+      0, 3, 0, 0, 9,
+      0, 0, 0, 7, 7,
+      0, 0, 0, 7, 0,
+    };
+    std::vector<int> second {
+      0, 0, 0, 0, 0,
+      0, 12, 12, 12, 0,
+      0, 0, 12, 0, 0,
+      0, 0, 0, 0, 0,
+    };
+    for (size_t i = 0; i < 2; ++i) {
+      partition_paths.emplace_back(CheckImagesConfig::addNumberToFilename(partition_path, i, true));
+      FitsWriter::writeFile(*VectorImage<int>::create(5, 4, i == 0 ? first : second), partition_paths.back());
+    }
+    TileManager::getInstance()->flush();
+
+    (*sources)[3] = {1, 1};
+    (*sources)[7] = {1, 1};
+    (*sources)[12] = {2, 5};
+  }
+
+  void segment(size_t hdu_index) {
+    auto frame = std::make_shared<DetectionImageFrame>(VectorImage<DetectionImage::PixelType>::create(5, 4));
+    frame->setHduIndex(hdu_index);
+
+    Segmentation segmentation(nullptr);
+    segmentation.setLabelling<RemeasureSegmentation>(std::make_shared<SimpleSourceFactory>(), partition_paths,
+                                                     sources);
+    segmentation.setNextStage(recorder);
+    segmentation.processFrame(frame);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (RemeasureSegmentation_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( numbered_filename_test ) {
+  BOOST_CHECK_EQUAL(CheckImagesConfig::addNumberToFilename("dir/partition.fits", 1, true), "dir/partition_1.fits");
+  BOOST_CHECK_EQUAL(CheckImagesConfig::addNumberToFilename("dir/partition.fits", 1, false), "dir/partition.fits");
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( first_frame_test, RemeasureSegmentationFixture ) {
+  segment(0);
+
+  // The sources keep their ids, with gaps, and the pixels missing from the catalog are ignored
+  std::map<int, size_t> expected_pixels {{3, 3}, {7, 3}};
+  BOOST_CHECK(recorder->m_pixels == expected_pixels);
+  BOOST_CHECK_EQUAL(recorder->m_detection_ids.at(3), 1);
+  BOOST_CHECK_EQUAL(recorder->m_detection_ids.at(7), 1);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( second_frame_test, RemeasureSegmentationFixture ) {
+  segment(1);
+
+  std::map<int, size_t> expected_pixels {{12, 4}};
+  BOOST_CHECK(recorder->m_pixels == expected_pixels);
+  BOOST_CHECK_EQUAL(recorder->m_detection_ids.at(12), 2);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE( missing_partition_image_test, RemeasureSegmentationFixture ) {
+  BOOST_CHECK_THROW(segment(2), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,72 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * FrameSplitter.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef _SEMAIN_FRAMESPLITTER_H_
+#define _SEMAIN_FRAMESPLITTER_H_
+
+#include "SEFramework/Pipeline/PipelineStage.h"
+#include "SEFramework/Source/SourceGroupInterface.h"
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace SourceXtractor {
+
+/**
+ * @class FrameSplitter
+ * @brief
+ *  Detects the end of a detection frame on the output side of the pipeline, so the segmentation of
+ *  the next frame does not need to wait for the measurement of the previous one.
+ *
+ * @details
+ *  Detection identifiers are assigned in segmentation order, so everything detected on a frame
+ *  has a lower identifier than anything detected on the following frames. The main loop registers,
+ *  after segmenting each frame, the first identifier that belongs to the next one. Groups must arrive
+ *  sorted (i.e. from a Sorter), and the callback is called when the first group of a later frame
+ *  is received, before it is passed downstream.
+ */
+class FrameSplitter: public PipelineReceiver<SourceGroupInterface>, public PipelineEmitter<SourceGroupInterface> {
+public:
+  using FrameEndCallback = std::function<void()>;
+
+  explicit FrameSplitter(FrameEndCallback on_frame_end);
+  virtual ~FrameSplitter() = default;
+
+  void receiveSource(std::unique_ptr<SourceGroupInterface> source) override;
+  void receiveProcessSignal(const ProcessSourcesEvent& event) override;
+
+  /// Register the end of the frame whose segmentation has just finished
+  void endFrame();
+
+  /// Close the frames still open. The pipeline must have been drained before.
+  void finish();
+
+private:
+  FrameEndCallback m_on_frame_end;
+  std::mutex m_boundaries_mutex;
+  std::deque<unsigned int> m_boundaries;
+};
+
+} // end SourceXtractor
+
+#endif // _SEMAIN_FRAMESPLITTER_H_
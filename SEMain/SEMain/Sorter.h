@@ -33,7 +33,8 @@ namespace SourceXtractor {
 class Sorter: public PipelineReceiver<SourceGroupInterface>, public PipelineEmitter<SourceGroupInterface> {
 public:
 
-  Sorter();
+  /// @param first_source_id Identifier of the first source to be emitted
+  explicit Sorter(int first_source_id = 1);
   virtual ~Sorter() = default;
 
   void receiveSource(std::unique_ptr<SourceGroupInterface> source) override;
@@ -0,0 +1,72 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * FrameSplitter.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "SEMain/FrameSplitter.h"
+#include <SEImplementation/Property/SourceId.h>
+
+namespace SourceXtractor {
+
+FrameSplitter::FrameSplitter(FrameEndCallback on_frame_end): m_on_frame_end{std::move(on_frame_end)} {
+}
+
+void FrameSplitter::receiveSource(std::unique_ptr<SourceGroupInterface> message) {
+  // All the sources of a group come from the same frame
+  auto detection_id = message->cbegin()->getProperty<SourceId>().getDetectionId();
+
+  int closed_frames = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_boundaries_mutex);
+    while (!m_boundaries.empty() && detection_id >= m_boundaries.front()) {
+      m_boundaries.pop_front();
+      ++closed_frames;
+    }
+  }
+  for (int i = 0; i < closed_frames; ++i) {
+    m_on_frame_end();
+  }
+
+  sendSource(std::move(message));
+}
+
+void FrameSplitter::receiveProcessSignal(const ProcessSourcesEvent& event) {
+  sendProcessSignal(event);
+}
+
+void FrameSplitter::endFrame() {
+  std::lock_guard<std::mutex> lock(m_boundaries_mutex);
+  m_boundaries.emplace_back(SourceId::getNextId());
+}
+
+void FrameSplitter::finish() {
+  size_t closed_frames;
+  {
+    std::lock_guard<std::mutex> lock(m_boundaries_mutex);
+    closed_frames = m_boundaries.size();
+    m_boundaries.clear();
+  }
+  for (size_t i = 0; i < closed_frames; ++i) {
+    m_on_frame_end();
+  }
+}
+
+} // end SourceXtractor
@@ -26,7 +26,7 @@ static unsigned int extractSourceId(const SourceInterface &i) {
   return i.getProperty<SourceID>().getId();
 }
 
-Sorter::Sorter(): m_output_next{1} {
+Sorter::Sorter(int first_source_id): m_output_next{first_source_id} {
 }
 
 void Sorter::receiveSource(std::unique_ptr<SourceGroupInterface> message) {
@@ -0,0 +1,434 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+/*
+ * MergeShards.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ElementsKernel/ProgramHeaders.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <fitsio.h>
+
+#include "Table/FitsReader.h"
+
+#include "SEImplementation/Configuration/ShardConfig.h"
+#include "SEImplementation/Output/FitsTableWriter.h"
+#include "SEImplementation/Output/IdRenumbering.h"
+
+namespace po = boost::program_options;
+
+using namespace SourceXtractor;
+using Euclid::Table::Row;
+
+static Elements::Logging logger = Elements::Logging::getLogger("MergeShards");
+
+static const std::string SHARD_CATALOG {"shard-catalog"};
+static const std::string SHARD_REGION {"shard-region"};
+static const std::string SHARD_CHECK_IMAGE {"shard-check-image"};
+static const std::string OUTPUT_CATALOG {"output-catalog"};
+static const std::string OUTPUT_CHECK_IMAGE {"output-check-image"};
+static const std::string ID_COLUMNS {"id-columns"};
+static const std::string SORT_COLUMN {"sort-column"};
+static const std::string CHECK_IMAGE_ID_COLUMN {"check-image-id-column"};
+static const std::string CHECK_IMAGE_HDU {"check-image-hdu"};
+
+// Rows read from each shard catalog at once
+static const std::size_t CHUNK_SIZE = 100000;
+
+// Rows of pixels copied from each shard check image at once
+static const long CHECK_IMAGE_ROWS = 256;
+
+static void checkFitsStatus(int status, const std::string& message) {
+  if (status != 0) {
+    char err_txt[31];
+    fits_get_errstatus(status, err_txt);
+    throw Elements::Exception() << message << " status: " << status << " = " << err_txt;
+  }
+}
+
+/// Names of the table HDUs of a catalog, i.e. CATALOG, CATALOG_1... one for each detection image
+static std::vector<std::string> getTableHdus(const std::string& path) {
+  int status = 0;
+  fitsfile *fptr = nullptr;
+  fits_open_file(&fptr, path.c_str(), READONLY, &status);
+  checkFitsStatus(status, "Can't open " + path);
+
+  int nb_hdus = 0;
+  fits_get_num_hdus(fptr, &nb_hdus, &status);
+  std::vector<std::string> hdus;
+  for (int hdu = 2; hdu <= nb_hdus && status == 0; ++hdu) {
+    int hdu_type = 0;
+    fits_movabs_hdu(fptr, hdu, &hdu_type, &status);
+    if (status != 0 || hdu_type == IMAGE_HDU) {
+      continue;
+    }
+    char extname[FLEN_VALUE];
+    fits_read_key(fptr, TSTRING, "EXTNAME", extname, nullptr, &status);
+    if (status == KEY_NO_EXIST) {
+      status = 0;
+      fits_close_file(fptr, &status);
+      throw Elements::Exception() << "The table HDU " << hdu << " of " << path << " has no EXTNAME";
+    }
+    hdus.emplace_back(extname);
+  }
+
+  int close_status = 0;
+  fits_close_file(fptr, &close_status);
+  checkFitsStatus(status, "Can't read the HDUs of " + path);
+  return hdus;
+}
+
+/// Check image of a shard, which may only cover the region processed by the shard
+struct ShardImage {
+  fitsfile *m_fptr = nullptr;
+  // Position of the first pixel in the full image, zero-based
+  long m_offset[2] = {0, 0};
+  long m_size[2] = {0, 0};
+
+  explicit ShardImage(const std::string& path) {
+    int status = 0;
+    fits_open_image(&m_fptr, path.c_str(), READONLY, &status);
+    checkFitsStatus(status, "Can't open " + path);
+
+    int naxis = 0;
+    fits_get_img_dim(m_fptr, &naxis, &status);
+    fits_get_img_size(m_fptr, 2, m_size, &status);
+    checkFitsStatus(status, "Can't read the size of " + path);
+    if (naxis != 2) {
+      throw Elements::Exception() << "Only two dimensional check images can be merged";
+    }
+
+    // The region is recorded with the IRAF keywords, physical = image - LTV
+    const char* keywords[2] = {"LTV1", "LTV2"};
+    for (int axis = 0; axis < 2; ++axis) {
+      double ltv = 0;
+      fits_read_key(m_fptr, TDOUBLE, keywords[axis], &ltv, nullptr, &status);
+      if (status == KEY_NO_EXIST) {
+        status = 0;
+      }
+      m_offset[axis] = static_cast<long>(-ltv);
+    }
+    checkFitsStatus(status, "Can't read the offset of " + path);
+  }
+
+  ~ShardImage() {
+    int status = 0;
+    fits_close_file(m_fptr, &status);
+  }
+
+  ShardImage(const ShardImage&) = delete;
+  ShardImage& operator=(const ShardImage&) = delete;
+
+  /// Read the pixels of the core region covered by the image, by strips given in full image FITS coordinates
+  template <typename Callback>
+  void readCoreRegion(const PixelRectangle& region, Callback callback) {
+    // FITS coordinates, 1-based and inclusive
+    long min_x = std::max<long>(region.getTopLeft().m_x, m_offset[0]) + 1;
+    long min_y = std::max<long>(region.getTopLeft().m_y, m_offset[1]) + 1;
+    long max_x = std::min<long>(region.getBottomRight().m_x, m_offset[0] + m_size[0] - 1) + 1;
+    long max_y = std::min<long>(region.getBottomRight().m_y, m_offset[1] + m_size[1] - 1) + 1;
+    long inc[2] = {1, 1};
+
+    std::vector<double> buffer;
+    int status = 0;
+    for (long y = min_y; y <= max_y; y += CHECK_IMAGE_ROWS) {
+      long fpixel[2] = {min_x, y};
+      long lpixel[2] = {max_x, std::min(max_y, y + CHECK_IMAGE_ROWS - 1)};
+      long shard_fpixel[2] = {fpixel[0] - m_offset[0], fpixel[1] - m_offset[1]};
+      long shard_lpixel[2] = {lpixel[0] - m_offset[0], lpixel[1] - m_offset[1]};
+      buffer.resize((lpixel[0] - fpixel[0] + 1) * (lpixel[1] - fpixel[1] + 1));
+      fits_read_subset(m_fptr, TDOUBLE, shard_fpixel, shard_lpixel, inc, nullptr, buffer.data(), nullptr, &status);
+      checkFitsStatus(status, "Can't read the pixels of the shard check image");
+      callback(fpixel, lpixel, buffer);
+    }
+  }
+};
+
+class MergeShards : public Elements::Program {
+
+public:
+
+  po::options_description defineSpecificProgramOptions() override {
+    po::options_description config_options { "MergeShards options" };
+
+    config_options.add_options()
+        (SHARD_CATALOG.c_str(), po::value<std::vector<std::string>>()->multitoken()->required(),
+            "Catalogs of the shards, in order")
+        (SHARD_REGION.c_str(), po::value<std::vector<std::string>>()->multitoken()->default_value({}, ""),
+            "Core region of each shard (xmin,ymin,xmax,ymax), required to merge check images")
+        (SHARD_CHECK_IMAGE.c_str(), po::value<std::vector<std::string>>()->multitoken()->default_value({}, ""),
+            "Check image of each shard, in the same order as the catalogs")
+        (OUTPUT_CATALOG.c_str(), po::value<std::string>()->required(), "Merged catalog")
+        (OUTPUT_CHECK_IMAGE.c_str(), po::value<std::string>()->default_value(""), "Merged check image")
+        (ID_COLUMNS.c_str(), po::value<std::string>()->default_value("source_id,detection_id,group_id"),
+            "Integer columns renumbered so they stay unique across shards")
+        (SORT_COLUMN.c_str(), po::value<std::string>()->default_value("source_id"),
+            "Integer column the rows of each shard are sorted by, so the merged catalog does not depend on the "
+            "order the shards were written in")
+        (CHECK_IMAGE_ID_COLUMN.c_str(), po::value<std::string>()->default_value(""),
+            "Id column held by the check image, renumbered like the catalog: detection_id for the segmentation, "
+            "source_id for the partition and group_id for the group check image")
+        (CHECK_IMAGE_HDU.c_str(), po::value<std::string>()->default_value("CATALOG"),
+            "Catalog HDU of the detection image the check image belongs to");
+
+    return config_options;
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+    auto catalogs = args[SHARD_CATALOG].as<std::vector<std::string>>();
+    auto regions = args[SHARD_REGION].as<std::vector<std::string>>();
+    auto check_images = args[SHARD_CHECK_IMAGE].as<std::vector<std::string>>();
+    auto output_check_image = args[OUTPUT_CHECK_IMAGE].as<std::string>();
+    auto check_image_id_column = args[CHECK_IMAGE_ID_COLUMN].as<std::string>();
+    auto check_image_hdu = args[CHECK_IMAGE_HDU].as<std::string>();
+
+    std::vector<std::string> id_columns;
+    auto id_columns_str = args[ID_COLUMNS].as<std::string>();
+    if (!id_columns_str.empty()) {
+      boost::split(id_columns, id_columns_str, boost::is_any_of(","));
+    }
+
+    std::vector<PixelRectangle> core_regions;
+    if (!output_check_image.empty()) {
+      if (check_images.size() != catalogs.size() || regions.size() != catalogs.size()) {
+        logger.fatal() << "A check image and a region are required for each shard";
+        return Elements::ExitCode::USAGE;
+      }
+      if (!check_image_id_column.empty() &&
+          std::find(id_columns.begin(), id_columns.end(), check_image_id_column) == id_columns.end()) {
+        logger.fatal() << "The id column of the check image must be one of the " << ID_COLUMNS;
+        return Elements::ExitCode::USAGE;
+      }
+      for (auto& region : regions) {
+        core_regions.emplace_back(ShardConfig::parseRegion(region));
+      }
+    }
+    else {
+      check_image_id_column.clear();
+    }
+
+    // The pixels of the sources owned by a neighbour carry ids that are not in the catalog,
+    // they are accounted for so they do not collide with the ids of the next shards
+    std::vector<std::int64_t> check_image_max_ids(catalogs.size(), 0);
+    if (!check_image_id_column.empty()) {
+      for (std::size_t i = 0; i < check_images.size(); ++i) {
+        ShardImage shard_image(check_images[i]);
+        shard_image.readCoreRegion(core_regions[i], [&](const long*, const long*, const std::vector<double>& pixels) {
+          for (auto value : pixels) {
+            check_image_max_ids[i] = std::max(check_image_max_ids[i], static_cast<std::int64_t>(value));
+          }
+        });
+      }
+    }
+
+    auto id_offsets = mergeCatalogs(catalogs, args[OUTPUT_CATALOG].as<std::string>(), id_columns,
+                                    args[SORT_COLUMN].as<std::string>(), check_image_hdu, check_image_id_column,
+                                    check_image_max_ids);
+
+    if (!output_check_image.empty()) {
+      if (check_image_id_column.empty()) {
+        std::fill(id_offsets.begin(), id_offsets.end(), 0);
+      }
+      mergeCheckImages(check_images, core_regions, output_check_image, id_offsets);
+    }
+
+    return Elements::ExitCode::OK;
+  }
+
+private:
+
+  /// Returns the offset added to the check image id column of each shard
+  std::vector<std::int64_t> mergeCatalogs(const std::vector<std::string>& catalogs, const std::string& output,
+                                          const std::vector<std::string>& id_columns, const std::string& sort_column,
+                                          const std::string& check_image_hdu, const std::string& check_image_id_column,
+                                          const std::vector<std::int64_t>& check_image_max_ids) {
+    // A shard without sources for a detection image has no HDU for it, the others keep their order
+    std::vector<std::vector<std::string>> shard_hdus;
+    std::vector<std::string> hdus;
+    for (auto& catalog : catalogs) {
+      shard_hdus.emplace_back(getTableHdus(catalog));
+      auto position = hdus.begin();
+      for (auto& hdu : shard_hdus.back()) {
+        auto found = std::find(hdus.begin(), hdus.end(), hdu);
+        if (found == hdus.end()) {
+          found = hdus.insert(position, hdu);
+        }
+        position = found + 1;
+      }
+    }
+    if (!check_image_id_column.empty() && std::find(hdus.begin(), hdus.end(), check_image_hdu) == hdus.end()) {
+      throw Elements::Exception() << "The shard catalogs have no " << check_image_hdu << " HDU";
+    }
+
+    // The HDUs are appended one after the other
+    boost::filesystem::remove(output);
+
+    IdRenumbering renumbering(id_columns);
+    std::vector<std::int64_t> id_offsets(catalogs.size(), 0);
+    long long row_count = 0;
+
+    for (auto& hdu : hdus) {
+      FitsTableWriter writer(output);
+      writer.setHduName(hdu);
+
+      for (std::size_t i = 0; i < catalogs.size(); ++i) {
+        // The ids of every HDU of every shard are shifted past the previous ones
+        renumbering.nextShard();
+        if (!check_image_id_column.empty() && hdu == check_image_hdu) {
+          id_offsets[i] = renumbering.getOffset(check_image_id_column);
+          renumbering.updateMaxId(check_image_id_column, check_image_max_ids[i]);
+        }
+        if (std::find(shard_hdus[i].begin(), shard_hdus[i].end(), hdu) == shard_hdus[i].end()) {
+          continue;
+        }
+
+        logger.info() << "Merging " << catalogs[i] << "[" << hdu << "]";
+        std::vector<Row> rows;
+        Euclid::Table::FitsReader reader(catalogs[i], hdu);
+        while (reader.hasMoreRows()) {
+          auto table = reader.read(CHUNK_SIZE);
+          for (auto& row : table) {
+            rows.emplace_back(renumbering.apply(row));
+          }
+        }
+        if (rows.empty()) {
+          continue;
+        }
+
+        // The shards may have written their sources in measurement order
+        std::vector<std::size_t> order(rows.size());
+        std::iota(order.begin(), order.end(), 0);
+        auto sort_index = rows.front().getColumnInfo()->find(sort_column);
+        if (sort_index) {
+          std::vector<std::int64_t> keys;
+          keys.reserve(rows.size());
+          for (auto& row : rows) {
+            keys.emplace_back(IdRenumbering::getId(row[*sort_index], sort_column));
+          }
+          std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) {
+            return keys[a] < keys[b];
+          });
+        }
+
+        for (std::size_t first = 0; first < order.size(); first += CHUNK_SIZE) {
+          std::vector<Row> chunk;
+          for (std::size_t j = first; j < std::min(order.size(), first + CHUNK_SIZE); ++j) {
+            chunk.emplace_back(rows[order[j]]);
+          }
+          writer.addRows(chunk);
+        }
+      }
+
+      writer.close();
+      row_count += writer.getRowCount();
+    }
+
+    logger.info() << "Wrote " << row_count << " sources into " << output;
+    return id_offsets;
+  }
+
+  void mergeCheckImages(const std::vector<std::string>& check_images, const std::vector<PixelRectangle>& regions,
+                        const std::string& output, const std::vector<std::int64_t>& id_offsets) {
+    // The shards may only cover their processed region, the full image spans all of them
+    long naxes[2] = {0, 0};
+    long first_offset[2] = {0, 0};
+    int bitpix = 0;
+    for (std::size_t i = 0; i < check_images.size(); ++i) {
+      ShardImage shard_image(check_images[i]);
+      for (int axis = 0; axis < 2; ++axis) {
+        naxes[axis] = std::max(naxes[axis], shard_image.m_offset[axis] + shard_image.m_size[axis]);
+      }
+      if (i == 0) {
+        int status = 0;
+        fits_get_img_type(shard_image.m_fptr, &bitpix, &status);
+        checkFitsStatus(status, "Can't read the type of " + check_images[i]);
+        first_offset[0] = shard_image.m_offset[0];
+        first_offset[1] = shard_image.m_offset[1];
+      }
+    }
+
+    // The header (type and WCS) is copied from the first shard, and the data unit
+    // starts zero-filled, so pixels not covered by any core region stay at 0
+    int status = 0;
+    fitsfile *output_fptr = nullptr;
+    fitsfile *first_fptr = nullptr;
+    fits_open_image(&first_fptr, check_images.front().c_str(), READONLY, &status);
+    fits_create_file(&output_fptr, ("!" + output).c_str(), &status);
+    fits_copy_header(first_fptr, output_fptr, &status);
+    fits_close_file(first_fptr, &status);
+    fits_resize_img(output_fptr, bitpix, 2, naxes, &status);
+    checkFitsStatus(status, "Can't create " + output);
+
+    // Move the reference pixel back to the full image, and drop the region offset
+    const char* crpix_keywords[2] = {"CRPIX1", "CRPIX2"};
+    for (int axis = 0; axis < 2; ++axis) {
+      double crpix = 0;
+      fits_read_key(output_fptr, TDOUBLE, crpix_keywords[axis], &crpix, nullptr, &status);
+      if (status == KEY_NO_EXIST) {
+        status = 0;
+        continue;
+      }
+      crpix += first_offset[axis];
+      fits_update_key(output_fptr, TDOUBLE, crpix_keywords[axis], &crpix, nullptr, &status);
+    }
+    for (auto keyword : {"LTV1", "LTV2"}) {
+      fits_delete_key(output_fptr, keyword, &status);
+      if (status == KEY_NO_EXIST) {
+        status = 0;
+      }
+    }
+    checkFitsStatus(status, "Can't update the header of " + output);
+
+    try {
+      for (std::size_t i = 0; i < check_images.size(); ++i) {
+        logger.info() << "Merging " << check_images[i];
+        ShardImage shard_image(check_images[i]);
+        auto id_offset = id_offsets[i];
+        shard_image.readCoreRegion(regions[i], [&](long* fpixel, long* lpixel, std::vector<double>& pixels) {
+          if (id_offset != 0) {
+            for (auto& value : pixels) {
+              if (value > 0) {
+                value += id_offset;
+              }
+            }
+          }
+          fits_write_subset(output_fptr, TDOUBLE, fpixel, lpixel, pixels.data(), &status);
+          checkFitsStatus(status, "Can't write the pixels of " + check_images[i]);
+        });
+      }
+    }
+    catch (...) {
+      status = 0;
+      fits_close_file(output_fptr, &status);
+      throw;
+    }
+
+    fits_close_file(output_fptr, &status);
+    checkFitsStatus(status, "Can't write " + output);
+  }
+};
+
+MAIN_FOR(MergeShards)
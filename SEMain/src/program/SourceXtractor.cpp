@@ -38,14 +38,19 @@
 #include "Configuration/ConfigManager.h"
 #include "Configuration/Utils.h"
 
+#include "SEUtils/MemoryAccounting.h"
+
 #include "SEFramework/Plugin/PluginManager.h"
 
 #include "SEFramework/Task/TaskProvider.h"
+#include "SEFramework/Task/PropertyPlanner.h"
 #include "SEFramework/Image/ProcessedImage.h"
 #include "SEFramework/Image/BufferedImage.h"
+#include "SEFramework/FITS/FitsImageSource.h"
 #include "SEFramework/Pipeline/SourceGrouping.h"
 #include "SEFramework/Pipeline/Deblending.h"
 #include "SEFramework/Pipeline/Partition.h"
+#include "SEFramework/Pipeline/Tracer.h"
 #include "SEFramework/Output/OutputRegistry.h"
 
 #include "SEFramework/Task/TaskFactoryRegistry.h"
@@ -59,6 +64,7 @@
 #include "SEImplementation/CheckImages/MoffatCheckImage.h"
 #include "SEImplementation/Background/BackgroundAnalyzerFactory.h"
 #include "SEImplementation/Configuration/MultiThreadingConfig.h"
+#include "SEImplementation/Configuration/PropertyPlannerConfig.h"
 #include "SEImplementation/Segmentation/SegmentationFactory.h"
 #include "SEImplementation/Output/OutputFactory.h"
 #include "SEImplementation/Grouping/GroupingFactory.h"
@@ -72,14 +78,21 @@
 #include "SEImplementation/Configuration/SE2BackgroundConfig.h"
 #include "SEImplementation/Configuration/WeightImageConfig.h"
 #include "SEImplementation/Configuration/MemoryConfig.h"
+#include "SEImplementation/Configuration/TracingConfig.h"
 #include "SEImplementation/Configuration/OutputConfig.h"
 #include "SEImplementation/Configuration/SamplingConfig.h"
 #include "SEImplementation/CheckImages/CheckImages.h"
 #include "SEImplementation/Prefetcher/Prefetcher.h"
+#include "SEImplementation/PythonConfig/PythonFallbackReport.h"
+#include "SEImplementation/Checkpoint/CheckpointFilter.h"
+#include "SEImplementation/Configuration/CheckpointConfig.h"
+#include "SEImplementation/Plugin/SourceIDs/SourceIDTask.h"
+#include "SEImplementation/Configuration/RemeasureConfig.h"
 
 #include "SEMain/ProgressReporterFactory.h"
 #include "SEMain/PluginConfig.h"
 #include "SEMain/Sorter.h"
+#include "SEMain/FrameSplitter.h"
 
 
 namespace po = boost::program_options;
@@ -188,6 +201,7 @@ public:
       config_manager.registerConfiguration<BackgroundConfig>();
       config_manager.registerConfiguration<SE2BackgroundConfig>();
       config_manager.registerConfiguration<MemoryConfig>();
+      config_manager.registerConfiguration<TracingConfig>();
       config_manager.registerConfiguration<BackgroundAnalyzerFactory>();
       config_manager.registerConfiguration<SamplingConfig>();
       config_manager.registerConfiguration<DetectionFrameConfig>();
@@ -328,10 +342,21 @@ public:
     auto& config_manager = ConfigManager::getInstance(config_manager_id);
     config_manager.initialize(args);
 
+    // Record the timeline of the run, if requested
+    auto& trace_file = config_manager.getConfiguration<TracingConfig>().getTraceFile();
+    if (!trace_file.empty()) {
+      Tracer::getInstance().setThreadName("Main");
+      Tracer::getInstance().start(trace_file);
+    }
+
     // Configure TileManager
     auto memory_config = config_manager.getConfiguration<MemoryConfig>();
     TileManager::getInstance()->setOptions(memory_config.getTileSize(),
         memory_config.getTileSize(), memory_config.getTileMaxMemory());
+    TileManager::getInstance()->setWriteBack(memory_config.getWriteBack());
+    MemoryAccounting::getInstance().setEnabled(memory_config.getMemoryReport() || memory_config.getSoftLimit() > 0);
+    MemoryAccounting::getInstance().setSoftLimit(memory_config.getSoftLimit() * 1024L * 1024L);
+    FitsImageSource::setMemoryMapping(memory_config.getMemoryMapping());
 
     CheckImages::getInstance().configure(config_manager);
 
@@ -364,9 +389,27 @@ public:
     std::shared_ptr<Measurement> measurement = measurement_factory.getMeasurement();
     std::shared_ptr<Output> output = output_factory.createOutput();
 
+    // The property dependencies are learnt from the first sources measured. The time spent on each property
+    // is measured only for the report.
+    auto& property_planner_config = config_manager.getConfiguration<PropertyPlannerConfig>();
+    if (property_planner_config.getPropertyPlanning() || property_planner_config.getPropertyReport()) {
+      auto output_types = output_registry->getOutputPropertyTypes(
+        config_manager.getConfiguration<OutputConfig>().getOutputProperties());
+      PropertyPlanner::getInstance().setOutputTypes({output_types.begin(), output_types.end()});
+      PropertyPlanner::getInstance().setRequiredProperties([registry = task_factory_registry](const PropertyId& property_id) {
+        return registry->getRequiredProperties(property_id);
+      });
+      PropertyPlanner::getInstance().setRecording(true);
+      PropertyPlanner::getInstance().setStatistics(property_planner_config.getPropertyReport());
+    }
+
+    // When re-measuring a previous run, its sources and groups are rebuilt as they were, without partition
+    // nor deblending
+    bool remeasure = config_manager.getConfiguration<RemeasureConfig>().isEnabled();
+
     // Prefetcher
     std::shared_ptr<Prefetcher> prefetcher;
-    if (thread_pool) {
+    if (thread_pool && !remeasure) {
       auto prefetch = source_grouping->requiredProperties();
       auto deblending_prefetch =  deblending->requiredProperties();
       prefetch.insert(deblending_prefetch.begin(), deblending_prefetch.end());
@@ -377,32 +420,90 @@ public:
     }
 
     // Link together the pipeline's steps
-    segmentation->setNextStage(partition);
+    std::shared_ptr<PipelineEmitter<SourceGroupInterface>> deblended = deblending;
+    if (remeasure) {
+      segmentation->setNextStage(source_grouping);
+      deblended = source_grouping;
+    }
+    else {
+      segmentation->setNextStage(partition);
 
-    if (prefetcher) {
-      partition->setNextStage(prefetcher);
-      prefetcher->setNextStage(source_grouping);
+      if (prefetcher) {
+        partition->setNextStage(prefetcher);
+        prefetcher->setNextStage(source_grouping);
+      }
+      else {
+        partition->setNextStage(source_grouping);
+      }
+
+      source_grouping->setNextStage(deblending);
+    }
+
+    // Skip the groups already measured by a previous run
+    auto checkpoint = config_manager.getConfiguration<CheckpointConfig>().getCheckpoint();
+    std::shared_ptr<CheckpointFilter> checkpoint_filter;
+    int first_source_id = 1;
+    if (checkpoint) {
+      // The restored rows keep their source_id, so the new sources are numbered after them
+      first_source_id = checkpoint->getMaxStoredValue("source_id") + 1;
+      SourceIDTask::setNextId(first_source_id);
+      checkpoint_filter = std::make_shared<CheckpointFilter>(checkpoint);
+      deblended->setNextStage(checkpoint_filter);
+      checkpoint_filter->setNextStage(measurement);
     }
     else {
-      partition->setNextStage(source_grouping);
+      deblended->setNextStage(measurement);
     }
 
-    source_grouping->setNextStage(deblending);
-    deblending->setNextStage(measurement);
+    // With frame pipelining the catalog part is switched when the first source of the next frame
+    // reaches the output, which requires the sources to arrive in segmentation order
+    size_t prev_writen_rows = 0;
+    std::shared_ptr<FrameSplitter> frame_splitter;
+    bool output_unsorted = config_manager.getConfiguration<OutputConfig>().getOutputUnsorted();
+    if (remeasure && !output_unsorted) {
+      // The re-measured sources keep the identifiers of the previous run, which have gaps where sources
+      // were filtered out, so the sorter would wait forever for them
+      logger.info() << "Re-measured sources keep their previous identifiers, writing output unsorted";
+      output_unsorted = true;
+    }
+    if (multithreading_config.getFramePipelining()) {
+      if (output_unsorted) {
+        logger.warn() << "Frame pipelining requires sorted output, disabling it";
+      }
+      else {
+        frame_splitter = std::make_shared<FrameSplitter>([&output, &prev_writen_rows]() {
+          size_t nb_writen_rows = output->flush();
+          output->nextPart();
+          logger.info() << (nb_writen_rows - prev_writen_rows) << " sources detected in frame, " << nb_writen_rows << " total";
+          prev_writen_rows = nb_writen_rows;
+        });
+      }
+    }
 
-    if (config_manager.getConfiguration<OutputConfig>().getOutputUnsorted()) {
+    if (output_unsorted) {
       logger.info() << "Writing output following measure order";
       measurement->setNextStage(output);
     } else {
       logger.info() << "Writing output following segmentation order";
-      auto sorter = std::make_shared<Sorter>();
+      auto sorter = std::make_shared<Sorter>(first_source_id);
       measurement->setNextStage(sorter);
-      sorter->setNextStage(output);
+      if (frame_splitter) {
+        sorter->setNextStage(frame_splitter);
+        frame_splitter->setNextStage(output);
+      }
+      else {
+        sorter->setNextStage(output);
+      }
     }
 
     segmentation->Observable<SegmentationProgress>::addObserver(progress_mediator->getSegmentationObserver());
     segmentation->Observable<SourceInterface>::addObserver(progress_mediator->getDetectionObserver());
-    deblending->Observable<SourceGroupInterface>::addObserver(progress_mediator->getDeblendingObserver());
+    if (checkpoint_filter) {
+      checkpoint_filter->Observable<SourceGroupInterface>::addObserver(progress_mediator->getDeblendingObserver());
+    }
+    else {
+      deblended->Observable<SourceGroupInterface>::addObserver(progress_mediator->getDeblendingObserver());
+    }
     measurement->Observable<SourceGroupInterface>::addObserver(progress_mediator->getMeasurementObserver());
 
     // Add observers for CheckImages
@@ -422,7 +523,6 @@ public:
 
     // Perform measurements (multi-threaded part)
     measurement->startThreads();
-    size_t prev_writen_rows = 0;
 
     if (detection_frames.size() > 0) {
       size_t frame_number = 0;
@@ -440,10 +540,22 @@ public:
           return Elements::ExitCode::NOT_OK;
         }
 
+        if (checkpoint_filter) {
+          checkpoint_filter->endFrame();
+        }
+
+        // Do not wait for the measurement, move on to the next frame
+        if (frame_splitter) {
+          frame_splitter->endFrame();
+          continue;
+        }
+
         if (prefetcher) {
           prefetcher->synchronize();
         }
         measurement->synchronizeThreads();
+        // Every source of the frame has been measured: draw them into the check images, in order
+        CheckImages::getInstance().mergeDeferredChanges();
 
         size_t nb_writen_rows = output->flush();
         output->nextPart();
@@ -452,6 +564,14 @@ public:
 
         prev_writen_rows = nb_writen_rows;
       }
+
+      if (frame_splitter) {
+        if (prefetcher) {
+          prefetcher->synchronize();
+        }
+        measurement->synchronizeThreads();
+        frame_splitter->finish();
+      }
     } else {
       // Running detection-less
 
@@ -501,6 +621,19 @@ public:
     CheckImages::getInstance().saveImages();
     TileManager::getInstance()->flush();
     progress_mediator->done();
+    Tracer::getInstance().stop();
+    if (memory_config.getMemoryReport()) {
+      MemoryAccounting::getInstance().logReport();
+    }
+    PythonFallbackReport::getInstance().logReport();
+
+    if (property_planner_config.getPropertyReport()) {
+      PropertyPlanner::getInstance().logReport();
+    }
+
+    if (checkpoint_filter && checkpoint_filter->getSkippedCount() > 0) {
+      logger.info() << checkpoint_filter->getSkippedCount() << " groups were restored from the checkpoint";
+    }
 
     if (prev_writen_rows > 0) {
       logger.info() << "total " << prev_writen_rows << " sources detected";
@@ -198,6 +198,7 @@ public:
         ("max-tile-memory", po::value<int>()->default_value(512), "Maximum memory used for image tiles cache in megabytes")
         ("tile-size", po::value<int>()->default_value(256), "Image tiles size in pixels")
         ("copy-coordinate-system", po::value<string>()->default_value(""), "Copy the coordinate system from another FITS file")
+        ("seed", po::value<unsigned int>()->default_value(0), "Seed for the random generator, 0 for a time based seed")
         ;
 
     return config_options;
@@ -489,6 +490,11 @@ public:
     auto tile_size = args["tile-size"].as<int>();
     TileManager::getInstance()->setOptions(tile_size, tile_size, max_tile_memory);
 
+    auto seed = args["seed"].as<unsigned int>();
+    if (seed != 0) {
+      m_rng.seed(seed);
+    }
+
     auto image_size = args["size"].as<double>();
     auto rot_angle = args["rotation"].as<double>() / 180.0 * M_PI;
     auto scale = args["scale"].as<double>();
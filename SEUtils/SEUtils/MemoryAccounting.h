@@ -0,0 +1,231 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _SEUTILS_MEMORYACCOUNTING_H_
+#define _SEUTILS_MEMORYACCOUNTING_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "ElementsKernel/Logging.h"
+
+namespace SourceXtractor {
+
+/**
+ * @class MemoryAccounting
+ * @brief Counts the bytes held by the large structures of the pipeline, per category, and their high-water marks
+ *
+ * @details
+ *  The figures are estimates of the payload (pixels, rows, work areas), not of the allocator overhead.
+ *  Nothing is counted unless the accounting is enabled, so the shared counters are not touched by default.
+ *
+ *  A soft limit can be set on everything but the tiles, which are already bounded by the tile memory limit.
+ *  Only the input of the multithreaded measurement waits for memory to be released when the limit is exceeded:
+ *  the other stages keep allocating, so the limit can be overshot.
+ */
+class MemoryAccounting {
+public:
+
+  enum Category {
+    TILES = 0,  ///< Image tiles, cached or waiting to be written
+    SOURCES,    ///< Pixel lists, pixel values and stamps of the sources
+    GROUPS,     ///< Stamps of the groups
+    FITTING,    ///< Work areas of the minimizers
+    OUTPUT,     ///< Catalog rows waiting to be written
+    FFT,        ///< Buffers of the FFT convolutions
+    CATEGORY_COUNT
+  };
+
+  /**
+   * Accounts a number of bytes in a category for as long as it lives. A copy accounts the same bytes again.
+   */
+  class Allocation {
+  public:
+    Allocation() : m_category(TILES), m_bytes(0) {}
+
+    Allocation(Category category, int64_t bytes) : m_category(category), m_bytes(bytes) {
+      getInstance().allocate(m_category, m_bytes);
+    }
+
+    Allocation(const Allocation& other) : Allocation(other.m_category, other.m_bytes) {}
+
+    Allocation(Allocation&& other) noexcept : m_category(other.m_category), m_bytes(other.m_bytes) {
+      other.m_bytes = 0;
+    }
+
+    Allocation& operator=(Allocation other) noexcept {
+      std::swap(m_category, other.m_category);
+      std::swap(m_bytes, other.m_bytes);
+      return *this;
+    }
+
+    ~Allocation() {
+      getInstance().release(m_category, m_bytes);
+    }
+
+    void resize(int64_t bytes) {
+      getInstance().allocate(m_category, bytes - m_bytes);
+      m_bytes = bytes;
+    }
+
+    int64_t getBytes() const {
+      return m_bytes;
+    }
+
+  private:
+    Category m_category;
+    int64_t m_bytes;
+  };
+
+  static MemoryAccounting& getInstance() {
+    static MemoryAccounting instance;
+    return instance;
+  }
+
+  static const char* getCategoryName(Category category) {
+    static const char* names[CATEGORY_COUNT] = {
+      "Tiles", "Source properties", "Group stamps", "Fitting work areas", "Output buffers", "FFT buffers"
+    };
+    return names[category];
+  }
+
+  /// Actually not thread safe, call before anything is allocated
+  void setEnabled(bool enabled) {
+    m_enabled = enabled;
+  }
+
+  bool isEnabled() const {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  void allocate(Category category, int64_t bytes) {
+    if (bytes < 0) {
+      release(category, -bytes);
+      return;
+    }
+    if (bytes == 0 || !isEnabled()) {
+      return;
+    }
+    updateMax(m_high_water[category], m_current[category].fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    updateMax(m_total_high_water, m_total.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+  }
+
+  void release(Category category, int64_t bytes) {
+    if (bytes == 0 || !isEnabled()) {
+      return;
+    }
+    m_current[category].fetch_sub(bytes, std::memory_order_relaxed);
+    m_total.fetch_sub(bytes, std::memory_order_relaxed);
+    if (m_waiters.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_released.notify_all();
+    }
+  }
+
+  int64_t getCurrent(Category category) const {
+    return m_current[category].load(std::memory_order_relaxed);
+  }
+
+  int64_t getHighWater(Category category) const {
+    return m_high_water[category].load(std::memory_order_relaxed);
+  }
+
+  int64_t getTotal() const {
+    return m_total.load(std::memory_order_relaxed);
+  }
+
+  /// Highest value reached by the sum of all categories at once, lower than the sum of the high-water marks
+  int64_t getTotalHighWater() const {
+    return m_total_high_water.load(std::memory_order_relaxed);
+  }
+
+  /// Limit on the bytes accounted outside of the tiles, 0 disables it. It needs the accounting to be enabled.
+  void setSoftLimit(int64_t bytes) {
+    m_soft_limit = bytes;
+  }
+
+  int64_t getSoftLimit() const {
+    return m_soft_limit;
+  }
+
+  bool isOverSoftLimit() const {
+    auto limit = m_soft_limit.load(std::memory_order_relaxed);
+    return limit > 0 && getTotal() - getCurrent(TILES) > limit;
+  }
+
+  /**
+   * Block while the soft limit is exceeded and pending() is true. pending() must tell if there is still
+   * work in progress that will release memory, otherwise the caller could wait forever.
+   */
+  template <typename Pending>
+  void waitBelowSoftLimit(Pending pending) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++m_waiters;
+    while (isOverSoftLimit() && pending()) {
+      // Releases notify, the timeout covers a change of pending() alone
+      m_released.wait_for(lock, std::chrono::milliseconds(100));
+    }
+    --m_waiters;
+  }
+
+  void resetHighWater() {
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+      m_high_water[i] = m_current[i].load();
+    }
+    m_total_high_water = m_total.load();
+  }
+
+  /// Log the high-water mark of each category
+  void logReport() const {
+    auto logger = Elements::Logging::getLogger("MemoryAccounting");
+    logger.info() << "Memory high-water marks (MiB):";
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+      auto category = static_cast<Category>(i);
+      logger.info() << "    " << getCategoryName(category) << ": " << toMiB(getHighWater(category));
+    }
+    logger.info() << "    Total at once: " << toMiB(getTotalHighWater());
+  }
+
+private:
+  std::array<std::atomic<int64_t>, CATEGORY_COUNT> m_current{}, m_high_water{};
+  std::atomic<int64_t> m_total{0}, m_total_high_water{0}, m_soft_limit{0};
+  std::atomic<int> m_waiters{0};
+  std::atomic<bool> m_enabled{false};
+  std::mutex m_mutex;
+  std::condition_variable m_released;
+
+  MemoryAccounting() = default;
+
+  static void updateMax(std::atomic<int64_t>& max, int64_t value) {
+    auto current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  static double toMiB(int64_t bytes) {
+    return bytes / (1024. * 1024.);
+  }
+};
+
+} // end of namespace SourceXtractor
+
+#endif /* _SEUTILS_MEMORYACCOUNTING_H_ */
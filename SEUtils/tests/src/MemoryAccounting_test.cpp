@@ -0,0 +1,123 @@
+/** Copyright © 2019-2022 Université de Genève, LMU Munich - Faculty of Physics, IAP-CNRS/Sorbonne Université
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <thread>
+#include <boost/test/unit_test.hpp>
+
+#include "SEUtils/MemoryAccounting.h"
+
+using namespace SourceXtractor;
+
+struct MemoryAccountingFixture {
+  MemoryAccounting& accounting = MemoryAccounting::getInstance();
+
+  MemoryAccountingFixture() {
+    accounting.setEnabled(true);
+    accounting.setSoftLimit(0);
+    accounting.resetHighWater();
+  }
+
+  ~MemoryAccountingFixture() {
+    accounting.setEnabled(false);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_SUITE (MemoryAccounting_test, MemoryAccountingFixture)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( allocation_test ) {
+  auto before = accounting.getCurrent(MemoryAccounting::SOURCES);
+  {
+    MemoryAccounting::Allocation a(MemoryAccounting::SOURCES, 100);
+    BOOST_CHECK_EQUAL(accounting.getCurrent(MemoryAccounting::SOURCES), before + 100);
+
+    // A copy counts again, a move does not
+    auto b = a;
+    BOOST_CHECK_EQUAL(accounting.getCurrent(MemoryAccounting::SOURCES), before + 200);
+    auto c = std::move(b);
+    BOOST_CHECK_EQUAL(accounting.getCurrent(MemoryAccounting::SOURCES), before + 200);
+
+    c.resize(50);
+    BOOST_CHECK_EQUAL(accounting.getCurrent(MemoryAccounting::SOURCES), before + 150);
+    BOOST_CHECK_EQUAL(accounting.getHighWater(MemoryAccounting::SOURCES), before + 200);
+  }
+  BOOST_CHECK_EQUAL(accounting.getCurrent(MemoryAccounting::SOURCES), before);
+  BOOST_CHECK_EQUAL(accounting.getHighWater(MemoryAccounting::SOURCES), before + 200);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( disabled_test ) {
+  accounting.setEnabled(false);
+  auto before = accounting.getCurrent(MemoryAccounting::SOURCES);
+  {
+    MemoryAccounting::Allocation a(MemoryAccounting::SOURCES, 100);
+    BOOST_CHECK_EQUAL(accounting.getCurrent(MemoryAccounting::SOURCES), before);
+  }
+  BOOST_CHECK_EQUAL(accounting.getCurrent(MemoryAccounting::SOURCES), before);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( total_high_water_test ) {
+  auto before = accounting.getTotal();
+  {
+    MemoryAccounting::Allocation a(MemoryAccounting::FITTING, 1000);
+  }
+  {
+    MemoryAccounting::Allocation b(MemoryAccounting::OUTPUT, 500);
+  }
+  BOOST_CHECK_EQUAL(accounting.getHighWater(MemoryAccounting::FITTING), 1000);
+  BOOST_CHECK_EQUAL(accounting.getHighWater(MemoryAccounting::OUTPUT), 500);
+  BOOST_CHECK_EQUAL(accounting.getTotalHighWater(), before + 1000);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE( soft_limit_test ) {
+  accounting.setSoftLimit(1000);
+
+  // Tiles have their own limit
+  MemoryAccounting::Allocation tiles(MemoryAccounting::TILES, 5000);
+  BOOST_CHECK(!accounting.isOverSoftLimit());
+
+  std::unique_ptr<MemoryAccounting::Allocation> group(
+    new MemoryAccounting::Allocation(MemoryAccounting::GROUPS, 2000));
+  BOOST_CHECK(accounting.isOverSoftLimit());
+
+  // Nothing pending, so there is no wait
+  accounting.waitBelowSoftLimit([]() { return false; });
+
+  // Wait until another thread releases the memory
+  std::atomic<bool> pending{true};
+  std::thread worker([&group]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    group.reset();
+  });
+  accounting.waitBelowSoftLimit([&pending]() { return pending.load(); });
+  BOOST_CHECK(!accounting.isOverSoftLimit());
+  worker.join();
+
+  accounting.setSoftLimit(0);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END ()